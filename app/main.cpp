@@ -1,15 +1,25 @@
 #include "geometry/point.h"
 #include "geometry/shape.h"
+#include "geometry/shape_file.h"
+#include "geometry/shape_store.h"
+#include "geometry/shape_stream.h"
+#include "geometry/thread_pool.h"
 #include "geometry/transform.h"
 #include "io/logger.h"
 #include "io/file_writer.h"
+#include "io/metrics.h"
 
 #include <iostream>
-#include <iomanip>
 #include <memory>
 #include <vector>
+#include <chrono>
 #include <cmath>
-#include <sstream>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
 
 // ── Student exercise ──────────────────────────────────────────────────────────
 
@@ -67,17 +77,110 @@ static void run() {
 // ── helper ────────────────────────────────────────────────────────────────────
 
 static void printShape(const geometry::Shape& s, io::Logger& log) {
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(4)
-        << s.name()
-        << "  area=" << s.area()
-        << "  perimeter=" << s.perimeter();
-    log.info(oss.str());
+    IO_LOG_INFO(log, "{}  area={:.4f}  perimeter={:.4f}", s.name(), s.area(), s.perimeter());
+}
+
+// ── streaming mode ────────────────────────────────────────────────────────────
+//
+//   app --stream [INPUT|-] [--out=FILE] [--translate=X,Y,Z]
+//       [--rotate-x=RAD] [--rotate-y=RAD] [--rotate-z=RAD] [--metrics=FILE]
+//       [--compress]
+//
+// Reads shape records (see geometry/shape_stream.h) from INPUT or stdin,
+// applies translate * rotZ * rotY * rotX whatever the order of the options
+// (a repeated option replaces the earlier angle), and writes CSV to FILE
+// (default stream_output.csv) through an async FileWriter.  With
+// --metrics, a JSON metrics snapshot is appended to that file every second.
+// With --compress, FILE is written in the block-compressed format of
+// io/compressed_file.h.
+
+static bool parseDoubles(const char* text, double* out, int count) {
+    for (int i = 0; i < count; ++i) {
+        char* end = nullptr;
+        out[i] = std::strtod(text, &end);
+        if (end == text || (i + 1 < count ? *end != ',' : *end != '\0')) return false;
+        text = end + 1;
+    }
+    return true;
+}
+
+static int runStream(int argc, char** argv) {
+    auto& log = io::Logger::instance();
+    std::string input = "-";
+    std::string output = "stream_output.csv";
+    std::string metrics;
+    bool compress = false;
+    double angle[3] = {0.0, 0.0, 0.0};   // x, y, z
+    geometry::Transform offset;
+
+    for (int i = 2; i < argc; ++i) {
+        const char* arg = argv[i];
+        double v[3];
+        if (std::strncmp(arg, "--out=", 6) == 0) {
+            output = arg + 6;
+        } else if (std::strncmp(arg, "--metrics=", 10) == 0) {
+            metrics = arg + 10;
+        } else if (std::strcmp(arg, "--compress") == 0) {
+            compress = true;
+        } else if (std::strncmp(arg, "--translate=", 12) == 0 && parseDoubles(arg + 12, v, 3)) {
+            offset = geometry::Transform::translation(v[0], v[1], v[2]);
+        } else if (std::strncmp(arg, "--rotate-x=", 11) == 0 && parseDoubles(arg + 11, v, 1)) {
+            angle[0] = v[0];
+        } else if (std::strncmp(arg, "--rotate-y=", 11) == 0 && parseDoubles(arg + 11, v, 1)) {
+            angle[1] = v[0];
+        } else if (std::strncmp(arg, "--rotate-z=", 11) == 0 && parseDoubles(arg + 11, v, 1)) {
+            angle[2] = v[0];
+        } else if (arg[0] != '-' || std::strcmp(arg, "-") == 0) {
+            input = arg;
+        } else {
+            log.error("Unknown or malformed argument: {}", arg);
+            return 2;
+        }
+    }
+
+    const geometry::Transform transform = offset * geometry::Transform::rotationZ(angle[2])
+                                        * geometry::Transform::rotationY(angle[1])
+                                        * geometry::Transform::rotationX(angle[0]);
+
+    const int fd = input == "-" ? STDIN_FILENO : ::open(input.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        log.error("Cannot open {}: {}", input, std::strerror(errno));
+        return 1;
+    }
+
+    int status = 0;
+    try {
+        io::WriterOptions options;
+        options.async = true;
+        if (compress) options.compression = io::Compression::Lz;
+        io::FileWriter writer(output, options);
+        std::unique_ptr<io::FileWriter> metricsFile;
+        std::unique_ptr<io::MetricsReporter> reporter;
+        if (!metrics.empty()) {
+            metricsFile = std::make_unique<io::FileWriter>(metrics, true);
+            reporter = std::make_unique<io::MetricsReporter>(std::chrono::seconds(1), *metricsFile);
+        }
+
+        const auto t0 = std::chrono::steady_clock::now();
+        const auto stats = geometry::transformShapeStream(fd, transform, writer);
+        writer.flush();
+        const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        log.info("Streamed {} records ({} bytes in, {} bytes out) in {:.3f} s: {:.2f} M records/s",
+                 stats.records, stats.bytesIn, stats.bytesOut, s, stats.records / s / 1e6);
+    } catch (const std::exception& ex) {
+        log.error("Streaming failed: {}", ex.what());
+        status = 1;
+    }
+    if (fd != STDIN_FILENO) ::close(fd);
+    return status;
 }
 
 // ── main ──────────────────────────────────────────────────────────────────────
 
-int main() {
+int main(int argc, char** argv) {
+    if (argc > 1 && std::strcmp(argv[1], "--stream") == 0) return runStream(argc, argv);
+
     // ── Student exercise ──────────────────────────────────────────────────────
     student_exercise::run();
 
@@ -87,7 +190,7 @@ int main() {
     log.info("=== Geometry demo starting ===");
 
     // ── Points & vector algebra ───────────────────────────────────────────────
-    log.debug("Creating points");
+    IO_LOG_DEBUG(log, "Creating points");
 
     const geometry::Point origin(0.0, 0.0, 0.0);
     const geometry::Point p1(3.0, 4.0, 0.0);
@@ -104,7 +207,7 @@ int main() {
     std::cout << "dist(origin, p1) = " << origin.distanceTo(p1) << "\n";
 
     // ── Shapes ────────────────────────────────────────────────────────────────
-    log.debug("Building shapes");
+    IO_LOG_DEBUG(log, "Building shapes");
 
     std::vector<std::unique_ptr<geometry::Shape>> shapes;
     shapes.push_back(std::make_unique<geometry::Circle>(origin, 5.0));
@@ -117,8 +220,13 @@ int main() {
         std::cout << "  centroid = " << s->centroid() << "\n";
     }
 
+    const geometry::ShapeStore store = geometry::ShapeStore::fromShapes(shapes);
+    auto& pool = geometry::ThreadPool::instance();
+    std::cout << "total area      = " << store.totalArea(pool)      << "\n";
+    std::cout << "total perimeter = " << store.totalPerimeter(pool) << "\n";
+
     // ── Transforms ────────────────────────────────────────────────────────────
-    log.debug("Applying transforms");
+    IO_LOG_DEBUG(log, "Applying transforms");
 
     const geometry::Transform t1 = geometry::Transform::translation(1.0, 2.0, 3.0);
     const geometry::Transform rx = geometry::Transform::rotationX(M_PI / 4.0); // 45°
@@ -138,23 +246,32 @@ int main() {
     std::cout << "round-trip (should equal p1): " << roundtrip << "\n";
 
     // ── Write results to a file ───────────────────────────────────────────────
-    log.debug("Writing results to output.txt");
+    IO_LOG_DEBUG(log, "Writing results to output.txt");
     try {
         io::FileWriter writer("output.txt");
-        writer.writeLine("=== Geometry results ===");
+        writer.writeLine("name,area,perimeter,centroid_x,centroid_y");
         for (const auto& s : shapes) {
-            std::ostringstream oss;
-            oss << std::fixed << std::setprecision(4)
-                << s->name()
-                << "  area=" << s->area()
-                << "  perimeter=" << s->perimeter()
-                << "  centroid=" << s->centroid().x()
-                << "," << s->centroid().y();
-            writer.writeLine(oss.str());
+            const geometry::Point c = s->centroid();
+            writer.record()
+                .field("name", s->name())
+                .field("area", s->area(), 4)
+                .field("perimeter", s->perimeter(), 4)
+                .field("centroid_x", c.x(), 4)
+                .field("centroid_y", c.y(), 4);
         }
-        log.info("Results written (" + std::to_string(writer.bytesWritten()) + " bytes)");
+        log.info("Results written ({} bytes)", writer.bytesWritten());
+    } catch (const std::exception& ex) {
+        log.warning("Could not write output file: {}", ex.what());
+    }
+
+    // Full-precision copy for downstream tools; read back with MappedShapes.
+    IO_LOG_DEBUG(log, "Writing shapes to shapes.bin");
+    try {
+        geometry::writeShapeFile("shapes.bin", store);
+        const geometry::MappedShapes mapped("shapes.bin");
+        log.info("Shapes written ({} shapes, {} bytes)", mapped.size(), mapped.file().fileSize());
     } catch (const std::exception& ex) {
-        log.warning(std::string("Could not write output file: ") + ex.what());
+        log.warning("Could not write shapes file: {}", ex.what());
     }
 
     log.info("=== Done ===");
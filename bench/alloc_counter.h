@@ -0,0 +1,39 @@
+#pragma once
+
+// Counts calls to the global operator new by replacing the global
+// allocation functions.  Replacements may be defined only once per
+// program, so include this from exactly one translation unit per bench.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace bench {
+
+inline std::atomic<std::size_t> g_allocations{0};
+
+/// Global operator new calls so far, from any thread.
+inline std::size_t allocationCount() {
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+} // namespace bench
+
+void* operator new(std::size_t size) {
+    bench::g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    bench::g_allocations.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t a = static_cast<std::size_t>(align);
+    if (void* p = std::aligned_alloc(a, (size + a - 1) / a * a)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
@@ -0,0 +1,211 @@
+#pragma once
+
+#include "io/json.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+/// Prevent the optimiser from discarding a computed value.
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void clobberMemory() {
+    asm volatile("" : : : "memory");
+}
+
+/// Run \p fn \p reps times and return the best wall time in seconds.
+template <typename Fn>
+double bestOf(int reps, Fn&& fn) {
+    double best = 1e300;
+    for (int r = 0; r < reps; ++r) {
+        const auto t0 = std::chrono::steady_clock::now();
+        fn();
+        const auto t1 = std::chrono::steady_clock::now();
+        const double s = std::chrono::duration<double>(t1 - t0).count();
+        if (s < best) best = s;
+    }
+    return best;
+}
+
+inline void report(const char* name, std::size_t items, double seconds) {
+    std::printf("%-40s %12.3f ms  %10.2f M items/s\n",
+                name, seconds * 1e3, static_cast<double>(items) / seconds / 1e6);
+}
+
+inline std::mt19937_64& rng() {
+    static std::mt19937_64 gen(42);
+    return gen;
+}
+
+inline double uniform(double lo, double hi) {
+    return std::uniform_real_distribution<double>(lo, hi)(rng());
+}
+
+// ── Checks ───────────────────────────────────────────────────────────────────
+//
+// check() reports a failure on stderr and counts it; main() returns
+// exitCode(), which is non-zero after any failure.
+
+inline int& failureCount() {
+    static int failures = 0;
+    return failures;
+}
+
+inline void check(bool ok, const char* what) {
+    if (!ok) {
+        std::fprintf(stderr, "FAIL: %s\n", what);
+        ++failureCount();
+    }
+}
+
+inline int exitCode() {
+    return failureCount() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// ── Suite runner ─────────────────────────────────────────────────────────────
+//
+// Runner times named cases: a few untimed warm-up calls, then `reps` timed
+// repetitions, reported as min / median / p99 / max / mean per item.  The
+// default of 100 reps keeps p99 below the single slowest run; with fewer
+// than 100 the two coincide.  Results can be written as JSON and diffed
+// with bench/compare.py.
+//
+//   bench::Runner run(argc, argv);
+//   for (std::size_t n : run.sizes({1'000, 100'000}))
+//       run.add("Point::distanceTo", n, [&] { ... n items of work ... });
+//   return run.finish();
+//
+// Command line: --json=FILE  --filter=SUBSTR  --reps=N  --warmup=N  --sizes=A,B,...
+
+struct Result {
+    std::string name;
+    std::size_t size;     ///< Parameter value (0 if unparameterized)
+    std::size_t items;    ///< Work items per repetition
+    int         reps;
+    double      min, median, p99, max, mean;   ///< Seconds per repetition
+};
+
+/// Nearest-rank percentile of an unsorted sample, \p q in [0, 1].
+inline double percentile(std::vector<double> samples, double q) {
+    std::sort(samples.begin(), samples.end());
+    const std::size_t rank = static_cast<std::size_t>(q * static_cast<double>(samples.size()) + 0.999999);
+    return samples[std::min(samples.size() - 1, rank == 0 ? 0 : rank - 1)];
+}
+
+class Runner {
+public:
+    Runner(int argc, char** argv) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            auto value = [&](const char* key) -> const char* {
+                const std::size_t len = std::strlen(key);
+                return arg.compare(0, len, key) == 0 ? arg.c_str() + len : nullptr;
+            };
+            if (const char* v = value("--json="))        m_json = v;
+            else if (const char* v = value("--filter=")) m_filter = v;
+            else if (const char* v = value("--reps="))   m_reps = std::max(1, std::atoi(v));
+            else if (const char* v = value("--warmup=")) m_warmup = std::max(0, std::atoi(v));
+            else if (const char* v = value("--sizes="))  m_sizes = parseSizes(v);
+            else std::fprintf(stderr, "bench: ignoring unknown argument %s\n", arg.c_str());
+        }
+    }
+
+    /// Parameter sweep: \p defaults unless --sizes was given.
+    std::vector<std::size_t> sizes(std::vector<std::size_t> defaults) const {
+        return m_sizes.empty() ? defaults : m_sizes;
+    }
+
+    /// Time \p fn, which performs \p items units of work per call.
+    void add(const std::string& name, std::size_t items, const std::function<void()>& fn) {
+        add(name, 0, items, fn);
+    }
+
+    void add(const std::string& name, std::size_t size, std::size_t items,
+             const std::function<void()>& fn) {
+        const std::string label = size ? name + "/" + std::to_string(size) : name;
+        if (!m_filter.empty() && label.find(m_filter) == std::string::npos) return;
+
+        for (int i = 0; i < m_warmup; ++i) fn();
+        std::vector<double> samples(static_cast<std::size_t>(m_reps));
+        for (double& s : samples) {
+            const auto t0 = std::chrono::steady_clock::now();
+            fn();
+            clobberMemory();
+            s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        }
+
+        Result r{name, size, items, m_reps, 0, 0, 0, 0, 0};
+        r.min    = *std::min_element(samples.begin(), samples.end());
+        r.median = percentile(samples, 0.5);
+        r.p99    = percentile(samples, 0.99);
+        r.max    = *std::max_element(samples.begin(), samples.end());
+        double sum = 0.0;
+        for (double s : samples) sum += s;
+        r.mean = sum / static_cast<double>(samples.size());
+
+        const double perItem = 1e9 / static_cast<double>(items ? items : 1);
+        std::printf("%-44s %10.2f ns/item  (p99 %10.2f, max %10.2f, min %10.2f)\n",
+                    label.c_str(), r.median * perItem, r.p99 * perItem, r.max * perItem, r.min * perItem);
+        m_results.push_back(r);
+    }
+
+    const std::vector<Result>& results() const noexcept { return m_results; }
+
+    /// Write JSON if requested; returns the process exit code.
+    int finish() const {
+        if (m_json.empty()) return EXIT_SUCCESS;
+        std::ofstream out(m_json);
+        if (!out) {
+            std::fprintf(stderr, "bench: cannot write %s\n", m_json.c_str());
+            return EXIT_FAILURE;
+        }
+        out << "{\n  \"results\": [\n";
+        std::string name;
+        char numbers[256];
+        for (std::size_t i = 0; i < m_results.size(); ++i) {
+            const Result& r = m_results[i];
+            name.clear();
+            io::appendJsonString(name, r.name);
+            std::snprintf(numbers, sizeof numbers,
+                          ", \"size\": %zu, \"items\": %zu, \"reps\": %d, \"min\": %.9e, \"median\": %.9e, "
+                          "\"p99\": %.9e, \"max\": %.9e, \"mean\": %.9e}%s\n",
+                          r.size, r.items, r.reps, r.min, r.median, r.p99, r.max, r.mean,
+                          i + 1 < m_results.size() ? "," : "");
+            out << "    {\"name\": " << name << numbers;
+        }
+        out << "  ]\n}\n";
+        return out ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+private:
+    static std::vector<std::size_t> parseSizes(const char* list) {
+        std::vector<std::size_t> sizes;
+        for (char* end = nullptr; *list; list = *end ? end + 1 : end) {
+            sizes.push_back(std::strtoull(list, &end, 10));
+            if (end == list) break;
+        }
+        return sizes;
+    }
+
+    std::string              m_json;
+    std::string              m_filter;
+    int                      m_reps{100};
+    int                      m_warmup{2};
+    std::vector<std::size_t> m_sizes;
+    std::vector<Result>      m_results;
+};
+
+} // namespace bench
@@ -0,0 +1,142 @@
+#include "bench_util.h"
+
+#include "geometry/aabb.h"
+#include "geometry/bvh.h"
+#include "geometry/shape.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+// BVH build, refit and queries over 1M shape bounds versus brute-force
+// scans.  Every query result is cross-checked against the scan, and
+// nearest() with an exact distance is checked to refine nearestBounds().
+
+namespace {
+
+using geometry::Aabb;
+using geometry::Point;
+
+Aabb randomBox(double world, double maxSize) {
+    const Point lo(bench::uniform(0, world), bench::uniform(0, world), bench::uniform(0, world / 100));
+    return Aabb(lo, Point(lo.x() + bench::uniform(0.01, maxSize),
+                          lo.y() + bench::uniform(0.01, maxSize),
+                          lo.z() + bench::uniform(0.0, maxSize / 10)));
+}
+
+bool sameSet(std::vector<std::size_t> a, std::vector<std::size_t> b) {
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    return a == b;
+}
+
+} // namespace
+
+int main() {
+    const std::size_t n = 1'000'000;
+    const std::size_t queries = 100;
+    const double world = 10'000.0;
+    int failures = 0;
+
+    std::vector<Aabb> bounds;
+    bounds.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) bounds.push_back(randomBox(world, 10.0));
+
+    geometry::BVH bvh;
+    const double build = bench::bestOf(1, [&] { bvh.build(bounds); });
+    bench::report("BVH::build (binned SAH)", n, build);
+
+    std::vector<Aabb> moved = bounds;
+    for (Aabb& b : moved)
+        b = Aabb(b.min() + Point(0.5, 0.5, 0.0), b.max() + Point(0.5, 0.5, 0.0));
+    const double refit = bench::bestOf(1, [&] { bvh.refit(moved); });
+    bench::report("BVH::refit", n, refit);
+    bounds = moved;
+
+    std::vector<Aabb> boxes;
+    std::vector<Point> points;
+    for (std::size_t q = 0; q < queries; ++q) {
+        boxes.push_back(randomBox(world, 50.0));
+        points.emplace_back(bench::uniform(0, world), bench::uniform(0, world), bench::uniform(0, world / 100));
+    }
+
+    std::vector<std::size_t> hits, expected;
+    std::size_t total = 0;
+
+    const double bvhBox = bench::bestOf(3, [&] {
+        total = 0;
+        for (const Aabb& q : boxes) { hits.clear(); bvh.query(q, hits); total += hits.size(); }
+        bench::doNotOptimize(total);
+    });
+    const double bruteBox = bench::bestOf(1, [&] {
+        total = 0;
+        for (const Aabb& q : boxes)
+            for (const Aabb& b : bounds) total += b.overlaps(q);
+        bench::doNotOptimize(total);
+    });
+    bench::report("box query: BVH", queries, bvhBox);
+    bench::report("box query: brute force", queries, bruteBox);
+    for (const Aabb& q : boxes) {
+        hits.clear(); expected.clear();
+        bvh.query(q, hits);
+        for (std::size_t i = 0; i < n; ++i) if (bounds[i].overlaps(q)) expected.push_back(i);
+        if (!sameSet(hits, expected)) ++failures;
+    }
+
+    const double bvhPoint = bench::bestOf(3, [&] {
+        total = 0;
+        for (const Point& p : points) { hits.clear(); bvh.query(p, hits); total += hits.size(); }
+        bench::doNotOptimize(total);
+    });
+    bench::report("point query: BVH", queries, bvhPoint);
+
+    const Point dir = Point(1.0, 0.7, 0.0).normalized();
+    const double bvhRay = bench::bestOf(3, [&] {
+        total = 0;
+        for (const Point& p : points) { hits.clear(); bvh.raycastBounds(p, dir, hits, 500.0); total += hits.size(); }
+        bench::doNotOptimize(total);
+    });
+    bench::report("ray query (t <= 500): BVH", queries, bvhRay);
+
+    std::size_t nearest = 0;
+    const double bvhNearest = bench::bestOf(3, [&] {
+        for (const Point& p : points) { nearest = bvh.nearestBounds(p); bench::doNotOptimize(nearest); }
+    });
+    const double bruteNearest = bench::bestOf(1, [&] {
+        for (const Point& p : points) {
+            double best = 1e300;
+            for (std::size_t i = 0; i < n; ++i) best = std::min(best, bounds[i].distanceSquared(p));
+            bench::doNotOptimize(best);
+        }
+    });
+    bench::report("nearest: BVH", queries, bvhNearest);
+    bench::report("nearest: brute force", queries, bruteNearest);
+    for (const Point& p : points) {
+        double best = 1e300;
+        for (std::size_t i = 0; i < n; ++i) best = std::min(best, bounds[i].distanceSquared(p));
+        if (bounds[bvh.nearestBounds(p)].distanceSquared(p) != best) ++failures;
+    }
+
+    // A point in the corner of a big circle's box: the box is nearest, the
+    // small circle beside it is the nearest shape.
+    std::vector<std::unique_ptr<geometry::Shape>> circles;
+    circles.push_back(std::make_unique<geometry::Circle>(Point(0, 0, 0), 10.0));
+    circles.push_back(std::make_unique<geometry::Circle>(Point(12, 12, 0), 0.5));
+    const geometry::BVH pair(circles);
+    const Point corner(9.5, 9.5, 0.0);
+    const auto toCircle = [&](std::size_t i) {
+        const auto& c = static_cast<const geometry::Circle&>(*circles[i]);
+        return std::max(0.0, c.center().distanceTo(corner) - c.radius());
+    };
+    if (pair.nearestBounds(corner) != 0 || pair.nearest(corner, toCircle) != 1) ++failures;
+
+    std::printf("box query speed-up: %.1fx, nearest speed-up: %.1fx\n",
+                bruteBox / bvhBox, bruteNearest / bvhNearest);
+    if (failures != 0) {
+        std::printf("ERROR: %d BVH queries disagree with brute force\n", failures);
+        return 1;
+    }
+    return 0;
+}
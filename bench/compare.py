@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+"""Compare two bench::Runner JSON result files.
+
+Usage: compare.py BASELINE.json CANDIDATE.json [--threshold PCT] [--metric median|p99|max|min|mean]
+
+Prints the per-item time of every case present in both files and flags
+cases whose metric grew by more than the threshold (default 5%).  Exits 1
+if any regression was flagged, so it can gate CI.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        results = json.load(f)["results"]
+    return {(r["name"], r["size"]): r for r in results}
+
+
+def per_item_ns(result, metric):
+    return result[metric] * 1e9 / max(result["items"], 1)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("candidate")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="regression threshold in percent (default 5)")
+    parser.add_argument("--metric", default="median", choices=["median", "p99", "max", "min", "mean"])
+    args = parser.parse_args()
+
+    base = load(args.baseline)
+    cand = load(args.candidate)
+
+    regressions = 0
+    print(f"{'case':<48} {'base ns':>12} {'new ns':>12} {'change':>9}")
+    for key in sorted(base.keys() & cand.keys()):
+        name, size = key
+        label = f"{name}/{size}" if size else name
+        old = per_item_ns(base[key], args.metric)
+        new = per_item_ns(cand[key], args.metric)
+        change = (new - old) / old * 100.0 if old > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        elif change < -args.threshold:
+            flag = "  improved"
+        print(f"{label:<48} {old:12.2f} {new:12.2f} {change:+8.1f}%{flag}")
+
+    for key in sorted(base.keys() - cand.keys()):
+        print(f"missing in candidate: {key[0]}/{key[1]}")
+    for key in sorted(cand.keys() - base.keys()):
+        print(f"new in candidate:     {key[0]}/{key[1]}")
+
+    if regressions:
+        print(f"\n{regressions} regression(s) above {args.threshold:.1f}% ({args.metric})")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
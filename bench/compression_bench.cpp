@@ -0,0 +1,410 @@
+#include "bench_util.h"
+
+#include "geometry/thread_pool.h"
+#include "io/compressed_file.h"
+#include "io/file_writer.h"
+#include "io/lz.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// Compressed FileWriter output: shape-result CSV rows (as the export stage
+// writes them) through an uncompressed async writer and through the
+// compressed mode on one and on all hardware threads, the compression
+// ratio, raw codec speed, and reading back sequentially with
+// CompressedReader and in parallel through MappedCompressedFile.
+//
+// Fuzzes the codec with round-trips over many data shapes and sizes, and
+// feeds the decoder mutated, truncated and random blocks, which must throw
+// or stay in bounds.  Round-trips whole files for several buffer sizes,
+// thread counts and backends through both readers (including random
+// seeks, a pipe and an unfinished file), and checks that damaged files are
+// rejected.  Exits non-zero on any failure.
+
+namespace {
+
+using io::lzCompress;
+using io::lzCompressBound;
+using io::lzDecompress;
+using bench::check;
+
+std::size_t below(std::size_t n) {
+    return n == 0 ? 0 : static_cast<std::size_t>(bench::rng()() % n);
+}
+
+/// One shape-result row, the kind of text the export stage writes.
+void appendRow(std::string& out, std::size_t i) {
+    static const char* const names[] = {"Circle", "Triangle", "Rectangle"};
+    char line[160];
+    const int n = std::snprintf(line, sizeof line, "%s,%.4f,%.4f,%.4f,%.4f\n", names[i % 3],
+                                bench::uniform(0, 1e4), bench::uniform(0, 1e3), bench::uniform(-1e3, 1e3),
+                                bench::uniform(-1e3, 1e3));
+    out.append(line, static_cast<std::size_t>(n));
+}
+
+/// Test input of \p size bytes in one of several shapes.
+std::string sample(int kind, std::size_t size) {
+    std::string s;
+    s.reserve(size + 160);
+    switch (kind) {
+        case 0:   // incompressible
+            while (s.size() < size) s += static_cast<char>(bench::rng()());
+            break;
+        case 1:   // small alphabet
+            while (s.size() < size) s += "ab"[bench::rng()() % 2];
+            break;
+        case 2:   // runs of every length, including very long ones
+            while (s.size() < size) s.append(1 + below(below(2) ? 20 : 5000), static_cast<char>(bench::rng()()));
+            break;
+        case 3: { // a chunk repeated with edits, some copies beyond the 64 KiB window
+            const std::string chunk = sample(0, 1 + below(3000));
+            while (s.size() < size) {
+                s += below(8) == 0 ? sample(0, below(70000)) : chunk;
+                if (!s.empty()) s[below(s.size())] ^= 1;
+            }
+            break;
+        }
+        case 4:   // CSV rows
+            for (std::size_t i = 0; s.size() < size; ++i) appendRow(s, i);
+            break;
+        default:  // all zeros
+            s.assign(size, '\0');
+    }
+    s.resize(size);
+    return s;
+}
+
+bool roundTrips(const std::string& in) {
+    std::vector<char> packed(lzCompressBound(in.size()));
+    const std::size_t n = lzCompress(in.data(), in.size(), packed.data());
+    std::string out(in.size() + 1, '\0');
+    bool ok = n <= packed.size() && lzDecompress(packed.data(), n, &out[0], in.size()) == in.size()
+           && out.compare(0, in.size(), in) == 0;
+    if (!in.empty()) {
+        // One byte too little room must be detected.
+        try {
+            lzDecompress(packed.data(), n, &out[0], in.size() - 1);
+            ok = false;
+        } catch (const std::runtime_error&) {
+        }
+    }
+    return ok;
+}
+
+void fuzzCodec() {
+    bool ok = true;
+    for (int iter = 0; iter < 3000 && ok; ++iter) {
+        const std::size_t size = below(8) == 0 ? below(300'000) : below(below(2) ? 64 : 5000);
+        ok = roundTrips(sample(iter % 6, size));
+    }
+    check(ok, "codec round-trips every data shape and size");
+
+    // The decoder must throw or stay inside its output on damaged input.
+    const std::size_t guard = 64;
+    bool bounded = true;
+    std::size_t rejected = 0, attempts = 0;
+    for (int iter = 0; iter < 600 && bounded; ++iter) {
+        const std::string in = sample(iter % 6, 1 + below(20000));
+        std::vector<char> packed(lzCompressBound(in.size()));
+        packed.resize(lzCompress(in.data(), in.size(), packed.data()));
+        for (int m = 0; m < 20 && bounded; ++m) {
+            std::vector<char> bad = packed;
+            switch (m % 4) {
+                case 0: bad[below(bad.size())] = static_cast<char>(bench::rng()()); break;
+                case 1: bad.resize(below(bad.size())); break;
+                case 2: for (int k = 0; k < 8; ++k) bad[below(bad.size())] ^= static_cast<char>(1 << below(8)); break;
+                default: bad.assign(below(200), '\0'); for (char& c : bad) c = static_cast<char>(bench::rng()());
+            }
+            std::vector<char> out(in.size() + guard, '\x5a');
+            ++attempts;
+            try {
+                bounded = lzDecompress(bad.data(), bad.size(), out.data(), in.size()) <= in.size();
+            } catch (const std::runtime_error&) {
+                ++rejected;
+            }
+            bounded = bounded && std::all_of(out.end() - guard, out.end(), [](char c) { return c == '\x5a'; });
+        }
+    }
+    std::printf("  decoder fuzz: %zu of %zu damaged blocks rejected, none out of bounds\n", rejected, attempts);
+    check(bounded, "decoder stays in bounds on damaged input");
+}
+
+// ── files ────────────────────────────────────────────────────────────────────
+
+/// Write \p size bytes as a mix of lines, records, raw blocks and flushes;
+/// returns what was written.
+std::string writeMixed(io::FileWriter& w, std::size_t size) {
+    std::string expected;
+    while (expected.size() < size) {
+        switch (below(5)) {
+            case 0: {
+                std::string line;
+                appendRow(line, below(3));
+                line.pop_back();
+                w.writeLine(line);
+                expected += line + '\n';
+                break;
+            }
+            case 1: {
+                const double a = bench::uniform(0, 10);
+                const std::size_t id = below(1000);
+                w.record().field("id", id).field("a", a, 3);
+                char line[64];
+                expected.append(line, static_cast<std::size_t>(std::snprintf(line, sizeof line, "%zu,%.3f\n", id, a)));
+                break;
+            }
+            case 2: {
+                const std::string block = sample(static_cast<int>(below(6)), below(40000));
+                w.writeBytes(block.data(), block.size());
+                expected += block;
+                break;
+            }
+            case 3:
+                if (below(10) == 0) w.flush();
+                break;
+            default: {
+                std::string rows;
+                for (std::size_t i = 0; i < 200; ++i) appendRow(rows, i);
+                w.writeBytes(rows.data(), rows.size());
+                expected += rows;
+            }
+        }
+    }
+    return expected;
+}
+
+bool readsBack(const std::string& path, const std::string& expected, geometry::ThreadPool& pool) {
+    // Sequential, in odd-sized pieces.
+    io::CompressedReader reader(path);
+    std::string got;
+    std::vector<char> piece(1 + below(100'000));
+    for (std::size_t n; (n = reader.read(piece.data(), 1 + below(piece.size()))) > 0;) got.append(piece.data(), n);
+    bool ok = got == expected && reader.position() == expected.size();
+
+    // Line by line.
+    io::CompressedReader lines(path);
+    std::string line, joined;
+    while (lines.readLine(line)) joined += line + '\n';
+    ok = ok && joined.compare(0, expected.size(), expected) == 0;
+
+    // Every block in parallel, then random seeks.
+    const io::MappedCompressedFile file(path);
+    std::string all(file.size(), '\0');
+    pool.parallelFor(0, file.blockCount(), [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) file.readBlock(i, &all[file.block(i).rawOffset]);
+    }, 1);
+    ok = ok && file.indexed() && file.size() == expected.size() && all == expected;
+    for (int q = 0; q < 50 && ok; ++q) {
+        const std::size_t offset = below(expected.size() + 10), size = below(300'000);
+        std::string part(size, '\0');
+        const std::size_t n = file.read(offset, &part[0], size);
+        ok = offset >= expected.size() ? n == 0 : part.compare(0, n, expected, offset, size) == 0
+                                                    && n == std::min(size, expected.size() - offset);
+    }
+    return ok;
+}
+
+template <typename Fn>
+bool throws(Fn&& fn) {
+    try {
+        fn();
+    } catch (const std::exception&) {
+        return true;
+    }
+    return false;
+}
+
+void files(const std::string& path, geometry::ThreadPool& pool) {
+    bool ok = true;
+    for (std::size_t bufferSize : {std::size_t{4096}, std::size_t{64} << 10, std::size_t{1} << 20})
+        for (std::size_t threads : {std::size_t{1}, std::size_t{3}})
+            for (io::WriteBackend backend : {io::WriteBackend::Auto, io::WriteBackend::Writev}) {
+                io::WriterOptions options;
+                options.compression = io::Compression::Lz;
+                options.bufferSize = bufferSize;
+                options.compressionThreads = threads;
+                options.backend = backend;
+                std::string expected;
+                std::size_t written = 0;
+                {
+                    io::FileWriter w(path, options);
+                    expected = writeMixed(w, below(6 * bufferSize) + (bufferSize == 4096 ? 100'000 : 0));
+                    written = w.bytesWritten();
+                }
+                ok = ok && written == expected.size() && readsBack(path, expected, pool);
+            }
+    check(ok, "files round-trip for every buffer size, thread count and backend");
+
+    io::WriterOptions options;
+    options.compression = io::Compression::Lz;
+    options.bufferSize = 64 << 10;
+
+    // Nothing written: a valid, empty file.
+    { io::FileWriter w(path, options); }
+    check(readsBack(path, "", pool), "empty compressed file");
+
+    // Unfinished file: whole blocks, no index yet.
+    {
+        io::FileWriter w(path, options);
+        const std::string expected = writeMixed(w, 500'000);
+        w.flush();
+        const io::MappedCompressedFile partial(path);
+        std::string all(partial.size(), '\0');
+        check(!partial.indexed() && partial.read(0, &all[0], all.size()) == expected.size() && all == expected,
+              "unfinished file reads by walking its blocks");
+        io::CompressedReader reader(path);
+        std::string got(expected.size() + 1, '\0');
+        check(reader.read(&got[0], got.size()) == expected.size() && got.compare(0, expected.size(), expected) == 0,
+              "streaming reader stops at the last whole block");
+    }
+
+    // Through a pipe.
+    std::string expected;
+    {
+        io::FileWriter w(path, options);
+        expected = writeMixed(w, 700'000);
+    }
+    int fds[2];
+    check(::pipe(fds) == 0, "pipe");
+    std::thread feeder([&] {
+        const int in = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        char buf[8192];
+        for (ssize_t n; (n = ::read(in, buf, sizeof buf)) > 0;)
+            for (ssize_t done = 0; done < n;) done += ::write(fds[1], buf + done, static_cast<std::size_t>(n - done));
+        ::close(in);
+        ::close(fds[1]);
+    });
+    std::string piped;
+    {
+        io::CompressedReader reader(fds[0]);
+        std::vector<char> buf(10'000);
+        for (std::size_t n; (n = reader.read(buf.data(), buf.size())) > 0;) piped.append(buf.data(), n);
+    }
+    feeder.join();
+    ::close(fds[0]);
+    check(piped == expected, "streaming reader on a pipe");
+
+    // Damaged files are rejected.
+    const std::string good = [&] {
+        std::string bytes(1 << 22, '\0');
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        bytes.resize(static_cast<std::size_t>(::read(fd, &bytes[0], bytes.size())));
+        ::close(fd);
+        return bytes;
+    }();
+    auto damaged = [&](const std::string& bytes) {
+        const std::string bad = path + ".bad";
+        const int fd = ::open(bad.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        check(::write(fd, bytes.data(), bytes.size()) == static_cast<ssize_t>(bytes.size()), "write damaged file");
+        ::close(fd);
+        const bool rejected = throws([&] { io::MappedCompressedFile f(bad); })
+                           && throws([&] {
+                                  io::CompressedReader r(bad);
+                                  std::vector<char> buf(1 << 16);
+                                  while (r.read(buf.data(), buf.size()) > 0) {}
+                              });
+        ::unlink(bad.c_str());
+        return rejected;
+    };
+    std::string badMagic = good;
+    badMagic[0] = 'X';
+    std::string badBlock = good;
+    badBlock[sizeof(io::CompressedFileHeader) + 3] = '\x7f';   // absurd rawSize
+    // Cut inside the first block: a cut between blocks is an unfinished file.
+    check(damaged(good.substr(0, sizeof(io::CompressedFileHeader) + sizeof(io::CompressedBlockHeader) + 100)),
+          "truncated file rejected");
+    check(damaged(badMagic), "bad magic rejected");
+    check(damaged(badBlock), "bad block header rejected");
+    check(damaged(""), "empty file rejected");
+    check(throws([&] { io::FileWriter w(path, options, true); }), "append to a compressed file throws");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t megabytes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 256;
+    const std::string path = "/tmp/compression_bench." + std::to_string(::getpid());
+    geometry::ThreadPool& pool = geometry::ThreadPool::instance();
+
+    fuzzCodec();
+    files(path, pool);
+
+    // ── export throughput ──
+    std::string csv;
+    for (std::size_t i = 0; csv.size() < (std::size_t{4} << 20); ++i) appendRow(csv, i);
+    const std::size_t total = megabytes << 20;
+    const std::size_t chunks = total / csv.size();
+    auto exportCsv = [&](const io::WriterOptions& options) {
+        return bench::bestOf(3, [&] {
+            io::FileWriter w(path, options);
+            for (std::size_t i = 0; i < chunks; ++i) w.writeBytes(csv.data(), csv.size());
+        });
+    };
+    io::WriterOptions plain;
+    plain.async = true;
+    io::WriterOptions one = plain;
+    one.compression = io::Compression::Lz;
+    one.compressionThreads = 1;
+    io::WriterOptions all = one;
+    all.compressionThreads = 0;
+
+    const std::size_t bytes = chunks * csv.size();
+    const double tPlain = exportCsv(plain);
+    const double tOne = exportCsv(one);
+    const double tAll = exportCsv(all);
+    const io::MappedCompressedFile file(path);
+    std::printf("%-40s %12.1f MB/s\n", "async, uncompressed", bytes / tPlain / 1e6);
+    std::printf("%-40s %12.1f MB/s\n", "async, LZ on 1 thread", bytes / tOne / 1e6);
+    char label[64];
+    std::snprintf(label, sizeof label, "async, LZ on %zu threads (default)",
+                  std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()),
+                                        io::DefaultCompressionThreads));
+    std::printf("%-40s %12.1f MB/s\n", label, bytes / tAll / 1e6);
+    std::printf("  %zu MB of CSV -> %.1f MB on disk, ratio %.2f, %zu blocks\n", bytes >> 20,
+                file.fileSize() / 1e6, static_cast<double>(bytes) / file.fileSize(), file.blockCount());
+    check(file.indexed() && file.size() == bytes, "exported file indexed and complete");
+
+    // ── codec ──
+    std::vector<char> packed(lzCompressBound(csv.size()));
+    std::string out(csv.size(), '\0');
+    std::size_t packedSize = 0;
+    const double tCompress = bench::bestOf(5, [&] { packedSize = lzCompress(csv.data(), csv.size(), packed.data()); });
+    const double tDecompress = bench::bestOf(5, [&] { lzDecompress(packed.data(), packedSize, &out[0], out.size()); });
+    std::printf("%-40s %12.1f MB/s\n", "lzCompress, CSV", csv.size() / tCompress / 1e6);
+    std::printf("%-40s %12.1f MB/s\n", "lzDecompress, CSV", csv.size() / tDecompress / 1e6);
+    check(out == csv, "codec round-trip on CSV");
+
+    // ── reading back ──
+    std::vector<char> buf(1 << 20);
+    std::size_t readBytes = 0;
+    const double tStream = bench::bestOf(3, [&] {
+        io::CompressedReader reader(path);
+        readBytes = 0;
+        for (std::size_t n; (n = reader.read(buf.data(), buf.size())) > 0;) readBytes += n;
+    });
+    std::vector<char> whole(file.size());
+    const double tParallel = bench::bestOf(3, [&] {
+        pool.parallelFor(0, file.blockCount(), [&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) file.readBlock(i, whole.data() + file.block(i).rawOffset);
+        }, 1);
+    });
+    std::printf("%-40s %12.1f MB/s\n", "CompressedReader, sequential", bytes / tStream / 1e6);
+    std::snprintf(label, sizeof label, "readBlock on %zu threads", pool.concurrency());
+    std::printf("%-40s %12.1f MB/s\n", label, bytes / tParallel / 1e6);
+    bool same = readBytes == bytes;
+    for (std::size_t i = 0; i < chunks && same; ++i)
+        same = std::memcmp(whole.data() + i * csv.size(), csv.data(), csv.size()) == 0;
+    check(same, "exported file reads back");
+
+    ::unlink(path.c_str());
+    return bench::exitCode();
+}
@@ -0,0 +1,158 @@
+#include "bench_util.h"
+
+#include "io/file_writer.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+// Single-producer write throughput: ofstream mode against the async writer
+// on each backend, for short lines and for large raw blocks.  Every output
+// file is read back and compared with the expected contents, and write
+// errors on /dev/full must be rethrown; exits non-zero on any mismatch.
+
+namespace {
+
+const char* backendName(io::WriteBackend b) {
+    switch (b) {
+        case io::WriteBackend::IoUring: return "io_uring";
+        case io::WriteBackend::Writev:  return "pwritev";
+        default:                        return "ofstream";
+    }
+}
+
+std::string makeLine(std::size_t i) {
+    return "shape " + std::to_string(i) + "  area=78.5398  perimeter=31.4159";
+}
+
+bool verifyLines(const std::string& path, std::size_t lines) {
+    std::ifstream in(path);
+    std::string got;
+    for (std::size_t i = 0; i < lines; ++i) {
+        if (!std::getline(in, got) || got != makeLine(i % 1024)) return false;
+    }
+    return !std::getline(in, got);
+}
+
+bool verifyBlocks(const std::string& path, const std::string& block, std::size_t blocks) {
+    std::ifstream in(path, std::ios::binary);
+    std::string got(block.size(), '\0');
+    for (std::size_t i = 0; i < blocks; ++i) {
+        if (!in.read(&got[0], static_cast<std::streamsize>(got.size())) || got != block) return false;
+    }
+    return in.peek() == std::char_traits<char>::eof();
+}
+
+struct Mode {
+    const char*       name;
+    io::WriterOptions options;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t lines  = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4'000'000;
+    const std::size_t blocks = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 256;
+    const std::string path = "/tmp/file_writer_bench." + std::to_string(::getpid());
+
+    std::vector<std::string> samples;
+    for (std::size_t i = 0; i < 1024; ++i) samples.push_back(makeLine(i));
+    const std::string block(1 << 20, 'x');
+
+    io::WriterOptions uring;
+    uring.async = true;
+    uring.backend = io::WriteBackend::Auto;
+    io::WriterOptions writev = uring;
+    writev.backend = io::WriteBackend::Writev;
+    io::WriterOptions group = uring;
+    group.durability = io::Durability::GroupCommit;
+
+    const Mode modes[] = {
+        {"ofstream",               io::WriterOptions{}},
+        {"async auto",             uring},
+        {"async pwritev",          writev},
+        {"async auto group-commit", group},
+    };
+
+    int failures = 0;
+    for (const Mode& mode : modes) {
+        std::string label;
+        std::size_t bytes = 0;
+        io::WriteBackend used = io::WriteBackend::Auto;
+
+        const double tl = bench::bestOf(1, [&] {
+            io::FileWriter w(path, mode.options);
+            for (std::size_t i = 0; i < lines; ++i) w.writeLine(samples[i % samples.size()]);
+            w.flush();
+            bytes = w.bytesWritten();
+            used = w.backend();
+        });
+        label = std::string(mode.name) + " lines [" + backendName(used) + "]";
+        std::printf("%-48s %10.3f ms  %8.1f MB/s\n", label.c_str(), tl * 1e3, bytes / tl / 1e6);
+        if (!verifyLines(path, lines)) {
+            std::fprintf(stderr, "MISMATCH: %s\n", label.c_str());
+            ++failures;
+        }
+
+        const double tb = bench::bestOf(1, [&] {
+            io::FileWriter w(path, mode.options);
+            for (std::size_t i = 0; i < blocks; ++i) w.writeBytes(block.data(), block.size());
+            w.flush();
+            bytes = w.bytesWritten();
+        });
+        label = std::string(mode.name) + " 1 MiB blocks [" + backendName(used) + "]";
+        std::printf("%-48s %10.3f ms  %8.1f MB/s\n", label.c_str(), tb * 1e3, bytes / tb / 1e6);
+        if (!verifyBlocks(path, block, blocks)) {
+            std::fprintf(stderr, "MISMATCH: %s\n", label.c_str());
+            ++failures;
+        }
+    }
+
+    // Append mode continues after existing contents.
+    {
+        { io::FileWriter w(path); w.writeLine("first"); }
+        { io::FileWriter w(path, uring, true); w.writeLine("second"); }
+        std::ifstream in(path);
+        std::string a, b;
+        if (!std::getline(in, a) || !std::getline(in, b) || a != "first" || b != "second") {
+            std::fprintf(stderr, "MISMATCH: async append\n");
+            ++failures;
+        }
+    }
+
+    // A background write error is rethrown by every later call, including
+    // one that hands over a buffer mid-record, and never corrupts memory.
+    if (::access("/dev/full", W_OK) == 0) {
+        for (const io::WriteBackend backend : {io::WriteBackend::Auto, io::WriteBackend::Writev}) {
+            io::WriterOptions options;
+            options.async      = true;
+            options.bufferSize = 4096;
+            options.backend    = backend;
+            io::FileWriter w("/dev/full", options);
+            int thrown = 0;
+            for (int i = 0; i < 2000; ++i) {
+                try {
+                    w.record().field("line", i).field("text", makeLine(static_cast<std::size_t>(i)));
+                } catch (const std::runtime_error&) {
+                    ++thrown;
+                }
+            }
+            bool flushThrows = false;
+            try {
+                w.flush();
+            } catch (const std::runtime_error&) {
+                flushThrows = true;
+            }
+            if (thrown == 0 || !flushThrows) {
+                std::fprintf(stderr, "MISMATCH: write errors on /dev/full [%s]\n", backendName(w.backend()));
+                ++failures;
+            }
+        }
+    }
+
+    std::remove(path.c_str());
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,256 @@
+#include "bench_util.h"
+
+#include "geometry/kd_tree.h"
+#include "geometry/point_buffer.h"
+#include "geometry/thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+// KdTree over a 10M-point cloud: serial and parallel build time, then
+// nearest, 8-nearest and radius query throughput for 1M random queries,
+// one at a time in input order and batched (Z-ordered, across the pool),
+// against a brute-force Point::distanceTo scan.
+//
+// Checks every query kind against a brute-force scan on uniform,
+// clustered and duplicate-heavy clouds (including exact distance ties,
+// k larger than the cloud, tiny and empty trees and several leaf sizes),
+// that the parallel build and batched queries match the serial ones for
+// every pool size, and that bad input throws.  Exits non-zero on any
+// failure.
+
+namespace {
+
+using namespace geometry;
+using bench::check;
+
+/// Same expression as the tree's leaf scan, so distances compare exactly.
+double distanceSquared(const PointBuffer& pts, std::size_t i, const Point& p) {
+    const double dx = pts.x()[i] - p.x(), dy = pts.y()[i] - p.y(), dz = pts.z()[i] - p.z();
+    return dx * dx + dy * dy + dz * dz;
+}
+
+std::vector<KdNeighbor> bruteNearest(const PointBuffer& pts, const Point& p, std::size_t k) {
+    std::vector<KdNeighbor> all(pts.size());
+    for (std::size_t i = 0; i < pts.size(); ++i) all[i] = {i, distanceSquared(pts, i, p)};
+    auto closer = [](const KdNeighbor& a, const KdNeighbor& b) {
+        return a.distanceSquared < b.distanceSquared
+            || (a.distanceSquared == b.distanceSquared && a.index < b.index);
+    };
+    const std::size_t m = std::min(k, all.size());
+    std::partial_sort(all.begin(), all.begin() + static_cast<std::ptrdiff_t>(m), all.end(), closer);
+    all.resize(m);
+    return all;
+}
+
+std::vector<std::size_t> bruteRadius(const PointBuffer& pts, const Point& p, double r) {
+    std::vector<std::size_t> out;
+    for (std::size_t i = 0; i < pts.size(); ++i)
+        if (distanceSquared(pts, i, p) <= r * r) out.push_back(i);
+    return out;
+}
+
+bool sameNeighbors(const std::vector<KdNeighbor>& a, const std::vector<KdNeighbor>& b) {
+    if (a.size() != b.size()) return false;
+    for (std::size_t i = 0; i < a.size(); ++i)
+        if (a[i].index != b[i].index || a[i].distanceSquared != b[i].distanceSquared) return false;
+    return true;
+}
+
+/// Cross-check every query kind on \p pts against brute force.
+bool matchesBruteForce(const PointBuffer& pts, std::size_t leafSize, std::size_t queries, double radius) {
+    const KdTree tree(pts, leafSize);
+    bool ok = tree.size() == pts.size();
+    std::vector<KdNeighbor> found;
+    std::vector<std::size_t> hits;
+    for (std::size_t q = 0; q < queries && ok; ++q) {
+        // Half the queries sit exactly on cloud points.
+        const Point p = q % 2 == 0 && !pts.empty()
+            ? pts[q % pts.size()]
+            : Point(bench::uniform(-1.2, 1.2), bench::uniform(-1.2, 1.2), bench::uniform(-1.2, 1.2));
+        const auto one = bruteNearest(pts, p, 1);
+        ok = tree.nearest(p) == (one.empty() ? pts.size() : one[0].index);
+        for (std::size_t k : {std::size_t{1}, std::size_t{5}, std::size_t{32}, pts.size() + 3}) {
+            tree.nearest(p, k, found);
+            ok = ok && sameNeighbors(found, bruteNearest(pts, p, k));
+        }
+        hits.clear();
+        tree.withinRadius(p, radius, hits);
+        std::sort(hits.begin(), hits.end());
+        ok = ok && hits == bruteRadius(pts, p, radius);
+    }
+    return ok;
+}
+
+PointBuffer uniformCloud(std::size_t n) {
+    PointBuffer pts;
+    pts.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+        pts.push_back(Point(bench::uniform(-1, 1), bench::uniform(-1, 1), bench::uniform(-1, 1)));
+    return pts;
+}
+
+void correctness() {
+    check(matchesBruteForce(uniformCloud(20'000), KdTree::DefaultLeafSize, 500, 0.1), "uniform cloud");
+
+    // Clusters of very different density.
+    PointBuffer clustered;
+    for (int c = 0; c < 20; ++c) {
+        const Point centre(bench::uniform(-1, 1), bench::uniform(-1, 1), bench::uniform(-1, 1));
+        const double spread = std::pow(10.0, -c % 5);
+        for (int i = 0; i < 500; ++i)
+            clustered.push_back(centre + Point(bench::uniform(-spread, spread), bench::uniform(-spread, spread),
+                                               bench::uniform(-spread, spread)));
+    }
+    check(matchesBruteForce(clustered, 4, 500, 0.05), "clustered cloud");
+
+    // Integer grid with every point repeated: many exact distance ties.
+    PointBuffer grid;
+    for (int rep = 0; rep < 3; ++rep)
+        for (int x = -5; x <= 5; ++x)
+            for (int y = -5; y <= 5; ++y) grid.push_back(Point(x * 0.2, y * 0.2, 0));
+    check(matchesBruteForce(grid, 1, 300, 0.2), "duplicate points and distance ties");
+
+    // Planar cloud: one axis has zero extent everywhere.
+    PointBuffer flat = uniformCloud(3000);
+    for (std::size_t i = 0; i < flat.size(); ++i) flat.z()[i] = 0.5;
+    check(matchesBruteForce(flat, 8, 200, 0.1), "planar cloud");
+
+    bool small = true;
+    for (std::size_t n = 0; n <= 40; ++n)
+        for (std::size_t leaf : {std::size_t{1}, std::size_t{2}, std::size_t{3}, std::size_t{8}, std::size_t{64}})
+            small = small && matchesBruteForce(uniformCloud(n), leaf, 20, 0.8);
+    check(small, "tiny trees, every leaf size");
+
+    const KdTree empty;
+    std::vector<KdNeighbor> found{{1, 1.0}};
+    empty.nearest(Point(0, 0, 0), 3, found);
+    check(empty.nearest(Point(0, 0, 0)) == 0 && found.empty(), "empty tree finds nothing");
+
+    std::vector<std::size_t> hits;
+    KdTree(uniformCloud(100)).withinRadius(Point(0, 0, 0), -1.0, hits);
+    check(hits.empty(), "negative radius finds nothing");
+
+    auto throws = [](auto&& fn) {
+        try {
+            fn();
+        } catch (const std::exception&) {
+            return true;
+        }
+        return false;
+    };
+    PointBuffer bad = uniformCloud(100);
+    bad.x()[37] = std::numeric_limits<double>::quiet_NaN();
+    ThreadPool pool(4);
+    check(throws([&] { KdTree t(bad); }) && throws([&] { KdTree t(bad, pool); }), "non-finite point throws");
+    check(throws([&] { KdTree t(uniformCloud(10), 0); }), "zero leaf size throws");
+}
+
+} // namespace
+
+int main() {
+    correctness();
+
+    const std::size_t n = 10'000'000;
+    const std::size_t queryCount = 1'000'000;
+    const double radius = 0.01;
+    const PointBuffer cloud = uniformCloud(n);
+    PointBuffer queries;
+    queries.reserve(queryCount);
+    for (std::size_t i = 0; i < queryCount; ++i)
+        queries.push_back(Point(bench::uniform(-1, 1), bench::uniform(-1, 1), bench::uniform(-1, 1)));
+    ThreadPool& pool = ThreadPool::instance();
+
+    // ── build ──
+    KdTree tree;
+    const double tBuild = bench::bestOf(1, [&] { tree.build(cloud); });
+    KdTree parallelTree;
+    const double tParallel = bench::bestOf(1, [&] { parallelTree.build(cloud, pool); });
+    bench::report("build, serial", n, tBuild);
+    char label[64];
+    std::snprintf(label, sizeof label, "build, %zu threads", pool.concurrency());
+    bench::report(label, n, tParallel);
+    std::printf("  depth %d, %.1f points per leaf\n", tree.depth(),
+                static_cast<double>(n) / static_cast<double>(std::size_t{1} << tree.depth()));
+
+    // ── queries ──
+    std::vector<std::size_t> single(queryCount), nearest(queryCount), batched(queryCount);
+    const double tSingle = bench::bestOf(3, [&] {
+        for (std::size_t i = 0; i < queryCount; ++i) single[i] = tree.nearest(queries[i]);
+    });
+    const double tNearest = bench::bestOf(3, [&] { tree.nearest(queries, nearest.data()); });
+    const double tBatched = bench::bestOf(3, [&] { parallelTree.nearest(queries, batched.data(), pool); });
+    bench::report("nearest, one at a time", queryCount, tSingle);
+    bench::report("nearest, batched", queryCount, tNearest);
+    std::snprintf(label, sizeof label, "nearest, batched on %zu threads", pool.concurrency());
+    bench::report(label, queryCount, tBatched);
+    check(nearest == single && batched == single, "parallel build and batched nearest match single queries");
+
+    const std::size_t k = 8;
+    std::vector<KdNeighbor> knn(queryCount * k);
+    const double tKnn = bench::bestOf(3, [&] { tree.nearest(queries, k, knn.data(), pool); });
+    bench::report("8-nearest, batched", queryCount, tKnn);
+
+    std::vector<std::size_t> offsets, hits;
+    const double tRadius = bench::bestOf(3, [&] { tree.withinRadius(queries, radius, offsets, hits, pool); });
+    bench::report("radius 0.01, batched", queryCount, tRadius);
+    std::printf("  %.2f hits per query\n", static_cast<double>(hits.size()) / queryCount);
+
+    // A brute-force scan over 10M points is slow; time a handful of queries.
+    const std::size_t bruteCount = 20;
+    std::vector<std::size_t> brute(bruteCount);
+    const double tBrute = bench::bestOf(1, [&] {
+        for (std::size_t q = 0; q < bruteCount; ++q) {
+            const Point p = queries[q];
+            double best = std::numeric_limits<double>::infinity();
+            for (std::size_t i = 0; i < n; ++i) {
+                const double d = cloud[i].distanceTo(p);
+                if (d < best) {
+                    best = d;
+                    brute[q] = i;
+                }
+            }
+        }
+    });
+    bench::report("nearest, brute-force scan", bruteCount, tBrute);
+    std::printf("  tree speed-up %.0fx\n", (tBrute / bruteCount) / (tSingle / queryCount));
+
+    bool sample = true;
+    std::vector<KdNeighbor> found;
+    std::vector<std::size_t> within;
+    for (std::size_t q = 0; q < bruteCount; ++q) {
+        const Point p = queries[q];
+        sample = sample && cloud[brute[q]].distanceTo(p) == cloud[nearest[q]].distanceTo(p);
+        tree.nearest(p, k, found);
+        sample = sample && std::equal(found.begin(), found.end(), knn.begin() + q * k,
+                                      [](const KdNeighbor& a, const KdNeighbor& b) {
+                                          return a.index == b.index && a.distanceSquared == b.distanceSquared;
+                                      });
+        within.clear();
+        tree.withinRadius(p, radius, within);
+        sample = sample && std::equal(within.begin(), within.end(), hits.begin() + offsets[q],
+                                      hits.begin() + offsets[q + 1]);
+    }
+    check(sample, "10M cloud: batched queries match brute force and single queries");
+
+    // The same tree for every pool size.
+    ThreadPool two(2), five(5);
+    const PointBuffer mid = uniformCloud(200'000);
+    const KdTree a(mid), b(mid, two), c(mid, five);
+    bool same = true;
+    for (std::size_t q = 0; q < 2000; ++q) {
+        std::vector<KdNeighbor> na, nb, nc;
+        a.nearest(queries[q], 16, na);
+        b.nearest(queries[q], 16, nb);
+        c.nearest(queries[q], 16, nc);
+        same = same && sameNeighbors(na, nb) && sameNeighbors(na, nc);
+    }
+    check(same, "build independent of pool size");
+
+    return bench::exitCode();
+}
@@ -0,0 +1,67 @@
+#include "alloc_counter.h"
+#include "bench_util.h"
+
+#include "io/logger.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+// Counts heap allocations made by Logger on its steady-state path (after
+// one warm-up pass), in both synchronous and asynchronous mode, and times
+// the per-call cost.  Exits non-zero if any allocation is observed.
+
+namespace {
+
+std::size_t countAllocations(io::Logger& log, const std::string& msg, std::size_t n) {
+    const std::size_t before = bench::allocationCount();
+    for (std::size_t i = 0; i < n; ++i) log.info(msg);
+    return bench::allocationCount() - before;
+}
+
+} // namespace
+
+int main() {
+    const std::size_t n = 200'000;
+    const std::string msg = "Circle  area=78.5398  perimeter=31.4159  centroid=(0, 0, 0)";
+
+    std::ofstream devnull("/dev/null");
+    std::streambuf* saved = std::cout.rdbuf(devnull.rdbuf());
+
+    auto& log = io::Logger::instance();
+    log.setLevel(io::LogLevel::INFO);
+    int failures = 0;
+
+    for (auto precision : {io::TimestampPrecision::Seconds, io::TimestampPrecision::Microseconds}) {
+        log.setTimestampPrecision(precision);
+        const char* label = precision == io::TimestampPrecision::Seconds ? "s" : "us";
+
+        countAllocations(log, msg, 16);  // warm up thread-local buffers
+        std::size_t allocs = 0;
+        const double t = bench::bestOf(3, [&] { allocs += countAllocations(log, msg, n); });
+        std::fprintf(stderr, "sync  [%-2s] %7.1f ns/call  allocations: %zu\n", label, t / n * 1e9, allocs);
+        failures += allocs != 0;
+    }
+
+    io::AsyncOptions opts;
+    opts.queueCapacity = 1024;
+    log.startAsync(opts);
+    countAllocations(log, msg, 2 * opts.queueCapacity);  // touch every ring slot once
+    log.flush();
+    std::size_t allocs = 0;
+    const double t = bench::bestOf(3, [&] {
+        allocs += countAllocations(log, msg, n);
+        log.flush();
+    });
+    log.stopAsync();
+    std::fprintf(stderr, "async      %7.1f ns/call  allocations: %zu\n", t / n * 1e9, allocs);
+    failures += allocs != 0;
+
+    std::cout.rdbuf(saved);
+    if (failures != 0) {
+        std::fprintf(stderr, "ERROR: steady-state logging allocated\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include "bench_util.h"
+
+#include "io/logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Producer-side latency of Logger::info under contention, synchronous
+// versus asynchronous mode.  stdout is redirected to /dev/null so the
+// numbers reflect the logger rather than the terminal.
+//
+// Usage: logger_contention_bench [threads] [messages-per-thread]
+
+namespace {
+
+struct Stats { double p50, p99, p999, max; };
+
+Stats percentiles(std::vector<double>& ns) {
+    std::sort(ns.begin(), ns.end());
+    auto at = [&](double q) { return ns[static_cast<std::size_t>(q * (ns.size() - 1))]; };
+    return {at(0.50), at(0.99), at(0.999), ns.back()};
+}
+
+std::vector<double> run(unsigned threads, std::size_t perThread) {
+    auto& log = io::Logger::instance();
+    std::vector<std::vector<double>> samples(threads);
+    std::vector<std::thread> pool;
+    std::atomic<unsigned> ready{0};
+
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            const std::string msg = "worker " + std::to_string(t) + " processed a batch of shapes";
+            auto& out = samples[t];
+            out.reserve(perThread);
+            ready.fetch_add(1);
+            while (ready.load() < threads) std::this_thread::yield();
+            for (std::size_t i = 0; i < perThread; ++i) {
+                const auto t0 = std::chrono::steady_clock::now();
+                log.info(msg);
+                const auto t1 = std::chrono::steady_clock::now();
+                out.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count());
+            }
+        });
+    }
+    for (auto& th : pool) th.join();
+
+    std::vector<double> all;
+    for (auto& s : samples) all.insert(all.end(), s.begin(), s.end());
+    return all;
+}
+
+void print(const char* name, std::vector<double>& ns) {
+    const Stats s = percentiles(ns);
+    std::fprintf(stderr, "%-28s p50 %8.0f ns  p99 %8.0f ns  p99.9 %8.0f ns  max %10.0f ns\n",
+                 name, s.p50, s.p99, s.p999, s.max);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const unsigned    threads   = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 32;
+    const std::size_t perThread = argc > 2 ? static_cast<std::size_t>(std::atol(argv[2])) : 20'000;
+
+    std::ofstream devnull("/dev/null");
+    std::streambuf* saved = std::cout.rdbuf(devnull.rdbuf());
+
+    auto& log = io::Logger::instance();
+    log.setLevel(io::LogLevel::INFO);
+
+    std::fprintf(stderr, "%u threads x %zu messages\n", threads, perThread);
+
+    std::vector<double> sync = run(threads, perThread);
+    print("sync (mutex + stdout)", sync);
+
+    io::AsyncOptions opts;
+    opts.queueCapacity = 1u << 15;
+    opts.overflow      = io::OverflowPolicy::CountDrops;
+    log.startAsync(opts);
+    std::vector<double> async = run(threads, perThread);
+    log.flush();
+    log.stopAsync();
+    print("async (per-thread rings)", async);
+    std::fprintf(stderr, "dropped: %llu\n", static_cast<unsigned long long>(log.droppedCount()));
+
+    std::cout.rdbuf(saved);
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include "bench_util.h"
+
+#include "io/logger.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Cost of log statements whose level is filtered out, compared with the
+// pre-existing pattern of building an ostringstream message up front, and
+// cost of the format-string API when the level is enabled.  Whether DEBUG
+// is compiled out follows the io library's IO_LOG_MIN_LEVEL (INFO in
+// release builds unless configured otherwise).
+
+namespace {
+
+double expensive(double x) {
+    bench::doNotOptimize(x);
+    return std::sqrt(x) * std::log(x + 1.0);
+}
+
+} // namespace
+
+int main() {
+    const std::size_t n = 5'000'000;
+    const int reps = 3;
+
+    std::ofstream devnull("/dev/null");
+    std::streambuf* saved = std::cout.rdbuf(devnull.rdbuf());
+
+    auto& log = io::Logger::instance();
+    log.setLevel(io::LogLevel::WARNING);
+
+    const double eager = bench::bestOf(reps, [&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            std::ostringstream oss;
+            oss << std::fixed << std::setprecision(4) << "area=" << expensive(double(i));
+            log.info(oss.str());
+        }
+    });
+    const double templ = bench::bestOf(reps, [&] {
+        for (std::size_t i = 0; i < n; ++i) log.info("area={:.4f}", expensive(double(i)));
+    });
+    const double macro = bench::bestOf(reps, [&] {
+        for (std::size_t i = 0; i < n; ++i) IO_LOG_INFO(log, "area={:.4f}", expensive(double(i)));
+        bench::clobberMemory();
+    });
+    const double stripped = bench::bestOf(reps, [&] {
+        for (std::size_t i = 0; i < n; ++i) IO_LOG_DEBUG(log, "area={:.4f}", expensive(double(i)));
+        bench::clobberMemory();
+    });
+
+    const std::size_t m = 500'000;
+    log.setLevel(io::LogLevel::INFO);
+    const double enabledEager = bench::bestOf(reps, [&] {
+        for (std::size_t i = 0; i < m; ++i) {
+            std::ostringstream oss;
+            oss << std::fixed << std::setprecision(4) << "area=" << double(i) * 0.5;
+            log.info(oss.str());
+        }
+    });
+    const double enabledFormat = bench::bestOf(reps, [&] {
+        for (std::size_t i = 0; i < m; ++i) log.info("area={:.4f}", double(i) * 0.5);
+    });
+
+    std::cout.rdbuf(saved);
+
+    std::printf("disabled level (INFO below WARNING):\n");
+    std::printf("  %-44s %8.2f ns/call\n", "ostringstream + log.info(string)", eager / n * 1e9);
+    std::printf("  %-44s %8.2f ns/call\n", "log.info(fmt, args) (args evaluated)", templ / n * 1e9);
+    std::printf("  %-44s %8.2f ns/call\n", "IO_LOG_INFO (args not evaluated)", macro / n * 1e9);
+    std::printf("  %-44s %8.2f ns/call\n",
+                io::Logger::isCompiledIn(io::LogLevel::DEBUG) ? "IO_LOG_DEBUG (filtered at runtime)"
+                                                              : "IO_LOG_DEBUG (compiled out)",
+                stripped / n * 1e9);
+    std::printf("enabled level:\n");
+    std::printf("  %-44s %8.2f ns/call\n", "ostringstream + log.info(string)", enabledEager / m * 1e9);
+    std::printf("  %-44s %8.2f ns/call\n", "log.info(fmt, args)", enabledFormat / m * 1e9);
+    return 0;
+}
@@ -0,0 +1,187 @@
+#include "bench_util.h"
+
+#include "geometry/point_buffer.h"
+#include "geometry/transform.h"
+#include "io/file_writer.h"
+#include "io/logger.h"
+#include "io/metrics.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Cost of the io::Metrics hot path (Counter::add, Histogram::record,
+// ScopedTimer) against an empty loop, single-threaded and with every
+// thread recording into the same metrics.
+//
+// Checks that per-thread shards merge to exact totals, including shards of
+// threads that have exited and metrics recorded while a thread exits, that histogram percentiles land within the
+// bucket width, that timers read back in nanoseconds, that the
+// instrumented Transform::applyBatch counts its points, and that the JSON
+// dump is written.  With -DIO_ENABLE_METRICS=OFF it checks instead that
+// the instrumented code registers nothing.  Exits non-zero on any failure.
+
+namespace {
+
+using bench::check;
+
+const io::MetricsSnapshot::CounterValue* findCounter(const io::MetricsSnapshot& s, const std::string& name) {
+    for (const auto& c : s.counters)
+        if (c.name == name) return &c;
+    return nullptr;
+}
+
+const io::MetricsSnapshot::HistogramValue* findHistogram(const io::MetricsSnapshot& s, const std::string& name) {
+    for (const auto& h : s.histograms)
+        if (h.name == name) return &h;
+    return nullptr;
+}
+
+/// Records from its destructor, which runs during thread exit after the
+/// thread's other thread_locals may be gone.
+struct LateRecorder {
+    ~LateRecorder() { IO_METRICS_COUNT("bench.late", 1); }
+};
+
+bool near(double actual, double expected, double relative) {
+    return actual >= expected * (1 - relative) && actual <= expected * (1 + relative);
+}
+
+} // namespace
+
+int main() {
+    const std::size_t n = 10'000'000;
+    const int reps = 3;
+    io::Metrics& metrics = io::Metrics::instance();
+
+    geometry::PointBuffer points(100'000);
+    geometry::Transform::rotationZ(0.5).applyBatch(points);
+
+#if !IO_METRICS_ENABLED
+    std::printf("metrics compiled out (IO_ENABLE_METRICS=OFF)\n");
+    const io::MetricsSnapshot off = metrics.snapshot();
+    check(off.counters.empty() && off.histograms.empty(), "instrumented code registers nothing");
+    return bench::exitCode();
+#else
+    // ── hot-path cost ──
+    const io::Counter counter = metrics.counter("bench.counter");
+    const io::Histogram histogram = metrics.histogram("bench.histogram");
+    const io::Histogram timer = metrics.timer("bench.timer");
+
+    const double tEmpty = bench::bestOf(reps, [&] {
+        for (std::size_t i = 0; i < n; ++i) bench::doNotOptimize(i);
+    });
+    const double tCounter = bench::bestOf(reps, [&] {
+        for (std::size_t i = 0; i < n; ++i) counter.add();
+    });
+    const double tRecord = bench::bestOf(reps, [&] {
+        for (std::size_t i = 0; i < n; ++i) histogram.record(i & 0xfff);
+    });
+    const double tTimer = bench::bestOf(reps, [&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            io::ScopedTimer t(timer);
+            bench::doNotOptimize(i);
+        }
+    });
+    bench::report("empty loop", n, tEmpty);
+    bench::report("Counter::add", n, tCounter);
+    bench::report("Histogram::record", n, tRecord);
+    bench::report("ScopedTimer", n, tTimer);
+
+    const std::size_t threads = std::max(2u, std::thread::hardware_concurrency());
+    const std::size_t perThread = n / threads;
+    const io::Counter shared = metrics.counter("bench.shared");
+    const double tShared = bench::bestOf(1, [&] {
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < threads; ++t)
+            workers.emplace_back([&] { for (std::size_t i = 0; i < perThread; ++i) shared.add(); });
+        for (auto& w : workers) w.join();
+    });
+    char label[64];
+    std::snprintf(label, sizeof label, "Counter::add, %zu threads", threads);
+    bench::report(label, perThread * threads, tShared);
+
+    // Constructed before the thread's first metric, so destroyed after
+    // whatever thread-exit hook that metric set up.
+    std::vector<std::thread> late;
+    for (int t = 0; t < 4; ++t)
+        late.emplace_back([] {
+            thread_local LateRecorder recorder;
+            IO_METRICS_COUNT("bench.late", 1);
+        });
+    for (auto& t : late) t.join();
+
+    // ── merged totals ──
+    io::MetricsSnapshot snap = metrics.snapshot();
+    check(findCounter(snap, "bench.late")->value == 8, "metrics recorded during thread exit are kept");
+    check(findCounter(snap, "bench.counter")->value == n * reps, "single-thread counter total");
+    check(findCounter(snap, "bench.shared")->value == perThread * threads,
+          "shards of exited threads are kept");
+    const auto* h = findHistogram(snap, "bench.histogram");
+    check(h->count == n * reps && h->max == 0xfff, "histogram count and max");
+
+    // Uniform 1..100000: every percentile within half a bucket (6.25%).
+    const io::Histogram uniform = metrics.histogram("bench.uniform");
+    for (std::uint64_t v = 1; v <= 100'000; ++v) uniform.record(v);
+    snap = metrics.snapshot();
+    const auto* u = findHistogram(snap, "bench.uniform");
+    check(near(u->percentile(0.5), 50'000, 0.0625) && near(u->percentile(0.9), 90'000, 0.0625)
+              && near(u->percentile(0.99), 99'000, 0.0625) && u->percentile(1.0) <= 100'000,
+          "percentiles within the bucket width");
+    check(near(u->mean(), 50'000.5, 1e-12), "histogram mean is exact");
+
+    bool buckets = true;
+    for (std::uint64_t v = 0; v < (1u << 20); v = v * 9 / 8 + 1) {
+        const std::size_t i = io::detail::bucketIndex(v);
+        buckets = buckets && io::detail::bucketLowerBound(i) <= v && v < io::detail::bucketLowerBound(i + 1);
+    }
+    check(buckets, "bucket bounds bracket their values");
+
+    // ── timers read back in nanoseconds ──
+    const io::Histogram sleeps = metrics.timer("bench.sleep");
+    for (int i = 0; i < 5; ++i) {
+        io::ScopedTimer t(sleeps);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    snap = metrics.snapshot();
+    const auto* s = findHistogram(snap, "bench.sleep");
+    std::printf("2 ms sleep timed as p50 %.3f ms, ticks per ns %.3f\n", s->percentile(0.5) / 1e6,
+                metrics.ticksPerNanosecond());
+    check(s->isTimer && s->percentile(0.5) > 1.8e6 && s->percentile(0.5) < 20e6, "timer in nanoseconds");
+
+    // ── instrumented library code ──
+    const std::uint64_t before = findCounter(snap, "transform.apply_batch.points")->value;
+    geometry::Transform::rotationX(0.5).applyBatch(points);
+    snap = metrics.snapshot();
+    check(findCounter(snap, "transform.apply_batch.points")->value == before + points.size(),
+          "applyBatch counts its points");
+    check(findHistogram(snap, "transform.apply_batch")->count >= 2, "applyBatch is timed");
+
+    // ── output ──
+    const std::string path = "/tmp/metrics_bench.jsonl";
+    {
+        io::FileWriter out(path);
+        io::MetricsReporter reporter(std::chrono::milliseconds(5), out);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    std::ifstream in(path);
+    std::string line;
+    std::size_t lines = 0;
+    bool wellFormed = true;
+    while (std::getline(in, line)) {
+        ++lines;
+        wellFormed = wellFormed && line.rfind("{\"time\":", 0) == 0 && line.back() == '}'
+                     && line.find("\"bench.counter\":") != std::string::npos
+                     && line.find("\"transform.apply_batch\":{\"unit\":\"ns\"") != std::string::npos;
+    }
+    std::remove(path.c_str());
+    check(lines >= 2 && wellFormed, "periodic JSON snapshots");
+
+    metrics.report(io::Logger::instance(), io::LogLevel::INFO);
+    return bench::exitCode();
+#endif
+}
@@ -0,0 +1,137 @@
+#include "bench_util.h"
+
+#include "geometry/point.h"
+#include "geometry/shape.h"
+#include "geometry/transform.h"
+#include "io/file_writer.h"
+#include "io/logger.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+// Regression suite for the scalar hot paths of both libraries.  Run through
+// the `bench` target, which writes bench_results.json in the build tree;
+// compare two runs with bench/compare.py.
+
+namespace {
+
+using geometry::Point;
+using geometry::Transform;
+
+std::vector<Point> randomPoints(std::size_t n) {
+    std::vector<Point> pts;
+    pts.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+        pts.emplace_back(bench::uniform(-100, 100), bench::uniform(-100, 100), bench::uniform(-100, 100));
+    return pts;
+}
+
+std::vector<Transform> randomTransforms(std::size_t n) {
+    std::vector<Transform> ts;
+    ts.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const Transform r = Transform::rotationX(bench::uniform(-3, 3)) * Transform::rotationZ(bench::uniform(-3, 3));
+        const Transform s = Transform::scale(bench::uniform(0.5, 2), bench::uniform(0.5, 2), bench::uniform(0.5, 2));
+        const Transform t = Transform::translation(bench::uniform(-10, 10), bench::uniform(-10, 10), 0.0);
+        switch (i % 3) {
+            case 0:  ts.push_back(t * r); break;        // rigid
+            case 1:  ts.push_back(t * r * s); break;    // affine
+            default: ts.push_back(t); break;            // translation
+        }
+    }
+    return ts;
+}
+
+void geometryCases(bench::Runner& run) {
+    for (std::size_t n : run.sizes({1'000, 100'000})) {
+        const std::vector<Point> a = randomPoints(n);
+        const std::vector<Point> b = randomPoints(n);
+
+        run.add("Point::distanceTo", n, n, [&] {
+            double sum = 0.0;
+            for (std::size_t i = 0; i < n; ++i) sum += a[i].distanceTo(b[i]);
+            bench::doNotOptimize(sum);
+        });
+
+        std::vector<geometry::Triangle> tris;
+        tris.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) tris.emplace_back(a[i], b[i], a[(i + 1) % n]);
+        run.add("Triangle::area", n, n, [&] {
+            double sum = 0.0;
+            for (const auto& t : tris) sum += t.area();
+            bench::doNotOptimize(sum);
+        });
+
+        const std::vector<Transform> ts = randomTransforms(n);
+        run.add("Transform::operator*", n, n, [&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                const Transform c = ts[i] * ts[n - 1 - i];
+                bench::doNotOptimize(c);
+            }
+        });
+
+        run.add("Transform::inverse", n, n, [&] {
+            for (const auto& t : ts) {
+                const Transform inv = t.inverse();
+                bench::doNotOptimize(inv);
+            }
+        });
+
+        run.add("Transform::apply", n, n, [&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                const Point p = ts[i].apply(a[i]);
+                bench::doNotOptimize(p);
+            }
+        });
+    }
+}
+
+void ioCases(bench::Runner& run, const std::string& path) {
+    const std::string msg = "Circle  area=78.5398  perimeter=31.4159  centroid=(0, 0, 0)";
+
+    std::ofstream devnull("/dev/null");
+    std::streambuf* saved = std::cout.rdbuf(devnull.rdbuf());
+    auto& log = io::Logger::instance();
+    log.setLevel(io::LogLevel::INFO);
+
+    for (std::size_t n : run.sizes({1'000, 100'000})) {
+        run.add("Logger::log", n, n, [&] {
+            for (std::size_t i = 0; i < n; ++i) log.log(io::LogLevel::INFO, msg);
+        });
+
+        run.add("Logger::log (filtered)", n, n, [&] {
+            for (std::size_t i = 0; i < n; ++i) log.log(io::LogLevel::DEBUG, msg);
+        });
+
+        run.add("FileWriter::writeLine", n, n, [&] {
+            io::FileWriter w(path);
+            for (std::size_t i = 0; i < n; ++i) w.writeLine(msg);
+            w.flush();
+        });
+
+        io::WriterOptions async;
+        async.async = true;
+        run.add("FileWriter::writeLine (async)", n, n, [&] {
+            io::FileWriter w(path, async);
+            for (std::size_t i = 0; i < n; ++i) w.writeLine(msg);
+            w.flush();
+        });
+    }
+
+    std::cout.flush();
+    std::cout.rdbuf(saved);
+    std::remove(path.c_str());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Runner run(argc, argv);
+    geometryCases(run);
+    ioCases(run, "/tmp/micro_bench." + std::to_string(::getpid()));
+    return run.finish();
+}
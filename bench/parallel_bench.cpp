@@ -0,0 +1,155 @@
+#include "bench_util.h"
+
+#include "geometry/point_buffer.h"
+#include "geometry/shape_store.h"
+#include "geometry/thread_pool.h"
+#include "geometry/transform.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Strong-scaling sweep of the ThreadPool-backed bulk operations over pool
+// sizes 1, 2, 4, ... up to the hardware thread count (or argv[1]).
+// Verifies that per-element results match the serial code bit-for-bit,
+// that totals are bit-identical across pool sizes, and that exceptions
+// propagate; exits non-zero otherwise.
+
+namespace {
+
+using namespace geometry;
+using bench::check;
+
+bool sameBits(const double* a, const double* b, std::size_t n) {
+    return std::memcmp(a, b, n * sizeof(double)) == 0;
+}
+
+bool sameTransforms(const std::vector<Transform>& a, const std::vector<Transform>& b) {
+    if (a.size() != b.size()) return false;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (std::memcmp(&a[i].matrix(), &b[i].matrix(), sizeof(Transform::Matrix)) != 0) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t maxThreads = argc > 1 ? std::strtoull(argv[1], nullptr, 10)
+                                            : std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t nShapes = 3'000'000;
+    const std::size_t nPoints = 4'000'000;
+    const std::size_t nTransforms = 500'000;
+    const int reps = 3;
+
+    ShapeStore store;
+    for (std::size_t i = 0; i < nShapes; ++i) {
+        const Point p(bench::uniform(-100, 100), bench::uniform(-100, 100), 0.0);
+        switch (i % 3) {
+            case 0: store.add(Circle(p, bench::uniform(0.1, 5))); break;
+            case 1: store.add(Triangle(p, p + Point(bench::uniform(0.1, 5), 0, 0),
+                                       p + Point(0, bench::uniform(0.1, 5), 0))); break;
+            default: store.add(Rectangle(p, bench::uniform(0.1, 5), bench::uniform(0.1, 5))); break;
+        }
+    }
+
+    PointBuffer points(nPoints);
+    for (std::size_t i = 0; i < nPoints; ++i)
+        points.set(i, Point(bench::uniform(-1, 1), bench::uniform(-1, 1), bench::uniform(-1, 1)));
+    const Transform xf = Transform::translation(1, 2, 3) * Transform::rotationZ(0.4)
+                       * Transform::scale(2, 2, 2);
+
+    std::vector<Transform> transforms;
+    transforms.reserve(nTransforms);
+    for (std::size_t i = 0; i < nTransforms; ++i)
+        transforms.push_back(Transform::translation(bench::uniform(-5, 5), 0, 0)
+                             * Transform::rotationX(bench::uniform(-3, 3))
+                             * Transform::scale(bench::uniform(0.5, 2), 1, 1));
+
+    // Serial references.
+    const std::vector<double> serialAreas = store.areas();
+    PointBuffer serialPoints;
+    xf.applyBatch(points, serialPoints);
+    std::vector<Transform> serialInverse;
+    for (const auto& t : transforms) serialInverse.push_back(t.inverse());
+
+    std::vector<std::size_t> sizes;
+    for (std::size_t t = 1; t < maxThreads; t *= 2) sizes.push_back(t);
+    sizes.push_back(maxThreads);
+
+    std::printf("%8s %14s %14s %14s %14s\n", "threads", "totalArea", "areas", "applyBatch", "inverseBatch");
+    double base[4] = {0, 0, 0, 0};
+    double firstTotal = 0.0, firstPerimeter = 0.0;
+
+    for (std::size_t threads : sizes) {
+        ThreadPool pool(threads);
+        double total = 0.0;
+        std::vector<double> areas(store.size());
+        PointBuffer out;
+        std::vector<Transform> inv;
+
+        const double t[4] = {
+            bench::bestOf(reps, [&] { total = store.totalArea(pool); }),
+            bench::bestOf(reps, [&] { store.areas(areas.data(), pool); }),
+            bench::bestOf(reps, [&] { xf.applyBatch(points, out, pool); }),
+            bench::bestOf(reps, [&] { Transform::inverseBatch(transforms, inv, pool); }),
+        };
+        const double perimeter = store.totalPerimeter(pool);
+
+        if (threads == sizes.front()) {
+            for (int k = 0; k < 4; ++k) base[k] = t[k];
+            firstTotal = total;
+            firstPerimeter = perimeter;
+        }
+        std::printf("%8zu", threads);
+        for (int k = 0; k < 4; ++k) std::printf("  %7.2fms %4.1fx", t[k] * 1e3, base[k] / t[k]);
+        std::printf("\n");
+
+        check(total == firstTotal, "totalArea identical across pool sizes");
+        check(perimeter == firstPerimeter, "totalPerimeter identical across pool sizes");
+        check(sameBits(areas.data(), serialAreas.data(), areas.size()), "areas match serial");
+        check(sameBits(out.x(), serialPoints.x(), nPoints) && sameBits(out.y(), serialPoints.y(), nPoints)
+              && sameBits(out.z(), serialPoints.z(), nPoints), "applyBatch matches serial");
+        check(sameTransforms(inv, serialInverse), "inverseBatch matches serial");
+
+        // Reductions over plain ranges, including nesting and exceptions.
+        const double sum = pool.parallelReduce(0, nPoints, 0.0,
+            [&](std::size_t b, std::size_t e) {
+                double s = 0.0;
+                for (std::size_t i = b; i < e; ++i) s += points.x()[i];
+                return s;
+            },
+            [](double a, double b) { return a + b; });
+        static double firstSum = sum;
+        check(sum == firstSum, "parallelReduce identical across pool sizes");
+
+        std::vector<int> hits(1000, 0);
+        pool.parallelFor(0, 10, [&](std::size_t b, std::size_t e) {
+            for (std::size_t i = b; i < e; ++i)
+                pool.parallelFor(0, 100, [&](std::size_t ib, std::size_t ie) {
+                    for (std::size_t j = ib; j < ie; ++j) ++hits[i * 100 + j];
+                }, 7);
+        }, 1);
+        check(std::all_of(hits.begin(), hits.end(), [](int h) { return h == 1; }), "nested parallelFor");
+
+        bool caught = false;
+        try {
+            pool.parallelFor(0, 100'000, [](std::size_t b, std::size_t) {
+                if (b >= 50'000) throw std::runtime_error("boom");
+            }, 1000);
+        } catch (const std::runtime_error&) {
+            caught = true;
+        }
+        check(caught, "exception propagated");
+    }
+
+    const double serialTotal = store.totalArea();
+    check(std::abs(firstTotal - serialTotal) <= 1e-9 * serialTotal, "parallel totalArea close to serial");
+
+    return bench::exitCode();
+}
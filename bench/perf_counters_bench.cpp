@@ -0,0 +1,187 @@
+#include "bench_util.h"
+
+#include "geometry/shape.h"
+#include "geometry/thread_pool.h"
+#include "geometry/transform.h"
+#include "io/file_writer.h"
+#include "io/logger.h"
+#include "io/perf_counters.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Hardware counters around the Transform::operator* and Triangle::area
+// loops, single-threaded and summed over a ThreadPool, with the cost of an
+// empty ScopedPerf region.  Reports IPC and misses per element through
+// io::Logger and writes the JSON dump.
+//
+// Checks PerfSample arithmetic, that grouped and independent counters
+// agree on what is available, that unavailable counters give empty samples
+// and a reason instead of throwing, that measured loops retire at least one
+// instruction per element, that regions from every worker are summed, and
+// that the JSON dump is written.  Exits non-zero on any failure.
+
+namespace {
+
+using geometry::Point;
+using geometry::Transform;
+using geometry::Triangle;
+using bench::check;
+
+const io::PerfSample* findRegion(const std::vector<std::pair<std::string, io::PerfSample>>& regions,
+                                 const std::string& name) {
+    for (const auto& r : regions)
+        if (r.first == name) return &r.second;
+    return nullptr;
+}
+
+void checkSampleArithmetic() {
+    io::PerfSample a;
+    a.counts   = {1000, 2500, 10, 20};
+    a.valid    = 0xF;
+    a.elements = 100;
+    a.runs     = 1;
+    check(std::fabs(a.ipc() - 2.5) < 1e-12, "ipc");
+    check(std::fabs(a.perElement(io::PerfEvent::CacheMisses) - 0.1) < 1e-12, "cache misses per element");
+
+    io::PerfSample b = a;
+    b.valid = 0x3;   // no miss counters
+    io::PerfSample sum;
+    sum += a;
+    sum += b;
+    check(sum.runs == 2 && sum.elements == 200 && sum.count(io::PerfEvent::Cycles) == 2000, "sum");
+    check(sum.has(io::PerfEvent::Instructions) && !sum.has(io::PerfEvent::BranchMisses),
+          "sum keeps only events valid in both");
+    check(std::isnan(sum.perElement(io::PerfEvent::BranchMisses)), "missing event gives NaN");
+
+    io::PerfSample empty;
+    check(std::isnan(empty.ipc()) && std::isnan(empty.perElement(io::PerfEvent::Cycles)),
+          "empty sample gives NaN");
+}
+
+/// Both modes open the same events, and a closed event never shows up in
+/// a sample.
+void checkModes(std::size_t n) {
+    for (const auto mode : {io::PerfCounters::Mode::Grouped, io::PerfCounters::Mode::Independent}) {
+        const io::PerfCounters counters(mode);
+        check(counters.available() || !counters.error().empty(), "unavailable counters give a reason");
+
+        const auto start = counters.mark();
+        double acc = 0.0;
+        for (std::size_t i = 0; i < n; ++i) {
+            acc += static_cast<double>(i);
+            bench::doNotOptimize(acc);
+        }
+        const io::PerfSample s = counters.since(start, n);
+        check(s.runs == 1 && s.elements == n, "since() fills runs and elements");
+        for (std::size_t e = 0; e < io::PerfEventCount; ++e) {
+            const auto event = static_cast<io::PerfEvent>(e);
+            check(!s.has(event) || counters.available(event), "sample has only opened events");
+        }
+        if (s.has(io::PerfEvent::Instructions))
+            check(s.count(io::PerfEvent::Instructions) >= n, "at least one instruction per iteration");
+        if (!counters.available()) check(s.valid == 0 && std::isnan(s.ipc()), "unavailable sample is empty");
+        std::printf("%-12s %s\n", mode == io::PerfCounters::Mode::Grouped ? "grouped:" : "independent:",
+                    counters.available() ? "available" : counters.error().c_str());
+    }
+    const io::PerfCounters grouped(io::PerfCounters::Mode::Grouped);
+    const io::PerfCounters independent(io::PerfCounters::Mode::Independent);
+    check(grouped.available() == independent.available(), "modes agree on availability");
+}
+
+} // namespace
+
+int main() {
+    const std::size_t N = 1 << 18;
+
+    std::vector<Transform> transforms;
+    std::vector<Triangle>  triangles;
+    transforms.reserve(N);
+    triangles.reserve(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        transforms.push_back(Transform::rotationZ(bench::uniform(-3, 3))
+                             * Transform::translation(bench::uniform(-5, 5), bench::uniform(-5, 5), 0.0));
+        triangles.emplace_back(Point(bench::uniform(-10, 10), bench::uniform(-10, 10)),
+                               Point(bench::uniform(-10, 10), bench::uniform(-10, 10)),
+                               Point(bench::uniform(-10, 10), bench::uniform(-10, 10)));
+    }
+
+    checkSampleArithmetic();
+    checkModes(N);
+
+    // ── regions ─────────────────────────────────────────────────────────────
+    io::PerfReport report;
+    const int reps = 5;
+    for (int r = 0; r < reps; ++r) {
+        {
+            io::ScopedPerf perf(report, "transform.compose", N);
+            Transform acc;
+            for (const auto& t : transforms) acc = acc * t;
+            bench::doNotOptimize(acc);
+        }
+        {
+            io::ScopedPerf perf(report, "triangle.area", N);
+            double total = 0.0;
+            for (const auto& t : triangles) total += t.area();
+            bench::doNotOptimize(total);
+        }
+    }
+
+    geometry::ThreadPool pool(4);
+    const std::size_t chunks = 64;
+    pool.parallelFor(0, N, [&](std::size_t first, std::size_t last) {
+        io::ScopedPerf perf(report, "triangle.area.parallel", last - first);
+        double total = 0.0;
+        for (std::size_t i = first; i < last; ++i) total += triangles[i].area();
+        bench::doNotOptimize(total);
+    }, N / chunks);
+
+    const double empty = bench::bestOf(5, [&] {
+        for (int i = 0; i < 10000; ++i) io::ScopedPerf perf(report, "empty");
+    });
+    bench::report("ScopedPerf (empty region)", 10000, empty);
+
+    const auto regions = report.regions();
+    const io::PerfSample* compose  = findRegion(regions, "transform.compose");
+    const io::PerfSample* area     = findRegion(regions, "triangle.area");
+    const io::PerfSample* parallel = findRegion(regions, "triangle.area.parallel");
+    check(compose && compose->runs == reps && compose->elements == reps * N, "compose region summed");
+    check(area && area->runs == reps && area->nanoseconds > 0, "area region summed");
+    check(parallel && parallel->runs == chunks && parallel->elements == N, "regions summed over workers");
+    if (area && area->has(io::PerfEvent::Instructions))
+        check(area->count(io::PerfEvent::Instructions) >= area->elements, "area instructions per element");
+    check(regions.size() == 4, "one entry per region name");
+    { io::ScopedPerf perf(report, "odd \"name\"\n\x01"); }
+
+    report.report(io::Logger::instance(), io::LogLevel::INFO);
+
+    // ── JSON dump ───────────────────────────────────────────────────────────
+    const std::string path = "perf_counters_bench.json";
+    {
+        io::FileWriter out(path);
+        report.writeJson(out);
+    }
+    std::ifstream in(path);
+    std::string line;
+    std::getline(in, line);
+    std::remove(path.c_str());
+    const bool measured = area && area->valid;
+    const std::string reason = io::PerfCounters::unavailableReason();
+    check(line.rfind(measured ? "{\"available\":true" : "{\"available\":false", 0) == 0 && line.back() == '}',
+          "JSON availability");
+    check(reason.empty() == (line.find("\"error\":") == std::string::npos), "JSON error");
+    check(std::count(line.begin(), line.end(), '{') == std::count(line.begin(), line.end(), '}'),
+          "JSON braces balance");
+    check(line.find("\"triangle.area.parallel\":{\"runs\":64,") != std::string::npos, "JSON regions");
+    check(line.find("\"odd \\\"name\\\"\\n\\u0001\":{") != std::string::npos, "JSON escapes region names");
+    check(measured || line.find("\"cycles\":null") != std::string::npos, "JSON null for unmeasured events");
+    std::printf("%s\n", line.c_str());
+
+    return bench::exitCode();
+}
@@ -0,0 +1,240 @@
+#include "bench_util.h"
+
+#include "geometry/point_buffer.h"
+#include "geometry/point_stats.h"
+#include "geometry/thread_pool.h"
+#include "geometry/transform.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Bounds, mean and covariance of a 10M-point cloud: the single-threaded
+// loop over std::vector<Point> that callers write today (running sums of
+// x and x·x) against pointStats() serially and across the pool.
+//
+// Checks that serial and parallel results are bit-identical for several
+// pool sizes, that a cloud far from the origin keeps full precision (where
+// the running-sum formula cancels), that merging split statistics matches
+// the whole, that principal axes recover a known rotated, scaled cloud and
+// that its PCA frame diagonalises the covariance, plus empty, single-point,
+// collinear and NaN cases.  Exits non-zero on any failure.
+
+namespace {
+
+using namespace geometry;
+using bench::check;
+
+bool identical(const PointStats& a, const PointStats& b) {
+    bool same = a.count == b.count;
+    for (int k = 0; k < 3; ++k) {
+        same = same && a.bounds.lo(k) == b.bounds.lo(k) && a.bounds.hi(k) == b.bounds.hi(k);
+    }
+    same = same && a.mean.x() == b.mean.x() && a.mean.y() == b.mean.y() && a.mean.z() == b.mean.z();
+    for (int k = 0; k < 6; ++k) same = same && a.comoments[k] == b.comoments[k];
+    return same;
+}
+
+bool near(double actual, double expected, double tolerance) {
+    return std::abs(actual - expected) <= tolerance * std::max(1.0, std::abs(expected));
+}
+
+/// Two-pass reference in long double.
+void reference(const PointBuffer& pts, long double mean[3], long double cov[3][3]) {
+    const double* c[3] = {pts.x(), pts.y(), pts.z()};
+    for (int a = 0; a < 3; ++a) {
+        long double s = 0;
+        for (std::size_t i = 0; i < pts.size(); ++i) s += c[a][i];
+        mean[a] = s / pts.size();
+    }
+    for (int a = 0; a < 3; ++a)
+        for (int b = 0; b < 3; ++b) {
+            long double s = 0;
+            for (std::size_t i = 0; i < pts.size(); ++i) s += (c[a][i] - mean[a]) * (c[b][i] - mean[b]);
+            cov[a][b] = s / pts.size();
+        }
+}
+
+/// The loop callers write today: running sums over Point objects.
+struct NaiveStats {
+    Aabb   bounds;
+    double mean[3];
+    double cov[3][3];
+};
+
+NaiveStats naiveStats(const std::vector<Point>& points) {
+    NaiveStats r;
+    double s[3] = {0, 0, 0}, ss[3][3] = {};
+    for (const Point& p : points) {
+        r.bounds.expand(p);
+        const double v[3] = {p.x(), p.y(), p.z()};
+        for (int a = 0; a < 3; ++a) {
+            s[a] += v[a];
+            for (int b = a; b < 3; ++b) ss[a][b] += v[a] * v[b];
+        }
+    }
+    const double n = static_cast<double>(points.size());
+    for (int a = 0; a < 3; ++a) r.mean[a] = s[a] / n;
+    for (int a = 0; a < 3; ++a)
+        for (int b = a; b < 3; ++b) r.cov[a][b] = r.cov[b][a] = ss[a][b] / n - r.mean[a] * r.mean[b];
+    return r;
+}
+
+void edgeCases() {
+    const PointBuffer none;
+    const PointStats empty = pointStats(none);
+    check(empty.count == 0 && empty.bounds.isEmpty() && empty.covariance(0, 0) == 0.0, "empty cloud");
+    check(bounds(none).isEmpty(), "empty bounds");
+
+    PointBuffer one;
+    one.push_back(Point(1, 2, 3));
+    const PointStats single = pointStats(one);
+    const PrincipalAxes singleAxes = principalAxes(single);
+    check(single.count == 1 && single.mean.x() == 1 && single.mean.z() == 3 && single.comoments[0] == 0.0,
+          "single point");
+    check(singleAxes.axes[0].x() == 1 && singleAxes.axes[2].z() == 1 && singleAxes.variances[0] == 0.0,
+          "single point has the world axes");
+
+    // Collinear along (1, 2, 2) / 3: one non-zero variance.
+    PointBuffer line;
+    for (int i = 0; i < 1001; ++i) line.push_back(Point(i, 2.0 * i, 2.0 * i) * (1.0 / 3.0));
+    const PrincipalAxes la = principalAxes(pointStats(line));
+    check(std::abs(la.axes[0].dot(Point(1, 2, 2) * (1.0 / 3.0))) > 1 - 1e-12 && la.variances[1] < 1e-9 &&
+              la.variances[2] < 1e-9, "collinear cloud");
+
+    // NaN coordinates are skipped by the bounds.
+    PointBuffer withNaN;
+    for (int i = 0; i < 10; ++i) withNaN.push_back(Point(i, -i, 0));
+    withNaN.set(3, Point(std::numeric_limits<double>::quiet_NaN(), 0, 0));
+    const Aabb nb = bounds(withNaN);
+    check(nb.lo(0) == 0 && nb.hi(0) == 9 && nb.lo(1) == -9 && nb.hi(1) == 0, "bounds skip NaN");
+
+    // Sizes around the lane and block boundaries agree with the reference.
+    bool sizes = true;
+    for (std::size_t n : {2u, 3u, 5u, 2047u, 2048u, 2049u, 6001u}) {
+        PointBuffer pts;
+        for (std::size_t i = 0; i < n; ++i)
+            pts.push_back(Point(bench::uniform(-1, 1), bench::uniform(0, 5), bench::uniform(-3, 0)));
+        long double mean[3], cov[3][3];
+        reference(pts, mean, cov);
+        const PointStats s = pointStats(pts);
+        sizes = sizes && near(s.mean.y(), static_cast<double>(mean[1]), 1e-14)
+                      && near(s.covariance(0, 2), static_cast<double>(cov[0][2]), 1e-12);
+    }
+    check(sizes, "lane and block boundaries");
+}
+
+} // namespace
+
+int main() {
+    edgeCases();
+
+    // ── cloud far from the origin ──
+    // A rotated, anisotropic Gaussian blob millions of units out: the running-sum
+    // formula loses most of its digits to cancellation.
+    const std::size_t n = 10'000'000;
+    const Transform rotation = Transform::rotationZ(0.3) * Transform::rotationX(0.7);
+    const double sigma[3] = {10.0, 3.0, 0.5};
+    const Point centre(1e6, -2e6, 5e5);
+    std::normal_distribution<double> gauss;
+    PointBuffer cloud;
+    cloud.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const Point local(sigma[0] * gauss(bench::rng()), sigma[1] * gauss(bench::rng()),
+                          sigma[2] * gauss(bench::rng()));
+        cloud.push_back(rotation.apply(local) + centre);
+    }
+    const std::vector<Point> objects = cloud.toPoints();
+    ThreadPool& pool = ThreadPool::instance();
+
+    NaiveStats naive;
+    PointStats serial, parallel;
+    Aabb box;
+    const double tNaive = bench::bestOf(3, [&] { naive = naiveStats(objects); });
+    const double tSerial = bench::bestOf(3, [&] { serial = pointStats(cloud); });
+    const double tParallel = bench::bestOf(3, [&] { parallel = pointStats(cloud, pool); });
+    const double tBounds = bench::bestOf(3, [&] { box = bounds(cloud, pool); });
+    bench::report("Point loop, running sums", n, tNaive);
+    bench::report("pointStats, serial", n, tSerial);
+    char label[64];
+    std::snprintf(label, sizeof label, "pointStats, %zu threads", pool.concurrency());
+    bench::report(label, n, tParallel);
+    std::snprintf(label, sizeof label, "bounds, %zu threads", pool.concurrency());
+    bench::report(label, n, tBounds);
+
+    // ── determinism ──
+    bool deterministic = identical(serial, parallel);
+    for (std::size_t threads : {1u, 2u, 3u, 7u}) {
+        ThreadPool p(threads);
+        deterministic = deterministic && identical(pointStats(cloud, p), serial);
+        const Aabb b = bounds(cloud, p);
+        for (int k = 0; k < 3; ++k)
+            deterministic = deterministic && b.lo(k) == serial.bounds.lo(k) && b.hi(k) == serial.bounds.hi(k);
+    }
+    check(deterministic, "identical for every pool size");
+    check(box.lo(0) == serial.bounds.lo(0) && box.hi(2) == serial.bounds.hi(2), "bounds agree with pointStats");
+
+    // ── accuracy ──
+    long double mean[3], cov[3][3];
+    reference(cloud, mean, cov);
+    double worst = 0, worstNaive = 0;
+    for (int a = 0; a < 3; ++a)
+        for (int b = 0; b < 3; ++b) {
+            const double scale = static_cast<double>(std::sqrt(cov[a][a] * cov[b][b]));
+            worst = std::max(worst, std::abs(serial.covariance(a, b) - static_cast<double>(cov[a][b])) / scale);
+            worstNaive = std::max(worstNaive, std::abs(naive.cov[a][b] - static_cast<double>(cov[a][b])) / scale);
+        }
+    std::printf("  worst covariance error (relative to sigma_a sigma_b): pointStats %.1e, running sums %.1e\n",
+                worst, worstNaive);
+    check(worst < 1e-12, "covariance accurate far from the origin");
+    const double meanError = std::max(std::abs(serial.mean.x() - static_cast<double>(mean[0])),
+                                      std::abs(serial.mean.y() - static_cast<double>(mean[1])));
+    std::printf("  mean error %.1e at |mean| %.0e\n", meanError, 2e6);
+    check(meanError < 1e-14 * 2e6, "mean accurate");
+
+    // ── merging ──
+    PointBuffer lo, hi;
+    for (std::size_t i = 0; i < 1'000'003; ++i) (i < 400'000 ? lo : hi).push_back(cloud[i]);
+    PointBuffer all(std::vector<Point>(objects.begin(), objects.begin() + 1'000'003));
+    PointStats merged = pointStats(lo);
+    merged.merge(pointStats(hi));
+    const PointStats whole = pointStats(all);
+    check(merged.count == whole.count && near(merged.mean.x(), whole.mean.x(), 1e-15)
+              && near(merged.covariance(0, 1), whole.covariance(0, 1), 1e-12),
+          "merge matches the whole");
+
+    // ── principal axes ──
+    const PrincipalAxes pa = principalAxes(serial);
+    bool axes = true;
+    for (int k = 0; k < 3; ++k) {
+        const Point expected(rotation.matrix()[0][k], rotation.matrix()[1][k], rotation.matrix()[2][k]);
+        axes = axes && std::abs(pa.axes[k].dot(expected)) > 1 - 1e-4
+                    && near(pa.variances[k], sigma[k] * sigma[k], 0.01);
+    }
+    std::printf("  variances %.3f %.3f %.4f (expected %.0f %.0f %.2f)\n", pa.variances[0], pa.variances[1],
+                pa.variances[2], sigma[0] * sigma[0], sigma[1] * sigma[1], sigma[2] * sigma[2]);
+    check(axes, "principal axes recover the rotation and scales");
+
+    const Transform toFrame = pa.toFrame();
+    const Transform roundTrip = pa.toWorld() * toFrame;
+    bool identity = toFrame.kind() == TransformKind::Rigid && pa.toWorld().kind() == TransformKind::Rigid;
+    for (int r = 0; r < 4; ++r)
+        for (int c = 0; c < 4; ++c)
+            identity = identity && std::abs(roundTrip.matrix()[r][c] - (r == c ? 1.0 : 0.0)) < 1e-9;
+    check(identity, "toWorld and toFrame are inverse rigid transforms");
+
+    PointBuffer framed = cloud;
+    toFrame.applyBatch(framed, pool);
+    const PointStats fs = pointStats(framed, pool);
+    check(std::abs(fs.mean.x()) < 1e-6 && std::abs(fs.mean.y()) < 1e-6 && std::abs(fs.mean.z()) < 1e-6,
+          "PCA frame is centred");
+    check(std::abs(fs.covariance(0, 1)) < 1e-6 * sigma[0] * sigma[1]
+              && std::abs(fs.covariance(0, 2)) < 1e-6 * sigma[0] * sigma[2]
+              && std::abs(fs.covariance(1, 2)) < 1e-6 * sigma[1] * sigma[2],
+          "PCA frame diagonalises the covariance");
+
+    return bench::exitCode();
+}
@@ -0,0 +1,133 @@
+#include "bench_util.h"
+
+#include "geometry/point_buffer.h"
+#include "geometry/shape.h"
+#include "geometry/transform.h"
+#include "geometry/transform_chain.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Float versus double: applyBatch throughput over buffers larger than the
+// last-level cache, where the float columns move half the bytes.  Checks
+// that the float SIMD kernels match TransformF::apply() bit-for-bit for
+// every kind, that float results stay within a fixed number of float ulps
+// of the double results, and that conversions behave.  Exits non-zero on
+// any failure.
+
+namespace {
+
+using namespace geometry;
+using bench::check;
+
+// ── compile-time checks ──────────────────────────────────────────────────────
+
+static_assert(sizeof(PointF) == 3 * sizeof(float), "PointF is three floats");
+static_assert(TransformF::translation(1, 2, 3).apply(PointF(1, 1, 1)) == PointF(2, 3, 4), "constexpr float");
+static_assert((lazy(TransformF::scale(2, 2, 2)) * TransformF::translation(1, 0, 0)).eval().kind()
+              == TransformKind::Affine, "float chain");
+static_assert(PointF(Point(0.1, 0.2, 0.3)) == PointF(0.1f, 0.2f, 0.3f), "explicit narrowing");
+
+/// Largest |float - double| over all coordinates, divided by the row
+/// magnitude sum_j |m_ij * p_j| + |m_i3| (the scale of the rounding error).
+double worstRelativeError(const Transform& t, const PointBuffer& in, const PointBufferF& outF,
+                          const PointBuffer& outD) {
+    const auto& m = t.matrix();
+    double worst = 0.0;
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        const double p[3] = {in.x()[i], in.y()[i], in.z()[i]};
+        const double f[3] = {outF.x()[i], outF.y()[i], outF.z()[i]};
+        const double d[3] = {outD.x()[i], outD.y()[i], outD.z()[i]};
+        for (int r = 0; r < 3; ++r) {
+            const double scale = std::abs(m[r][0] * p[0]) + std::abs(m[r][1] * p[1])
+                               + std::abs(m[r][2] * p[2]) + std::abs(m[r][3]);
+            worst = std::max(worst, std::abs(f[r] - d[r]) / scale);
+        }
+    }
+    return worst;
+}
+
+} // namespace
+
+int main() {
+    const std::size_t n = 8'000'000;
+    const int reps = 5;
+
+    PointBuffer pd(n);
+    for (std::size_t i = 0; i < n; ++i)
+        pd.set(i, Point(bench::uniform(-1e3, 1e3), bench::uniform(-1e3, 1e3), bench::uniform(-1e3, 1e3)));
+    const PointBufferF pf(pd);
+
+    const Transform td = Transform::translation(1.0, 2.0, 3.0) * Transform::rotationX(0.3)
+                       * Transform::scale(2.0, 0.5, 1.5);
+    const TransformF tf(td);
+    check(tf.kind() == td.kind(), "conversion keeps the kind");
+
+    // ── throughput ──
+    PointBuffer outD;
+    PointBufferF outF;
+    const double secD = bench::bestOf(reps, [&] { td.applyBatch(pd, outD); bench::clobberMemory(); });
+    const double secF = bench::bestOf(reps, [&] { tf.applyBatch(pf, outF); bench::clobberMemory(); });
+    bench::report("Transform::applyBatch (double)", n, secD);
+    bench::report("TransformF::applyBatch (float)", n, secF);
+    std::printf("float speed-up: %.2fx  (%.1f vs %.1f GB/s)\n", secD / secF,
+                n * 6 * sizeof(double) / secD / 1e9, n * 6 * sizeof(float) / secF / 1e9);
+
+    // ── float accuracy against double ──
+    // Rounding the inputs and the matrix to float, three products and three
+    // sums: a handful of unit roundoffs of the row magnitude.
+    const double bound = 8.0 * FLT_EPSILON;
+    const double err = worstRelativeError(td, pd, outF, outD);
+    std::printf("worst float error: %.3g of row magnitude (bound %.3g)\n", err, bound);
+    check(err <= bound, "float applyBatch within bound of double");
+
+    // ── bit-exactness of the float kernels for every kind ──
+    const TransformF kinds[] = {
+        TransformF::identity(),
+        TransformF::translation(1.5f, -2.0f, 0.25f),
+        TransformF::scale(2.0f, 0.5f, -3.0f),
+        TransformF::rotationZ(0.7f) * TransformF::translation(1, 2, 3),
+        TransformF(td),
+        TransformF::fromMatrix({{{1, 0.1f, 0, 0}, {0, 1, 0.2f, 0}, {0, 0, 1, 0}, {0.01f, 0.02f, 0.03f, 1}}}),
+    };
+    const std::size_t small = 1003;   // not a multiple of any lane count
+    PointBufferF in(small);
+    for (std::size_t i = 0; i < small; ++i) in.set(i, pf[i]);
+    for (const TransformF& k : kinds) {
+        PointBufferF out;
+        k.applyBatch(in, out);
+        bool exact = true;
+        for (std::size_t i = 0; i < small; ++i) {
+            const PointF e = k.apply(in[i]);
+            const float ev[3] = {e.x(), e.y(), e.z()};
+            const float ov[3] = {out.x()[i], out.y()[i], out.z()[i]};
+            exact = exact && std::memcmp(ev, ov, sizeof ev) == 0;
+        }
+        check(exact, "float applyBatch matches TransformF::apply bit-for-bit");
+    }
+    check(TransformF::rotationY(0.4f).kind() == TransformKind::Rigid, "float rotation classified rigid");
+    check(TransformF::fromMatrix(TransformF::rotationX(1.1f).matrix()).kind() == TransformKind::Rigid,
+          "float fromMatrix(rotation) classified rigid");
+
+    // ── shapes ──
+    double worstArea = 0.0;
+    for (int i = 0; i < 10'000; ++i) {
+        const Point c(bench::uniform(-100, 100), bench::uniform(-100, 100), 0.0);
+        const Circle circle(c, bench::uniform(0.1, 10));
+        const Rectangle rect(c, bench::uniform(0.1, 10), bench::uniform(0.1, 10));
+        const Triangle tri(c, c + Point(bench::uniform(1, 5), 0, 0), c + Point(0, bench::uniform(1, 5), 0));
+        worstArea = std::max({worstArea,
+            std::abs(CircleF(circle).area() - circle.area()) / circle.area(),
+            std::abs(RectangleF(rect).area() - rect.area()) / rect.area(),
+            std::abs(TriangleF(tri).area() - tri.area()) / tri.area()});
+    }
+    std::printf("worst float area error: %.3g relative\n", worstArea);
+    check(worstArea <= 1e-4, "float shape areas close to double");
+
+    return bench::exitCode();
+}
@@ -0,0 +1,219 @@
+#include "bench_util.h"
+
+#include "geometry/point_buffer.h"
+#include "geometry/predicates.h"
+#include "geometry/shape.h"
+#include "geometry/shape_store.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <vector>
+
+// Batched containment / intersection predicates against loops of single
+// tests, as hand-rolled callers write them today:
+//
+//  - 1M points against one circle, rectangle and triangle, one at a time
+//    through the Shape interface (virtual bounds() pre-check, then the
+//    exact test)
+//  - one point or shape against 1M circles, rectangles and triangles, one
+//    shape object at a time
+//
+// Checks boundary, degenerate, NaN and z-offset cases for every predicate,
+// and that every batched mask bit equals the corresponding single test,
+// with unused mask bits cleared.  Exits non-zero on any failure.
+
+namespace {
+
+using namespace geometry;
+using bench::check;
+
+const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+/// Every bit of \p mask equals test(i), and the bits past \p n are clear.
+template <typename Test>
+bool maskMatches(const std::vector<std::uint64_t>& mask, std::size_t n, Test&& test) {
+    for (std::size_t i = 0; i < n; ++i)
+        if (maskBit(mask.data(), i) != test(i)) return false;
+    return n % 64 == 0 || (mask[n / 64] >> (n % 64)) == 0;
+}
+
+std::size_t popcount(const std::vector<std::uint64_t>& mask) {
+    std::size_t c = 0;
+    for (std::uint64_t w : mask) c += static_cast<std::size_t>(__builtin_popcountll(w));
+    return c;
+}
+
+void edgeCases() {
+    const Circle c(Point(0, 0, 0), 1);
+    check(contains(c, Point(1, 0, 0)) && contains(c, Point(0, -1, 0)), "circle boundary inside");
+    check(!contains(c, Point(1 + 1e-12, 0, 0)), "circle just outside");
+    check(contains(c, Point(0, 0, 100)), "circle ignores z");
+    check(!contains(c, Point(NaN, 0, 0)), "NaN point outside circle");
+
+    const Rectangle r(Point(1, 1, 0), 2, 3);
+    check(contains(r, Point(1, 1, 0)) && contains(r, Point(3, 4, 0)) && contains(r, Point(2, 1, 0)),
+          "rectangle corners and edges inside");
+    check(!contains(r, Point(3 + 1e-9, 2, 0)) && !contains(r, Point(2, 1 - 1e-9, 0)), "rectangle just outside");
+    check(!contains(r, Point(2, NaN, 0)), "NaN point outside rectangle");
+
+    const Triangle t(Point(0, 0, 0), Point(4, 0, 0), Point(0, 4, 0));
+    const Triangle cw(Point(0, 0, 0), Point(0, 4, 0), Point(4, 0, 0));
+    for (const Triangle* tri : {&t, &cw}) {
+        check(contains(*tri, Point(0, 0, 0)) && contains(*tri, Point(4, 0, 0)) && contains(*tri, Point(0, 4, 0)),
+              "triangle vertices inside");
+        check(contains(*tri, Point(2, 2, 0)) && contains(*tri, Point(2, 0, 0)), "triangle edges inside");
+        check(contains(*tri, Point(1, 1, 7)), "triangle interior, z ignored");
+        check(!contains(*tri, Point(2.0001, 2, 0)) && !contains(*tri, Point(-1e-12, 1, 0)), "triangle just outside");
+    }
+    const Triangle degenerate(Point(0, 0, 0), Point(1, 1, 0), Point(2, 2, 0));
+    check(!contains(degenerate, Point(1, 1, 0)) && !contains(degenerate, Point(0, 0, 0)),
+          "degenerate triangle contains nothing");
+    check(!contains(t, Point(NaN, NaN, 0)), "NaN point outside triangle");
+    const Triangle slanted(Point(0, 0, 0), Point(4, 0, 5), Point(0, 4, -5));
+    check(contains(slanted, Point(1, 1, 0)), "triangle tested by its XY projection");
+
+    check(intersects(Circle(Point(0, 0, 0), 1), Circle(Point(3, 0, 0), 2)), "tangent circles intersect");
+    check(!intersects(Circle(Point(0, 0, 0), 1), Circle(Point(3.0001, 0, 0), 2)), "separate circles");
+    check(intersects(Circle(Point(0, 0, 0), 5), Circle(Point(1, 0, 0), 1)), "nested circles intersect");
+    check(intersects(Rectangle(Point(0, 0, 0), 1, 1), Rectangle(Point(1, 0, 0), 1, 1)), "rectangles sharing an edge");
+    check(intersects(Rectangle(Point(0, 0, 0), 1, 1), Rectangle(Point(1, 1, 0), 1, 1)), "rectangles sharing a corner");
+    check(!intersects(Rectangle(Point(0, 0, 0), 1, 1), Rectangle(Point(1 + 1e-9, 0, 0), 1, 1)), "separate rectangles");
+    check(intersects(Rectangle(Point(0, 0, 0), 10, 10), Rectangle(Point(2, 2, 0), 1, 1)), "nested rectangles");
+
+    // Batched forms on the same cases, with sizes around the 4-lane and 64-bit boundaries.
+    for (std::size_t n : {std::size_t{0}, std::size_t{1}, std::size_t{3}, std::size_t{63}, std::size_t{64},
+                          std::size_t{65}, std::size_t{131}}) {
+        PointBuffer pts;
+        for (std::size_t i = 0; i < n; ++i) {
+            const double v = static_cast<double>(i % 9) / 2;   // 0, 0.5, ... 4: lands on every boundary
+            pts.push_back(Point(v - (i % 5 == 0 ? 1e-12 : 0.0), static_cast<double>(i % 7) / 2, 0));
+        }
+        if (n > 2) pts.set(2, Point(NaN, 1, 0));
+        std::vector<std::uint64_t> m(maskWords(n) + 1, ~std::uint64_t(0));
+        contains(t, pts, m.data());
+        check(maskMatches(m, n, [&](std::size_t i) { return contains(t, pts[i]); }), "small batch triangle");
+        contains(degenerate, pts, m.data());
+        check(maskMatches(m, n, [](std::size_t) { return false; }), "small batch degenerate triangle");
+        contains(r, pts, m.data());
+        check(maskMatches(m, n, [&](std::size_t i) { return contains(r, pts[i]); }), "small batch rectangle");
+        contains(c, pts, m.data());
+        check(maskMatches(m, n, [&](std::size_t i) { return contains(c, pts[i]); }), "small batch circle");
+        check(m.back() == ~std::uint64_t(0), "nothing written past maskWords(n)");
+    }
+}
+
+} // namespace
+
+int main() {
+    edgeCases();
+
+    const std::size_t n = 1'000'003;   // not a multiple of 64
+    const int reps = 5;
+    std::vector<std::uint64_t> mask(maskWords(n));
+
+    // ── N points against one shape ──
+    PointBuffer points;
+    points.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+        points.push_back(Point(bench::uniform(-10, 10), bench::uniform(-10, 10), bench::uniform(-1, 1)));
+
+    const Circle circle(Point(1, -2, 0), 5);
+    const Rectangle rect(Point(-3, -4, 0), 7, 5);
+    const Triangle tri(Point(-8, -6, 0), Point(9, -1, 0), Point(0, 8, 0));
+    const std::vector<std::unique_ptr<Shape>> shapes = [&] {
+        std::vector<std::unique_ptr<Shape>> v;
+        v.push_back(std::make_unique<Circle>(circle));
+        v.push_back(std::make_unique<Rectangle>(rect));
+        v.push_back(std::make_unique<Triangle>(tri));
+        return v;
+    }();
+
+    std::vector<char> single(n);
+    for (const auto& s : shapes) {
+        const Shape& shape = *s;
+        const double tSingle = bench::bestOf(reps, [&] {
+            const Aabb box = shape.bounds();
+            for (std::size_t i = 0; i < n; ++i) {
+                const Point p = points[i];
+                bool in = box.contains(Point(p.x(), p.y(), box.lo(2)));
+                if (in) {
+                    if (auto* c = dynamic_cast<const Circle*>(&shape)) in = contains(*c, p);
+                    else if (auto* r = dynamic_cast<const Rectangle*>(&shape)) in = contains(*r, p);
+                    else in = contains(static_cast<const Triangle&>(shape), p);
+                }
+                single[i] = in;
+            }
+            bench::clobberMemory();
+        });
+        const double tBatch = bench::bestOf(reps, [&] {
+            if (auto* c = dynamic_cast<const Circle*>(&shape)) contains(*c, points, mask.data());
+            else if (auto* r = dynamic_cast<const Rectangle*>(&shape)) contains(*r, points, mask.data());
+            else contains(static_cast<const Triangle&>(shape), points, mask.data());
+            bench::clobberMemory();
+        });
+        char label[64];
+        std::snprintf(label, sizeof label, "%s vs points, one at a time", shape.name().c_str());
+        bench::report(label, n, tSingle);
+        std::snprintf(label, sizeof label, "%s vs points, batched", shape.name().c_str());
+        bench::report(label, n, tBatch);
+        std::printf("  %zu of %zu inside, speed-up %.1fx\n", popcount(mask), n, tSingle / tBatch);
+        check(maskMatches(mask, n, [&](std::size_t i) { return single[i] != 0; }),
+              "batched points equal single tests");
+    }
+
+    // ── one point / shape against N shapes ──
+    ShapeStore store;
+    store.reserve(n, n, n);
+    std::vector<Circle> circles;
+    std::vector<Rectangle> rects;
+    std::vector<Triangle> tris;
+    circles.reserve(n);
+    rects.reserve(n);
+    tris.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const Point o(bench::uniform(-100, 100), bench::uniform(-100, 100), 0);
+        circles.emplace_back(o, bench::uniform(0.1, 10));
+        rects.emplace_back(o, bench::uniform(0.1, 10), bench::uniform(0.1, 10));
+        tris.emplace_back(o, o + Point(bench::uniform(-10, 10), bench::uniform(-10, 10), 0),
+                          o + Point(bench::uniform(-10, 10), bench::uniform(-10, 10), 0));
+        store.add(circles.back());
+        store.add(rects.back());
+        store.add(tris.back());
+    }
+    const Point query(3, -4, 0);
+    const Circle queryCircle(query, 4);
+    const Rectangle queryRect(query, 6, 3);
+
+    auto compare = [&](const char* name, auto&& singleTest, auto&& batched) {
+        const double tSingle = bench::bestOf(reps, [&] {
+            for (std::size_t i = 0; i < n; ++i) single[i] = singleTest(i);
+            bench::clobberMemory();
+        });
+        const double tBatch = bench::bestOf(reps, [&] {
+            batched();
+            bench::clobberMemory();
+        });
+        char label[64];
+        std::snprintf(label, sizeof label, "%s, one at a time", name);
+        bench::report(label, n, tSingle);
+        std::snprintf(label, sizeof label, "%s, batched", name);
+        bench::report(label, n, tBatch);
+        std::printf("  %zu of %zu hit, speed-up %.1fx\n", popcount(mask), n, tSingle / tBatch);
+        check(maskMatches(mask, n, [&](std::size_t i) { return single[i] != 0; }), name);
+    };
+    compare("circles vs point", [&](std::size_t i) { return contains(circles[i], query); },
+            [&] { contains(store.circles(), query, mask.data()); });
+    compare("rectangles vs point", [&](std::size_t i) { return contains(rects[i], query); },
+            [&] { contains(store.rectangles(), query, mask.data()); });
+    compare("triangles vs point", [&](std::size_t i) { return contains(tris[i], query); },
+            [&] { contains(store.triangles(), query, mask.data()); });
+    compare("circles vs circle", [&](std::size_t i) { return intersects(circles[i], queryCircle); },
+            [&] { intersects(store.circles(), queryCircle, mask.data()); });
+    compare("rectangles vs rectangle", [&](std::size_t i) { return intersects(rects[i], queryRect); },
+            [&] { intersects(store.rectangles(), queryRect, mask.data()); });
+
+    return bench::exitCode();
+}
@@ -0,0 +1,291 @@
+#include "alloc_counter.h"
+#include "bench_util.h"
+
+#include "io/file_writer.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+// Formatting shape result rows (name, area, perimeter, centroid) into an
+// async FileWriter: an ostringstream per row plus writeLine, as app/main.cpp
+// did, against snprintf and against FileWriter::record() in CSV (fixed and
+// shortest) and JSON-lines layouts.
+//
+// Checks that the record rows equal the iostream rows byte for byte, that
+// shortest-form doubles parse back bit-exactly, CSV quoting and JSON
+// escaping, non-finite values, integer limits, fields and strings that
+// cross buffer boundaries, bytesWritten(), and that records do not
+// allocate.  Exits non-zero on any failure.
+
+namespace {
+
+using bench::check;
+
+std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream all;
+    all << in.rdbuf();
+    return all.str();
+}
+
+struct Row {
+    std::string name;
+    double      area, perimeter, cx, cy;
+};
+
+/// Small async buffers so records straddle buffer hand-overs.
+io::WriterOptions smallAsync() {
+    io::WriterOptions options;
+    options.async = true;
+    options.bufferSize = 4096;
+    return options;
+}
+
+/// Write \p fn's records in stream mode and with small async buffers, and
+/// compare both files with \p expected.
+template <typename Fn>
+void expectOutput(const std::string& path, const std::string& expected, const char* what, Fn&& fn) {
+    for (const bool async : {false, true}) {
+        std::size_t written = 0;
+        {
+            io::FileWriter w(path, async ? smallAsync() : io::WriterOptions{});
+            fn(w);
+            w.flush();
+            written = w.bytesWritten();
+        }
+        const std::string got = readFile(path);
+        if (got != expected || written != expected.size()) {
+            std::fprintf(stderr, "%s (%s mode):\n  expected: %s\n  got:      %s\n", what,
+                         async ? "async" : "stream", expected.substr(0, 200).c_str(), got.substr(0, 200).c_str());
+            check(false, what);
+        }
+    }
+}
+
+void formatting(const std::string& path) {
+    using io::RecordFormat;
+    const double inf = std::numeric_limits<double>::infinity();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    expectOutput(path, "Circle,78.5398,0.1,-3,7,true\n", "CSV fields", [](io::FileWriter& w) {
+        w.record().field("name", "Circle").field("area", 78.539816, 4).field("x", 0.1).field("n", -3)
+            .field("u", 7u).field("ok", true);
+    });
+    expectOutput(path, "{\"name\":\"Circle\",\"area\":78.5398,\"x\":0.1,\"n\":-3,\"ok\":false}\n", "JSON fields",
+                 [](io::FileWriter& w) {
+        w.record(RecordFormat::JsonLines).field("name", "Circle").field("area", 78.539816, 4).field("x", 0.1)
+            .field("n", -3).field("ok", false);
+    });
+
+    expectOutput(path, "plain,\"a,b\",\"say \"\"hi\"\"\",\"two\nlines\",\n", "CSV quoting", [](io::FileWriter& w) {
+        w.record().field("", "plain").field("", "a,b").field("", "say \"hi\"").field("", "two\nlines")
+            .field("", "");
+    });
+    expectOutput(path, "{\"k\\\"ey\":\"q\\\" b\\\\ n\\n t\\t r\\r \\u0001\\u001f \xc3\xa9\"}\n", "JSON escaping",
+                 [](io::FileWriter& w) {
+        w.record(RecordFormat::JsonLines).field("k\"ey", std::string_view("q\" b\\ n\n t\t r\r \x01\x1f \xc3\xa9"));
+    });
+
+    expectOutput(path, "inf,-inf,nan,inf\n{\"a\":null,\"b\":null,\"c\":null,\"d\":1.50}\n", "non-finite values",
+                 [&](io::FileWriter& w) {
+        w.record().field("a", inf).field("b", -inf).field("c", nan).field("d", inf, 2);
+        w.record(RecordFormat::JsonLines).field("a", inf).field("b", -inf, 3).field("c", nan).field("d", 1.5, 2);
+    });
+
+    expectOutput(path, "-9223372036854775808,18446744073709551615,-128,65535,0\n", "integer limits",
+                 [](io::FileWriter& w) {
+        w.record().field("", std::numeric_limits<long long>::min())
+            .field("", std::numeric_limits<unsigned long long>::max())
+            .field("", static_cast<std::int8_t>(-128)).field("", static_cast<std::uint16_t>(65535))
+            .field("", std::size_t{0});
+    });
+
+    // Precision is clamped; the largest field must still fit its space.
+    std::ostringstream big;
+    big << std::fixed << std::setprecision(300) << -std::numeric_limits<double>::max();
+    expectOutput(path, "2,0.000\n" + big.str() + "\n", "precision clamped", [](io::FileWriter& w) {
+        w.record().field("", 1.5, -4).field("", 0.0, 3);
+        w.record().field("", -std::numeric_limits<double>::max(), 1000);
+    });
+
+    expectOutput(path, "\n{}\nafter\n", "empty records and explicit end", [](io::FileWriter& w) {
+        w.record();
+        auto r = w.record(RecordFormat::JsonLines);
+        r.end();
+        r.end();
+        w.writeLine("after");
+    });
+
+    // Long strings cross the 4 KiB async buffers and the stream-mode staging.
+    std::string text;
+    for (int i = 0; i < 20000; ++i) text += "ab\"c,\n\x02"[i % 7];
+    std::string csv = "\"", json = "{\"t\":\"";
+    for (const char c : text) {
+        if (c == '"') csv += '"';
+        csv += c;
+        if (c == '"') json += "\\\"";
+        else if (c == '\n') json += "\\n";
+        else if (c == '\x02') json += "\\u0002";
+        else json += c;
+    }
+    csv += "\",1\n";
+    json += "\"}\n";
+    expectOutput(path, csv + json, "long strings", [&](io::FileWriter& w) {
+        w.record().field("", text).field("", 1);
+        w.record(RecordFormat::JsonLines).field("t", text);
+    });
+
+    // Many records mixed with writeLine, every one crossing buffer ends somewhere.
+    std::string expected;
+    for (int i = 0; i < 3000; ++i) {
+        char line[128];
+        std::snprintf(line, sizeof line, "row%d,%.3f,%d\nplain %d\n", i, i * 0.25, -i, i);
+        expected += line;
+    }
+    expectOutput(path, expected, "records between lines", [](io::FileWriter& w) {
+        for (int i = 0; i < 3000; ++i) {
+            char name[16];
+            std::snprintf(name, sizeof name, "row%d", i);
+            w.record().field("", name).field("", i * 0.25, 3).field("", -i);
+            w.writeLine("plain " + std::to_string(i));
+        }
+    });
+
+    // Empty JSON strings at every offset from a buffer end: the closing
+    // quote needs room of its own.
+    std::string empties;
+    for (std::size_t k = 0; k < 8; ++k) {
+        empties += "{\"" + std::string(k, 'x') + "\":\"\"";
+        for (int i = 0; i < 1000; ++i) empties += ",\"\":\"\"";
+        empties += "}\n";
+    }
+    expectOutput(path, empties, "empty JSON strings at buffer ends", [](io::FileWriter& w) {
+        for (std::size_t k = 0; k < 8; ++k) {
+            auto r = w.record(RecordFormat::JsonLines);
+            r.field(std::string(k, 'x'), "");
+            for (int i = 0; i < 1000; ++i) r.field("", "");
+        }
+    });
+}
+
+/// Random finite doubles of every magnitude parse back bit-exactly.
+void roundTrip(const std::string& path) {
+    const std::size_t n = 1'000'000;
+    std::vector<double> values;
+    values.reserve(n);
+    while (values.size() < n) {
+        const std::uint64_t bits = bench::rng()();
+        double v;
+        std::memcpy(&v, &bits, sizeof v);
+        if (std::isfinite(v)) values.push_back(v);
+    }
+    values.insert(values.end(), {0.0, -0.0, 5e-324, std::numeric_limits<double>::max(), 0.1, 1e23});
+    {
+        io::WriterOptions options;
+        options.async = true;
+        io::FileWriter w(path, options);
+        for (double v : values) w.record().field("", v);
+    }
+    std::ifstream in(path);
+    std::string line;
+    std::size_t i = 0;
+    bool exact = true;
+    while (std::getline(in, line) && i < values.size()) {
+        const double back = std::strtod(line.c_str(), nullptr);
+        exact = exact && std::memcmp(&back, &values[i], sizeof back) == 0;
+        ++i;
+    }
+    check(exact && i == values.size(), "shortest doubles round-trip bit-exactly");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+    const std::string path = "/tmp/record_writer_bench." + std::to_string(::getpid());
+    const std::string other = path + ".iostream";
+
+    formatting(path);
+    roundTrip(path);
+
+    const char* names[] = {"Circle", "Triangle", "Rectangle"};
+    std::vector<Row> rows(1024);
+    for (std::size_t i = 0; i < rows.size(); ++i)
+        rows[i] = {names[i % 3], bench::uniform(0, 1e4), bench::uniform(0, 1e3), bench::uniform(-1e3, 1e3),
+                   bench::uniform(-1e3, 1e3)};
+
+    io::WriterOptions options;
+    options.async = true;
+    auto timed = [&](const std::string& file, auto&& writeRow) {
+        return bench::bestOf(3, [&] {
+            io::FileWriter w(file, options);
+            for (std::size_t i = 0; i < n; ++i) writeRow(w, rows[i % rows.size()]);
+            w.flush();
+        });
+    };
+
+    const double tStream = timed(other, [](io::FileWriter& w, const Row& r) {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(4) << r.name << "," << r.area << "," << r.perimeter << ","
+            << r.cx << "," << r.cy;
+        w.writeLine(oss.str());
+    });
+    const double tPrintf = timed(path, [](io::FileWriter& w, const Row& r) {
+        char line[256];
+        const int len = std::snprintf(line, sizeof line, "%s,%.4f,%.4f,%.4f,%.4f", r.name.c_str(), r.area,
+                                      r.perimeter, r.cx, r.cy);
+        w.writeLine(std::string_view(line, static_cast<std::size_t>(len)));
+    });
+    auto fixedRow = [](io::FileWriter& w, const Row& r) {
+        w.record().field("name", r.name).field("area", r.area, 4).field("perimeter", r.perimeter, 4)
+            .field("centroid_x", r.cx, 4).field("centroid_y", r.cy, 4);
+    };
+    const double tFixed = timed(path, fixedRow);
+    check(readFile(path) == readFile(other), "record rows match iostream rows");
+
+    const double tShortest = timed(path, [](io::FileWriter& w, const Row& r) {
+        w.record().field("name", r.name).field("area", r.area).field("perimeter", r.perimeter)
+            .field("centroid_x", r.cx).field("centroid_y", r.cy);
+    });
+    const double tJson = timed(path, [](io::FileWriter& w, const Row& r) {
+        w.record(io::RecordFormat::JsonLines).field("name", r.name).field("area", r.area)
+            .field("perimeter", r.perimeter).field("centroid_x", r.cx).field("centroid_y", r.cy);
+    });
+
+    bench::report("ostringstream + writeLine, %.4f", n, tStream);
+    bench::report("snprintf + writeLine, %.4f", n, tPrintf);
+    bench::report("record() CSV, fixed 4", n, tFixed);
+    bench::report("record() CSV, shortest", n, tShortest);
+    bench::report("record() JSON lines, shortest", n, tJson);
+    std::printf("  record() speed-up over iostream %.1fx\n", tStream / tFixed);
+
+    // Steady state: buffers are allocated by the constructor and records
+    // allocate nothing; the async writer's hand-over queue and background
+    // thread allocate a little per 4 MiB buffer, never per record.
+    for (const bool async : {false, true}) {
+        io::FileWriter w(path, async ? options : io::WriterOptions{});
+        fixedRow(w, rows[0]);
+        const std::size_t before = bench::allocationCount();
+        for (std::size_t i = 0; i < 100'000; ++i) {
+            fixedRow(w, rows[i % rows.size()]);
+            w.record(io::RecordFormat::JsonLines).field("id", i).field("area", rows[i % rows.size()].area);
+        }
+        const std::size_t allocations = bench::allocationCount() - before;
+        std::printf("  %s mode: %zu allocations per 200000 records\n", async ? "async" : "stream", allocations);
+        check(async ? allocations * 1000 < 200'000 : allocations == 0, "records do not allocate");
+    }
+
+    std::remove(path.c_str());
+    std::remove(other.c_str());
+    return bench::exitCode();
+}
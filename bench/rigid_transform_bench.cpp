@@ -0,0 +1,184 @@
+#include "bench_util.h"
+
+#include "geometry/point_buffer.h"
+#include "geometry/rigid_transform.h"
+#include "geometry/transform.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+// Composes a chain of 1M random rigid steps (rotation about a random axis
+// plus a translation) as Transform matrices and as RigidTransforms, and
+// compares throughput, size and how far each result drifts from a proper
+// rotation.  Also times inverse() and apply().
+//
+// Checks that RigidTransform agrees with Transform for factories,
+// composition, inverse, apply and the to / from conversions, that slerp
+// hits its end points and interpolates the angle, and that applyBatch
+// equals the matrix kernels.  Exits non-zero on any failure.
+
+namespace {
+
+using namespace geometry;
+using bench::check;
+
+Point randomPoint(double lo, double hi) {
+    return Point(bench::uniform(lo, hi), bench::uniform(lo, hi), bench::uniform(lo, hi));
+}
+
+RigidTransform randomRigid() {
+    const Point t = randomPoint(-1, 1);
+    return RigidTransform(Quaternion::fromAxisAngle(randomPoint(-1, 1), bench::uniform(-3, 3)), t);
+}
+
+/// max |RᵀR - I| over the 3×3 block.
+double orthonormalityError(const Transform& t) {
+    const auto& m = t.matrix();
+    double err = 0.0;
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j) {
+            double dot = 0.0;
+            for (int k = 0; k < 3; ++k) dot += m[k][i] * m[k][j];
+            err = std::max(err, std::abs(dot - (i == j ? 1.0 : 0.0)));
+        }
+    return err;
+}
+
+/// Both transforms map a few probe points to the same place.
+bool sameMapping(const Transform& a, const Transform& b, double tol = 1e-9) {
+    for (const Point& p : {Point(0, 0, 0), Point(1, 0, 0), Point(0, 1, 0), Point(0, 0, 1), Point(-3, 5, 7)}) {
+        const Point d = a.apply(p) - b.apply(p);
+        if (std::abs(d.x()) > tol || std::abs(d.y()) > tol || std::abs(d.z()) > tol) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    const std::size_t n = 1'000'000;
+    const int reps = 3;
+
+    std::vector<RigidTransform> rigid(n);
+    std::vector<Transform> matrix(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        rigid[i] = randomRigid();
+        matrix[i] = rigid[i].toTransform();
+    }
+    std::printf("sizeof(Transform) %zu bytes, sizeof(RigidTransform) %zu bytes\n",
+                sizeof(Transform), sizeof(RigidTransform));
+
+    // ── composition chain ──
+    Transform chainM;
+    RigidTransform chainR;
+    const double tMatrix = bench::bestOf(reps, [&] {
+        Transform acc;
+        for (const Transform& t : matrix) acc = acc * t;
+        chainM = acc;
+    });
+    const double tRigid = bench::bestOf(reps, [&] {
+        RigidTransform acc;
+        for (const RigidTransform& t : rigid) acc = acc * t;
+        chainR = acc;
+    });
+    bench::report("Transform chain (operator*)", n, tMatrix);
+    bench::report("RigidTransform chain (operator*)", n, tRigid);
+    std::printf("  speed-up %.2fx\n", tMatrix / tRigid);
+
+    const double matrixDrift = orthonormalityError(chainM);
+    const double quatDrift = std::abs(chainR.rotation().norm() - 1.0);
+    const RigidTransform fixed = chainR.normalized();
+    std::printf("after %zu compositions: |R^T R - I| = %.3g (matrix), |q| - 1 = %.3g (quaternion), "
+                "%.3g after normalized()\n", n, matrixDrift, quatDrift,
+                orthonormalityError(fixed.toTransform()));
+    check(orthonormalityError(fixed.toTransform()) < 1e-15 * 8, "normalized chain is orthonormal");
+    check(fixed.toTransform().kind() == TransformKind::Rigid, "normalized chain converts to a Rigid transform");
+    check(sameMapping(chainM, fixed.toTransform(), 1e-6), "chains agree");
+
+    // ── inverse / apply ──
+    std::vector<Transform> invM(n);
+    std::vector<RigidTransform> invR(n);
+    const double tInvM = bench::bestOf(reps, [&] {
+        for (std::size_t i = 0; i < n; ++i) invM[i] = matrix[i].inverse();
+    });
+    const double tInvR = bench::bestOf(reps, [&] {
+        for (std::size_t i = 0; i < n; ++i) invR[i] = rigid[i].inverse();
+    });
+    bench::report("Transform::inverse (rigid)", n, tInvM);
+    bench::report("RigidTransform::inverse", n, tInvR);
+
+    const Point probe(0.3, -0.7, 1.1);
+    Point sumM, sumR;
+    const double tApplyM = bench::bestOf(reps, [&] {
+        Point s;
+        for (const Transform& t : matrix) s = s + t.apply(probe);
+        sumM = s;
+    });
+    const double tApplyR = bench::bestOf(reps, [&] {
+        Point s;
+        for (const RigidTransform& t : rigid) s = s + t.apply(probe);
+        sumR = s;
+    });
+    bench::report("Transform::apply", n, tApplyM);
+    bench::report("RigidTransform::apply", n, tApplyR);
+    check(sumM.distanceTo(sumR) < 1e-12 * n, "apply agrees with the matrix form");
+
+    bool ok = true;
+    for (std::size_t i = 0; i + 1 < n && i < 10'000; ++i) {
+        ok = ok && sameMapping(invM[i], invR[i].toTransform())
+                && sameMapping(matrix[i] * matrix[i + 1], (rigid[i] * rigid[i + 1]).toTransform())
+                && sameMapping(matrix[i], RigidTransform::fromTransform(matrix[i]).toTransform())
+                && (rigid[i] * invR[i]).apply(probe) == probe;
+    }
+    check(ok, "composition, inverse and fromTransform agree with Transform");
+
+    // ── factories, conversion ──
+    for (double a : {-2.5, -0.3, 0.0, 0.7, 3.1}) {
+        check(sameMapping(Transform::rotationX(a), RigidTransform::rotationX(a).toTransform())
+                  && sameMapping(Transform::rotationY(a), RigidTransform::rotationY(a).toTransform())
+                  && sameMapping(Transform::rotationZ(a), RigidTransform::rotationZ(a).toTransform()),
+              "rotation factories match Transform");
+    }
+    check(RigidTransform::translation(1, 2, 3).toTransform().kind() == TransformKind::Translation,
+          "pure translation keeps its kind");
+    check(RigidTransform().toTransform().kind() == TransformKind::Identity, "identity keeps its kind");
+    bool threw = false;
+    try { RigidTransform::fromTransform(Transform::scale(2, 2, 2)); } catch (const std::invalid_argument&) { threw = true; }
+    check(threw, "fromTransform rejects a scale");
+    // Rotations by ~pi exercise every branch of the matrix-to-quaternion conversion.
+    for (const Point& axis : {Point(1, 0, 0), Point(0, 1, 0), Point(0, 0, 1), Point(1, 1, 1)}) {
+        const Transform t = RigidTransform(Quaternion::fromAxisAngle(axis, 3.14), Point()).toTransform();
+        check(sameMapping(t, RigidTransform::fromTransform(t).toTransform()), "fromTransform near pi");
+    }
+
+    // ── slerp ──
+    const RigidTransform a = RigidTransform::translation(0, 0, 0) * RigidTransform::rotationZ(0.2);
+    const RigidTransform b = RigidTransform::translation(4, 0, 8) * RigidTransform::rotationZ(1.8);
+    check(sameMapping(RigidTransform::slerp(a, b, 0).toTransform(), a.toTransform()), "slerp at 0");
+    check(sameMapping(RigidTransform::slerp(a, b, 1).toTransform(), b.toTransform()), "slerp at 1");
+    check(sameMapping(RigidTransform::slerp(a, b, 0.25).toTransform(),
+                      (RigidTransform::translation(1, 0, 2) * RigidTransform::rotationZ(0.6)).toTransform()),
+          "slerp interpolates angle and translation");
+    check(sameMapping(RigidTransform::slerp(a, a, 0.5).toTransform(), a.toTransform()), "slerp of equal rotations");
+
+    // ── applyBatch ──
+    PointBuffer points;
+    for (std::size_t i = 0; i < 100'000; ++i) points.push_back(randomPoint(-10, 10));
+    PointBuffer out;
+    rigid[0].applyBatch(points, out);
+    const Transform m0 = rigid[0].toTransform();
+    ok = true;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        const Point e = m0.apply(points[i]);
+        ok = ok && e.x() == out.x()[i] && e.y() == out.y()[i] && e.z() == out.z()[i];
+    }
+    check(ok, "applyBatch equals the matrix kernels");
+
+    const RigidTransformF f(rigid[1]);
+    check(Point(f.apply(PointF(probe))).distanceTo(rigid[1].apply(probe)) < 1e-5, "float precision");
+
+    return bench::exitCode();
+}
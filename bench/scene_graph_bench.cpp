@@ -0,0 +1,159 @@
+#include "bench_util.h"
+
+#include "geometry/scene_graph.h"
+#include "geometry/thread_pool.h"
+#include "geometry/transform.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// A 1M-node hierarchy (random recursive tree: every node's parent is a
+// uniformly chosen earlier node).  Each frame changes the local transform
+// of 1% of the nodes, then brings every world transform up to date:
+//
+//  - recompose:  walk every node's parent chain with operator* (no cache)
+//  - full:       recompute all cached transforms level by level
+//  - dirty:      recompute only the changed subtrees, serial and parallel
+//
+// Checks that cached world transforms are bit-identical to recomposing
+// the parent chain, that world * inverseWorld is the identity, and that
+// serial and parallel updates agree.  Exits non-zero on any failure.
+
+namespace {
+
+using namespace geometry;
+using Clock = std::chrono::steady_clock;
+using bench::check;
+
+double seconds(Clock::time_point t0) {
+    return std::chrono::duration<double>(Clock::now() - t0).count();
+}
+
+Transform randomLocal() {
+    return Transform::translation(bench::uniform(-1, 1), bench::uniform(-1, 1), bench::uniform(-1, 1))
+         * Transform::rotationZ(bench::uniform(-0.5, 0.5));
+}
+
+Transform recompose(const SceneGraph& g, SceneGraph::NodeId id, std::vector<SceneGraph::NodeId>& chain) {
+    chain.clear();
+    for (SceneGraph::NodeId n = id; n != SceneGraph::NoParent; n = g.parent(n)) chain.push_back(n);
+    Transform w = g.local(chain.back());
+    for (std::size_t i = chain.size() - 1; i-- > 0;) w = w * g.local(chain[i]);
+    return w;
+}
+
+bool sameMatrix(const Transform& a, const Transform& b) {
+    return std::memcmp(&a.matrix(), &b.matrix(), sizeof(Transform::Matrix)) == 0;
+}
+
+bool nearIdentity(const Transform& t) {
+    const auto& m = t.matrix();
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+            if (std::abs(m[i][j] - (i == j ? 1.0 : 0.0)) > 1e-9) return false;
+    return true;
+}
+
+} // namespace
+
+int main() {
+    const std::size_t n = 1'000'000;
+    const std::size_t perFrame = n / 100;
+    const int frames = 5;
+
+    SceneGraph serial, parallel;
+    serial.reserve(n);
+    parallel.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto parent = i == 0 ? SceneGraph::NoParent
+                                   : static_cast<SceneGraph::NodeId>(bench::rng()() % i);
+        const Transform local = randomLocal();
+        serial.addNode(local, parent);
+        parallel.addNode(local, parent);
+    }
+
+    ThreadPool& pool = ThreadPool::instance();
+    auto t0 = Clock::now();
+    serial.update();
+    const double initial = seconds(t0);
+    parallel.update(pool);
+    std::printf("%zu nodes, %zu levels, initial update %.2f ms\n", n, serial.levels(), initial * 1e3);
+
+    // Recomposing every parent chain, as consumers do without a cache.
+    std::vector<SceneGraph::NodeId> chain;
+    std::vector<Transform> recomposed(n);
+    t0 = Clock::now();
+    for (SceneGraph::NodeId id = 0; id < n; ++id) recomposed[id] = recompose(serial, id, chain);
+    const double tRecompose = seconds(t0);
+
+    bool exact = true;
+    for (SceneGraph::NodeId id = 0; id < n && exact; ++id) exact = sameMatrix(recomposed[id], serial.world(id));
+    check(exact, "cached world equals recomposed parent chain");
+
+    double tFull = 1e300, tDirty = 1e300, tParallel = 1e300;
+    std::size_t touched = 0;
+    for (int f = 0; f < frames; ++f) {
+        std::vector<SceneGraph::NodeId> changed(perFrame);
+        for (auto& id : changed) id = static_cast<SceneGraph::NodeId>(bench::rng()() % n);
+        std::vector<Transform> locals(perFrame);
+        for (auto& l : locals) l = randomLocal();
+
+        for (std::size_t k = 0; k < perFrame; ++k) {
+            serial.setLocal(changed[k], locals[k]);
+            parallel.setLocal(changed[k], locals[k]);
+        }
+        t0 = Clock::now();
+        serial.update();
+        tDirty = std::min(tDirty, seconds(t0));
+        touched = serial.lastUpdateCount();
+
+        t0 = Clock::now();
+        parallel.update(pool);
+        tParallel = std::min(tParallel, seconds(t0));
+
+        // Full recompute for comparison: a root change dirties everything.
+        SceneGraph::NodeId root = 0;
+        parallel.setLocal(root, parallel.local(root));
+        t0 = Clock::now();
+        parallel.update();
+        tFull = std::min(tFull, seconds(t0));
+    }
+
+    std::printf("per frame (1%% of nodes changed, %zu recomputed):\n", touched);
+    std::printf("  recompose parent chains %10.2f ms\n", tRecompose * 1e3);
+    std::printf("  full update             %10.2f ms\n", tFull * 1e3);
+    std::printf("  dirty update            %10.2f ms  (%.1fx vs full)\n", tDirty * 1e3, tFull / tDirty);
+    std::printf("  dirty update, %2zu threads %9.2f ms\n", pool.concurrency(), tParallel * 1e3);
+
+    exact = true;
+    bool inverse = true;
+    for (SceneGraph::NodeId id = 0; id < n; ++id) {
+        exact = exact && sameMatrix(serial.world(id), parallel.world(id))
+                      && sameMatrix(serial.inverseWorld(id), parallel.inverseWorld(id));
+        if (id % 997 == 0) {
+            exact = exact && sameMatrix(serial.world(id), recompose(serial, id, chain));
+            inverse = inverse && nearIdentity(serial.world(id) * serial.inverseWorld(id));
+        }
+    }
+    check(exact, "incremental, parallel and recomposed world transforms agree");
+    check(inverse, "world * inverseWorld is the identity");
+
+    // Small hand-built hierarchy: only the changed subtree is recomputed.
+    SceneGraph g;
+    const auto a = g.addNode(Transform::translation(1, 0, 0));
+    const auto b = g.addNode(Transform::translation(0, 1, 0), a);
+    const auto c = g.addNode(Transform::translation(0, 0, 1), a);
+    const auto d = g.addNode(Transform::scale(2, 2, 2), b);
+    g.update();
+    check(g.lastUpdateCount() == 4, "initial update computes every node");
+    g.setLocal(b, Transform::translation(0, 2, 0));
+    check(g.world(d).apply(Point(1, 1, 1)) == Point(3, 4, 2), "world after setLocal");
+    check(g.lastUpdateCount() == 2, "setLocal recomputes only the subtree");
+    check(g.world(c).apply(Point(0, 0, 0)) == Point(1, 0, 1), "sibling unchanged");
+
+    return bench::exitCode();
+}
@@ -0,0 +1,176 @@
+#include "alloc_counter.h"
+#include "bench_util.h"
+
+#include "geometry/shape.h"
+#include "geometry/shape_arena.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+// Builds, walks and tears down a scene of mixed shapes three ways: one
+// std::make_unique per shape, a monotonic ShapeArena and a pooled
+// ShapeArena.  Reports per-phase times and global heap allocation counts,
+// checks that all three agree on the total area and that the arena
+// handles destroy() / reset() / stale handles / throwing constructors
+// correctly.  Exits non-zero on any failure.
+
+namespace {
+
+using namespace geometry;
+using Clock = std::chrono::steady_clock;
+using bench::check;
+
+struct Spec {
+    Point  p;
+    double a, b;
+};
+
+struct Phase {
+    double      seconds = 1e300;
+    std::size_t allocations = 0;
+};
+
+struct Timings {
+    Phase  build, walk, teardown;
+    double total = 0.0;
+};
+
+template <typename Fn>
+void measure(Phase& phase, Fn&& fn) {
+    const std::size_t before = bench::allocationCount();
+    const auto t0 = Clock::now();
+    fn();
+    const double s = std::chrono::duration<double>(Clock::now() - t0).count();
+    if (s < phase.seconds) phase.seconds = s;
+    phase.allocations = bench::allocationCount() - before;
+}
+
+Timings runUniquePtr(const std::vector<Spec>& specs, int reps) {
+    Timings t;
+    for (int r = 0; r < reps; ++r) {
+        std::vector<std::unique_ptr<Shape>> shapes;
+        measure(t.build, [&] {
+            shapes.reserve(specs.size());
+            for (std::size_t i = 0; i < specs.size(); ++i) {
+                const Spec& s = specs[i];
+                switch (i % 3) {
+                    case 0: shapes.push_back(std::make_unique<Circle>(s.p, s.a)); break;
+                    case 1: shapes.push_back(std::make_unique<Triangle>(s.p, s.p + Point(s.a, 0, 0),
+                                                                        s.p + Point(0, s.b, 0))); break;
+                    default: shapes.push_back(std::make_unique<Rectangle>(s.p, s.a, s.b)); break;
+                }
+            }
+        });
+        measure(t.walk, [&] {
+            t.total = 0.0;
+            for (const auto& s : shapes) t.total += s->area();
+        });
+        measure(t.teardown, [&] { std::vector<std::unique_ptr<Shape>>().swap(shapes); });
+    }
+    return t;
+}
+
+Timings runArena(const std::vector<Spec>& specs, int reps, ShapeArena::Kind kind) {
+    Timings t;
+    ShapeArena arena(kind, 1 << 20);
+    for (int r = 0; r < reps; ++r) {
+        measure(t.build, [&] {
+            for (std::size_t i = 0; i < specs.size(); ++i) {
+                const Spec& s = specs[i];
+                switch (i % 3) {
+                    case 0: arena.make<Circle>(s.p, s.a); break;
+                    case 1: arena.make<Triangle>(s.p, s.p + Point(s.a, 0, 0), s.p + Point(0, s.b, 0)); break;
+                    default: arena.make<Rectangle>(s.p, s.a, s.b); break;
+                }
+            }
+        });
+        measure(t.walk, [&] {
+            t.total = 0.0;
+            arena.forEach([&](const Shape& s) { t.total += s.area(); });
+        });
+        measure(t.teardown, [&] { arena.reset(); });
+    }
+    return t;
+}
+
+void print(const char* name, const Timings& t) {
+    std::printf("%-22s build %8.2f ms (%8zu allocs)  walk %7.2f ms  teardown %7.2f ms\n",
+                name, t.build.seconds * 1e3, t.build.allocations, t.walk.seconds * 1e3,
+                t.teardown.seconds * 1e3);
+}
+
+void checkSemantics() {
+    for (ShapeArena::Kind kind : {ShapeArena::Kind::Monotonic, ShapeArena::Kind::Pooled}) {
+        ShapeArena arena(kind);
+        auto c = arena.make<Circle>(Point(0, 0, 0), 1.0);
+        ShapeHandle<Shape> base = arena.make<Rectangle>(Point(1, 1, 0), 2.0, 3.0);
+        auto f = arena.make<CircleF>(PointF(0, 0, 0), 2.0f);
+        check(arena.size() == 3, "three live shapes");
+        check(base->area() == 6.0 && c->radius() == 1.0 && f->radius() == 2.0f, "handles dereference");
+
+        bool threw = false;
+        try {
+            arena.make<Circle>(Point(0, 0, 0), -1.0);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        check(threw && arena.size() == 3, "throwing constructor leaves the arena unchanged");
+
+        std::size_t doubles = 0, floats = 0;
+        arena.forEach([&](const Shape&) { ++doubles; });
+        arena.forEach([&](const ShapeF&) { ++floats; });
+        check(doubles == 2 && floats == 1, "forEach visits each precision");
+
+        void* freed = c.get();
+        arena.destroy(c);
+        check(arena.size() == 2, "destroy drops the live count");
+        auto again = arena.make<Circle>(Point(5, 5, 5), 3.0);
+        check(again.slot() == c.slot(), "destroyed slot is reused");
+        if (kind == ShapeArena::Kind::Pooled)
+            check(again.get() == freed, "pooled arena recycles the block");
+        check(again.generation() != c.generation(), "reused slot gets a new generation");
+        check(arena.get(c) == nullptr && arena.get(again) == again.get(), "get() rejects a stale handle");
+        arena.destroy(c);
+        check(arena.size() == 3 && arena.get(again) != nullptr, "destroying a stale handle is a no-op");
+
+        arena.reset();
+        check(arena.empty(), "reset empties the arena");
+        auto fresh = arena.make<Circle>(Point(0, 0, 0), 1.0);
+        check(fresh.slot() == c.slot(), "slots restart after reset");
+        check(arena.get(c) == nullptr && arena.get(base) == nullptr && arena.get(fresh) != nullptr,
+              "handles from before reset are stale");
+        check(arena.get(ShapeHandle<Circle>()) == nullptr, "get() of a null handle");
+    }
+}
+
+} // namespace
+
+int main() {
+    const std::size_t n = 1'000'000;
+    const int reps = 5;
+
+    std::vector<Spec> specs(n);
+    for (Spec& s : specs)
+        s = Spec{Point(bench::uniform(-100, 100), bench::uniform(-100, 100), 0.0),
+                 bench::uniform(0.1, 5), bench::uniform(0.1, 5)};
+
+    const Timings heap = runUniquePtr(specs, reps);
+    const Timings mono = runArena(specs, reps, ShapeArena::Kind::Monotonic);
+    const Timings pool = runArena(specs, reps, ShapeArena::Kind::Pooled);
+
+    print("make_unique", heap);
+    print("ShapeArena monotonic", mono);
+    print("ShapeArena pooled", pool);
+
+    check(heap.total == mono.total && heap.total == pool.total, "total area identical");
+    check(heap.build.allocations >= n, "make_unique allocates per shape");
+    check(mono.build.allocations * 100 < n, "monotonic arena allocates in blocks");
+    check(pool.build.allocations * 100 < n, "pooled arena allocates in blocks");
+
+    checkSemantics();
+    return bench::exitCode();
+}
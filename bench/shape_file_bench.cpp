@@ -0,0 +1,234 @@
+#include "bench_util.h"
+
+#include "geometry/shape_file.h"
+#include "geometry/transform.h"
+#include "io/file_writer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+// Round-trips point and shape collections through the binary column format
+// (bit-exact, including empty collections), checks that malformed files,
+// crafted index offsets and invalid shapes are rejected, and compares load
+// time against parsing the same points as text.  Exits non-zero on any
+// failure.
+
+namespace {
+
+using namespace geometry;
+using bench::check;
+
+bool sameBits(const double* a, const double* b, std::size_t n) {
+    return n == 0 || std::memcmp(a, b, n * sizeof(double)) == 0;
+}
+
+bool sameColumn(const std::vector<double>& a, const io::ColumnView<double>& b) {
+    return a.size() == b.size() && sameBits(a.data(), b.data(), a.size());
+}
+
+template <typename Fn>
+bool throws(Fn&& fn) {
+    try {
+        fn();
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+PointBuffer randomPoints(std::size_t n) {
+    PointBuffer p(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        p.set(i, Point(bench::uniform(-1e3, 1e3), bench::uniform(-1e3, 1e3), bench::uniform(-1e3, 1e3)));
+    }
+    return p;
+}
+
+ShapeStore randomShapes(std::size_t n) {
+    ShapeStore s;
+    auto pt = [] { return Point(bench::uniform(-1e3, 1e3), bench::uniform(-1e3, 1e3), bench::uniform(-1, 1)); };
+    for (std::size_t i = 0; i < n; ++i) {
+        switch (i % 3) {
+            case 0: s.add(Circle(pt(), bench::uniform(0.1, 5.0))); break;
+            case 1: s.add(Triangle(pt(), pt(), pt())); break;
+            default: s.add(Rectangle(pt(), bench::uniform(0.1, 5.0), bench::uniform(0.1, 5.0))); break;
+        }
+    }
+    return s;
+}
+
+void roundTripPoints(const std::string& path, std::size_t n) {
+    const PointBuffer points = randomPoints(n);
+    writePointFile(path, points);
+    const MappedPoints mapped(path);
+    check(mapped.size() == n, "point count");
+    check(sameBits(points.x(), mapped.x(), n) && sameBits(points.y(), mapped.y(), n)
+          && sameBits(points.z(), mapped.z(), n), "point columns bit-exact");
+    const PointBuffer copy = mapped.toBuffer();
+    check(sameBits(points.x(), copy.x(), n), "toBuffer");
+
+    // Transform straight from the mapping.
+    const Transform t = Transform::rotationZ(0.3) * Transform::translation(1, 2, 3);
+    PointBuffer a, b;
+    t.applyBatch(points, a);
+    t.applyBatch(mapped.x(), mapped.y(), mapped.z(), mapped.size(), b);
+    check(sameBits(a.x(), b.x(), n) && sameBits(a.z(), b.z(), n), "applyBatch on mapped columns");
+}
+
+void roundTripShapes(const std::string& path, std::size_t n) {
+    const ShapeStore shapes = randomShapes(n);
+    writeShapeFile(path, shapes);
+    const MappedShapes mapped(path);
+    check(mapped.circleCount() == shapes.circleCount()
+          && mapped.triangleCount() == shapes.triangleCount()
+          && mapped.rectangleCount() == shapes.rectangleCount(), "shape counts");
+
+    const auto& c = shapes.circles();
+    const auto& t = shapes.triangles();
+    const auto& r = shapes.rectangles();
+    const auto& mc = mapped.circles();
+    const auto& mt = mapped.triangles();
+    const auto& mr = mapped.rectangles();
+    check(sameColumn(c.cx, mc.cx) && sameColumn(c.cy, mc.cy) && sameColumn(c.cz, mc.cz)
+          && sameColumn(c.r, mc.r), "circle columns bit-exact");
+    check(sameColumn(t.ax, mt.ax) && sameColumn(t.ay, mt.ay) && sameColumn(t.az, mt.az)
+          && sameColumn(t.bx, mt.bx) && sameColumn(t.by, mt.by) && sameColumn(t.bz, mt.bz)
+          && sameColumn(t.cx, mt.cx) && sameColumn(t.cy, mt.cy) && sameColumn(t.cz, mt.cz),
+          "triangle columns bit-exact");
+    check(sameColumn(r.ox, mr.ox) && sameColumn(r.oy, mr.oy) && sameColumn(r.oz, mr.oz)
+          && sameColumn(r.w, mr.w) && sameColumn(r.h, mr.h), "rectangle columns bit-exact");
+    check(mapped.toStore().totalArea() == shapes.totalArea(), "toStore totalArea");
+}
+
+void rejectsMalformed(const std::string& path) {
+    writePointFile(path, randomPoints(100));
+    check(throws([&] { MappedShapes s(path); }), "schema mismatch rejected");
+
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), {});
+    }
+    auto rewrite = [&](const std::string& contents) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    };
+
+    rewrite(bytes.substr(0, bytes.size() - 64));
+    check(throws([&] { MappedPoints p(path); }), "truncated file rejected");
+
+    std::string bad = bytes;
+    bad[0] = 'X';
+    rewrite(bad);
+    check(throws([&] { MappedPoints p(path); }), "bad magic rejected");
+
+    rewrite(bytes.substr(0, 10));
+    check(throws([&] { MappedPoints p(path); }), "short header rejected");
+
+    // An index offset near 2^64 whose end wraps around to inside the file.
+    bad = bytes;
+    const std::uint64_t wrapping = ~std::uint64_t{0} - sizeof(io::ColumnFileEntry) + 1;
+    std::memcpy(&bad[offsetof(io::ColumnFileHeader, indexOffset)], &wrapping, sizeof wrapping);
+    rewrite(bad);
+    check(throws([&] { MappedPoints p(path); }), "wrapping index offset rejected");
+
+    // Well-formed columns holding a shape the store would not accept.
+    {
+        io::ColumnFileWriter w(path, ShapeFileSchema);
+        const std::vector<double> one{1.0}, negative{-1.0}, none;
+        for (const char* name : {"circle.cx", "circle.cy", "circle.cz"}) w.add(name, one);
+        w.add("circle.r", negative);
+        for (const char* name : {"triangle.ax", "triangle.ay", "triangle.az", "triangle.bx", "triangle.by",
+                                 "triangle.bz", "triangle.cx", "triangle.cy", "triangle.cz", "rectangle.ox",
+                                 "rectangle.oy", "rectangle.oz", "rectangle.w", "rectangle.h"})
+            w.add(name, none);
+        w.finish();
+    }
+    check(throws([&] { MappedShapes s(path); s.toStore(); }), "invalid mapped shape rejected by toStore");
+
+    check(throws([] { MappedPoints p("/nonexistent/points.bin"); }), "missing file rejected");
+}
+
+double sumAll(const double* x, const double* y, const double* z, std::size_t n) {
+    double s = 0.0;
+    for (std::size_t i = 0; i < n; ++i) s += x[i] + y[i] + z[i];
+    return s;
+}
+
+void loadBenchmark(const std::string& dir, std::size_t n) {
+    const PointBuffer points = randomPoints(n);
+    const std::string bin = dir + ".points.bin";
+    const std::string txt = dir + ".points.txt";
+
+    writePointFile(bin, points);
+    {
+        io::FileWriter w(txt);
+        char line[96];
+        for (std::size_t i = 0; i < n; ++i) {
+            std::snprintf(line, sizeof line, "%.17g %.17g %.17g", points.x()[i], points.y()[i], points.z()[i]);
+            w.writeLine(line);
+        }
+    }
+
+    double expected = sumAll(points.x(), points.y(), points.z(), n);
+    double got = 0.0;
+
+    const double tText = bench::bestOf(3, [&] {
+        std::ifstream in(txt);
+        PointBuffer p;
+        p.reserve(n);
+        std::string line;
+        while (std::getline(in, line)) {
+            char* end = nullptr;
+            const double x = std::strtod(line.c_str(), &end);
+            const double y = std::strtod(end, &end);
+            const double z = std::strtod(end, &end);
+            p.push_back(Point(x, y, z));
+        }
+        got = sumAll(p.x(), p.y(), p.z(), p.size());
+    });
+    check(got == expected, "text load sum");
+
+    const double tOpen = bench::bestOf(3, [&] {
+        MappedPoints p(bin);
+        bench::doNotOptimize(p.size());
+    });
+
+    const double tScan = bench::bestOf(3, [&] {
+        MappedPoints p(bin);
+        got = sumAll(p.x(), p.y(), p.z(), p.size());
+    });
+    check(got == expected, "mapped load sum");
+
+    bench::report("text parse + sum", n, tText);
+    bench::report("mmap open", n, tOpen);
+    bench::report("mmap open + sum", n, tScan);
+    std::printf("text/mmap speedup (load + sum): %.1fx\n", tText / tScan);
+
+    std::remove(bin.c_str());
+    std::remove(txt.c_str());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+    const std::string base = "/tmp/shape_file_bench." + std::to_string(::getpid());
+    const std::string path = base + ".bin";
+
+    for (std::size_t size : {std::size_t{0}, std::size_t{1}, std::size_t{7}, std::size_t{10'000}}) {
+        roundTripPoints(path, size);
+        roundTripShapes(path, size);
+    }
+    rejectsMalformed(path);
+    std::remove(path.c_str());
+
+    loadBenchmark(base, n);
+    return bench::exitCode();
+}
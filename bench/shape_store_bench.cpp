@@ -0,0 +1,91 @@
+#include "bench_util.h"
+
+#include "geometry/shape.h"
+#include "geometry/shape_store.h"
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+// Bulk area / perimeter / centroid over a mixed shape collection:
+// std::vector<std::unique_ptr<Shape>> with virtual calls versus ShapeStore.
+
+int main() {
+    const std::size_t n = 3'000'000;
+    const int reps = 5;
+
+    std::vector<std::unique_ptr<geometry::Shape>> shapes;
+    shapes.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const geometry::Point p(bench::uniform(-100, 100), bench::uniform(-100, 100), 0.0);
+        switch (i % 3) {
+            case 0:
+                shapes.push_back(std::make_unique<geometry::Circle>(p, bench::uniform(0.1, 5)));
+                break;
+            case 1:
+                shapes.push_back(std::make_unique<geometry::Triangle>(
+                    p, p + geometry::Point(bench::uniform(0.1, 5), 0.0, 0.0),
+                    p + geometry::Point(0.0, bench::uniform(0.1, 5), 0.0)));
+                break;
+            default:
+                shapes.push_back(std::make_unique<geometry::Rectangle>(
+                    p, bench::uniform(0.1, 5), bench::uniform(0.1, 5)));
+                break;
+        }
+    }
+    const geometry::ShapeStore store = geometry::ShapeStore::fromShapes(shapes);
+
+    double polyArea = 0.0, polyPerim = 0.0;
+    const double polyTotals = bench::bestOf(reps, [&] {
+        polyArea = polyPerim = 0.0;
+        for (const auto& s : shapes) {
+            polyArea  += s->area();
+            polyPerim += s->perimeter();
+        }
+        bench::doNotOptimize(polyArea);
+        bench::doNotOptimize(polyPerim);
+    });
+    bench::report("virtual area+perimeter totals", n, polyTotals);
+
+    double storeArea = 0.0, storePerim = 0.0;
+    const double storeTotals = bench::bestOf(reps, [&] {
+        storeArea  = store.totalArea();
+        storePerim = store.totalPerimeter();
+        bench::doNotOptimize(storeArea);
+        bench::doNotOptimize(storePerim);
+    });
+    bench::report("ShapeStore area+perimeter totals", n, storeTotals);
+    std::printf("speed-up: %.2fx\n", polyTotals / storeTotals);
+
+    std::vector<geometry::Point> polyCentroids(n);
+    const double polyCent = bench::bestOf(reps, [&] {
+        for (std::size_t i = 0; i < n; ++i) polyCentroids[i] = shapes[i]->centroid();
+        bench::clobberMemory();
+    });
+    bench::report("virtual centroid()", n, polyCent);
+
+    std::vector<double> areas(n);
+    const double storeAreas = bench::bestOf(reps, [&] {
+        store.areas(areas.data());
+        bench::clobberMemory();
+    });
+    bench::report("ShapeStore::areas", n, storeAreas);
+
+    geometry::PointBuffer centroids;
+    const double storeCent = bench::bestOf(reps, [&] {
+        store.centroids(centroids);
+        bench::clobberMemory();
+    });
+    bench::report("ShapeStore::centroids", n, storeCent);
+    std::printf("speed-up: %.2fx\n", polyCent / storeCent);
+
+    const double relArea  = std::abs(storeArea - polyArea) / polyArea;
+    const double relPerim = std::abs(storePerim - polyPerim) / polyPerim;
+    if (relArea > 1e-9 || relPerim > 1e-9) {
+        std::printf("ERROR: totals disagree (area %.3g, perimeter %.3g relative)\n",
+                    relArea, relPerim);
+        return 1;
+    }
+    return 0;
+}
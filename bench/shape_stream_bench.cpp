@@ -0,0 +1,179 @@
+#include "bench_util.h"
+
+#include "geometry/shape_stream.h"
+#include "geometry/transform.h"
+#include "io/file_writer.h"
+
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <sys/resource.h>
+#include <type_traits>
+#include <unistd.h>
+
+// Streams a generated file of 2M shape records through ShapeStreamReader
+// (parse only) and transformShapeStream (parse, transform, CSV through an
+// async FileWriter) and reports records/s.  Checks that numbers round-trip
+// exactly, that the output has a header and does not depend on the chunk
+// size, that peak memory does not grow with the input, that a leading '+'
+// is accepted and that malformed input is rejected with its line number.  Exits non-zero on any failure.
+
+namespace {
+
+using namespace geometry;
+using bench::check;
+
+long maxRssKiB() {
+    rusage ru{};
+    ::getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_maxrss;
+}
+
+struct Fd {
+    explicit Fd(const std::string& path) : fd(::open(path.c_str(), O_RDONLY | O_CLOEXEC)) {
+        if (fd < 0) throw std::runtime_error("cannot open " + path);
+    }
+    ~Fd() { ::close(fd); }
+    int fd;
+};
+
+std::string slurp(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), {});
+}
+
+std::string writeTemp(const char* name, const std::string& text) {
+    const std::string path = std::string("/tmp/") + name;
+    std::ofstream(path, std::ios::binary) << text;
+    return path;
+}
+
+/// Expect parsing \p text to throw a message mentioning "line \p line".
+void expectError(const char* text, int line, const char* what) {
+    const std::string path = writeTemp("shape_stream_bad.txt", text);
+    Fd in(path);
+    try {
+        ShapeStreamReader(in.fd, 64).run([](const auto&) {});
+    } catch (const std::runtime_error& e) {
+        check(std::strstr(e.what(), ("line " + std::to_string(line) + ":").c_str()) != nullptr, what);
+        ::unlink(path.c_str());
+        return;
+    }
+    check(false, what);
+    ::unlink(path.c_str());
+}
+
+} // namespace
+
+int main() {
+    const std::size_t n = 2'000'000;
+    const int reps = 3;
+    const std::string input = "/tmp/shape_stream_bench.txt";
+    const std::string output = "/tmp/shape_stream_bench.csv";
+
+    // ── generate ──
+    double sumRadius = 0.0;
+    {
+        io::WriterOptions opts;
+        opts.async = true;
+        io::FileWriter w(input, opts);
+        w.writeLine("# generated by shape_stream_bench");
+        char line[512];
+        for (std::size_t i = 0; i < n; ++i) {
+            char* p = line;
+            char* end = line + sizeof line;
+            const char* name = i % 3 == 0 ? "circle" : i % 3 == 1 ? "triangle" : "rectangle";
+            const int count = i % 3 == 0 ? 4 : i % 3 == 1 ? 9 : 5;
+            p += std::strlen(std::strcpy(p, name));
+            for (int k = 0; k < count; ++k) {
+                *p++ = ' ';
+                const double v = (i % 3 != 1 && k >= 3) ? bench::uniform(0.1, 5) : bench::uniform(-1e3, 1e3);
+                if (i % 3 == 0 && k == 3) sumRadius += v;
+                p = std::to_chars(p, end, v).ptr;
+            }
+            w.writeLine(std::string_view(line, static_cast<std::size_t>(p - line)));
+        }
+    }
+
+    // ── parse only ──
+    std::size_t records = 0;
+    double parsedRadius = 0.0;
+    const long rssBefore = maxRssKiB();
+    const double tParse = bench::bestOf(reps, [&] {
+        Fd in(input);
+        parsedRadius = 0.0;
+        ShapeStreamReader reader(in.fd);
+        records = reader.run([&](const auto& s) {
+            if constexpr (std::is_same<std::decay_t<decltype(s)>, Circle>::value) parsedRadius += s.radius();
+            bench::doNotOptimize(s);
+        });
+    });
+    bench::report("ShapeStreamReader::run (parse)", n, tParse);
+    check(records == n, "every record parsed");
+    check(parsedRadius == sumRadius, "numbers round-trip exactly through to_chars / from_chars");
+
+    // ── parse, transform, write ──
+    const Transform xf = Transform::translation(1, 2, 3) * Transform::rotationZ(0.5);
+    ShapeStreamStats stats;
+    const double tStream = bench::bestOf(reps, [&] {
+        Fd in(input);
+        io::WriterOptions opts;
+        opts.async = true;
+        io::FileWriter out(output, opts);
+        stats = transformShapeStream(in.fd, xf, out);
+    });
+    bench::report("transformShapeStream (parse + write)", n, tStream);
+    std::printf("input %.1f MB, output %.1f MB, %.1f MB/s in\n", stats.bytesIn / 1e6, stats.bytesOut / 1e6,
+                stats.bytesIn / tStream / 1e6);
+    const long rssGrowth = maxRssKiB() - rssBefore;
+    std::printf("peak RSS growth while streaming: %ld KiB\n", rssGrowth);
+    check(stats.records == n, "every record written");
+    check(rssGrowth < 32 * 1024, "memory stays bounded");
+
+    // ── chunk size independence ──
+    const std::string reference = slurp(output);
+    for (std::size_t chunk : {std::size_t{256}, std::size_t{4096}}) {
+        Fd in(input);
+        {
+            io::FileWriter out(output);
+            transformShapeStream(in.fd, xf, out, chunk);
+        }
+        check(slurp(output) == reference, "output independent of chunk size");
+    }
+
+    check(reference.rfind("name,area,perimeter,centroid_x,centroid_y,centroid_z\n", 0) == 0, "CSV header row");
+
+    // ── signs ──
+    {
+        const std::string path = writeTemp("shape_stream_signs.txt", "circle +1 -2 +3e0 +0.5\n");
+        Fd in(path);
+        double sum = 0.0;
+        ShapeStreamReader(in.fd).run([&](const auto& s) {
+            if constexpr (std::is_same<std::decay_t<decltype(s)>, Circle>::value)
+                sum = s.center().x() + s.center().y() + s.center().z() + s.radius();
+        });
+        check(sum == 2.5, "leading '+' accepted");
+        ::unlink(path.c_str());
+    }
+
+    // ── malformed input ──
+    expectError("circle 0 0 0 1\nhexagon 1 2 3\n", 2, "unknown shape");
+    expectError("circle 0 0 0\n", 1, "missing number");
+    expectError("# c\n\nrectangle 0 0 0 1 2 3\n", 3, "trailing characters");
+    expectError("circle 0 0 0 -1\n", 1, "negative radius");
+    expectError("circle 0 0 0 +-1\n", 1, "two signs");
+    expectError("circle 1 2 3.5.5\n", 1, "two decimal points");
+    expectError("circle 1 2 3-4\n", 1, "numbers without a blank");
+    expectError("triangle 0 0 0 1 1 1 2 2 inf\n", 1, "non-finite number");
+    expectError(("circle " + std::string(100, '1') + "\n").c_str(), 1, "line longer than a chunk");
+
+    ::unlink(input.c_str());
+    ::unlink(output.c_str());
+    return bench::exitCode();
+}
@@ -0,0 +1,67 @@
+#include "bench_util.h"
+
+#include "geometry/point.h"
+#include "geometry/point_buffer.h"
+#include "geometry/transform.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// Compares Transform::applyBatch on a PointBuffer against the scalar
+// apply() loop over std::vector<Point>, and checks the results agree
+// bit-for-bit.
+
+int main() {
+    const std::size_t n = 10'000'000;
+    const int reps = 5;
+
+    std::vector<geometry::Point> points;
+    points.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+        points.emplace_back(bench::uniform(-100, 100),
+                            bench::uniform(-100, 100),
+                            bench::uniform(-100, 100));
+
+    const geometry::Transform t =
+        geometry::Transform::translation(1.0, 2.0, 3.0) *
+        geometry::Transform::rotationX(0.3) *
+        geometry::Transform::scale(2.0, 0.5, 1.5);
+
+    std::vector<geometry::Point> scalarOut(n);
+    const double scalar = bench::bestOf(reps, [&] {
+        for (std::size_t i = 0; i < n; ++i) scalarOut[i] = t.apply(points[i]);
+        bench::clobberMemory();
+    });
+    bench::report("Transform::apply (scalar loop)", n, scalar);
+
+    const geometry::PointBuffer in(points);
+    geometry::PointBuffer out;
+    const double batch = bench::bestOf(reps, [&] {
+        t.applyBatch(in, out);
+        bench::clobberMemory();
+    });
+    bench::report("Transform::applyBatch (out-of-place)", n, batch);
+
+    geometry::PointBuffer inplace(points);
+    const double batchInPlace = bench::bestOf(1, [&] {
+        t.applyBatch(inplace);
+        bench::clobberMemory();
+    });
+    bench::report("Transform::applyBatch (in-place)", n, batchInPlace);
+
+    std::printf("speed-up: %.2fx\n", scalar / batch);
+
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const geometry::Point a = scalarOut[i];
+        if (out.x()[i] != a.x() || out.y()[i] != a.y() || out.z()[i] != a.z() ||
+            inplace.x()[i] != a.x() || inplace.y()[i] != a.y() || inplace.z()[i] != a.z())
+            ++mismatches;
+    }
+    if (mismatches != 0) {
+        std::printf("ERROR: %zu results differ from Transform::apply\n", mismatches);
+        return 1;
+    }
+    return 0;
+}
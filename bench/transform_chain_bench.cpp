@@ -0,0 +1,78 @@
+#include "bench_util.h"
+
+#include "geometry/transform.h"
+#include "geometry/transform_chain.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Per-point three-step pipelines (translate * rotate * scale, different for
+// every point): eager composition then apply, versus applying the lazy
+// chain step by step.  Compile-time folding is checked with static_assert;
+// run-time results are checked against the eager product.
+
+namespace {
+
+using namespace geometry;
+
+// ── compile-time checks ──────────────────────────────────────────────────────
+
+constexpr Transform Offset = Transform::translation(1.0, 2.0, 3.0);
+constexpr Transform Double = Transform::scale(2.0, 2.0, 2.0);
+constexpr Transform Folded = (lazy(Offset) * Double * Offset).eval();
+
+static_assert(Folded.kind() == TransformKind::Affine, "translation * scale is affine");
+static_assert(Folded.apply(Point(0, 0, 0)) == Point(3.0, 6.0, 9.0), "folded pipeline");
+static_assert(chain(Offset, Double).apply(Point(1, 1, 1)) == Point(3.0, 4.0, 5.0), "lazy apply");
+static_assert((Offset * Offset).kind() == TransformKind::Translation, "translation kind");
+static_assert(Point(1, 2, 3).cross(Point(4, 5, 6)) == Point(-3, 6, -3), "constexpr cross");
+
+} // namespace
+
+int main() {
+    const std::size_t n = 1'000'000;
+    const int reps = 5;
+
+    std::vector<Transform> t, r, s;
+    std::vector<Point> pts;
+    for (std::size_t i = 0; i < n; ++i) {
+        t.push_back(Transform::translation(bench::uniform(-5, 5), bench::uniform(-5, 5), 0.0));
+        r.push_back(Transform::rotationZ(bench::uniform(-3, 3)));
+        s.push_back(Transform::scale(bench::uniform(0.5, 2), bench::uniform(0.5, 2), 1.0));
+        pts.emplace_back(bench::uniform(-1, 1), bench::uniform(-1, 1), bench::uniform(-1, 1));
+    }
+
+    std::vector<Point> eager(n), fused(n), stepped(n);
+    const double tEager = bench::bestOf(reps, [&] {
+        for (std::size_t i = 0; i < n; ++i) eager[i] = (t[i] * r[i] * s[i]).apply(pts[i]);
+    });
+    const double tFused = bench::bestOf(reps, [&] {
+        for (std::size_t i = 0; i < n; ++i) fused[i] = (lazy(t[i]) * r[i] * s[i]).eval().apply(pts[i]);
+    });
+    const double tStepped = bench::bestOf(reps, [&] {
+        for (std::size_t i = 0; i < n; ++i) stepped[i] = (lazy(t[i]) * r[i] * s[i]).apply(pts[i]);
+    });
+
+    bench::report("eager (t * r * s).apply(p)", n, tEager);
+    bench::report("lazy chain eval().apply(p)", n, tFused);
+    bench::report("lazy chain apply(p)", n, tStepped);
+
+    int failures = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (std::memcmp(&eager[i], &fused[i], sizeof(Point)) != 0) {
+            std::fprintf(stderr, "MISMATCH: eval() differs from eager product at %zu\n", i);
+            ++failures;
+            break;
+        }
+        if (eager[i].distanceTo(stepped[i]) > 1e-12) {
+            std::fprintf(stderr, "MISMATCH: stepped apply off by %g at %zu\n",
+                         eager[i].distanceTo(stepped[i]), i);
+            ++failures;
+            break;
+        }
+    }
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
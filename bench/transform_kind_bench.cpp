@@ -0,0 +1,193 @@
+#include "bench_util.h"
+
+#include "geometry/point.h"
+#include "geometry/transform.h"
+
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+// Measures the kind-specialised compose / apply / inverse paths of
+// Transform against the general 4×4 algorithms they replace, and checks
+// that both agree to within 1e-9 and that tiny but regular affine
+// matrices still invert.
+
+namespace {
+
+using geometry::Point;
+using geometry::Transform;
+using Mat4 = Transform::Matrix;
+
+Mat4 generalCompose(const Mat4& a, const Mat4& b) {
+    Mat4 res{};
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+            for (int k = 0; k < 4; ++k)
+                res[i][j] += a[i][k] * b[k][j];
+    return res;
+}
+
+Point generalApply(const Mat4& m, const Point& p) {
+    const double w = m[3][0]*p.x() + m[3][1]*p.y() + m[3][2]*p.z() + m[3][3];
+    return Point(
+        (m[0][0]*p.x() + m[0][1]*p.y() + m[0][2]*p.z() + m[0][3]) / w,
+        (m[1][0]*p.x() + m[1][1]*p.y() + m[1][2]*p.z() + m[1][3]) / w,
+        (m[2][0]*p.x() + m[2][1]*p.y() + m[2][2]*p.z() + m[2][3]) / w
+    );
+}
+
+Mat4 generalInverse(const Mat4& m) {
+    std::array<std::array<double, 8>, 4> aug{};
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) aug[i][j] = m[i][j];
+        aug[i][4 + i] = 1.0;
+    }
+    for (int col = 0; col < 4; ++col) {
+        int pivot = col;
+        for (int row = col + 1; row < 4; ++row)
+            if (std::abs(aug[row][col]) > std::abs(aug[pivot][col])) pivot = row;
+        std::swap(aug[col], aug[pivot]);
+        const double div = aug[col][col];
+        for (double& v : aug[col]) v /= div;
+        for (int row = 0; row < 4; ++row) {
+            if (row == col) continue;
+            const double factor = aug[row][col];
+            for (int j = 0; j < 8; ++j) aug[row][j] -= factor * aug[col][j];
+        }
+    }
+    Mat4 r{};
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j) r[i][j] = aug[i][4 + j];
+    return r;
+}
+
+bool close(const Mat4& a, const Mat4& b) {
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+            if (std::abs(a[i][j] - b[i][j]) > 1e-9 * (1.0 + std::abs(b[i][j]))) return false;
+    return true;
+}
+
+const char* kindName(geometry::TransformKind k) {
+    switch (k) {
+        case geometry::TransformKind::Identity:    return "identity";
+        case geometry::TransformKind::Translation: return "translation";
+        case geometry::TransformKind::Scale:       return "scale";
+        case geometry::TransformKind::Rigid:       return "rigid";
+        case geometry::TransformKind::Affine:      return "affine";
+        case geometry::TransformKind::Projective:  return "projective";
+    }
+    return "?";
+}
+
+int runKind(const Transform& t) {
+    const std::size_t n = 200'000;
+    const int reps = 5;
+    const Mat4& m = t.matrix();
+    const char* kind = kindName(t.kind());
+    int failures = 0;
+
+    std::vector<Point> pts;
+    pts.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+        pts.emplace_back(bench::uniform(-10, 10), bench::uniform(-10, 10), bench::uniform(-10, 10));
+
+    char label[64];
+
+    Transform acc = t;
+    const double fastCompose = bench::bestOf(reps, [&] {
+        for (std::size_t i = 0; i < n; ++i) { acc = t * t; bench::doNotOptimize(acc); }
+    });
+    Mat4 accM{};
+    const double slowCompose = bench::bestOf(reps, [&] {
+        for (std::size_t i = 0; i < n; ++i) { accM = generalCompose(m, m); bench::doNotOptimize(accM); }
+    });
+    if (!close((t * t).matrix(), generalCompose(m, m))) ++failures;
+
+    Point out;
+    const double fastApply = bench::bestOf(reps, [&] {
+        for (std::size_t i = 0; i < n; ++i) { out = t.apply(pts[i]); bench::doNotOptimize(out); }
+    });
+    const double slowApply = bench::bestOf(reps, [&] {
+        for (std::size_t i = 0; i < n; ++i) { out = generalApply(m, pts[i]); bench::doNotOptimize(out); }
+    });
+    for (std::size_t i = 0; i < 1000; ++i)
+        if (t.apply(pts[i]).distanceTo(generalApply(m, pts[i])) > 1e-9) ++failures;
+
+    const double fastInverse = bench::bestOf(reps, [&] {
+        for (std::size_t i = 0; i < n; ++i) { acc = t.inverse(); bench::doNotOptimize(acc); }
+    });
+    const double slowInverse = bench::bestOf(reps, [&] {
+        for (std::size_t i = 0; i < n; ++i) { accM = generalInverse(m); bench::doNotOptimize(accM); }
+    });
+    if (!close(t.inverse().matrix(), generalInverse(m))) ++failures;
+
+    std::snprintf(label, sizeof label, "%s compose", kind);
+    bench::report(label, n, fastCompose);
+    std::printf("  %-38s %.2fx vs general\n", "", slowCompose / fastCompose);
+    std::snprintf(label, sizeof label, "%s apply", kind);
+    bench::report(label, n, fastApply);
+    std::printf("  %-38s %.2fx vs general\n", "", slowApply / fastApply);
+    std::snprintf(label, sizeof label, "%s inverse", kind);
+    bench::report(label, n, fastInverse);
+    std::printf("  %-38s %.2fx vs general\n", "", slowInverse / fastInverse);
+
+    if (failures != 0)
+        std::printf("ERROR: %s fast path disagrees with the general algorithm\n", kind);
+    return failures;
+}
+
+/// Invertibility does not depend on the overall scale: a uniformly scaled
+/// rotation with det 1e-15 inverts, dependent columns do not.
+template <typename T>
+int checkSingular() {
+    using TransformT = geometry::BasicTransform<T>;
+    int failures = 0;
+    const TransformT small = TransformT::rotationZ(T(0.3)) * TransformT::scale(T(1e-5), T(1e-5), T(1e-5));
+    try {
+        const auto roundTrip = (small * small.inverse()).matrix();
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j)
+                if (std::abs(roundTrip[i][j] - (i == j ? T(1) : T(0))) > T(1e-4)) ++failures;
+    } catch (const std::runtime_error&) {
+        ++failures;
+    }
+
+    typename TransformT::Matrix flat = TransformT::rotationY(T(0.2)).matrix();
+    for (int i = 0; i < 3; ++i) flat[i][2] = T(2) * flat[i][0];
+    try {
+        TransformT::fromMatrix(flat).inverse();
+        ++failures;
+    } catch (const std::runtime_error&) {
+    }
+
+    if (failures != 0)
+        std::printf("ERROR: %s singularity test depends on scale\n", sizeof(T) == 4 ? "float" : "double");
+    return failures;
+}
+
+} // namespace
+
+int main() {
+    Mat4 perspective{};
+    perspective[0][0] = 1.5;
+    perspective[1][1] = 1.5;
+    perspective[2][2] = -1.02;
+    perspective[2][3] = -2.02;
+    perspective[3][2] = -1.0;
+
+    const Transform kinds[] = {
+        Transform::translation(1.0, -2.0, 3.0),
+        Transform::scale(2.0, 0.5, 4.0),
+        Transform::translation(1.0, 2.0, 3.0) * Transform::rotationY(0.7) * Transform::rotationX(0.3),
+        Transform::rotationZ(0.4) * Transform::scale(2.0, 3.0, 0.5) * Transform::translation(0.5, 0.0, 1.0),
+        Transform::fromMatrix(perspective),
+    };
+
+    int failures = 0;
+    for (const Transform& t : kinds) failures += runKind(t);
+    failures += checkSingular<double>();
+    failures += checkSingular<float>();
+    return failures == 0 ? 0 : 1;
+}
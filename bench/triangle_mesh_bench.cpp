@@ -0,0 +1,166 @@
+#include "bench_util.h"
+
+#include "geometry/shape_store.h"
+#include "geometry/thread_pool.h"
+#include "geometry/transform.h"
+#include "geometry/triangle_mesh.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+// A 1000 x 1000 grid surface (2M triangles, 1M shared vertices) with
+// jittered heights, stored three ways:
+//
+//  - std::vector<Triangle>:  every face owns its three vertices
+//  - ShapeStore:             triangle columns, still three vertices per face
+//  - TriangleMesh:           shared vertex buffer + index buffer
+//
+// Reports memory per representation and face-area / surface-area
+// throughput.  Checks that mesh areas equal ShapeStore's bit for bit and
+// agree with Triangle::area(), that normals are unit length, that area and
+// centroid of a flat grid are exact, that a uniform scale multiplies the
+// area by its square, and that parallel results match the serial ones and
+// do not depend on the pool size.  Exits non-zero on any failure.
+
+namespace {
+
+using namespace geometry;
+using bench::check;
+
+/// (n+1)^2 vertices on a unit-spaced grid, two faces per cell.
+TriangleMesh grid(std::size_t n, double jitter) {
+    TriangleMesh m;
+    m.reserve((n + 1) * (n + 1), 2 * n * n);
+    for (std::size_t j = 0; j <= n; ++j)
+        for (std::size_t i = 0; i <= n; ++i)
+            m.addVertex(Point(double(i), double(j), jitter > 0 ? bench::uniform(-jitter, jitter) : 0.0));
+    const auto at = [n](std::size_t i, std::size_t j) { return TriangleMesh::Index(j * (n + 1) + i); };
+    for (std::size_t j = 0; j < n; ++j)
+        for (std::size_t i = 0; i < n; ++i) {
+            m.addFace(at(i, j), at(i + 1, j), at(i + 1, j + 1));
+            m.addFace(at(i, j), at(i + 1, j + 1), at(i, j + 1));
+        }
+    return m;
+}
+
+bool unitLength(const PointBuffer& b) {
+    for (std::size_t i = 0; i < b.size(); ++i) {
+        const double l = b[i].length();
+        if (std::abs(l - 1.0) > 1e-12) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    const std::size_t n = 1000;
+    const int reps = 5;
+
+    const TriangleMesh mesh = grid(n, 0.5);
+    const std::size_t faces = mesh.faceCount();
+
+    std::vector<Triangle> triangles;
+    triangles.reserve(faces);
+    ShapeStore store;
+    store.reserve(0, faces, 0);
+    for (std::size_t f = 0; f < faces; ++f) {
+        triangles.push_back(mesh.face(f));
+        store.add(triangles.back());
+    }
+
+    std::printf("%zu faces, %zu vertices\n", faces, mesh.vertexCount());
+    std::printf("  vector<Triangle> %8.1f MB\n", faces * sizeof(Triangle) / 1e6);
+    std::printf("  ShapeStore       %8.1f MB\n", faces * 9 * sizeof(double) / 1e6);
+    std::printf("  TriangleMesh     %8.1f MB\n",
+                (mesh.vertexCount() * 3 * sizeof(double) + faces * 3 * sizeof(TriangleMesh::Index)) / 1e6);
+
+    // ── face areas ──
+    std::vector<double> heron(faces), columns(faces), indexed(faces), parallel(faces);
+    const double tHeron = bench::bestOf(reps, [&] {
+        for (std::size_t f = 0; f < faces; ++f) heron[f] = triangles[f].area();
+        bench::clobberMemory();
+    });
+    const double tStore = bench::bestOf(reps, [&] { store.areas(columns.data()); });
+    const double tMesh = bench::bestOf(reps, [&] { mesh.faceAreas(indexed.data()); });
+    ThreadPool& pool = ThreadPool::instance();
+    const double tParallel = bench::bestOf(reps, [&] { mesh.faceAreas(parallel.data(), pool); });
+    bench::report("Triangle::area (Heron)", faces, tHeron);
+    bench::report("ShapeStore::areas", faces, tStore);
+    bench::report("TriangleMesh::faceAreas", faces, tMesh);
+    bench::report("TriangleMesh::faceAreas (parallel)", faces, tParallel);
+
+    check(std::memcmp(indexed.data(), columns.data(), faces * sizeof(double)) == 0,
+          "mesh face areas equal ShapeStore areas");
+    check(std::memcmp(indexed.data(), parallel.data(), faces * sizeof(double)) == 0,
+          "parallel face areas equal serial");
+    bool close = true;
+    for (std::size_t f = 0; f < faces && close; ++f)
+        close = std::abs(indexed[f] - heron[f]) <= 1e-9 * heron[f];
+    check(close, "face areas agree with Triangle::area");
+
+    // ── surface area, normals, centroid ──
+    double area = 0.0;
+    const double tSurface = bench::bestOf(reps, [&] { area = mesh.surfaceArea(); });
+    bench::report("TriangleMesh::surfaceArea", faces, tSurface);
+    check(std::abs(area - store.totalArea()) <= 1e-9 * area, "surface area equals ShapeStore total");
+
+    PointBuffer normals, parallelNormals;
+    const double tNormals = bench::bestOf(reps, [&] { mesh.faceNormals(normals); });
+    bench::report("TriangleMesh::faceNormals", faces, tNormals);
+    mesh.faceNormals(parallelNormals, pool);
+    check(unitLength(normals), "face normals are unit length");
+    check(std::memcmp(normals.x(), parallelNormals.x(), faces * sizeof(double)) == 0
+              && std::memcmp(normals.z(), parallelNormals.z(), faces * sizeof(double)) == 0,
+          "parallel face normals equal serial");
+
+    PointBuffer vertexNormals;
+    const double tVertex = bench::bestOf(reps, [&] { mesh.vertexNormals(vertexNormals); });
+    bench::report("TriangleMesh::vertexNormals", mesh.vertexCount(), tVertex);
+    check(unitLength(vertexNormals), "vertex normals are unit length");
+
+    const double pooledTotal = mesh.surfaceArea(pool);
+    const Point pooledCentroid = mesh.centroid(pool);
+    for (std::size_t threads : {std::size_t{1}, std::size_t{2}, std::size_t{4}}) {
+        ThreadPool p(threads);
+        const Point c = mesh.centroid(p);
+        check(mesh.surfaceArea(p) == pooledTotal && c.x() == pooledCentroid.x() && c.y() == pooledCentroid.y()
+                  && c.z() == pooledCentroid.z(),
+              "parallel totals independent of pool size");
+    }
+
+    const TriangleMesh flat = grid(64, 0.0);
+    PointBuffer flatNormals;
+    flat.faceNormals(flatNormals);
+    bool up = true;
+    for (std::size_t f = 0; f < flat.faceCount(); ++f) up = up && flatNormals[f] == Point(0, 0, 1);
+    check(up, "flat grid normals point up");
+    check(flat.surfaceArea() == 64.0 * 64.0, "flat grid area");
+    check(flat.centroid() == Point(32, 32, 0), "flat grid centroid");
+
+    // ── transform ──
+    TriangleMesh scaled = mesh;
+    const double tTransform = bench::bestOf(1, [&] { scaled.transform(Transform::scale(3, 3, 3), pool); });
+    bench::report("TriangleMesh::transform (parallel)", mesh.vertexCount(), tTransform);
+    check(std::abs(scaled.surfaceArea() - 9.0 * area) <= 1e-12 * 9.0 * area, "uniform scale multiplies area by s^2");
+    TriangleMesh moved = flat;
+    moved.transform(Transform::translation(1, 2, 3));
+    check(moved.centroid() == Point(33, 34, 3), "translation moves the centroid");
+
+    // ── validation ──
+    bool threw = false;
+    try { TriangleMesh(PointBuffer(3), {0, 1, 3}); } catch (const std::invalid_argument&) { threw = true; }
+    check(threw, "out-of-range index rejected");
+    threw = false;
+    try { TriangleMesh(PointBuffer(3), {0, 1}); } catch (const std::invalid_argument&) { threw = true; }
+    check(threw, "partial face rejected");
+    threw = false;
+    try { TriangleMesh(PointBuffer(3), {0, 0, 0}).centroid(); } catch (const std::domain_error&) { threw = true; }
+    check(threw, "centroid of zero-area mesh rejected");
+
+    return bench::exitCode();
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "point.h"
+#include <algorithm>
+#include <array>
+#include <limits>
+
+namespace geometry {
+
+/// Axis-aligned bounding box.  A default-constructed box is empty
+/// (min = +inf, max = -inf) and is the identity for expand().
+class Aabb {
+public:
+    Aabb() noexcept {
+        m_min.fill( std::numeric_limits<double>::infinity());
+        m_max.fill(-std::numeric_limits<double>::infinity());
+    }
+    Aabb(const Point& min, const Point& max) noexcept
+        : m_min{min.x(), min.y(), min.z()}, m_max{max.x(), max.y(), max.z()} {}
+
+    Point min() const { return Point(m_min[0], m_min[1], m_min[2]); }
+    Point max() const { return Point(m_max[0], m_max[1], m_max[2]); }
+    Point center() const {
+        return Point((m_min[0] + m_max[0]) * 0.5,
+                     (m_min[1] + m_max[1]) * 0.5,
+                     (m_min[2] + m_max[2]) * 0.5);
+    }
+
+    double lo(int axis) const noexcept { return m_min[axis]; }
+    double hi(int axis) const noexcept { return m_max[axis]; }
+
+    bool isEmpty() const noexcept {
+        return m_min[0] > m_max[0] || m_min[1] > m_max[1] || m_min[2] > m_max[2];
+    }
+
+    void expand(const Point& p) noexcept {
+        const double v[3] = {p.x(), p.y(), p.z()};
+        for (int a = 0; a < 3; ++a) {
+            m_min[a] = std::min(m_min[a], v[a]);
+            m_max[a] = std::max(m_max[a], v[a]);
+        }
+    }
+
+    void expand(const Aabb& b) noexcept {
+        for (int a = 0; a < 3; ++a) {
+            m_min[a] = std::min(m_min[a], b.m_min[a]);
+            m_max[a] = std::max(m_max[a], b.m_max[a]);
+        }
+    }
+
+    bool overlaps(const Aabb& b) const noexcept {
+        return m_min[0] <= b.m_max[0] && b.m_min[0] <= m_max[0] &&
+               m_min[1] <= b.m_max[1] && b.m_min[1] <= m_max[1] &&
+               m_min[2] <= b.m_max[2] && b.m_min[2] <= m_max[2];
+    }
+
+    bool contains(const Point& p) const noexcept {
+        return p.x() >= m_min[0] && p.x() <= m_max[0] &&
+               p.y() >= m_min[1] && p.y() <= m_max[1] &&
+               p.z() >= m_min[2] && p.z() <= m_max[2];
+    }
+
+    /// Squared distance from \p p to the box (0 if inside).
+    double distanceSquared(const Point& p) const noexcept {
+        const double v[3] = {p.x(), p.y(), p.z()};
+        double d2 = 0.0;
+        for (int a = 0; a < 3; ++a) {
+            const double d = std::max(std::max(m_min[a] - v[a], v[a] - m_max[a]), 0.0);
+            d2 += d * d;
+        }
+        return d2;
+    }
+
+    /// Half the surface area; the constant factor is irrelevant for SAH.
+    double halfArea() const noexcept {
+        if (isEmpty()) return 0.0;
+        const double dx = m_max[0] - m_min[0];
+        const double dy = m_max[1] - m_min[1];
+        const double dz = m_max[2] - m_min[2];
+        return dx * dy + dy * dz + dz * dx;
+    }
+
+private:
+    std::array<double, 3> m_min, m_max;
+};
+
+} // namespace geometry
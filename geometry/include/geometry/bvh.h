@@ -0,0 +1,134 @@
+#pragma once
+
+#include "aabb.h"
+#include "point.h"
+#include "shape.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace geometry {
+
+/// Build parameters for BVH.
+struct BvhOptions {
+    std::size_t maxLeafSize = 4;   ///< Stop splitting at this many primitives
+    int         bins        = 16;  ///< SAH bins per axis
+    unsigned    threads     = 0;   ///< Build threads; 0 = hardware concurrency
+};
+
+/// Bounding volume hierarchy over a set of axis-aligned boxes.
+///
+/// Primitives are identified by their index in the bounds array passed to
+/// build(); queries report those indices.  The tree only knows the bounds,
+/// so it is a broad phase: query(), raycastBounds() and nearestBounds() test
+/// boxes, and their results are candidates that callers refine with exact
+/// shape tests.  nearest() with a distance callback does that refinement
+/// itself.  Nodes are laid out depth-first in one flat array, with the left
+/// child immediately after its parent.
+class BVH {
+public:
+    using Options = BvhOptions;
+
+    BVH() = default;
+    explicit BVH(std::vector<Aabb> bounds, const Options& opts = Options{});
+    explicit BVH(const std::vector<std::unique_ptr<Shape>>& shapes, const Options& opts = Options{});
+
+    /// (Re)build the tree with a binned surface-area-heuristic split.
+    void build(std::vector<Aabb> bounds, const Options& opts = Options{});
+
+    /// Update primitive bounds in place and refit node boxes bottom-up without
+    /// changing the topology.  \p bounds must have the same size as before.
+    /// Query cost degrades if primitives move far; rebuild in that case.
+    void refit(const std::vector<Aabb>& bounds);
+
+    /// Replace the bounds of a single primitive and refit only its ancestors.
+    void update(std::size_t primitive, const Aabb& bounds);
+
+    std::size_t size()      const noexcept { return m_bounds.size(); }
+    std::size_t nodeCount() const noexcept { return m_nodes.size(); }
+    const Aabb& bounds(std::size_t primitive) const { return m_bounds[primitive]; }
+
+    /// Primitives whose bounds overlap \p box.
+    void query(const Aabb& box, std::vector<std::size_t>& out) const;
+
+    /// Primitives whose bounds contain \p p.
+    void query(const Point& p, std::vector<std::size_t>& out) const;
+
+    /// Primitives whose bounds are hit by the ray origin + t·dir, 0 ≤ t ≤ tMax,
+    /// in no particular order.  The shapes themselves may still be missed.
+    void raycastBounds(const Point& origin, const Point& dir, std::vector<std::size_t>& out,
+                       double tMax = std::numeric_limits<double>::infinity()) const;
+
+    /// Primitive whose bounds are closest to \p p (distance 0 if inside),
+    /// or size() if the tree is empty.  Not necessarily the closest shape:
+    /// a large box can be nearer than the shape inside it.
+    std::size_t nearestBounds(const Point& p) const;
+
+    /// Primitive minimising \p distance(index), the exact distance from \p p
+    /// to that primitive; it must never be smaller than the distance to the
+    /// primitive's bounds.  Returns size() if the tree is empty.
+    template <typename DistanceFn>
+    std::size_t nearest(const Point& p, DistanceFn&& distance) const;
+
+private:
+    /// SAH splits below this depth fall back to median splits, which bounds
+    /// the total depth (and the traversal stacks) to 2 × MaxSahDepth.
+    static constexpr int MaxSahDepth = 32;
+    static constexpr int MaxDepth    = 2 * MaxSahDepth;
+
+    struct Node {
+        Aabb          box;
+        std::uint32_t first  = 0;  ///< Leaf: first entry in m_order
+        std::uint32_t count  = 0;  ///< Leaf: number of primitives; 0 for inner nodes
+        std::uint32_t right  = 0;  ///< Inner: index of right child (left is this + 1)
+        std::uint32_t parent = 0;
+    };
+
+    std::vector<Aabb>          m_bounds;
+    std::vector<Node>          m_nodes;
+    std::vector<std::uint32_t> m_order;     ///< Primitive indices grouped by leaf
+    std::vector<std::uint32_t> m_leafOf;    ///< Primitive → leaf node index
+
+    class Builder;
+};
+
+// ── template implementation ──────────────────────────────────────────────────
+
+template <typename DistanceFn>
+std::size_t BVH::nearest(const Point& p, DistanceFn&& distance) const {
+    std::size_t best = size();
+    if (m_nodes.empty()) return best;
+
+    double bestDist = std::numeric_limits<double>::infinity();
+    std::uint32_t stack[MaxDepth + 2];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const Node& n = m_nodes[stack[--top]];
+        const double boxDist = std::sqrt(n.box.distanceSquared(p));
+        if (boxDist >= bestDist) continue;
+        if (n.count > 0) {
+            for (std::uint32_t i = n.first; i < n.first + n.count; ++i) {
+                const double d = distance(static_cast<std::size_t>(m_order[i]));
+                if (d < bestDist) {
+                    bestDist = d;
+                    best = m_order[i];
+                }
+            }
+            continue;
+        }
+        // Visit the nearer child first so the bound tightens sooner.
+        const std::uint32_t left = static_cast<std::uint32_t>(&n - m_nodes.data()) + 1;
+        const std::uint32_t right = n.right;
+        const bool leftFirst = m_nodes[left].box.distanceSquared(p)
+                             <= m_nodes[right].box.distanceSquared(p);
+        stack[top++] = leftFirst ? right : left;
+        stack[top++] = leftFirst ? left : right;
+    }
+    return best;
+}
+
+} // namespace geometry
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "point.h"
+#include "point_buffer.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace geometry {
+
+class ThreadPool;
+
+/// A point found by a KdTree query.
+struct KdNeighbor {
+    std::size_t index;              ///< Position in the points passed to build()
+    double      distanceSquared;
+};
+
+/// k-d tree over a point cloud for nearest-neighbour and radius queries.
+///
+/// The tree is implicit: points are reordered into SoA columns, inner
+/// nodes live in one flat array (children of node i at 2i + 1 and 2i + 2)
+/// holding only a split axis and value, and every leaf covers a range of
+/// the columns computed from its position, so leaves differ in size by at
+/// most one.  Each node splits its points at the median along the axis of
+/// largest extent.
+///
+/// Queries compare squared distances and report points by their index in
+/// the build input.  Distance ties are broken by the smaller index, so
+/// results are exactly those of a brute-force scan.  The tree is immutable
+/// after build() and safe to query from many threads.
+class KdTree {
+public:
+    using Neighbor = KdNeighbor;
+
+    static constexpr std::size_t DefaultLeafSize = 8;
+
+    KdTree() = default;
+    explicit KdTree(const PointBuffer& points, std::size_t leafSize = DefaultLeafSize);
+    KdTree(const PointBuffer& points, ThreadPool& pool, std::size_t leafSize = DefaultLeafSize);
+
+    /// (Re)build over \p points with leaves of at most \p leafSize points.
+    /// The parallel variant splits each tree level across \p pool and builds
+    /// the same tree for every pool size.  Throws std::invalid_argument for
+    /// a zero leaf size or non-finite coordinates, std::length_error for
+    /// more than 2^32 - 1 points.
+    void build(const PointBuffer& points, std::size_t leafSize = DefaultLeafSize);
+    void build(const PointBuffer& points, ThreadPool& pool, std::size_t leafSize = DefaultLeafSize);
+
+    std::size_t size()  const noexcept { return m_index.size(); }
+    bool        empty() const noexcept { return m_index.empty(); }
+    int         depth() const noexcept { return m_depth; }
+
+    /// Index of the point closest to \p p, or size() if the tree is empty.
+    std::size_t nearest(const Point& p) const;
+
+    /// Replace \p out with the min(k, size()) points closest to \p p,
+    /// nearest first.
+    void nearest(const Point& p, std::size_t k, std::vector<Neighbor>& out) const;
+
+    /// Append the index of every point within \p radius of \p p (boundary
+    /// included), in tree order.
+    void withinRadius(const Point& p, double radius, std::vector<std::size_t>& out) const;
+
+    // ── batched queries ──────────────────────────────────────────────────────
+    //
+    // Queries run in Morton (Z-)order of their coordinates so that
+    // consecutive queries share tree paths and leaves; results are written
+    // in query order and equal those of the single-query calls.
+
+    /// out[i] = nearest(queries[i]); \p out holds queries.size() entries.
+    void nearest(const PointBuffer& queries, std::size_t* out) const;
+    void nearest(const PointBuffer& queries, std::size_t* out, ThreadPool& pool) const;
+
+    /// Row i of \p out (k entries) holds the k nearest points of query i,
+    /// nearest first; rows are padded with {size(), infinity} when the tree
+    /// has fewer than k points.  \p out holds queries.size() × k entries.
+    void nearest(const PointBuffer& queries, std::size_t k, Neighbor* out, ThreadPool& pool) const;
+
+    /// Radius search for every query in compressed-row form: the hits of
+    /// query i are indices[offsets[i] .. offsets[i + 1]), in tree order.
+    /// Both vectors are replaced; offsets gets queries.size() + 1 entries.
+    void withinRadius(const PointBuffer& queries, double radius, std::vector<std::size_t>& offsets,
+                      std::vector<std::size_t>& indices, ThreadPool& pool) const;
+
+private:
+    struct Node {
+        double        split = std::numeric_limits<double>::infinity();
+        std::uint32_t axis  = 0;
+    };
+
+    /// Deepest supported tree: leaves are indexed by std::uint32_t.
+    static constexpr int MaxDepth = 32;
+
+    void buildImpl(const PointBuffer& points, ThreadPool* pool, std::size_t leafSize);
+
+    /// Column range of leaf \p leaf (0-based at the leaf level).
+    std::size_t leafBegin(std::size_t leaf) const noexcept {
+        return static_cast<std::size_t>((static_cast<std::uint64_t>(leaf) * size()) >> m_depth);
+    }
+
+    /// Visit every leaf that may hold a point within sqrt(bound) of \p p,
+    /// calling scan(first, last) on its column range.  \p bound may shrink
+    /// as scan finds closer points.
+    template <typename Scan>
+    void descend(const Point& p, const double& bound, Scan&& scan) const;
+
+    PointBuffer                m_points;   ///< Build input, reordered into leaf order
+    std::vector<std::uint32_t> m_index;    ///< Column position → build-input index
+    std::vector<Node>          m_nodes;    ///< 2^depth - 1 inner nodes, breadth first
+    int                        m_depth = 0;
+};
+
+} // namespace geometry
@@ -2,35 +2,84 @@
 
 #include <cmath>
 #include <ostream>
+#include <type_traits>
 
 namespace geometry {
 
-/// A point (or vector) in 3-D space.
-class Point {
+/// A point (or vector) in 3-D space with coordinates of type \p T
+/// (float or double).  Use the Point / PointF aliases.
+///
+/// Construction, arithmetic and comparison are constexpr; only the
+/// functions that need a square root are evaluated at run time.
+/// Converting between precisions is explicit: `PointF(p)`.
+template <typename T>
+class BasicPoint {
+    static_assert(std::is_floating_point<T>::value, "BasicPoint needs a floating-point scalar");
+
 public:
-    explicit Point(double x = 0.0, double y = 0.0, double z = 0.0);
+    using Scalar = T;
+
+    /// Absolute per-component tolerance used by operator==.
+    static constexpr T Tolerance = std::is_same<T, float>::value ? T(1e-5) : T(1e-9);
 
-    double x() const noexcept { return m_x; }
-    double y() const noexcept { return m_y; }
-    double z() const noexcept { return m_z; }
+    constexpr explicit BasicPoint(T x = T(0), T y = T(0), T z = T(0)) noexcept
+        : m_x(x), m_y(y), m_z(z) {}
 
-    double length()              const noexcept;
-    double distanceTo(const Point& other) const noexcept;
-    Point  normalized()          const;
+    template <typename U>
+    constexpr explicit BasicPoint(const BasicPoint<U>& other) noexcept
+        : m_x(static_cast<T>(other.x())), m_y(static_cast<T>(other.y())), m_z(static_cast<T>(other.z())) {}
 
-    Point operator+(const Point& other) const noexcept;
-    Point operator-(const Point& other) const noexcept;
-    Point operator*(double scalar)      const noexcept;
-    double dot(const Point& other)      const noexcept;
-    Point  cross(const Point& other)    const noexcept;
+    constexpr T x() const noexcept { return m_x; }
+    constexpr T y() const noexcept { return m_y; }
+    constexpr T z() const noexcept { return m_z; }
 
-    bool operator==(const Point& other) const noexcept;
-    bool operator!=(const Point& other) const noexcept;
+    T          length()                          const noexcept;
+    T          distanceTo(const BasicPoint& other) const noexcept;
+    BasicPoint normalized()                      const;
 
-    friend std::ostream& operator<<(std::ostream& os, const Point& p);
+    constexpr BasicPoint operator+(const BasicPoint& other) const noexcept {
+        return BasicPoint(m_x + other.m_x, m_y + other.m_y, m_z + other.m_z);
+    }
+    constexpr BasicPoint operator-(const BasicPoint& other) const noexcept {
+        return BasicPoint(m_x - other.m_x, m_y - other.m_y, m_z - other.m_z);
+    }
+    constexpr BasicPoint operator*(T scalar) const noexcept {
+        return BasicPoint(m_x * scalar, m_y * scalar, m_z * scalar);
+    }
+    constexpr T dot(const BasicPoint& other) const noexcept {
+        return m_x * other.m_x + m_y * other.m_y + m_z * other.m_z;
+    }
+    constexpr BasicPoint cross(const BasicPoint& other) const noexcept {
+        return BasicPoint(
+            m_y * other.m_z - m_z * other.m_y,
+            m_z * other.m_x - m_x * other.m_z,
+            m_x * other.m_y - m_y * other.m_x
+        );
+    }
+
+    /// Component-wise comparison within Tolerance.
+    constexpr bool operator==(const BasicPoint& other) const noexcept {
+        return near(m_x, other.m_x) && near(m_y, other.m_y) && near(m_z, other.m_z);
+    }
+    constexpr bool operator!=(const BasicPoint& other) const noexcept { return !(*this == other); }
 
 private:
-    double m_x, m_y, m_z;
+    static constexpr bool near(T a, T b) noexcept {
+        return (a > b ? a - b : b - a) < Tolerance;
+    }
+
+    T m_x, m_y, m_z;
 };
 
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const BasicPoint<T>& p);
+
+using Point  = BasicPoint<double>;
+using PointF = BasicPoint<float>;
+
+extern template class BasicPoint<float>;
+extern template class BasicPoint<double>;
+extern template std::ostream& operator<<(std::ostream&, const BasicPoint<float>&);
+extern template std::ostream& operator<<(std::ostream&, const BasicPoint<double>&);
+
 } // namespace geometry
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "point.h"
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace geometry {
+
+/// Minimal allocator returning storage aligned to \p Align bytes.
+template <typename T, std::size_t Align>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Align>; };
+
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Align>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Align}));
+    }
+    void deallocate(T* p, std::size_t) noexcept {
+        ::operator delete(p, std::align_val_t{Align});
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Align>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Align>&) const noexcept { return false; }
+};
+
+/// Structure-of-arrays point container: x, y and z live in separate
+/// 64-byte aligned columns so batch kernels can stream them with SIMD loads.
+/// Use the PointBuffer (double) / PointBufferF (float) aliases; a float
+/// buffer moves half the bytes per point.
+template <typename T>
+class BasicPointBuffer {
+public:
+    using Scalar = T;
+    using PointType = BasicPoint<T>;
+    static constexpr std::size_t Alignment = 64;
+    using Column = std::vector<T, AlignedAllocator<T, Alignment>>;
+
+    BasicPointBuffer() = default;
+    explicit BasicPointBuffer(std::size_t count);
+    explicit BasicPointBuffer(const std::vector<PointType>& points);
+
+    /// Convert from a buffer of the other precision (rounds to nearest).
+    template <typename U>
+    explicit BasicPointBuffer(const BasicPointBuffer<U>& other)
+        : m_x(other.x(), other.x() + other.size()),
+          m_y(other.y(), other.y() + other.size()),
+          m_z(other.z(), other.z() + other.size()) {}
+
+    std::size_t size()  const noexcept { return m_x.size(); }
+    bool        empty() const noexcept { return m_x.empty(); }
+
+    void resize(std::size_t count);
+    void reserve(std::size_t count);
+    void clear() noexcept;
+
+    void      push_back(const PointType& p);
+    void      set(std::size_t i, const PointType& p) noexcept;
+    PointType operator[](std::size_t i) const noexcept;
+
+    std::vector<PointType> toPoints() const;
+
+    T*       x() noexcept       { return m_x.data(); }
+    T*       y() noexcept       { return m_y.data(); }
+    T*       z() noexcept       { return m_z.data(); }
+    const T* x() const noexcept { return m_x.data(); }
+    const T* y() const noexcept { return m_y.data(); }
+    const T* z() const noexcept { return m_z.data(); }
+
+private:
+    Column m_x, m_y, m_z;
+};
+
+using PointBuffer  = BasicPointBuffer<double>;
+using PointBufferF = BasicPointBuffer<float>;
+
+extern template class BasicPointBuffer<float>;
+extern template class BasicPointBuffer<double>;
+
+} // namespace geometry
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "aabb.h"
+#include "point.h"
+#include "point_buffer.h"
+#include "transform.h"
+#include <array>
+#include <cstddef>
+
+namespace geometry {
+
+class ThreadPool;
+
+/// Count, bounds, mean and covariance of a point cloud.
+///
+/// Computed in one pass over fixed-size blocks: each block is reduced
+/// two-pass while it is in cache (sum for its mean, then deviations from
+/// that mean), and the block results are merged left to right with the
+/// pairwise update of Chan et al.  Block boundaries depend only on the
+/// point count, so serial and parallel results are identical for every
+/// pool size.  NaN coordinates are ignored by the bounds but poison the
+/// mean and covariance.
+struct PointStats {
+    std::size_t count = 0;
+    Aabb        bounds;                  ///< Empty box for an empty cloud
+    Point       mean;
+    /// Sums of products of deviations from the mean (co-moments), in the
+    /// order xx, xy, xz, yy, yz, zz.
+    std::array<double, 6> comoments{};
+
+    /// Population covariance (co-moment / count); 0 for an empty cloud.
+    double covariance(int row, int col) const noexcept;
+
+    /// Combine with the statistics of another, disjoint set of points.
+    void merge(const PointStats& other) noexcept;
+};
+
+/// Eigen-decomposition of a cloud's covariance.
+struct PrincipalAxes {
+    Point                 origin;        ///< The cloud's mean
+    std::array<Point, 3>  axes;          ///< Unit eigenvectors, right-handed
+    std::array<double, 3> variances{};   ///< Matching eigenvalues, descending
+
+    /// Rigid transform from PCA-frame coordinates to world coordinates:
+    /// the frame's x, y and z axes map to axes[0], axes[1] and axes[2],
+    /// its origin to the mean.
+    Transform toWorld() const;
+
+    /// Inverse of toWorld(): world coordinates into the PCA frame, where
+    /// the cloud is centred and its covariance diagonal.
+    Transform toFrame() const;
+};
+
+Aabb       bounds(const PointBuffer& points);
+Aabb       bounds(const PointBuffer& points, ThreadPool& pool);
+PointStats pointStats(const PointBuffer& points);
+PointStats pointStats(const PointBuffer& points, ThreadPool& pool);
+
+/// Principal axes from cyclic Jacobi rotations of the 3×3 covariance.
+/// Each axis points so that its largest component is positive, except
+/// axes[2], which is axes[0] × axes[1].  A cloud with fewer than two
+/// points has the world axes and zero variances.
+PrincipalAxes principalAxes(const PointStats& stats);
+
+} // namespace geometry
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "point.h"
+#include "point_buffer.h"
+#include "shape.h"
+#include "shape_store.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace geometry {
+
+/// Containment and overlap predicates for circles, triangles and rectangles.
+///
+/// All tests work in the XY plane and ignore z: circles and rectangles lie
+/// in the XY plane, and triangles are tested by their XY projection.
+/// Shapes are closed, so points on the boundary are inside and touching
+/// shapes intersect.  A triangle of zero (projected) area contains no
+/// points.  Comparisons involving NaN are false.
+///
+/// The batched forms test N points against one shape, or one point or
+/// shape against the N shapes of a ShapeStore column set, and write a
+/// bitmask: bit i % 64 of word i / 64 is set when item i passes.  They
+/// need maskWords(N) words; unused bits of the last word are cleared.
+/// AVX2 kernels are picked at runtime, with a scalar fallback; both
+/// perform the same IEEE operations as the single tests, so results are
+/// identical.
+
+constexpr std::size_t maskWords(std::size_t n) noexcept { return (n + 63) / 64; }
+
+constexpr bool maskBit(const std::uint64_t* mask, std::size_t i) noexcept {
+    return (mask[i / 64] >> (i % 64)) & 1u;
+}
+
+// ── single tests ─────────────────────────────────────────────────────────────
+
+template <typename T>
+inline bool contains(const BasicCircle<T>& c, const BasicPoint<T>& p) noexcept {
+    const T dx = p.x() - c.center().x();
+    const T dy = p.y() - c.center().y();
+    return dx * dx + dy * dy <= c.radius() * c.radius();
+}
+
+template <typename T>
+inline bool contains(const BasicRectangle<T>& r, const BasicPoint<T>& p) noexcept {
+    const BasicPoint<T>& o = r.origin();
+    return p.x() >= o.x() && p.x() <= o.x() + r.width() && p.y() >= o.y() && p.y() <= o.y() + r.height();
+}
+
+/// Edge-function (unnormalised barycentric) test; either winding.
+template <typename T>
+inline bool contains(const BasicTriangle<T>& t, const BasicPoint<T>& p) noexcept {
+    const T ax = t.a().x(), ay = t.a().y(), bx = t.b().x(), by = t.b().y(), cx = t.c().x(), cy = t.c().y();
+    const T area2 = (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+    const T e0 = (bx - ax) * (p.y() - ay) - (by - ay) * (p.x() - ax);
+    const T e1 = (cx - bx) * (p.y() - by) - (cy - by) * (p.x() - bx);
+    const T e2 = (ax - cx) * (p.y() - cy) - (ay - cy) * (p.x() - cx);
+    return area2 != T(0) && ((e0 >= T(0) && e1 >= T(0) && e2 >= T(0)) || (e0 <= T(0) && e1 <= T(0) && e2 <= T(0)));
+}
+
+template <typename T>
+inline bool intersects(const BasicCircle<T>& a, const BasicCircle<T>& b) noexcept {
+    const T dx = b.center().x() - a.center().x();
+    const T dy = b.center().y() - a.center().y();
+    const T r = a.radius() + b.radius();
+    return dx * dx + dy * dy <= r * r;
+}
+
+template <typename T>
+inline bool intersects(const BasicRectangle<T>& a, const BasicRectangle<T>& b) noexcept {
+    const BasicPoint<T>& p = a.origin();
+    const BasicPoint<T>& q = b.origin();
+    return p.x() <= q.x() + b.width() && q.x() <= p.x() + a.width() &&
+           p.y() <= q.y() + b.height() && q.y() <= p.y() + a.height();
+}
+
+// ── N points against one shape ───────────────────────────────────────────────
+
+void contains(const Circle& circle, const PointBuffer& points, std::uint64_t* mask);
+void contains(const Rectangle& rectangle, const PointBuffer& points, std::uint64_t* mask);
+void contains(const Triangle& triangle, const PointBuffer& points, std::uint64_t* mask);
+
+// ── one point or shape against N shapes ──────────────────────────────────────
+
+/// Bit i: shape i of the column set contains \p p.
+void contains(const ShapeStore::Circles& circles, const Point& p, std::uint64_t* mask);
+void contains(const ShapeStore::Rectangles& rectangles, const Point& p, std::uint64_t* mask);
+void contains(const ShapeStore::Triangles& triangles, const Point& p, std::uint64_t* mask);
+
+/// Bit i: shape i of the column set intersects \p shape.
+void intersects(const ShapeStore::Circles& circles, const Circle& circle, std::uint64_t* mask);
+void intersects(const ShapeStore::Rectangles& rectangles, const Rectangle& rectangle, std::uint64_t* mask);
+
+} // namespace geometry
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "point.h"
+#include "transform.h"
+#include <type_traits>
+
+namespace geometry {
+
+template <typename T> class BasicPointBuffer;
+class ThreadPool;
+
+/// Quaternion w + xi + yj + zk with components of type \p T.
+///
+/// Only unit quaternions represent rotations; rotate() assumes one.
+template <typename T>
+class BasicQuaternion {
+    static_assert(std::is_floating_point<T>::value, "BasicQuaternion needs a floating-point scalar");
+
+public:
+    using Scalar = T;
+    using PointType = BasicPoint<T>;
+
+    constexpr BasicQuaternion() noexcept : m_w(T(1)), m_x(T(0)), m_y(T(0)), m_z(T(0)) {}   ///< Identity
+    constexpr BasicQuaternion(T w, T x, T y, T z) noexcept : m_w(w), m_x(x), m_y(y), m_z(z) {}
+
+    template <typename U>
+    constexpr explicit BasicQuaternion(const BasicQuaternion<U>& other) noexcept
+        : m_w(static_cast<T>(other.w())), m_x(static_cast<T>(other.x())),
+          m_y(static_cast<T>(other.y())), m_z(static_cast<T>(other.z())) {}
+
+    /// Rotation by \p radians about \p axis (need not be unit length).
+    /// Throws std::domain_error for a zero axis.
+    static BasicQuaternion fromAxisAngle(const PointType& axis, T radians);
+
+    constexpr T w() const noexcept { return m_w; }
+    constexpr T x() const noexcept { return m_x; }
+    constexpr T y() const noexcept { return m_y; }
+    constexpr T z() const noexcept { return m_z; }
+
+    constexpr PointType vector() const noexcept { return PointType(m_x, m_y, m_z); }
+
+    /// Hamilton product: (a * b).rotate(p) == a.rotate(b.rotate(p)).
+    constexpr BasicQuaternion operator*(const BasicQuaternion& o) const noexcept {
+        return BasicQuaternion(
+            m_w * o.m_w - m_x * o.m_x - m_y * o.m_y - m_z * o.m_z,
+            m_w * o.m_x + m_x * o.m_w + m_y * o.m_z - m_z * o.m_y,
+            m_w * o.m_y - m_x * o.m_z + m_y * o.m_w + m_z * o.m_x,
+            m_w * o.m_z + m_x * o.m_y - m_y * o.m_x + m_z * o.m_w);
+    }
+    constexpr BasicQuaternion conjugate() const noexcept { return BasicQuaternion(m_w, -m_x, -m_y, -m_z); }
+    constexpr T dot(const BasicQuaternion& o) const noexcept {
+        return m_w * o.m_w + m_x * o.m_x + m_y * o.m_y + m_z * o.m_z;
+    }
+
+    T               norm()       const noexcept;
+    /// Throws std::domain_error for the zero quaternion.
+    BasicQuaternion normalized() const;
+
+    /// Rotate \p p: q p q*, evaluated as p + 2w(v × p) + 2v × (v × p).
+    constexpr PointType rotate(const PointType& p) const noexcept {
+        const PointType v = vector();
+        const PointType t = v.cross(p) * T(2);
+        return p + t * m_w + v.cross(t);
+    }
+
+private:
+    T m_w, m_x, m_y, m_z;
+};
+
+/// Rotation followed by translation, stored as a unit quaternion and a
+/// translation vector (7 scalars instead of a 16-scalar matrix) with
+/// entries of type \p T.  Use the RigidTransform / RigidTransformF aliases.
+///
+/// Follows Transform's conventions: (a * b).apply(p) == a.apply(b.apply(p)),
+/// and rotationX/Y/Z rotate by the same angles in the same direction.
+/// Composition reads and writes less than half the data of a rigid matrix
+/// product, and inverse() is a conjugation with no solving.  Rounding in
+/// long composition chains perturbs both the rotation and the quaternion's
+/// norm; normalized() brings the norm back to one, so the result is always
+/// an exact rotation (though not the exact product), where a matrix drifts
+/// away from orthonormality.
+template <typename T>
+class BasicRigidTransform {
+public:
+    using Scalar = T;
+    using PointType = BasicPoint<T>;
+    using Quaternion = BasicQuaternion<T>;
+    using TransformType = BasicTransform<T>;
+    using Buffer = BasicPointBuffer<T>;
+
+    constexpr BasicRigidTransform() noexcept = default;   ///< Identity
+    constexpr BasicRigidTransform(const Quaternion& rotation, const PointType& translation) noexcept
+        : m_rotation(rotation), m_translation(translation) {}
+
+    template <typename U>
+    constexpr explicit BasicRigidTransform(const BasicRigidTransform<U>& other) noexcept
+        : m_rotation(other.rotation()), m_translation(other.translation()) {}
+
+    static constexpr BasicRigidTransform identity() noexcept { return BasicRigidTransform{}; }
+    static constexpr BasicRigidTransform translation(T tx, T ty, T tz) noexcept {
+        return BasicRigidTransform(Quaternion(), PointType(tx, ty, tz));
+    }
+    static BasicRigidTransform rotationX(T radians);
+    static BasicRigidTransform rotationY(T radians);
+    static BasicRigidTransform rotationZ(T radians);
+
+    /// Extract rotation and translation from \p t.  Throws
+    /// std::invalid_argument unless t.kind() is Identity, Translation or Rigid.
+    static BasicRigidTransform fromTransform(const TransformType& t);
+
+    /// Equivalent matrix transform (kind Identity, Translation or Rigid).
+    TransformType toTransform() const;
+
+    constexpr BasicRigidTransform operator*(const BasicRigidTransform& o) const noexcept {
+        return BasicRigidTransform(m_rotation * o.m_rotation, m_rotation.rotate(o.m_translation) + m_translation);
+    }
+    constexpr PointType apply(const PointType& p) const noexcept {
+        return m_rotation.rotate(p) + m_translation;
+    }
+    /// Exact for a unit rotation: conjugate the quaternion, rotate back the translation.
+    constexpr BasicRigidTransform inverse() const noexcept {
+        const Quaternion r = m_rotation.conjugate();
+        return BasicRigidTransform(r, r.rotate(m_translation) * T(-1));
+    }
+
+    /// Rescale the rotation to unit length, e.g. every few thousand compositions.
+    BasicRigidTransform normalized() const;
+
+    /// Interpolate from \p a (t = 0) to \p b (t = 1): spherical-linear on the
+    /// shortest rotation arc, linear on the translation.
+    static BasicRigidTransform slerp(const BasicRigidTransform& a, const BasicRigidTransform& b, T t);
+
+    /// Transform every point of \p points in place.  Converts to the matrix
+    /// once and runs Transform::applyBatch(), so results equal
+    /// toTransform().apply() and may differ from apply() in the last ulps.
+    void applyBatch(Buffer& points) const;
+    void applyBatch(const Buffer& in, Buffer& out) const;
+    void applyBatch(Buffer& points, ThreadPool& pool) const;
+
+    constexpr const Quaternion& rotation()    const noexcept { return m_rotation; }
+    constexpr const PointType&  translation() const noexcept { return m_translation; }
+
+private:
+    Quaternion m_rotation;
+    PointType  m_translation;
+};
+
+using Quaternion      = BasicQuaternion<double>;
+using QuaternionF     = BasicQuaternion<float>;
+using RigidTransform  = BasicRigidTransform<double>;
+using RigidTransformF = BasicRigidTransform<float>;
+
+extern template class BasicQuaternion<float>;
+extern template class BasicQuaternion<double>;
+extern template class BasicRigidTransform<float>;
+extern template class BasicRigidTransform<double>;
+
+} // namespace geometry
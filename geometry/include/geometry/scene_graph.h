@@ -0,0 +1,99 @@
+#pragma once
+
+#include "transform.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace geometry {
+
+class ThreadPool;
+
+/// Transform hierarchy with cached world and inverse-world transforms.
+///
+/// Every node stores a local Transform relative to its parent; world(n) is
+/// parent-world * local and inverseWorld(n) its inverse.  Both are cached
+/// and recomputed lazily:
+///
+///  - setLocal() only records the node; the next update() recomputes that
+///    node's subtree and nothing else.
+///  - Nodes are stored in breadth-first order with siblings adjacent, so
+///    the part of any subtree that lies on one level is a contiguous range.
+///    update() walks the dirty ranges level by level, optionally splitting
+///    each level across a ThreadPool.  Results do not depend on the pool.
+///  - world() and inverseWorld() run update() first if anything is pending.
+///
+/// World transforms are composed as ((L0 * L1) * L2) ... from the root,
+/// bit-identical to recomposing the parent chain with operator*.  Inverse
+/// worlds are composed from cached local inverses, L_n^-1 * ... * L_0^-1.
+class SceneGraph {
+public:
+    using NodeId = std::uint32_t;
+    static constexpr NodeId NoParent = std::numeric_limits<NodeId>::max();
+
+    SceneGraph() = default;
+
+    /// Add a node under \p parent (or a new root).  Ids are dense and
+    /// assigned in creation order.  Throws std::invalid_argument for an
+    /// unknown parent and std::runtime_error if \p local is singular.
+    NodeId addNode(const Transform& local, NodeId parent = NoParent);
+
+    void reserve(std::size_t nodes);
+
+    /// Replace a node's local transform and mark its subtree dirty.
+    /// Throws std::runtime_error if \p local is singular.
+    void setLocal(NodeId node, const Transform& local);
+
+    const Transform& local(NodeId node) const { return m_local[m_pos[node]]; }
+    NodeId           parent(NodeId node) const { return m_parent[node]; }
+
+    const Transform& world(NodeId node);
+    const Transform& inverseWorld(NodeId node);
+
+    /// Recompute every dirty world / inverse-world transform.
+    void update();
+    void update(ThreadPool& pool);
+
+    std::size_t size()  const noexcept { return m_parent.size(); }
+    bool        dirty() const noexcept { return m_layoutDirty || !m_pendingRoots.empty(); }
+
+    /// Depth of the hierarchy (number of levels); valid after update().
+    std::size_t levels() const noexcept { return m_levelStart.empty() ? 0 : m_levelStart.size() - 1; }
+
+    /// Nodes recomputed by the last update().
+    std::size_t lastUpdateCount() const noexcept { return m_lastUpdated; }
+
+private:
+    using Pos = std::uint32_t;
+
+    struct Range {
+        Pos first, last;   ///< [first, last) in breadth-first positions
+    };
+
+    void relayout();
+    void collectDirty();
+    template <typename ForLevel>
+    void recompute(ForLevel&& forLevel);
+    void recomputeRange(Pos first, Pos last) noexcept;
+
+    // Indexed by NodeId.
+    std::vector<NodeId> m_parent;
+    std::vector<Pos>    m_pos;         ///< NodeId -> breadth-first position
+
+    // Indexed by breadth-first position.
+    std::vector<Transform> m_local, m_localInverse, m_world, m_inverseWorld;
+    std::vector<Pos>       m_parentPos;               ///< NoParent for roots
+    std::vector<Pos>       m_childBegin, m_childEnd;  ///< Children of each position
+    std::vector<Pos>       m_levelStart;              ///< Level l is [start[l], start[l+1])
+    std::vector<std::uint32_t> m_levelOf;
+
+    // Pending work.
+    std::vector<Pos>                m_pendingRoots;
+    std::vector<std::vector<Range>> m_dirty;          ///< Merged ranges per level
+    std::vector<std::uint8_t>       m_marked;         ///< Position already pending
+    bool                            m_layoutDirty = false;
+    std::size_t                     m_lastUpdated = 0;
+};
+
+} // namespace geometry
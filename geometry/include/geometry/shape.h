@@ -1,5 +1,6 @@
 #pragma once
 
+#include "aabb.h"
 #include "point.h"
 #include <string>
 #include <vector>
@@ -7,73 +8,126 @@
 
 namespace geometry {
 
-/// Abstract base for all 2-D / 3-D shapes.
-class Shape {
+/// Abstract base for all 2-D / 3-D shapes with coordinates of type \p T.
+/// Use the Shape / Circle / Triangle / Rectangle aliases (double) or their
+/// ...F counterparts (float).  Bounds are always reported as a double Aabb.
+template <typename T>
+class BasicShape {
 public:
-    virtual ~Shape() = default;
+    using Scalar = T;
+    using PointType = BasicPoint<T>;
 
-    virtual double      area()      const = 0;
-    virtual double      perimeter() const = 0;
+    virtual ~BasicShape() = default;
+
+    virtual T           area()      const = 0;
+    virtual T           perimeter() const = 0;
     virtual std::string name()      const = 0;
-    virtual Point       centroid()  const = 0;
+    virtual PointType   centroid()  const = 0;
+    virtual Aabb        bounds()    const = 0;
 };
 
 // ─────────────────────────────────────────────────────────────────────────────
 
-class Circle : public Shape {
+template <typename T>
+class BasicCircle : public BasicShape<T> {
 public:
-    Circle(const Point& center, double radius);
+    using PointType = BasicPoint<T>;
+
+    BasicCircle(const PointType& center, T radius);
 
-    double      area()      const override;
-    double      perimeter() const override;
+    /// Convert from the other precision.
+    template <typename U>
+    explicit BasicCircle(const BasicCircle<U>& other)
+        : BasicCircle(PointType(other.center()), static_cast<T>(other.radius())) {}
+
+    T           area()      const override;
+    T           perimeter() const override;
     std::string name()      const override;
-    Point       centroid()  const override;
+    PointType   centroid()  const override;
+    Aabb        bounds()    const override;
 
-    const Point& center() const noexcept { return m_center; }
-    double       radius() const noexcept { return m_radius; }
+    const PointType& center() const noexcept { return m_center; }
+    T                radius() const noexcept { return m_radius; }
 
 private:
-    Point  m_center;
-    double m_radius;
+    PointType m_center;
+    T         m_radius;
 };
 
 // ─────────────────────────────────────────────────────────────────────────────
 
-class Triangle : public Shape {
+template <typename T>
+class BasicTriangle : public BasicShape<T> {
 public:
-    Triangle(const Point& a, const Point& b, const Point& c);
+    using PointType = BasicPoint<T>;
+
+    BasicTriangle(const PointType& a, const PointType& b, const PointType& c);
 
-    double      area()      const override;
-    double      perimeter() const override;
+    /// Convert from the other precision.
+    template <typename U>
+    explicit BasicTriangle(const BasicTriangle<U>& other)
+        : BasicTriangle(PointType(other.a()), PointType(other.b()), PointType(other.c())) {}
+
+    T           area()      const override;
+    T           perimeter() const override;
     std::string name()      const override;
-    Point       centroid()  const override;
+    PointType   centroid()  const override;
+    Aabb        bounds()    const override;
 
-    const Point& a() const noexcept { return m_a; }
-    const Point& b() const noexcept { return m_b; }
-    const Point& c() const noexcept { return m_c; }
+    const PointType& a() const noexcept { return m_a; }
+    const PointType& b() const noexcept { return m_b; }
+    const PointType& c() const noexcept { return m_c; }
 
 private:
-    Point m_a, m_b, m_c;
+    PointType m_a, m_b, m_c;
 };
 
 // ─────────────────────────────────────────────────────────────────────────────
 
-class Rectangle : public Shape {
+template <typename T>
+class BasicRectangle : public BasicShape<T> {
 public:
+    using PointType = BasicPoint<T>;
+
     /// \p origin is the bottom-left corner; width and height extend in +X / +Y.
-    Rectangle(const Point& origin, double width, double height);
+    BasicRectangle(const PointType& origin, T width, T height);
 
-    double      area()      const override;
-    double      perimeter() const override;
+    /// Convert from the other precision.
+    template <typename U>
+    explicit BasicRectangle(const BasicRectangle<U>& other)
+        : BasicRectangle(PointType(other.origin()), static_cast<T>(other.width()),
+                         static_cast<T>(other.height())) {}
+
+    T           area()      const override;
+    T           perimeter() const override;
     std::string name()      const override;
-    Point       centroid()  const override;
+    PointType   centroid()  const override;
+    Aabb        bounds()    const override;
 
-    double width()  const noexcept { return m_width;  }
-    double height() const noexcept { return m_height; }
+    const PointType& origin() const noexcept { return m_origin; }
+    T                width()  const noexcept { return m_width;  }
+    T                height() const noexcept { return m_height; }
 
 private:
-    Point  m_origin;
-    double m_width, m_height;
+    PointType m_origin;
+    T         m_width, m_height;
 };
 
+using Shape     = BasicShape<double>;
+using Circle    = BasicCircle<double>;
+using Triangle  = BasicTriangle<double>;
+using Rectangle = BasicRectangle<double>;
+
+using ShapeF     = BasicShape<float>;
+using CircleF    = BasicCircle<float>;
+using TriangleF  = BasicTriangle<float>;
+using RectangleF = BasicRectangle<float>;
+
+extern template class BasicCircle<float>;
+extern template class BasicCircle<double>;
+extern template class BasicTriangle<float>;
+extern template class BasicTriangle<double>;
+extern template class BasicRectangle<float>;
+extern template class BasicRectangle<double>;
+
 } // namespace geometry
@@ -0,0 +1,184 @@
+#pragma once
+
+#include "shape.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace geometry {
+
+/// Non-owning pointer to a shape that lives in a ShapeArena.
+///
+/// Valid until the shape is destroyed through the arena, or the arena is
+/// reset or destroyed.  The handle carries the generation of its slot, so
+/// ShapeArena::get() and destroy() recognise a stale handle even after the
+/// slot has been reused; get() and operator-> on the handle itself are
+/// unchecked.  A handle to a derived shape converts to a handle to its base.
+template <typename S>
+class ShapeHandle {
+public:
+    ShapeHandle() noexcept = default;
+
+    template <typename D, typename = std::enable_if_t<std::is_convertible<D*, S*>::value>>
+    ShapeHandle(const ShapeHandle<D>& other) noexcept
+        : m_ptr(other.get()), m_slot(other.slot()), m_generation(other.generation()) {}
+
+    S* get()        const noexcept { return m_ptr; }
+    S* operator->() const noexcept { return m_ptr; }
+    S& operator*()  const noexcept { return *m_ptr; }
+    explicit operator bool() const noexcept { return m_ptr != nullptr; }
+
+    std::uint32_t slot()       const noexcept { return m_slot; }
+    std::uint32_t generation() const noexcept { return m_generation; }
+
+private:
+    friend class ShapeArena;
+    ShapeHandle(S* ptr, std::uint32_t slot, std::uint32_t generation) noexcept
+        : m_ptr(ptr), m_slot(slot), m_generation(generation) {}
+
+    S*            m_ptr        = nullptr;
+    std::uint32_t m_slot       = 0;
+    std::uint32_t m_generation = 0;
+};
+
+/// Region allocator for Shape objects built on std::pmr.
+///
+/// Replaces one `std::make_unique` per shape: objects are packed next to
+/// each other and torn down together by reset() or the destructor.
+///
+///  - Monotonic: bump allocation from a std::pmr::monotonic_buffer_resource.
+///    destroy() runs the destructor but the memory is only reclaimed by
+///    reset().  Use for frame-scoped or otherwise transient geometry.
+///  - Pooled: size-class pools from a std::pmr::unsynchronized_pool_resource.
+///    destroy() returns the block to its pool for reuse.  Use for
+///    long-lived shapes that come and go individually.
+///
+/// Not thread-safe; use one arena per thread.
+class ShapeArena {
+public:
+    enum class Kind { Monotonic, Pooled };
+
+    /// \p initialBytes sizes the first monotonic block (ignored for Pooled).
+    /// Both kinds draw from \p upstream.
+    explicit ShapeArena(Kind kind = Kind::Monotonic, std::size_t initialBytes = 64 * 1024,
+                        std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+    ~ShapeArena();
+
+    ShapeArena(const ShapeArena&) = delete;
+    ShapeArena& operator=(const ShapeArena&) = delete;
+
+    /// Construct an \p S (Circle, TriangleF, ...) in the arena.
+    template <typename S, typename... Args>
+    ShapeHandle<S> make(Args&&... args);
+
+    /// Destroy one shape early.  Its handle, and every copy, is stale
+    /// afterwards; destroying a stale handle does nothing.
+    template <typename S>
+    void destroy(ShapeHandle<S> handle) noexcept;
+
+    /// The shape behind \p handle, or nullptr if it has been destroyed or
+    /// the arena reset since the handle was made.
+    template <typename S>
+    S* get(ShapeHandle<S> handle) const noexcept;
+
+    /// Destroy every shape and give the memory back to the resource.
+    void reset() noexcept;
+
+    Kind        kind() const noexcept { return m_kind; }
+    std::size_t size() const noexcept { return m_live; }   ///< Live shapes
+    bool        empty() const noexcept { return m_live == 0; }
+
+    /// Call \p fn(Shape&) or \p fn(ShapeF&) on every live shape in slot
+    /// order.  That is creation order until destroy() frees a slot: the next
+    /// shape made takes the freed slot and is visited at its position.
+    template <typename Fn>
+    void forEach(Fn&& fn) const;
+
+    /// The resource shapes are allocated from, for pmr containers that
+    /// should share the arena's lifetime.
+    std::pmr::memory_resource* resource() const noexcept { return m_resource; }
+
+private:
+    struct Entry {
+        void*       memory;          ///< nullptr once destroyed
+        Shape*      shape;           ///< Set for double shapes
+        ShapeF*     shapeF;          ///< Set for float shapes
+        void      (*destroy)(void*);
+        std::size_t size;
+        std::size_t align;
+        std::uint32_t generation;    ///< Matches the handles of the current shape
+    };
+
+    void* allocate(std::size_t size, std::size_t align);
+    std::uint32_t record(const Entry& e);
+    void release(std::uint32_t slot) noexcept;
+
+    bool live(std::uint32_t slot, std::uint32_t generation) const noexcept {
+        return slot < m_entries.size() && m_entries[slot].memory && m_entries[slot].generation == generation;
+    }
+
+    template <typename S>
+    static void destroyAs(void* p) noexcept { std::launder(static_cast<S*>(p))->~S(); }
+
+    Kind                                                 m_kind;
+    std::pmr::memory_resource*                           m_upstream;
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> m_monotonic;
+    std::unique_ptr<std::pmr::unsynchronized_pool_resource> m_pool;
+    std::pmr::memory_resource*                           m_resource = nullptr;
+    std::pmr::vector<Entry>                              m_entries;
+    std::pmr::vector<std::uint32_t>                      m_freeSlots;
+    std::size_t                                          m_live = 0;
+    std::uint32_t                                        m_generation = 0;   ///< Last one handed out
+};
+
+// ── template implementation ──────────────────────────────────────────────────
+
+template <typename S, typename... Args>
+ShapeHandle<S> ShapeArena::make(Args&&... args) {
+    static_assert(std::is_base_of<Shape, S>::value || std::is_base_of<ShapeF, S>::value,
+                  "ShapeArena holds Shape or ShapeF subclasses");
+    void* mem = allocate(sizeof(S), alignof(S));
+    S* obj = nullptr;
+    try {
+        obj = ::new (mem) S(std::forward<Args>(args)...);
+        Entry e{mem, nullptr, nullptr, &destroyAs<S>, sizeof(S), alignof(S), 0};
+        if constexpr (std::is_base_of<Shape, S>::value) e.shape = obj;
+        else                                            e.shapeF = obj;
+        const std::uint32_t slot = record(e);
+        return ShapeHandle<S>(obj, slot, m_entries[slot].generation);
+    } catch (...) {
+        if (obj) obj->~S();
+        m_resource->deallocate(mem, sizeof(S), alignof(S));
+        throw;
+    }
+}
+
+template <typename S>
+void ShapeArena::destroy(ShapeHandle<S> handle) noexcept {
+    if (handle && live(handle.slot(), handle.generation())) release(handle.slot());
+}
+
+template <typename S>
+S* ShapeArena::get(ShapeHandle<S> handle) const noexcept {
+    return handle && live(handle.slot(), handle.generation()) ? handle.get() : nullptr;
+}
+
+template <typename Fn>
+void ShapeArena::forEach(Fn&& fn) const {
+    for (const Entry& e : m_entries) {
+        if (!e.memory) continue;
+        if constexpr (std::is_invocable<Fn&, Shape&>::value) {
+            if (e.shape) fn(*e.shape);
+        }
+        if constexpr (std::is_invocable<Fn&, ShapeF&>::value) {
+            if (e.shapeF) fn(*e.shapeF);
+        }
+    }
+}
+
+} // namespace geometry
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "point_buffer.h"
+#include "shape_store.h"
+#include "io/column_file.h"
+#include <cstddef>
+#include <string>
+
+namespace geometry {
+
+/// Binary, columnar persistence for point sets and shape collections.
+///
+/// Files use the io column file format (see io/column_file.h): every
+/// coordinate is stored as a full-precision double in its own 64-byte
+/// aligned column.  The Mapped* readers memory-map the file and hand out
+/// pointers straight into the mapping, so opening is O(1) in file size and
+/// pages load on first touch.
+
+constexpr const char* PointFileSchema = "geometry.points";
+constexpr const char* ShapeFileSchema = "geometry.shapes";
+
+/// Write \p points to \p path, replacing any existing file.
+void writePointFile(const std::string& path, const PointBuffer& points,
+                    const io::WriterOptions& options = {});
+
+/// Write the columns of \p shapes to \p path, replacing any existing file.
+void writeShapeFile(const std::string& path, const ShapeStore& shapes,
+                    const io::WriterOptions& options = {});
+
+/// Zero-copy point set backed by a mapped file.
+/// Throws std::runtime_error if the file is not a point file.
+class MappedPoints {
+public:
+    explicit MappedPoints(const std::string& path);
+
+    std::size_t size()  const noexcept { return m_x.size(); }
+    bool        empty() const noexcept { return m_x.empty(); }
+
+    const double* x() const noexcept { return m_x.data(); }
+    const double* y() const noexcept { return m_y.data(); }
+    const double* z() const noexcept { return m_z.data(); }
+
+    Point operator[](std::size_t i) const noexcept { return Point(m_x[i], m_y[i], m_z[i]); }
+
+    /// Copy into an owning buffer.
+    PointBuffer toBuffer() const;
+
+    const io::MappedColumnFile& file() const noexcept { return m_file; }
+
+private:
+    io::MappedColumnFile       m_file;
+    io::ColumnView<double>     m_x, m_y, m_z;
+};
+
+/// Zero-copy shape collection backed by a mapped file.  Columns mirror
+/// ShapeStore::Circles, Triangles and Rectangles.
+/// Throws std::runtime_error if the file is not a shape file.
+class MappedShapes {
+public:
+    using Column = io::ColumnView<double>;
+
+    struct Circles    { Column cx, cy, cz, r; };
+    struct Triangles  { Column ax, ay, az, bx, by, bz, cx, cy, cz; };
+    struct Rectangles { Column ox, oy, oz, w, h; };
+
+    explicit MappedShapes(const std::string& path);
+
+    std::size_t circleCount()    const noexcept { return m_circles.r.size(); }
+    std::size_t triangleCount()  const noexcept { return m_triangles.ax.size(); }
+    std::size_t rectangleCount() const noexcept { return m_rectangles.w.size(); }
+    std::size_t size() const noexcept { return circleCount() + triangleCount() + rectangleCount(); }
+
+    const Circles&    circles()    const noexcept { return m_circles; }
+    const Triangles&  triangles()  const noexcept { return m_triangles; }
+    const Rectangles& rectangles() const noexcept { return m_rectangles; }
+
+    /// Copy into an owning ShapeStore, checking every shape as add() does.
+    /// Throws std::runtime_error for a shape the store would not accept
+    /// (e.g. a non-positive radius).
+    ShapeStore toStore() const;
+
+    const io::MappedColumnFile& file() const noexcept { return m_file; }
+
+private:
+    io::MappedColumnFile m_file;
+    Circles              m_circles;
+    Triangles            m_triangles;
+    Rectangles           m_rectangles;
+};
+
+} // namespace geometry
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "point_buffer.h"
+#include "shape.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace geometry {
+
+class ThreadPool;
+
+/// Data-oriented shape collection.
+///
+/// Circles, triangles and rectangles are kept in per-type columns of plain
+/// doubles, so bulk queries run as branch-free loops over contiguous memory
+/// instead of one virtual call per heap-allocated Shape.  Bulk results are
+/// laid out in storage order: all circles, then triangles, then rectangles.
+///
+/// Triangle areas use the cross-product formula ½|AB × AC| (one sqrt)
+/// rather than Heron's formula, so they may differ from Triangle::area()
+/// in the last few ulps.
+class ShapeStore {
+public:
+    ShapeStore() = default;
+
+    /// Copy shapes out of a polymorphic collection.
+    /// Throws std::invalid_argument for Shape subclasses the store cannot hold.
+    static ShapeStore fromShapes(const std::vector<std::unique_ptr<Shape>>& shapes);
+
+    void add(const Circle& c);
+    void add(const Triangle& t);
+    void add(const Rectangle& r);
+    void add(const Shape& s);
+
+    void reserve(std::size_t circles, std::size_t triangles, std::size_t rectangles);
+    void clear() noexcept;
+
+    std::size_t circleCount()    const noexcept { return m_circles.r.size(); }
+    std::size_t triangleCount()  const noexcept { return m_triangles.ax.size(); }
+    std::size_t rectangleCount() const noexcept { return m_rectangles.w.size(); }
+    std::size_t size()           const noexcept;
+
+    Circle    circle(std::size_t i)    const;
+    Triangle  triangle(std::size_t i)  const;
+    Rectangle rectangle(std::size_t i) const;
+
+    /// Rebuild the polymorphic representation, in storage order.
+    std::vector<std::unique_ptr<Shape>> toShapes() const;
+
+    /// Fill \p out (size() entries) with per-shape values.
+    void areas(double* out)      const noexcept;
+    void perimeters(double* out) const noexcept;
+
+    std::vector<double> areas()      const;
+    std::vector<double> perimeters() const;
+    PointBuffer         centroids()  const;
+    std::vector<Aabb>   bounds()     const;
+
+    /// Centroids into a caller-owned buffer, resized to size().
+    void centroids(PointBuffer& out) const;
+
+    double totalArea()      const noexcept;
+    double totalPerimeter() const noexcept;
+
+    /// Parallel variants.  Per-shape results equal the serial ones; totals
+    /// are summed per fixed-size block and are identical for every pool
+    /// size, but may differ from the serial totals in the last few ulps.
+    void   areas(double* out, ThreadPool& pool)      const;
+    void   perimeters(double* out, ThreadPool& pool) const;
+    double totalArea(ThreadPool& pool)               const;
+    double totalPerimeter(ThreadPool& pool)          const;
+
+    struct Circles    { std::vector<double> cx, cy, cz, r; };
+    struct Triangles  { std::vector<double> ax, ay, az, bx, by, bz, cx, cy, cz; };
+    struct Rectangles { std::vector<double> ox, oy, oz, w, h; };
+
+    /// Read-only column access, e.g. for serialisation and the batched
+    /// predicates.  Shapes only enter the store through add(), which is
+    /// where their invariants are checked.
+    const Circles&    circles()    const noexcept { return m_circles; }
+    const Triangles&  triangles()  const noexcept { return m_triangles; }
+    const Rectangles& rectangles() const noexcept { return m_rectangles; }
+
+private:
+    Circles    m_circles;
+    Triangles  m_triangles;
+    Rectangles m_rectangles;
+};
+
+} // namespace geometry
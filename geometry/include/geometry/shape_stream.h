@@ -0,0 +1,120 @@
+#pragma once
+
+#include "shape.h"
+#include "transform.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace io { class FileWriter; }
+
+namespace geometry {
+
+/// Streaming reader for text shape descriptions, one record per line:
+///
+///   circle    cx cy cz r
+///   triangle  ax ay az  bx by bz  cx cy cz
+///   rectangle ox oy oz w h
+///
+/// Fields are separated by spaces or tabs; numbers may carry a leading
+/// '+' or '-'.  Blank lines and lines starting with '#' are skipped, and
+/// CRLF line endings are accepted.
+///
+/// Input is read from a file descriptor in fixed-size chunks and parsed in
+/// place with std::from_chars, so memory stays at one chunk however large
+/// the input is and no record allocates.  Malformed records, and lines
+/// longer than a chunk, throw std::runtime_error naming the line number;
+/// so do non-finite numbers and non-positive radii or sizes.
+class ShapeStreamReader {
+public:
+    static constexpr std::size_t DefaultChunkSize = 1 << 20;
+
+    /// Reads from \p fd (not closed by the reader).
+    explicit ShapeStreamReader(int fd, std::size_t chunkSize = DefaultChunkSize);
+
+    /// Parse the whole stream, calling visit(const Circle&),
+    /// visit(const Triangle&) or visit(const Rectangle&) for every record.
+    /// Returns the number of records.
+    template <typename Visitor>
+    std::size_t run(Visitor&& visit);
+
+    std::uint64_t bytesRead() const noexcept { return m_bytesRead; }
+    std::size_t   lineNumber() const noexcept { return m_line; }
+
+private:
+    enum class Kind : std::uint8_t { None, Circle, Triangle, Rectangle };
+
+    struct Record {
+        Kind   kind = Kind::None;
+        double v[9];
+    };
+
+    /// Next chunk of complete lines as [first, last); false at end of input.
+    bool nextChunk(const char*& first, const char*& last);
+    /// Parse one line (without its '\n') into \p rec; Kind::None to skip.
+    void parseLine(const char* first, const char* last, Record& rec) const;
+
+    int               m_fd;
+    std::vector<char> m_buffer;
+    std::size_t       m_tail = 0;       ///< Offset of the unfinished line in m_buffer
+    std::size_t       m_carry = 0;      ///< Its length, moved to the front by the next chunk
+    bool              m_eof = false;
+    std::uint64_t     m_bytesRead = 0;
+    std::size_t       m_line = 0;
+};
+
+/// Counters reported by transformShapeStream().
+struct ShapeStreamStats {
+    std::size_t   records = 0;
+    std::uint64_t bytesIn = 0;
+    std::uint64_t bytesOut = 0;
+};
+
+/// Read shape records from \p fd, apply \p transform to each shape's
+/// defining points (circle centre, triangle vertices, rectangle origin;
+/// sizes are kept), and write them to \p out as CSV under the header
+///
+///   name,area,perimeter,centroid_x,centroid_y,centroid_z
+///
+/// Numbers use the shortest round-trip form (std::to_chars).
+ShapeStreamStats transformShapeStream(int fd, const Transform& transform, io::FileWriter& out,
+                                      std::size_t chunkSize = ShapeStreamReader::DefaultChunkSize);
+
+// ── template implementation ──────────────────────────────────────────────────
+
+template <typename Visitor>
+std::size_t ShapeStreamReader::run(Visitor&& visit) {
+    std::size_t records = 0;
+    const char* first = nullptr;
+    const char* last = nullptr;
+    Record rec;
+    while (nextChunk(first, last)) {
+        while (first < last) {
+            const void* nl = std::memchr(first, '\n', static_cast<std::size_t>(last - first));
+            const char* eol = nl ? static_cast<const char*>(nl) : last;
+            ++m_line;
+            parseLine(first, eol, rec);
+            first = nl ? eol + 1 : last;
+
+            const double* v = rec.v;
+            switch (rec.kind) {
+                case Kind::None:
+                    continue;
+                case Kind::Circle:
+                    visit(Circle(Point(v[0], v[1], v[2]), v[3]));
+                    break;
+                case Kind::Triangle:
+                    visit(Triangle(Point(v[0], v[1], v[2]), Point(v[3], v[4], v[5]), Point(v[6], v[7], v[8])));
+                    break;
+                case Kind::Rectangle:
+                    visit(Rectangle(Point(v[0], v[1], v[2]), v[3], v[4]));
+                    break;
+            }
+            ++records;
+        }
+    }
+    return records;
+}
+
+} // namespace geometry
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace geometry {
+
+/// Work-stealing thread pool for data-parallel loops.
+///
+/// A loop over [begin, end) is cut into chunks of `grain` items.  Each
+/// worker owns a deque of chunk ranges: it splits the range it is holding
+/// in half, keeps the front half and pushes the back half to the bottom of
+/// its deque, where idle workers steal it.  The calling thread joins in
+/// until the loop is finished, so nested loops cannot deadlock.
+///
+/// Reductions are deterministic: chunk boundaries depend only on the range
+/// and grain (never on the thread count or on scheduling), each chunk is
+/// reduced serially, and the chunk results are combined left to right.
+/// The first exception thrown by a loop body is rethrown to the caller.
+class ThreadPool {
+public:
+    /// \p threads is the total parallelism including the calling thread;
+    /// 0 means std::thread::hardware_concurrency().
+    explicit ThreadPool(std::size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Process-wide pool sized to the hardware.
+    static ThreadPool& instance();
+
+    /// Worker threads plus the calling thread.
+    std::size_t concurrency() const noexcept { return m_queues.size() + 1; }
+
+    /// Call fn(first, last) for consecutive sub-ranges covering [begin, end).
+    /// \p grain 0 picks about eight chunks per thread.
+    template <typename Fn>
+    void parallelFor(std::size_t begin, std::size_t end, Fn&& fn, std::size_t grain = 0) {
+        if (end <= begin) return;
+        const std::size_t n = end - begin;
+        if (grain == 0) grain = std::max<std::size_t>(1, n / (concurrency() * 8));
+        const std::size_t chunks = (n + grain - 1) / grain;
+        run(chunks, [&](std::size_t c) {
+            const std::size_t first = begin + c * grain;
+            fn(first, std::min(end, first + grain));
+        });
+    }
+
+    /// Reduce [begin, end): map(first, last) -> T per chunk, then fold the
+    /// chunk results in order with combine(T, T) starting from \p init.
+    /// \p grain 0 picks a size that depends only on the range length, so
+    /// the result is identical for every pool size.
+    template <typename T, typename Map, typename Combine>
+    T parallelReduce(std::size_t begin, std::size_t end, T init, Map&& map, Combine&& combine,
+                     std::size_t grain = 0) {
+        if (end <= begin) return init;
+        const std::size_t n = end - begin;
+        if (grain == 0) grain = std::max<std::size_t>(DefaultReduceGrain, n / 1024);
+        const std::size_t chunks = (n + grain - 1) / grain;
+        std::vector<T> partial(chunks, init);
+        run(chunks, [&](std::size_t c) {
+            const std::size_t first = begin + c * grain;
+            partial[c] = map(first, std::min(end, first + grain));
+        });
+        T acc = init;
+        for (const T& p : partial) acc = combine(acc, p);
+        return acc;
+    }
+
+    /// out[i] = fn(in[i]) for every element of [first, last).
+    template <typename InIt, typename OutIt, typename Fn>
+    void parallelTransform(InIt first, InIt last, OutIt out, Fn&& fn, std::size_t grain = 0) {
+        const auto n = static_cast<std::size_t>(std::distance(first, last));
+        parallelFor(0, n, [&](std::size_t b, std::size_t e) {
+            for (std::size_t i = b; i < e; ++i) out[i] = fn(first[i]);
+        }, grain);
+    }
+
+    static constexpr std::size_t DefaultReduceGrain = 2048;
+
+private:
+    struct Job;
+
+    struct Task {
+        Job*        job;
+        std::size_t first, last;   ///< Chunk indices
+    };
+
+    struct alignas(64) Queue {
+        std::mutex       mutex;
+        std::deque<Task> tasks;
+    };
+
+    /// Run body(c) for every chunk c in [0, chunks) and wait.
+    void run(std::size_t chunks, const std::function<void(std::size_t)>& body);
+
+    void push(std::size_t queue, const Task& task);
+    bool pop(std::size_t self, Task& task);
+    void execute(std::size_t self, Task task);
+    void workerLoop(std::size_t self);
+
+    std::vector<std::unique_ptr<Queue>> m_queues;   ///< One per worker
+    std::vector<std::thread>            m_workers;
+
+    std::atomic<std::size_t> m_queued{0};
+    std::atomic<std::size_t> m_sleeping{0};
+    std::atomic<bool>        m_stop{false};
+    std::mutex               m_sleepMutex;
+    std::condition_variable  m_wake;
+};
+
+} // namespace geometry
@@ -2,29 +2,234 @@
 
 #include "point.h"
 #include <array>
+#include <cstddef>
+#include <vector>
 
 namespace geometry {
 
-/// 4×4 column-major transformation matrix.
-class Transform {
+template <typename T> class BasicPointBuffer;
+class ThreadPool;
+
+/// Structural class of a Transform, from cheapest to most general.
+///
+/// Every kind is also a valid instance of all kinds after it; compose,
+/// apply and inverse pick the cheapest algorithm that is valid for it.
+enum class TransformKind {
+    Identity,     ///< No-op
+    Translation,  ///< Pure translation
+    Scale,        ///< Axis-aligned scale about the origin
+    Rigid,        ///< Rotation followed by translation
+    Affine,       ///< Any 3×3 linear map plus translation
+    Projective    ///< Bottom row differs from (0, 0, 0, 1)
+};
+
+namespace detail {
+
+template <typename T>
+using BasicMat4 = std::array<std::array<T, 4>, 4>;
+using Mat4 = BasicMat4<double>;
+
+template <typename T = double>
+constexpr BasicMat4<T> zero4x4() noexcept {
+    return BasicMat4<T>{};
+}
+
+template <typename T = double>
+constexpr BasicMat4<T> identity4x4() noexcept {
+    BasicMat4<T> m{};
+    m[0][0] = m[1][1] = m[2][2] = m[3][3] = T(1);
+    return m;
+}
+
+constexpr bool isAffine(TransformKind k) noexcept {
+    return k != TransformKind::Projective;
+}
+
+/// Kind of the product of two transforms of kinds \p a and \p b.
+constexpr TransformKind composeKind(TransformKind a, TransformKind b) noexcept {
+    using K = TransformKind;
+    if (a == K::Identity) return b;
+    if (b == K::Identity) return a;
+    if (a == b) return a;
+    if ((a == K::Translation || a == K::Rigid) &&
+        (b == K::Translation || b == K::Rigid))
+        return K::Rigid;
+    if (isAffine(a) && isAffine(b)) return K::Affine;
+    return K::Projective;
+}
+
+} // namespace detail
+
+/// 4×4 column-major transformation matrix with entries of type \p T
+/// (float or double).  Use the Transform / TransformF aliases.
+///
+/// Construction, the identity / translation / scale factories, composition
+/// and apply() are constexpr, so fixed transforms can be built and folded
+/// at compile time.  See transform_chain.h for lazily composed chains.
+template <typename T>
+class BasicTransform {
 public:
-    Transform();                          ///< Identity
-    static Transform identity();
-    static Transform translation(double tx, double ty, double tz);
-    static Transform scale(double sx, double sy, double sz);
-    static Transform rotationX(double radians);
-    static Transform rotationY(double radians);
-    static Transform rotationZ(double radians);
-
-    Transform operator*(const Transform& other) const;
-    Point     apply(const Point& p)             const;
-    Transform inverse()                         const;
+    using Scalar = T;
+    using Matrix = detail::BasicMat4<T>;
+    using PointType = BasicPoint<T>;
+    using Buffer = BasicPointBuffer<T>;
+
+    constexpr BasicTransform() noexcept : m(detail::identity4x4<T>()) {}   ///< Identity
+
+    /// Convert from the other precision; the kind is kept as is.
+    template <typename U>
+    constexpr explicit BasicTransform(const BasicTransform<U>& other) noexcept
+        : m(), m_kind(other.kind())
+    {
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j)
+                m[i][j] = static_cast<T>(other.matrix()[i][j]);
+    }
+
+    static constexpr BasicTransform identity() noexcept { return BasicTransform{}; }
+    static constexpr BasicTransform translation(T tx, T ty, T tz) noexcept;
+    static constexpr BasicTransform scale(T sx, T sy, T sz) noexcept;
+    static BasicTransform rotationX(T radians);
+    static BasicTransform rotationY(T radians);
+    static BasicTransform rotationZ(T radians);
+
+    /// Wrap an arbitrary row-major matrix; its kind is inferred from the values.
+    static BasicTransform fromMatrix(const Matrix& data);
+
+    constexpr BasicTransform operator*(const BasicTransform& other) const noexcept;
+    constexpr PointType      apply(const PointType& p)              const noexcept;
+    BasicTransform           inverse()                              const;
+
+    /// Transform every point of \p points in place.
+    ///
+    /// Uses AVX2 or SSE2 kernels picked at runtime, with a scalar fallback;
+    /// float kernels process twice as many lanes per instruction.  Each lane
+    /// performs the same IEEE operations in the same order as apply() (no
+    /// FMA contraction), so results match apply() bit-for-bit.
+    void applyBatch(Buffer& points) const;
+
+    /// Out-of-place variant; \p out is resized to match \p in.
+    void applyBatch(const Buffer& in, Buffer& out) const;
+
+    /// Variant reading from caller-owned columns (e.g. a MappedPoints file).
+    void applyBatch(const T* x, const T* y, const T* z, std::size_t n, Buffer& out) const;
+
+    /// Parallel variants: the points are split into blocks across \p pool.
+    /// Results are identical to the serial versions.
+    void applyBatch(Buffer& points, ThreadPool& pool) const;
+    void applyBatch(const Buffer& in, Buffer& out, ThreadPool& pool) const;
+
+    /// out[i] = in[i].inverse() for every transform, split across \p pool.
+    /// Throws std::runtime_error if any of them is singular.
+    static void inverseBatch(const std::vector<BasicTransform>& in, std::vector<BasicTransform>& out,
+                             ThreadPool& pool);
+
+    constexpr TransformKind kind()   const noexcept { return m_kind; }
+    constexpr const Matrix& matrix() const noexcept { return m; }
 
 private:
     // Row-major storage: m[row][col]
-    std::array<std::array<double, 4>, 4> m;
+    Matrix        m;
+    TransformKind m_kind{TransformKind::Identity};
 
-    explicit Transform(const std::array<std::array<double, 4>, 4>& data);
+    constexpr BasicTransform(const Matrix& data, TransformKind kind) noexcept : m(data), m_kind(kind) {}
 };
 
+using Transform  = BasicTransform<double>;
+using TransformF = BasicTransform<float>;
+
+extern template class BasicTransform<float>;
+extern template class BasicTransform<double>;
+
+// ── constexpr implementation ─────────────────────────────────────────────────
+
+template <typename T>
+constexpr BasicTransform<T> BasicTransform<T>::translation(T tx, T ty, T tz) noexcept {
+    Matrix d = detail::identity4x4<T>();
+    d[0][3] = tx;
+    d[1][3] = ty;
+    d[2][3] = tz;
+    return BasicTransform(d, TransformKind::Translation);
+}
+
+template <typename T>
+constexpr BasicTransform<T> BasicTransform<T>::scale(T sx, T sy, T sz) noexcept {
+    Matrix d = detail::identity4x4<T>();
+    d[0][0] = sx;
+    d[1][1] = sy;
+    d[2][2] = sz;
+    return BasicTransform(d, TransformKind::Scale);
+}
+
+template <typename T>
+constexpr BasicTransform<T> BasicTransform<T>::operator*(const BasicTransform& other) const noexcept {
+    using K = TransformKind;
+    const K kind = detail::composeKind(m_kind, other.m_kind);
+
+    if (m_kind == K::Identity) return other;
+    if (other.m_kind == K::Identity) return *this;
+
+    if (m_kind == K::Translation && other.m_kind == K::Translation) {
+        Matrix res = m;
+        for (int i = 0; i < 3; ++i) res[i][3] += other.m[i][3];
+        return BasicTransform(res, kind);
+    }
+
+    if (m_kind == K::Scale && other.m_kind == K::Scale) {
+        Matrix res = m;
+        for (int i = 0; i < 3; ++i) res[i][i] *= other.m[i][i];
+        return BasicTransform(res, kind);
+    }
+
+    if (detail::isAffine(kind)) {
+        // Both bottom rows are (0, 0, 0, 1): only the top 3×4 block changes.
+        Matrix res = detail::identity4x4<T>();
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 4; ++j) {
+                T v = m[i][0] * other.m[0][j]
+                    + m[i][1] * other.m[1][j]
+                    + m[i][2] * other.m[2][j];
+                if (j == 3) v += m[i][3];
+                res[i][j] = v;
+            }
+        }
+        return BasicTransform(res, kind);
+    }
+
+    Matrix res = detail::zero4x4<T>();
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+            for (int k = 0; k < 4; ++k)
+                res[i][j] += m[i][k] * other.m[k][j];
+    return BasicTransform(res, kind);
+}
+
+template <typename T>
+constexpr BasicPoint<T> BasicTransform<T>::apply(const PointType& p) const noexcept {
+    switch (m_kind) {
+        case TransformKind::Identity:
+            return p;
+        case TransformKind::Translation:
+            return PointType(p.x() + m[0][3], p.y() + m[1][3], p.z() + m[2][3]);
+        case TransformKind::Scale:
+            return PointType(p.x() * m[0][0], p.y() * m[1][1], p.z() * m[2][2]);
+        case TransformKind::Rigid:
+        case TransformKind::Affine:
+            // w is exactly 1: skip the perspective divide.
+            return PointType(
+                m[0][0]*p.x() + m[0][1]*p.y() + m[0][2]*p.z() + m[0][3],
+                m[1][0]*p.x() + m[1][1]*p.y() + m[1][2]*p.z() + m[1][3],
+                m[2][0]*p.x() + m[2][1]*p.y() + m[2][2]*p.z() + m[2][3]
+            );
+        case TransformKind::Projective:
+            break;
+    }
+    const T w = m[3][0]*p.x() + m[3][1]*p.y() + m[3][2]*p.z() + m[3][3];
+    return PointType(
+        (m[0][0]*p.x() + m[0][1]*p.y() + m[0][2]*p.z() + m[0][3]) / w,
+        (m[1][0]*p.x() + m[1][1]*p.y() + m[1][2]*p.z() + m[1][3]) / w,
+        (m[2][0]*p.x() + m[2][1]*p.y() + m[2][2]*p.z() + m[2][3]) / w
+    );
+}
+
 } // namespace geometry
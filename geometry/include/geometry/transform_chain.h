@@ -0,0 +1,98 @@
+#pragma once
+
+#include "point_buffer.h"
+#include "transform.h"
+#include <array>
+#include <cstddef>
+
+namespace geometry {
+
+/// A product of transforms that is not evaluated until it is used.
+///
+/// `lazy(a) * b * c` (or `chain(a, b, c)`) stores the factors by value and
+/// costs nothing to build.  The product then either
+///
+///  - applies itself to a point step by step — c, then b, then a — using
+///    each factor's kind-specialised apply(), so no 4×4 product is ever
+///    formed (N matrix-vector products instead of N-1 matrix-matrix ones);
+///  - or fuses into a single Transform with eval(), which left-folds
+///    operator* and is bit-identical to writing `a * b * c` eagerly.
+///
+/// Step-by-step apply() rounds differently from eval().apply(); both are
+/// within a few ulps of the exact product.  Everything except applyBatch()
+/// is constexpr, so a fixed pipeline can be folded at compile time:
+///
+///   constexpr Transform toWorld = (lazy(Transform::translation(1, 0, 0))
+///                                  * Transform::scale(2, 2, 2)).eval();
+///
+/// \p T selects the precision of the factors (see BasicTransform).
+template <std::size_t N, typename T = double>
+class TransformChain {
+    static_assert(N > 0, "TransformChain needs at least one factor");
+
+public:
+    using TransformType = BasicTransform<T>;
+    using PointType = BasicPoint<T>;
+
+    constexpr explicit TransformChain(const std::array<TransformType, N>& factors) noexcept
+        : m_factors(factors) {}
+
+    static constexpr std::size_t size() noexcept { return N; }
+    constexpr const TransformType& operator[](std::size_t i) const noexcept { return m_factors[i]; }
+
+    /// Apply the chain to \p p right to left without composing matrices.
+    constexpr PointType apply(const PointType& p) const noexcept {
+        PointType q = p;
+        for (std::size_t i = N; i-- > 0;) q = m_factors[i].apply(q);
+        return q;
+    }
+
+    /// Fuse the chain into one Transform.
+    constexpr TransformType eval() const noexcept {
+        TransformType t = m_factors[0];
+        for (std::size_t i = 1; i < N; ++i) t = t * m_factors[i];
+        return t;
+    }
+
+    constexpr operator TransformType() const noexcept { return eval(); }
+
+    /// Fuse once, then run the SIMD batch kernel over every point.
+    void applyBatch(BasicPointBuffer<T>& points) const { eval().applyBatch(points); }
+    void applyBatch(const BasicPointBuffer<T>& in, BasicPointBuffer<T>& out) const {
+        eval().applyBatch(in, out);
+    }
+
+    constexpr TransformChain<N + 1, T> operator*(const TransformType& rhs) const noexcept {
+        std::array<TransformType, N + 1> f{};
+        for (std::size_t i = 0; i < N; ++i) f[i] = m_factors[i];
+        f[N] = rhs;
+        return TransformChain<N + 1, T>(f);
+    }
+
+    template <std::size_t M>
+    constexpr TransformChain<N + M, T> operator*(const TransformChain<M, T>& rhs) const noexcept {
+        std::array<TransformType, N + M> f{};
+        for (std::size_t i = 0; i < N; ++i) f[i] = m_factors[i];
+        for (std::size_t i = 0; i < M; ++i) f[N + i] = rhs[i];
+        return TransformChain<N + M, T>(f);
+    }
+
+private:
+    std::array<TransformType, N> m_factors;
+};
+
+/// Start a lazy chain: `lazy(a) * b * c`.
+template <typename T>
+constexpr TransformChain<1, T> lazy(const BasicTransform<T>& t) noexcept {
+    return TransformChain<1, T>(std::array<BasicTransform<T>, 1>{t});
+}
+
+/// Build a lazy chain from its factors, leftmost first.
+template <typename T, typename... Ts>
+constexpr TransformChain<1 + sizeof...(Ts), T> chain(const BasicTransform<T>& first,
+                                                     const Ts&... rest) noexcept {
+    return TransformChain<1 + sizeof...(Ts), T>(
+        std::array<BasicTransform<T>, 1 + sizeof...(Ts)>{first, rest...});
+}
+
+} // namespace geometry
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "point_buffer.h"
+#include "shape.h"
+#include "transform.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace geometry {
+
+class ThreadPool;
+
+/// Indexed triangle mesh: one shared SoA vertex buffer plus an index
+/// buffer holding three vertex indices per face.
+///
+/// Shared vertices are stored once, and a whole-mesh transform is one
+/// Transform::applyBatch() over the vertex columns.  Face kernels gather a
+/// block of faces into local columns and then run branch-free loops over
+/// them, so the arithmetic vectorises even though the vertex loads are
+/// indexed.  Face areas use ½|AB × AC| (one square root per face) and
+/// match ShapeStore's triangle areas.
+class TriangleMesh {
+public:
+    using Index = std::uint32_t;
+
+    TriangleMesh() = default;
+
+    /// Adopt existing buffers.  Throws std::invalid_argument if the index
+    /// count is not a multiple of three or an index is out of range.
+    TriangleMesh(PointBuffer vertices, std::vector<Index> indices);
+
+    Index addVertex(const Point& p);
+    /// Throws std::invalid_argument if an index is out of range.
+    void  addFace(Index a, Index b, Index c);
+    void  reserve(std::size_t vertices, std::size_t faces);
+
+    std::size_t vertexCount() const noexcept { return m_vertices.size(); }
+    std::size_t faceCount()   const noexcept { return m_indices.size() / 3; }
+
+    const PointBuffer&        vertices() const noexcept { return m_vertices; }
+    const std::vector<Index>& indices()  const noexcept { return m_indices; }
+
+    Point    vertex(Index i) const noexcept { return m_vertices[i]; }
+    Triangle face(std::size_t f) const;
+
+    /// Fill \p out (faceCount() entries) with per-face areas.
+    void                faceAreas(double* out) const noexcept;
+    std::vector<double> faceAreas() const;
+
+    /// Unit face normals (right-hand rule, A→B→C); zero for degenerate faces.
+    void faceNormals(PointBuffer& out) const;
+
+    /// Unit vertex normals: the area-weighted sum of adjacent face normals,
+    /// normalised.  Zero for vertices with no non-degenerate face.
+    void vertexNormals(PointBuffer& out) const;
+
+    double surfaceArea() const noexcept;
+
+    /// Area-weighted centroid of the surface.
+    /// Throws std::domain_error if the surface area is zero.
+    Point centroid() const;
+
+    /// Transform every vertex in place.
+    void transform(const Transform& t);
+
+    /// Parallel variants.  Per-face results and transformed vertices equal
+    /// the serial ones; totals are summed per fixed-size block and are
+    /// identical for every pool size, but may differ from the serial totals
+    /// in the last few ulps.
+    void   faceAreas(double* out, ThreadPool& pool) const;
+    void   faceNormals(PointBuffer& out, ThreadPool& pool) const;
+    double surfaceArea(ThreadPool& pool) const;
+    Point  centroid(ThreadPool& pool) const;
+    void   transform(const Transform& t, ThreadPool& pool);
+
+private:
+    PointBuffer        m_vertices;
+    std::vector<Index> m_indices;
+};
+
+} // namespace geometry
@@ -0,0 +1,359 @@
+#include "geometry/bvh.h"
+#include <algorithm>
+#include <future>
+#include <stdexcept>
+#include <thread>
+
+namespace geometry {
+
+// ── builder ──────────────────────────────────────────────────────────────────
+
+class BVH::Builder {
+public:
+    Builder(const std::vector<Aabb>& bounds, std::vector<std::uint32_t>& order,
+            const Options& opts)
+        : m_bounds(bounds), m_order(order), m_opts(opts)
+    {
+        m_centroid.resize(bounds.size() * 3);
+        for (std::size_t i = 0; i < bounds.size(); ++i)
+            for (int a = 0; a < 3; ++a)
+                m_centroid[i * 3 + a] = (bounds[i].lo(a) + bounds[i].hi(a)) * 0.5;
+
+        unsigned threads = opts.threads != 0 ? opts.threads
+                                             : std::max(1u, std::thread::hardware_concurrency());
+        while (threads > 1) {
+            threads = (threads + 1) / 2;
+            ++m_parallelDepth;
+        }
+        m_bins = std::max(2, opts.bins);
+    }
+
+    /// Append the subtree for m_order[begin, end) to \p nodes.
+    void build(std::uint32_t begin, std::uint32_t end, int depth,
+               std::vector<Node>& nodes, std::uint32_t parent)
+    {
+        const std::uint32_t self = static_cast<std::uint32_t>(nodes.size());
+        nodes.emplace_back();
+        nodes[self].parent = parent;
+
+        Aabb box, centroidBox;
+        for (std::uint32_t i = begin; i < end; ++i) {
+            const std::uint32_t prim = m_order[i];
+            box.expand(m_bounds[prim]);
+            centroidBox.expand(centroidOf(prim));
+        }
+        nodes[self].box = box;
+
+        const std::uint32_t count = end - begin;
+        if (count <= m_opts.maxLeafSize || depth >= MaxDepth) {
+            makeLeaf(nodes[self], begin, count);
+            return;
+        }
+
+        std::uint32_t mid = depth < MaxSahDepth
+            ? sahPartition(begin, end, box, centroidBox)
+            : begin;
+        if (mid == begin || mid == end) mid = medianPartition(begin, end, centroidBox);
+
+        const bool parallel = depth < m_parallelDepth && count >= ParallelThreshold;
+        if (!parallel) {
+            build(begin, mid, depth + 1, nodes, self);
+            nodes[self].right = static_cast<std::uint32_t>(nodes.size());
+            build(mid, end, depth + 1, nodes, self);
+            return;
+        }
+
+        // Build the right subtree on another thread into its own array, then
+        // splice it in after the left subtree and rebase its indices.
+        std::vector<Node> rightNodes;
+        auto rightTask = std::async(std::launch::async, [&] {
+            build(mid, end, depth + 1, rightNodes, 0);
+        });
+        build(begin, mid, depth + 1, nodes, self);
+        rightTask.get();
+
+        const std::uint32_t offset = static_cast<std::uint32_t>(nodes.size());
+        for (Node& n : rightNodes) {
+            if (n.count == 0) n.right += offset;
+            n.parent += offset;
+        }
+        rightNodes.front().parent = self;
+        nodes[self].right = offset;
+        nodes.insert(nodes.end(), rightNodes.begin(), rightNodes.end());
+    }
+
+private:
+    static constexpr std::uint32_t ParallelThreshold = 16384;
+
+    const std::vector<Aabb>&    m_bounds;
+    std::vector<std::uint32_t>& m_order;
+    const Options&              m_opts;
+    std::vector<double>         m_centroid;
+    int                         m_bins = 16;
+    int                         m_parallelDepth = 0;
+
+    Point centroidOf(std::uint32_t prim) const {
+        return Point(m_centroid[prim * 3], m_centroid[prim * 3 + 1], m_centroid[prim * 3 + 2]);
+    }
+
+    static void makeLeaf(Node& n, std::uint32_t begin, std::uint32_t count) {
+        n.first = begin;
+        n.count = count;
+    }
+
+    int binOf(std::uint32_t prim, int axis, double lo, double scale) const {
+        const int b = static_cast<int>((m_centroid[prim * 3 + axis] - lo) * scale);
+        return std::min(std::max(b, 0), m_bins - 1);
+    }
+
+    /// Binned SAH over all three axes; returns the split position, or
+    /// \p begin if no split beats keeping the range together.
+    std::uint32_t sahPartition(std::uint32_t begin, std::uint32_t end,
+                               const Aabb& box, const Aabb& centroidBox)
+    {
+        struct Bin { Aabb box; std::uint32_t count = 0; };
+        std::vector<Bin>    bins(m_bins);
+        std::vector<double> rightCost(m_bins);
+
+        double bestCost = static_cast<double>(end - begin) * box.halfArea();
+        int bestAxis = -1, bestSplit = 0;
+
+        for (int axis = 0; axis < 3; ++axis) {
+            const double lo = centroidBox.lo(axis);
+            const double extent = centroidBox.hi(axis) - lo;
+            if (!(extent > 0.0)) continue;
+            const double scale = m_bins / extent;
+
+            std::fill(bins.begin(), bins.end(), Bin{});
+            for (std::uint32_t i = begin; i < end; ++i) {
+                const std::uint32_t prim = m_order[i];
+                Bin& b = bins[binOf(prim, axis, lo, scale)];
+                b.box.expand(m_bounds[prim]);
+                ++b.count;
+            }
+
+            // rightCost[s] = cost of bins [s, m_bins)
+            Aabb acc;
+            std::uint32_t n = 0;
+            for (int s = m_bins - 1; s > 0; --s) {
+                acc.expand(bins[s].box);
+                n += bins[s].count;
+                rightCost[s] = n * acc.halfArea();
+            }
+            acc = Aabb{};
+            n = 0;
+            for (int s = 1; s < m_bins; ++s) {
+                acc.expand(bins[s - 1].box);
+                n += bins[s - 1].count;
+                const double cost = n * acc.halfArea() + rightCost[s];
+                if (cost < bestCost) {
+                    bestCost  = cost;
+                    bestAxis  = axis;
+                    bestSplit = s;
+                }
+            }
+        }
+
+        if (bestAxis < 0) return begin;
+        const double lo = centroidBox.lo(bestAxis);
+        const double scale = m_bins / (centroidBox.hi(bestAxis) - lo);
+        auto it = std::partition(m_order.begin() + begin, m_order.begin() + end,
+            [&](std::uint32_t prim) { return binOf(prim, bestAxis, lo, scale) < bestSplit; });
+        return static_cast<std::uint32_t>(it - m_order.begin());
+    }
+
+    std::uint32_t medianPartition(std::uint32_t begin, std::uint32_t end,
+                                  const Aabb& centroidBox)
+    {
+        int axis = 0;
+        double best = -1.0;
+        for (int a = 0; a < 3; ++a) {
+            const double extent = centroidBox.hi(a) - centroidBox.lo(a);
+            if (extent > best) { best = extent; axis = a; }
+        }
+        const std::uint32_t mid = begin + (end - begin) / 2;
+        std::nth_element(m_order.begin() + begin, m_order.begin() + mid, m_order.begin() + end,
+            [&](std::uint32_t l, std::uint32_t r) {
+                return m_centroid[l * 3 + axis] < m_centroid[r * 3 + axis];
+            });
+        return mid;
+    }
+};
+
+// ── construction ─────────────────────────────────────────────────────────────
+
+BVH::BVH(std::vector<Aabb> bounds, const Options& opts) {
+    build(std::move(bounds), opts);
+}
+
+BVH::BVH(const std::vector<std::unique_ptr<Shape>>& shapes, const Options& opts) {
+    std::vector<Aabb> bounds;
+    bounds.reserve(shapes.size());
+    for (const auto& s : shapes) bounds.push_back(s->bounds());
+    build(std::move(bounds), opts);
+}
+
+void BVH::build(std::vector<Aabb> bounds, const Options& opts) {
+    if (bounds.size() >= std::numeric_limits<std::uint32_t>::max())
+        throw std::length_error("BVH: too many primitives");
+
+    m_bounds = std::move(bounds);
+    m_nodes.clear();
+    m_order.resize(m_bounds.size());
+    for (std::uint32_t i = 0; i < m_order.size(); ++i) m_order[i] = i;
+    m_leafOf.assign(m_bounds.size(), 0);
+    if (m_bounds.empty()) return;
+
+    m_nodes.reserve(2 * m_bounds.size() / std::max<std::size_t>(1, opts.maxLeafSize) + 1);
+    Builder builder(m_bounds, m_order, opts);
+    builder.build(0, static_cast<std::uint32_t>(m_order.size()), 0, m_nodes, 0);
+
+    for (std::uint32_t n = 0; n < m_nodes.size(); ++n) {
+        const Node& node = m_nodes[n];
+        for (std::uint32_t i = node.first; i < node.first + node.count; ++i)
+            m_leafOf[m_order[i]] = n;
+    }
+}
+
+// ── refit ────────────────────────────────────────────────────────────────────
+
+void BVH::refit(const std::vector<Aabb>& bounds) {
+    if (bounds.size() != m_bounds.size())
+        throw std::invalid_argument("BVH::refit: primitive count changed");
+    m_bounds = bounds;
+
+    // Children always follow their parent, so a reverse sweep is bottom-up.
+    for (std::size_t n = m_nodes.size(); n-- > 0;) {
+        Node& node = m_nodes[n];
+        Aabb box;
+        if (node.count > 0) {
+            for (std::uint32_t i = node.first; i < node.first + node.count; ++i)
+                box.expand(m_bounds[m_order[i]]);
+        } else {
+            box.expand(m_nodes[n + 1].box);
+            box.expand(m_nodes[node.right].box);
+        }
+        node.box = box;
+    }
+}
+
+void BVH::update(std::size_t primitive, const Aabb& bounds) {
+    m_bounds.at(primitive) = bounds;
+
+    std::uint32_t n = m_leafOf[primitive];
+    Node& leaf = m_nodes[n];
+    Aabb box;
+    for (std::uint32_t i = leaf.first; i < leaf.first + leaf.count; ++i)
+        box.expand(m_bounds[m_order[i]]);
+    leaf.box = box;
+
+    while (n != 0) {
+        n = m_nodes[n].parent;
+        Node& node = m_nodes[n];
+        Aabb merged = m_nodes[n + 1].box;
+        merged.expand(m_nodes[node.right].box);
+        node.box = merged;
+    }
+}
+
+// ── queries ──────────────────────────────────────────────────────────────────
+
+void BVH::query(const Aabb& box, std::vector<std::size_t>& out) const {
+    if (m_nodes.empty()) return;
+    std::uint32_t stack[MaxDepth + 2];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const std::uint32_t n = stack[--top];
+        const Node& node = m_nodes[n];
+        if (!node.box.overlaps(box)) continue;
+        if (node.count > 0) {
+            for (std::uint32_t i = node.first; i < node.first + node.count; ++i)
+                if (m_bounds[m_order[i]].overlaps(box)) out.push_back(m_order[i]);
+        } else {
+            stack[top++] = node.right;
+            stack[top++] = n + 1;
+        }
+    }
+}
+
+void BVH::query(const Point& p, std::vector<std::size_t>& out) const {
+    if (m_nodes.empty()) return;
+    std::uint32_t stack[MaxDepth + 2];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const std::uint32_t n = stack[--top];
+        const Node& node = m_nodes[n];
+        if (!node.box.contains(p)) continue;
+        if (node.count > 0) {
+            for (std::uint32_t i = node.first; i < node.first + node.count; ++i)
+                if (m_bounds[m_order[i]].contains(p)) out.push_back(m_order[i]);
+        } else {
+            stack[top++] = node.right;
+            stack[top++] = n + 1;
+        }
+    }
+}
+
+namespace {
+
+/// Slab test.  Axes with a zero direction component only check that the
+/// origin lies within the slab, avoiding 0 × inf.
+bool rayHitsBox(const Aabb& box, const double o[3], const double inv[3],
+                const bool parallel[3], double tMax)
+{
+    double t0 = 0.0, t1 = tMax;
+    for (int a = 0; a < 3; ++a) {
+        if (parallel[a]) {
+            if (o[a] < box.lo(a) || o[a] > box.hi(a)) return false;
+            continue;
+        }
+        double tn = (box.lo(a) - o[a]) * inv[a];
+        double tf = (box.hi(a) - o[a]) * inv[a];
+        if (tn > tf) std::swap(tn, tf);
+        t0 = std::max(t0, tn);
+        t1 = std::min(t1, tf);
+        if (t0 > t1) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+void BVH::raycastBounds(const Point& origin, const Point& dir, std::vector<std::size_t>& out,
+                        double tMax) const
+{
+    if (m_nodes.empty()) return;
+    const double o[3] = {origin.x(), origin.y(), origin.z()};
+    const double d[3] = {dir.x(), dir.y(), dir.z()};
+    double inv[3];
+    bool parallel[3];
+    for (int a = 0; a < 3; ++a) {
+        parallel[a] = d[a] == 0.0;
+        inv[a] = parallel[a] ? 0.0 : 1.0 / d[a];
+    }
+
+    std::uint32_t stack[MaxDepth + 2];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const std::uint32_t n = stack[--top];
+        const Node& node = m_nodes[n];
+        if (!rayHitsBox(node.box, o, inv, parallel, tMax)) continue;
+        if (node.count > 0) {
+            for (std::uint32_t i = node.first; i < node.first + node.count; ++i)
+                if (rayHitsBox(m_bounds[m_order[i]], o, inv, parallel, tMax))
+                    out.push_back(m_order[i]);
+        } else {
+            stack[top++] = node.right;
+            stack[top++] = n + 1;
+        }
+    }
+}
+
+std::size_t BVH::nearestBounds(const Point& p) const {
+    return nearest(p, [&](std::size_t i) { return std::sqrt(m_bounds[i].distanceSquared(p)); });
+}
+
+} // namespace geometry
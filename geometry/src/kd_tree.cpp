@@ -0,0 +1,345 @@
+#include "geometry/kd_tree.h"
+#include "geometry/thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace geometry {
+
+namespace {
+
+/// A point being sorted into place during the build.
+struct Entry {
+    double        c[3];
+    std::uint32_t index;
+};
+
+/// Column range [first, last) of node \p j on level \p level, and the split
+/// position between its children.
+struct NodeRange {
+    std::size_t first, mid, last;
+};
+
+NodeRange nodeRange(std::size_t n, int level, std::size_t j) noexcept {
+    const auto at = [n](std::uint64_t num, int shift) {
+        return static_cast<std::size_t>((num * n) >> shift);
+    };
+    return {at(j, level), at(2 * j + 1, level + 1), at(j + 1, level)};
+}
+
+} // namespace
+
+// ── construction ─────────────────────────────────────────────────────────────
+
+KdTree::KdTree(const PointBuffer& points, std::size_t leafSize) {
+    build(points, leafSize);
+}
+
+KdTree::KdTree(const PointBuffer& points, ThreadPool& pool, std::size_t leafSize) {
+    build(points, pool, leafSize);
+}
+
+void KdTree::build(const PointBuffer& points, std::size_t leafSize) {
+    buildImpl(points, nullptr, leafSize);
+}
+
+void KdTree::build(const PointBuffer& points, ThreadPool& pool, std::size_t leafSize) {
+    buildImpl(points, &pool, leafSize);
+}
+
+void KdTree::buildImpl(const PointBuffer& points, ThreadPool* pool, std::size_t leafSize) {
+    if (leafSize == 0) throw std::invalid_argument("KdTree: leaf size must be positive");
+    const std::size_t n = points.size();
+    if (n > std::numeric_limits<std::uint32_t>::max()) throw std::length_error("KdTree: too many points");
+
+    auto forEach = [pool](std::size_t count, auto&& fn) {
+        if (pool) pool->parallelFor(0, count, fn);
+        else if (count > 0) fn(std::size_t{0}, count);
+    };
+
+    std::vector<Entry> entries(n);
+    const double* px = points.x();
+    const double* py = points.y();
+    const double* pz = points.z();
+    forEach(n, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            if (!std::isfinite(px[i]) || !std::isfinite(py[i]) || !std::isfinite(pz[i]))
+                throw std::invalid_argument("KdTree: non-finite point coordinate");
+            entries[i] = Entry{{px[i], py[i], pz[i]}, static_cast<std::uint32_t>(i)};
+        }
+    });
+
+    int depth = 0;
+    while (((n + (std::size_t{1} << depth) - 1) >> depth) > leafSize) ++depth;
+    std::vector<Node> nodes((std::size_t{1} << depth) - 1);
+
+    // Nodes of one level cover disjoint column ranges, so each level is
+    // split in parallel; every node's work depends only on its range.
+    for (int level = 0; level < depth; ++level) {
+        const std::size_t count = std::size_t{1} << level;
+        Node* levelNodes = nodes.data() + (count - 1);
+        forEach(count, [&](std::size_t firstNode, std::size_t lastNode) {
+            for (std::size_t j = firstNode; j < lastNode; ++j) {
+                const NodeRange r = nodeRange(n, level, j);
+                if (r.mid == r.last) continue;   // empty right child: keep split = +inf
+
+                double lo[3], hi[3];
+                for (int a = 0; a < 3; ++a) lo[a] = hi[a] = entries[r.first].c[a];
+                for (std::size_t i = r.first + 1; i < r.last; ++i) {
+                    for (int a = 0; a < 3; ++a) {
+                        lo[a] = std::min(lo[a], entries[i].c[a]);
+                        hi[a] = std::max(hi[a], entries[i].c[a]);
+                    }
+                }
+                std::uint32_t axis = 0;
+                for (std::uint32_t a = 1; a < 3; ++a)
+                    if (hi[a] - lo[a] > hi[axis] - lo[axis]) axis = a;
+
+                std::nth_element(entries.begin() + r.first, entries.begin() + r.mid, entries.begin() + r.last,
+                                 [axis](const Entry& l, const Entry& rr) { return l.c[axis] < rr.c[axis]; });
+                levelNodes[j] = Node{entries[r.mid].c[axis], axis};
+            }
+        });
+    }
+
+    m_points.resize(n);
+    m_index.resize(n);
+    double* x = m_points.x();
+    double* y = m_points.y();
+    double* z = m_points.z();
+    forEach(n, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            x[i] = entries[i].c[0];
+            y[i] = entries[i].c[1];
+            z[i] = entries[i].c[2];
+            m_index[i] = entries[i].index;
+        }
+    });
+    m_nodes = std::move(nodes);
+    m_depth = depth;
+}
+
+// ── traversal ────────────────────────────────────────────────────────────────
+
+template <typename Scan>
+void KdTree::descend(const Point& p, const double& bound, Scan&& scan) const {
+    if (empty()) return;
+    const double q[3] = {p.x(), p.y(), p.z()};
+    const std::size_t inner = m_nodes.size();
+
+    // Far children wait with their squared distance to the splitting plane
+    // and are skipped if the bound has shrunk past it by the time they pop.
+    struct Pending {
+        std::size_t node;
+        double      distanceSquared;
+    };
+    Pending stack[MaxDepth + 1];
+    int top = 0;
+    stack[top++] = {0, 0.0};
+    while (top > 0) {
+        const Pending next = stack[--top];
+        if (next.distanceSquared > bound) continue;
+        std::size_t node = next.node;
+        while (node < inner) {
+            const Node& s = m_nodes[node];
+            const double diff = q[s.axis] - s.split;
+            // Branch-free: which side is nearer is unpredictable.  The two
+            // children of node i sum to 4i + 3.
+            const std::size_t near = 2 * node + 2 - static_cast<std::size_t>(diff < 0);
+            stack[top++] = {4 * node + 3 - near, diff * diff};
+            node = near;
+        }
+        const std::size_t leaf = node - inner;
+        scan(leafBegin(leaf), leafBegin(leaf + 1));
+    }
+}
+
+namespace {
+
+/// Heap order for k-nearest: the front of a max-heap is the worst neighbour.
+bool closer(const KdNeighbor& a, const KdNeighbor& b) noexcept {
+    return a.distanceSquared < b.distanceSquared
+        || (a.distanceSquared == b.distanceSquared && a.index < b.index);
+}
+
+} // namespace
+
+// ── queries ──────────────────────────────────────────────────────────────────
+
+std::size_t KdTree::nearest(const Point& p) const {
+    const double* x = m_points.x();
+    const double* y = m_points.y();
+    const double* z = m_points.z();
+    std::size_t best = size();
+    double bound = std::numeric_limits<double>::infinity();
+    descend(p, bound, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            const double dx = x[i] - p.x(), dy = y[i] - p.y(), dz = z[i] - p.z();
+            const double d = dx * dx + dy * dy + dz * dz;
+            if (d < bound || (d == bound && m_index[i] < best)) {
+                bound = d;
+                best = m_index[i];
+            }
+        }
+    });
+    return best;
+}
+
+void KdTree::nearest(const Point& p, std::size_t k, std::vector<Neighbor>& out) const {
+    out.clear();
+    if (k == 0) return;
+    out.reserve(std::min(k, size()));
+    const double* x = m_points.x();
+    const double* y = m_points.y();
+    const double* z = m_points.z();
+    double bound = std::numeric_limits<double>::infinity();
+    descend(p, bound, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            const double dx = x[i] - p.x(), dy = y[i] - p.y(), dz = z[i] - p.z();
+            const Neighbor c{m_index[i], dx * dx + dy * dy + dz * dz};
+            if (out.size() < k) {
+                out.push_back(c);
+                std::push_heap(out.begin(), out.end(), closer);
+                if (out.size() < k) continue;
+            } else if (closer(c, out.front())) {
+                std::pop_heap(out.begin(), out.end(), closer);
+                out.back() = c;
+                std::push_heap(out.begin(), out.end(), closer);
+            } else {
+                continue;
+            }
+            bound = out.front().distanceSquared;
+        }
+    });
+    std::sort_heap(out.begin(), out.end(), closer);
+}
+
+void KdTree::withinRadius(const Point& p, double radius, std::vector<std::size_t>& out) const {
+    if (!(radius >= 0)) return;
+    const double* x = m_points.x();
+    const double* y = m_points.y();
+    const double* z = m_points.z();
+    const double bound = radius * radius;
+    descend(p, bound, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            const double dx = x[i] - p.x(), dy = y[i] - p.y(), dz = z[i] - p.z();
+            if (dx * dx + dy * dy + dz * dz <= bound) out.push_back(m_index[i]);
+        }
+    });
+}
+
+// ── batched queries ──────────────────────────────────────────────────────────
+
+namespace {
+
+/// Spread the low 21 bits of \p v to every third bit.
+std::uint64_t spreadBits(std::uint64_t v) noexcept {
+    v &= 0x1fffff;
+    v = (v | v << 32) & 0x1f00000000ffffULL;
+    v = (v | v << 16) & 0x1f0000ff0000ffULL;
+    v = (v | v << 8)  & 0x100f00f00f00f00fULL;
+    v = (v | v << 4)  & 0x10c30c30c30c30c3ULL;
+    v = (v | v << 2)  & 0x1249249249249249ULL;
+    return v;
+}
+
+/// Query positions sorted along a Morton (Z-order) curve over the queries'
+/// bounding box.  Consecutive queries then walk mostly the same tree paths
+/// and leaves, which on clouds larger than the cache is worth several times
+/// the cost of the sort.  Non-finite coordinates sort to the low end.
+std::vector<std::size_t> zOrder(const PointBuffer& queries) {
+    const std::size_t n = queries.size();
+    const double* c[3] = {queries.x(), queries.y(), queries.z()};
+    double lo[3], scale[3];
+    for (int a = 0; a < 3; ++a) {
+        double mn = std::numeric_limits<double>::infinity(), mx = -mn;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (c[a][i] < mn) mn = c[a][i];
+            if (c[a][i] > mx) mx = c[a][i];
+        }
+        const double extent = mx - mn;
+        lo[a] = mn;
+        scale[a] = extent > 0 && std::isfinite(extent) ? 0x1fffff / extent : 0.0;
+    }
+
+    std::vector<std::pair<std::uint64_t, std::size_t>> keys(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        std::uint64_t key = 0;
+        for (int a = 0; a < 3; ++a) {
+            const double t = (c[a][i] - lo[a]) * scale[a];
+            const std::uint64_t cell = t >= 0 ? static_cast<std::uint64_t>(std::min(t, double(0x1fffff))) : 0;
+            key |= spreadBits(cell) << a;
+        }
+        keys[i] = {key, i};
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<std::size_t> order(n);
+    for (std::size_t i = 0; i < n; ++i) order[i] = keys[i].second;
+    return order;
+}
+
+} // namespace
+
+void KdTree::nearest(const PointBuffer& queries, std::size_t* out) const {
+    for (std::size_t i : zOrder(queries)) out[i] = nearest(queries[i]);
+}
+
+void KdTree::nearest(const PointBuffer& queries, std::size_t* out, ThreadPool& pool) const {
+    const std::vector<std::size_t> order = zOrder(queries);
+    pool.parallelFor(0, order.size(), [&](std::size_t first, std::size_t last) {
+        for (std::size_t j = first; j < last; ++j) out[order[j]] = nearest(queries[order[j]]);
+    });
+}
+
+void KdTree::nearest(const PointBuffer& queries, std::size_t k, Neighbor* out, ThreadPool& pool) const {
+    if (k == 0) return;
+    const std::vector<std::size_t> order = zOrder(queries);
+    pool.parallelFor(0, order.size(), [&](std::size_t first, std::size_t last) {
+        std::vector<Neighbor> found;
+        for (std::size_t j = first; j < last; ++j) {
+            const std::size_t i = order[j];
+            nearest(queries[i], k, found);
+            Neighbor* row = out + i * k;
+            std::copy(found.begin(), found.end(), row);
+            std::fill(row + found.size(), row + k,
+                      Neighbor{size(), std::numeric_limits<double>::infinity()});
+        }
+    });
+}
+
+void KdTree::withinRadius(const PointBuffer& queries, double radius, std::vector<std::size_t>& offsets,
+                          std::vector<std::size_t>& indices, ThreadPool& pool) const {
+    // Queries run in Z-order, each fixed-size block of them collecting its
+    // hits separately; the hits are then copied out in query order.
+    constexpr std::size_t Grain = 256;
+    const std::size_t n = queries.size();
+    const std::vector<std::size_t> order = zOrder(queries);
+    std::vector<std::vector<std::size_t>> blocks((n + Grain - 1) / Grain);
+    std::vector<std::size_t> start(n);
+    offsets.assign(n + 1, 0);
+    pool.parallelFor(0, n, [&](std::size_t first, std::size_t last) {
+        std::vector<std::size_t>& hits = blocks[first / Grain];
+        for (std::size_t j = first; j < last; ++j) {
+            const std::size_t i = order[j];
+            start[j] = hits.size();
+            withinRadius(queries[i], radius, hits);
+            offsets[i + 1] = hits.size() - start[j];
+        }
+    }, Grain);
+
+    for (std::size_t i = 0; i < n; ++i) offsets[i + 1] += offsets[i];
+    indices.resize(offsets[n]);
+    pool.parallelFor(0, n, [&](std::size_t first, std::size_t last) {
+        for (std::size_t j = first; j < last; ++j) {
+            const std::size_t i = order[j];
+            const auto from = blocks[j / Grain].begin() + static_cast<std::ptrdiff_t>(start[j]);
+            std::copy(from, from + static_cast<std::ptrdiff_t>(offsets[i + 1] - offsets[i]),
+                      indices.begin() + static_cast<std::ptrdiff_t>(offsets[i]));
+        }
+    });
+}
+
+} // namespace geometry
@@ -0,0 +1,67 @@
+#include "geometry/point_buffer.h"
+
+namespace geometry {
+
+template <typename T>
+BasicPointBuffer<T>::BasicPointBuffer(std::size_t count)
+    : m_x(count), m_y(count), m_z(count) {}
+
+template <typename T>
+BasicPointBuffer<T>::BasicPointBuffer(const std::vector<PointType>& points)
+    : BasicPointBuffer(points.size())
+{
+    for (std::size_t i = 0; i < points.size(); ++i) set(i, points[i]);
+}
+
+template <typename T>
+void BasicPointBuffer<T>::resize(std::size_t count) {
+    m_x.resize(count);
+    m_y.resize(count);
+    m_z.resize(count);
+}
+
+template <typename T>
+void BasicPointBuffer<T>::reserve(std::size_t count) {
+    m_x.reserve(count);
+    m_y.reserve(count);
+    m_z.reserve(count);
+}
+
+template <typename T>
+void BasicPointBuffer<T>::clear() noexcept {
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+}
+
+template <typename T>
+void BasicPointBuffer<T>::push_back(const PointType& p) {
+    m_x.push_back(p.x());
+    m_y.push_back(p.y());
+    m_z.push_back(p.z());
+}
+
+template <typename T>
+void BasicPointBuffer<T>::set(std::size_t i, const PointType& p) noexcept {
+    m_x[i] = p.x();
+    m_y[i] = p.y();
+    m_z[i] = p.z();
+}
+
+template <typename T>
+typename BasicPointBuffer<T>::PointType BasicPointBuffer<T>::operator[](std::size_t i) const noexcept {
+    return PointType(m_x[i], m_y[i], m_z[i]);
+}
+
+template <typename T>
+std::vector<typename BasicPointBuffer<T>::PointType> BasicPointBuffer<T>::toPoints() const {
+    std::vector<PointType> out;
+    out.reserve(size());
+    for (std::size_t i = 0; i < size(); ++i) out.push_back((*this)[i]);
+    return out;
+}
+
+template class BasicPointBuffer<float>;
+template class BasicPointBuffer<double>;
+
+} // namespace geometry
@@ -0,0 +1,360 @@
+#include "geometry/point_stats.h"
+#include "geometry/thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define GEOMETRY_X86_SIMD 1
+#endif
+
+namespace geometry {
+
+// ── statistics ───────────────────────────────────────────────────────────────
+
+double PointStats::covariance(int row, int col) const noexcept {
+    static constexpr int slot[3][3] = {{0, 1, 2}, {1, 3, 4}, {2, 4, 5}};
+    return count == 0 ? 0.0 : comoments[slot[row][col]] / static_cast<double>(count);
+}
+
+void PointStats::merge(const PointStats& other) noexcept {
+    if (other.count == 0) return;
+    if (count == 0) {
+        *this = other;
+        return;
+    }
+    const double na = static_cast<double>(count), nb = static_cast<double>(other.count);
+    const double n = na + nb;
+    const double d[3] = {other.mean.x() - mean.x(), other.mean.y() - mean.y(), other.mean.z() - mean.z()};
+    const double w = na * nb / n;
+    int s = 0;
+    for (int i = 0; i < 3; ++i)
+        for (int j = i; j < 3; ++j, ++s) comoments[s] += other.comoments[s] + d[i] * d[j] * w;
+    mean = Point(mean.x() + d[0] * (nb / n), mean.y() + d[1] * (nb / n), mean.z() + d[2] * (nb / n));
+    count += other.count;
+    bounds.expand(other.bounds);
+}
+
+// ── block kernels ────────────────────────────────────────────────────────────
+//
+// A block is reduced in four interleaved lanes (point i of the block goes
+// to lane i % 4), and the lanes are combined as (l0 + l1) + (l2 + l3).
+// The AVX2 kernels hold the lanes in one register and perform the same
+// IEEE operations (no FMA) as the scalar ones, so every path and every
+// machine gives identical bits.  Minimum and maximum follow the
+// _mm256_min_pd / _mm256_max_pd operand order, which skips NaN inputs.
+
+namespace {
+
+/// Points per block: two passes over one block stay in the L2 cache.  The
+/// block size fixes the result; changing it changes the last bits.
+constexpr std::size_t Block = 2048;
+
+struct Columns {
+    const double* c[3];
+};
+
+struct Lanes {
+    double sum[3][4];
+    double lo[3][4];
+    double hi[3][4];
+    double co[6][4];   ///< xx, xy, xz, yy, yz, zz
+
+    Lanes() {
+        const double inf = std::numeric_limits<double>::infinity();
+        for (int a = 0; a < 3; ++a)
+            for (int l = 0; l < 4; ++l) {
+                sum[a][l] = 0.0;
+                lo[a][l] = inf;
+                hi[a][l] = -inf;
+            }
+        for (auto& s : co) std::fill(s, s + 4, 0.0);
+    }
+};
+
+inline double combine(const double* l) { return (l[0] + l[1]) + (l[2] + l[3]); }
+
+// Scalar lane updates, also used for the tails of the AVX2 kernels.
+
+inline void rangeLane(const Columns& in, std::size_t i, int l, Lanes& out) {
+    for (int a = 0; a < 3; ++a) {
+        const double v = in.c[a][i];
+        out.lo[a][l] = v < out.lo[a][l] ? v : out.lo[a][l];
+        out.hi[a][l] = v > out.hi[a][l] ? v : out.hi[a][l];
+    }
+}
+
+inline void sumLane(const Columns& in, std::size_t i, int l, Lanes& out) {
+    for (int a = 0; a < 3; ++a) out.sum[a][l] += in.c[a][i];
+}
+
+inline void comomentLane(const Columns& in, std::size_t i, int l, const double* m, Lanes& out) {
+    const double dx = in.c[0][i] - m[0], dy = in.c[1][i] - m[1], dz = in.c[2][i] - m[2];
+    out.co[0][l] += dx * dx;
+    out.co[1][l] += dx * dy;
+    out.co[2][l] += dx * dz;
+    out.co[3][l] += dy * dy;
+    out.co[4][l] += dy * dz;
+    out.co[5][l] += dz * dz;
+}
+
+/// Pass 1 over [first, last): per-lane sums (if \p sums) and bounds.
+void firstPassScalar(const Columns& in, std::size_t first, std::size_t last, bool sums, Lanes& out) {
+    for (std::size_t i = first; i < last; ++i) {
+        const int l = static_cast<int>((i - first) % 4);
+        rangeLane(in, i, l, out);
+        if (sums) sumLane(in, i, l, out);
+    }
+}
+
+void secondPassScalar(const Columns& in, std::size_t first, std::size_t last, const double* m, Lanes& out) {
+    for (std::size_t i = first; i < last; ++i) comomentLane(in, i, static_cast<int>((i - first) % 4), m, out);
+}
+
+#ifdef GEOMETRY_X86_SIMD
+#define GEOMETRY_AVX2 __attribute__((target("avx2")))
+
+GEOMETRY_AVX2
+void firstPassAvx2(const Columns& in, std::size_t first, std::size_t last, bool sums, Lanes& out) {
+    __m256d s[3], lo[3], hi[3];
+    for (int a = 0; a < 3; ++a) {
+        s[a] = _mm256_loadu_pd(out.sum[a]);
+        lo[a] = _mm256_loadu_pd(out.lo[a]);
+        hi[a] = _mm256_loadu_pd(out.hi[a]);
+    }
+    std::size_t i = first;
+    for (; i + 4 <= last; i += 4) {
+        for (int a = 0; a < 3; ++a) {
+            const __m256d v = _mm256_loadu_pd(in.c[a] + i);
+            lo[a] = _mm256_min_pd(v, lo[a]);
+            hi[a] = _mm256_max_pd(v, hi[a]);
+            if (sums) s[a] = _mm256_add_pd(s[a], v);
+        }
+    }
+    for (int a = 0; a < 3; ++a) {
+        _mm256_storeu_pd(out.sum[a], s[a]);
+        _mm256_storeu_pd(out.lo[a], lo[a]);
+        _mm256_storeu_pd(out.hi[a], hi[a]);
+    }
+    for (int l = 0; i < last; ++i, ++l) {
+        rangeLane(in, i, l, out);
+        if (sums) sumLane(in, i, l, out);
+    }
+}
+
+GEOMETRY_AVX2
+void secondPassAvx2(const Columns& in, std::size_t first, std::size_t last, const double* m, Lanes& out) {
+    const __m256d mx = _mm256_set1_pd(m[0]), my = _mm256_set1_pd(m[1]), mz = _mm256_set1_pd(m[2]);
+    __m256d co[6];
+    for (int k = 0; k < 6; ++k) co[k] = _mm256_loadu_pd(out.co[k]);
+    std::size_t i = first;
+    for (; i + 4 <= last; i += 4) {
+        const __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(in.c[0] + i), mx);
+        const __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(in.c[1] + i), my);
+        const __m256d dz = _mm256_sub_pd(_mm256_loadu_pd(in.c[2] + i), mz);
+        co[0] = _mm256_add_pd(co[0], _mm256_mul_pd(dx, dx));
+        co[1] = _mm256_add_pd(co[1], _mm256_mul_pd(dx, dy));
+        co[2] = _mm256_add_pd(co[2], _mm256_mul_pd(dx, dz));
+        co[3] = _mm256_add_pd(co[3], _mm256_mul_pd(dy, dy));
+        co[4] = _mm256_add_pd(co[4], _mm256_mul_pd(dy, dz));
+        co[5] = _mm256_add_pd(co[5], _mm256_mul_pd(dz, dz));
+    }
+    for (int k = 0; k < 6; ++k) _mm256_storeu_pd(out.co[k], co[k]);
+    for (int l = 0; i < last; ++i, ++l) comomentLane(in, i, l, m, out);
+}
+
+#undef GEOMETRY_AVX2
+
+bool hasAvx2() {
+    static const bool avx2 = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+    }();
+    return avx2;
+}
+#endif // GEOMETRY_X86_SIMD
+
+void firstPass(const Columns& in, std::size_t first, std::size_t last, bool sums, Lanes& out) {
+#ifdef GEOMETRY_X86_SIMD
+    if (hasAvx2()) {
+        firstPassAvx2(in, first, last, sums, out);
+        return;
+    }
+#endif
+    firstPassScalar(in, first, last, sums, out);
+}
+
+void secondPass(const Columns& in, std::size_t first, std::size_t last, const double* m, Lanes& out) {
+#ifdef GEOMETRY_X86_SIMD
+    if (hasAvx2()) {
+        secondPassAvx2(in, first, last, m, out);
+        return;
+    }
+#endif
+    secondPassScalar(in, first, last, m, out);
+}
+
+Aabb laneBounds(const Lanes& lanes) {
+    double lo[3], hi[3];
+    for (int a = 0; a < 3; ++a) {
+        lo[a] = lanes.lo[a][0];
+        hi[a] = lanes.hi[a][0];
+        for (int l = 1; l < 4; ++l) {
+            lo[a] = lanes.lo[a][l] < lo[a] ? lanes.lo[a][l] : lo[a];
+            hi[a] = lanes.hi[a][l] > hi[a] ? lanes.hi[a][l] : hi[a];
+        }
+    }
+    return Aabb(Point(lo[0], lo[1], lo[2]), Point(hi[0], hi[1], hi[2]));
+}
+
+Aabb boundsBlock(const Columns& in, std::size_t first, std::size_t last) {
+    Lanes lanes;
+    firstPass(in, first, last, false, lanes);
+    return laneBounds(lanes);
+}
+
+PointStats statsBlock(const Columns& in, std::size_t first, std::size_t last) {
+    Lanes lanes;
+    firstPass(in, first, last, true, lanes);
+
+    PointStats s;
+    s.count = last - first;
+    s.bounds = laneBounds(lanes);
+    const double n = static_cast<double>(s.count);
+    const double m[3] = {combine(lanes.sum[0]) / n, combine(lanes.sum[1]) / n, combine(lanes.sum[2]) / n};
+    s.mean = Point(m[0], m[1], m[2]);
+
+    secondPass(in, first, last, m, lanes);
+    for (int k = 0; k < 6; ++k) s.comoments[k] = combine(lanes.co[k]);
+    return s;
+}
+
+Columns columns(const PointBuffer& points) {
+    return Columns{{points.x(), points.y(), points.z()}};
+}
+
+} // namespace
+
+// ── reductions ───────────────────────────────────────────────────────────────
+//
+// Serial and parallel reductions fold the same Block-sized chunks in the
+// same order, so their results are identical.
+
+Aabb bounds(const PointBuffer& points) {
+    const Columns in = columns(points);
+    Aabb box;
+    for (std::size_t b = 0; b < points.size(); b += Block)
+        box.expand(boundsBlock(in, b, std::min(points.size(), b + Block)));
+    return box;
+}
+
+Aabb bounds(const PointBuffer& points, ThreadPool& pool) {
+    const Columns in = columns(points);
+    return pool.parallelReduce(std::size_t{0}, points.size(), Aabb{},
+        [&](std::size_t first, std::size_t last) { return boundsBlock(in, first, last); },
+        [](Aabb a, const Aabb& b) { a.expand(b); return a; }, Block);
+}
+
+PointStats pointStats(const PointBuffer& points) {
+    const Columns in = columns(points);
+    PointStats stats;
+    for (std::size_t b = 0; b < points.size(); b += Block)
+        stats.merge(statsBlock(in, b, std::min(points.size(), b + Block)));
+    return stats;
+}
+
+PointStats pointStats(const PointBuffer& points, ThreadPool& pool) {
+    const Columns in = columns(points);
+    return pool.parallelReduce(std::size_t{0}, points.size(), PointStats(),
+        [&](std::size_t first, std::size_t last) { return statsBlock(in, first, last); },
+        [](PointStats a, const PointStats& b) { a.merge(b); return a; }, Block);
+}
+
+// ── principal axes ───────────────────────────────────────────────────────────
+
+PrincipalAxes principalAxes(const PointStats& stats) {
+    PrincipalAxes pa;
+    pa.origin = stats.mean;
+    pa.axes = {Point(1, 0, 0), Point(0, 1, 0), Point(0, 0, 1)};
+    if (stats.count < 2) return pa;
+
+    // Cyclic Jacobi: rotate away each off-diagonal term in turn until they
+    // vanish relative to the diagonal.  Converges quadratically; a handful
+    // of sweeps suffice for 3×3.
+    double a[3][3], v[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j) a[i][j] = stats.covariance(i, j);
+
+    for (int sweep = 0; sweep < 32; ++sweep) {
+        const double off = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+        const double diag = a[0][0] * a[0][0] + a[1][1] * a[1][1] + a[2][2] * a[2][2];
+        if (off <= diag * 1e-32 || off == 0.0) break;
+        for (int p = 0; p < 2; ++p) {
+            for (int q = p + 1; q < 3; ++q) {
+                if (a[p][q] == 0.0) continue;
+                const double theta = (a[q][q] - a[p][p]) / (2 * a[p][q]);
+                const double t = (theta >= 0 ? 1.0 : -1.0) / (std::abs(theta) + std::sqrt(theta * theta + 1));
+                const double c = 1 / std::sqrt(t * t + 1), s = t * c;
+                for (int k = 0; k < 3; ++k) {   // A ← A·J
+                    const double akp = a[k][p], akq = a[k][q];
+                    a[k][p] = c * akp - s * akq;
+                    a[k][q] = s * akp + c * akq;
+                }
+                for (int k = 0; k < 3; ++k) {   // A ← Jᵀ·A
+                    const double apk = a[p][k], aqk = a[q][k];
+                    a[p][k] = c * apk - s * aqk;
+                    a[q][k] = s * apk + c * aqk;
+                }
+                a[p][q] = a[q][p] = 0.0;
+                for (int k = 0; k < 3; ++k) {   // V ← V·J
+                    const double vkp = v[k][p], vkq = v[k][q];
+                    v[k][p] = c * vkp - s * vkq;
+                    v[k][q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+
+    int order[3] = {0, 1, 2};
+    std::sort(order, order + 3, [&](int l, int r) { return a[l][l] > a[r][r]; });
+    for (int k = 0; k < 3; ++k) {
+        const int e = order[k];
+        pa.variances[k] = std::max(a[e][e], 0.0);
+        Point axis(v[0][e], v[1][e], v[2][e]);
+        const double big = std::abs(axis.x()) >= std::abs(axis.y()) && std::abs(axis.x()) >= std::abs(axis.z())
+            ? axis.x()
+            : std::abs(axis.y()) >= std::abs(axis.z()) ? axis.y() : axis.z();
+        pa.axes[k] = big < 0 ? axis * -1.0 : axis;
+    }
+    pa.axes[2] = pa.axes[0].cross(pa.axes[1]);
+    return pa;
+}
+
+Transform PrincipalAxes::toWorld() const {
+    Transform::Matrix m = detail::identity4x4();
+    for (int c = 0; c < 3; ++c) {
+        m[0][c] = axes[c].x();
+        m[1][c] = axes[c].y();
+        m[2][c] = axes[c].z();
+    }
+    m[0][3] = origin.x();
+    m[1][3] = origin.y();
+    m[2][3] = origin.z();
+    return Transform::fromMatrix(m);
+}
+
+Transform PrincipalAxes::toFrame() const {
+    // Rotation part is the transpose; translation is -Rᵀ·origin.
+    Transform::Matrix m = detail::identity4x4();
+    for (int r = 0; r < 3; ++r) {
+        m[r][0] = axes[r].x();
+        m[r][1] = axes[r].y();
+        m[r][2] = axes[r].z();
+        m[r][3] = -axes[r].dot(origin);
+    }
+    return Transform::fromMatrix(m);
+}
+
+} // namespace geometry
@@ -0,0 +1,299 @@
+#include "geometry/predicates.h"
+#include <algorithm>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define GEOMETRY_X86_SIMD 1
+#endif
+
+namespace geometry {
+
+// ── kernels ──────────────────────────────────────────────────────────────────
+//
+// Each kernel is a small struct over the input columns with two members:
+// scalar(i) tests item i, and avx2(i) (x86-64 only) tests items [i, i + 4)
+// and returns their results as the low four bits.  Both evaluate the same
+// expressions as the single tests in predicates.h, operation for operation
+// and without FMA, so every path gives identical bits.  The drivers below
+// assemble the 64-bit mask words; elsewhere only the scalar path exists.
+
+namespace {
+
+#ifdef GEOMETRY_X86_SIMD
+#define GEOMETRY_AVX2 __attribute__((target("avx2")))
+
+GEOMETRY_AVX2 inline __m256d load(const double* p) { return _mm256_loadu_pd(p); }
+GEOMETRY_AVX2 inline __m256d splat(double v)       { return _mm256_set1_pd(v); }
+GEOMETRY_AVX2 inline __m256d le(__m256d a, __m256d b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+GEOMETRY_AVX2 inline __m256d ge(__m256d a, __m256d b) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+GEOMETRY_AVX2 inline __m256d both(__m256d a, __m256d b) { return _mm256_and_pd(a, b); }
+GEOMETRY_AVX2 inline __m256d sub(__m256d a, __m256d b) { return _mm256_sub_pd(a, b); }
+GEOMETRY_AVX2 inline __m256d add(__m256d a, __m256d b) { return _mm256_add_pd(a, b); }
+GEOMETRY_AVX2 inline __m256d mul(__m256d a, __m256d b) { return _mm256_mul_pd(a, b); }
+GEOMETRY_AVX2 inline unsigned bits(__m256d m) { return static_cast<unsigned>(_mm256_movemask_pd(m)); }
+
+/// a * b - c * d, as written in the scalar code.
+GEOMETRY_AVX2 inline __m256d cross(__m256d a, __m256d b, __m256d c, __m256d d) {
+    return sub(mul(a, b), mul(c, d));
+}
+#endif // GEOMETRY_X86_SIMD
+
+/// Points in a circle, or circles around a point (same expression).
+struct CircleKernel {
+    const double* x;  const double* y;   ///< Column or broadcast source
+    const double* r;                     ///< Radii column, or null for a fixed radius
+    double qx, qy, qr;
+
+    bool scalar(std::size_t i) const {
+        const double dx = x[i] - qx, dy = y[i] - qy;
+        const double rr = r ? r[i] : qr;
+        return dx * dx + dy * dy <= rr * rr;
+    }
+#ifdef GEOMETRY_X86_SIMD
+    GEOMETRY_AVX2 unsigned avx2(std::size_t i) const {
+        const __m256d dx = sub(load(x + i), splat(qx));
+        const __m256d dy = sub(load(y + i), splat(qy));
+        const __m256d rr = r ? load(r + i) : splat(qr);
+        return bits(le(add(mul(dx, dx), mul(dy, dy)), mul(rr, rr)));
+    }
+#endif
+};
+
+/// Circles intersecting a circle: centre distance against the radius sum.
+struct CircleOverlapKernel {
+    const double* x;  const double* y;  const double* r;
+    double qx, qy, qr;
+
+    bool scalar(std::size_t i) const {
+        const double dx = qx - x[i], dy = qy - y[i], rr = r[i] + qr;
+        return dx * dx + dy * dy <= rr * rr;
+    }
+#ifdef GEOMETRY_X86_SIMD
+    GEOMETRY_AVX2 unsigned avx2(std::size_t i) const {
+        const __m256d dx = sub(splat(qx), load(x + i));
+        const __m256d dy = sub(splat(qy), load(y + i));
+        const __m256d rr = add(load(r + i), splat(qr));
+        return bits(le(add(mul(dx, dx), mul(dy, dy)), mul(rr, rr)));
+    }
+#endif
+};
+
+/// Points in a rectangle [ox, ox + w] x [oy, oy + h].
+struct PointsInRectangleKernel {
+    const double* x;  const double* y;
+    double ox, oy, w, h;
+
+    bool scalar(std::size_t i) const {
+        return x[i] >= ox && x[i] <= ox + w && y[i] >= oy && y[i] <= oy + h;
+    }
+#ifdef GEOMETRY_X86_SIMD
+    GEOMETRY_AVX2 unsigned avx2(std::size_t i) const {
+        const __m256d px = load(x + i), py = load(y + i);
+        const __m256d inX = both(ge(px, splat(ox)), le(px, splat(ox + w)));
+        const __m256d inY = both(ge(py, splat(oy)), le(py, splat(oy + h)));
+        return bits(both(inX, inY));
+    }
+#endif
+};
+
+/// Rectangles containing a point.
+struct RectanglesAroundPointKernel {
+    const double* ox; const double* oy; const double* w; const double* h;
+    double px, py;
+
+    bool scalar(std::size_t i) const {
+        return px >= ox[i] && px <= ox[i] + w[i] && py >= oy[i] && py <= oy[i] + h[i];
+    }
+#ifdef GEOMETRY_X86_SIMD
+    GEOMETRY_AVX2 unsigned avx2(std::size_t i) const {
+        const __m256d x0 = load(ox + i), y0 = load(oy + i);
+        const __m256d x = splat(px), y = splat(py);
+        const __m256d inX = both(ge(x, x0), le(x, add(x0, load(w + i))));
+        const __m256d inY = both(ge(y, y0), le(y, add(y0, load(h + i))));
+        return bits(both(inX, inY));
+    }
+#endif
+};
+
+/// Rectangles overlapping [qx, qx + qw] x [qy, qy + qh].
+struct RectangleOverlapKernel {
+    const double* ox; const double* oy; const double* w; const double* h;
+    double qx, qy, qw, qh;
+
+    bool scalar(std::size_t i) const {
+        return ox[i] <= qx + qw && qx <= ox[i] + w[i] && oy[i] <= qy + qh && qy <= oy[i] + h[i];
+    }
+#ifdef GEOMETRY_X86_SIMD
+    GEOMETRY_AVX2 unsigned avx2(std::size_t i) const {
+        const __m256d x0 = load(ox + i), y0 = load(oy + i);
+        const __m256d x = splat(qx), y = splat(qy);
+        const __m256d inX = both(le(x0, splat(qx + qw)), le(x, add(x0, load(w + i))));
+        const __m256d inY = both(le(y0, splat(qy + qh)), le(y, add(y0, load(h + i))));
+        return bits(both(inX, inY));
+    }
+#endif
+};
+
+/// Shared edge-function test: e0..e2 all >= 0 or all <= 0, and area2 != 0.
+inline bool sameSide(double area2, double e0, double e1, double e2) {
+    return area2 != 0.0 && ((e0 >= 0.0 && e1 >= 0.0 && e2 >= 0.0) || (e0 <= 0.0 && e1 <= 0.0 && e2 <= 0.0));
+}
+
+#ifdef GEOMETRY_X86_SIMD
+GEOMETRY_AVX2 inline unsigned sameSide(__m256d area2, __m256d e0, __m256d e1, __m256d e2) {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d pos = both(both(ge(e0, zero), ge(e1, zero)), ge(e2, zero));
+    const __m256d neg = both(both(le(e0, zero), le(e1, zero)), le(e2, zero));
+    const __m256d nonDegenerate = _mm256_cmp_pd(area2, zero, _CMP_NEQ_OQ);
+    return bits(both(nonDegenerate, _mm256_or_pd(pos, neg)));
+}
+#endif
+
+/// Points in one triangle.
+struct PointsInTriangleKernel {
+    const double* x;  const double* y;
+    double ax, ay, bx, by, cx, cy, area2;
+
+    bool scalar(std::size_t i) const {
+        const double px = x[i], py = y[i];
+        const double e0 = (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+        const double e1 = (cx - bx) * (py - by) - (cy - by) * (px - bx);
+        const double e2 = (ax - cx) * (py - cy) - (ay - cy) * (px - cx);
+        return sameSide(area2, e0, e1, e2);
+    }
+#ifdef GEOMETRY_X86_SIMD
+    GEOMETRY_AVX2 unsigned avx2(std::size_t i) const {
+        const __m256d px = load(x + i), py = load(y + i);
+        const __m256d e0 = cross(splat(bx - ax), sub(py, splat(ay)), splat(by - ay), sub(px, splat(ax)));
+        const __m256d e1 = cross(splat(cx - bx), sub(py, splat(by)), splat(cy - by), sub(px, splat(bx)));
+        const __m256d e2 = cross(splat(ax - cx), sub(py, splat(cy)), splat(ay - cy), sub(px, splat(cx)));
+        return sameSide(splat(area2), e0, e1, e2);
+    }
+#endif
+};
+
+/// Triangles containing one point.
+struct TrianglesAroundPointKernel {
+    const ShapeStore::Triangles& t;
+    double px, py;
+
+    bool scalar(std::size_t i) const {
+        const double ax = t.ax[i], ay = t.ay[i], bx = t.bx[i], by = t.by[i], cx = t.cx[i], cy = t.cy[i];
+        const double area2 = (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+        const double e0 = (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+        const double e1 = (cx - bx) * (py - by) - (cy - by) * (px - bx);
+        const double e2 = (ax - cx) * (py - cy) - (ay - cy) * (px - cx);
+        return sameSide(area2, e0, e1, e2);
+    }
+#ifdef GEOMETRY_X86_SIMD
+    GEOMETRY_AVX2 unsigned avx2(std::size_t i) const {
+        const __m256d ax = load(&t.ax[i]), ay = load(&t.ay[i]);
+        const __m256d bx = load(&t.bx[i]), by = load(&t.by[i]);
+        const __m256d cx = load(&t.cx[i]), cy = load(&t.cy[i]);
+        const __m256d x = splat(px), y = splat(py);
+        const __m256d area2 = cross(sub(bx, ax), sub(cy, ay), sub(by, ay), sub(cx, ax));
+        const __m256d e0 = cross(sub(bx, ax), sub(y, ay), sub(by, ay), sub(x, ax));
+        const __m256d e1 = cross(sub(cx, bx), sub(y, by), sub(cy, by), sub(x, bx));
+        const __m256d e2 = cross(sub(ax, cx), sub(y, cy), sub(ay, cy), sub(x, cx));
+        return sameSide(area2, e0, e1, e2);
+    }
+#endif
+};
+
+// ── drivers ──────────────────────────────────────────────────────────────────
+
+template <typename Kernel>
+void maskScalar(const Kernel& k, std::size_t first, std::size_t n, std::uint64_t* mask) {
+    for (std::size_t w = first / 64; w * 64 < n; ++w) {
+        std::uint64_t word = 0;
+        const std::size_t end = std::min(n, w * 64 + 64);
+        for (std::size_t i = w * 64; i < end; ++i) word |= std::uint64_t(k.scalar(i)) << (i % 64);
+        mask[w] = word;
+    }
+}
+
+#ifdef GEOMETRY_X86_SIMD
+template <typename Kernel>
+GEOMETRY_AVX2 void maskAvx2(const Kernel& k, std::size_t n, std::uint64_t* mask) {
+    const std::size_t full = n / 64;
+    for (std::size_t w = 0; w < full; ++w) {
+        std::uint64_t word = 0;
+        for (unsigned j = 0; j < 64; j += 4) word |= std::uint64_t(k.avx2(w * 64 + j)) << j;
+        mask[w] = word;
+    }
+    maskScalar(k, full * 64, n, mask);
+}
+
+bool hasAvx2() {
+    static const bool avx2 = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+    }();
+    return avx2;
+}
+
+#undef GEOMETRY_AVX2
+#endif // GEOMETRY_X86_SIMD
+
+template <typename Kernel>
+void run(const Kernel& k, std::size_t n, std::uint64_t* mask) {
+#ifdef GEOMETRY_X86_SIMD
+    if (hasAvx2()) {
+        maskAvx2(k, n, mask);
+        return;
+    }
+#endif
+    maskScalar(k, 0, n, mask);
+}
+
+} // namespace
+
+// ── N points against one shape ───────────────────────────────────────────────
+
+void contains(const Circle& c, const PointBuffer& points, std::uint64_t* mask) {
+    run(CircleKernel{points.x(), points.y(), nullptr, c.center().x(), c.center().y(), c.radius()},
+        points.size(), mask);
+}
+
+void contains(const Rectangle& r, const PointBuffer& points, std::uint64_t* mask) {
+    run(PointsInRectangleKernel{points.x(), points.y(), r.origin().x(), r.origin().y(), r.width(), r.height()},
+        points.size(), mask);
+}
+
+void contains(const Triangle& t, const PointBuffer& points, std::uint64_t* mask) {
+    const double ax = t.a().x(), ay = t.a().y(), bx = t.b().x(), by = t.b().y(), cx = t.c().x(), cy = t.c().y();
+    const double area2 = (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+    if (area2 == 0.0) {
+        std::fill(mask, mask + maskWords(points.size()), 0);
+        return;
+    }
+    run(PointsInTriangleKernel{points.x(), points.y(), ax, ay, bx, by, cx, cy, area2}, points.size(), mask);
+}
+
+// ── one point or shape against N shapes ──────────────────────────────────────
+
+void contains(const ShapeStore::Circles& c, const Point& p, std::uint64_t* mask) {
+    run(CircleKernel{c.cx.data(), c.cy.data(), c.r.data(), p.x(), p.y(), 0.0}, c.r.size(), mask);
+}
+
+void contains(const ShapeStore::Rectangles& r, const Point& p, std::uint64_t* mask) {
+    run(RectanglesAroundPointKernel{r.ox.data(), r.oy.data(), r.w.data(), r.h.data(), p.x(), p.y()},
+        r.w.size(), mask);
+}
+
+void contains(const ShapeStore::Triangles& t, const Point& p, std::uint64_t* mask) {
+    run(TrianglesAroundPointKernel{t, p.x(), p.y()}, t.ax.size(), mask);
+}
+
+void intersects(const ShapeStore::Circles& c, const Circle& q, std::uint64_t* mask) {
+    run(CircleOverlapKernel{c.cx.data(), c.cy.data(), c.r.data(), q.center().x(), q.center().y(), q.radius()},
+        c.r.size(), mask);
+}
+
+void intersects(const ShapeStore::Rectangles& r, const Rectangle& q, std::uint64_t* mask) {
+    run(RectangleOverlapKernel{r.ox.data(), r.oy.data(), r.w.data(), r.h.data(),
+                               q.origin().x(), q.origin().y(), q.width(), q.height()},
+        r.w.size(), mask);
+}
+
+} // namespace geometry
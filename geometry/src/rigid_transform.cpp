@@ -0,0 +1,156 @@
+#include "geometry/rigid_transform.h"
+#include "geometry/point_buffer.h"
+#include <cmath>
+#include <stdexcept>
+
+namespace geometry {
+
+// ── quaternion ───────────────────────────────────────────────────────────────
+
+template <typename T>
+BasicQuaternion<T> BasicQuaternion<T>::fromAxisAngle(const PointType& axis, T radians) {
+    const T len = axis.length();
+    if (len == T(0)) throw std::domain_error("Quaternion: rotation axis has zero length");
+    const T s = std::sin(radians / T(2)) / len;
+    return BasicQuaternion(std::cos(radians / T(2)), axis.x() * s, axis.y() * s, axis.z() * s);
+}
+
+template <typename T>
+T BasicQuaternion<T>::norm() const noexcept {
+    return std::sqrt(dot(*this));
+}
+
+template <typename T>
+BasicQuaternion<T> BasicQuaternion<T>::normalized() const {
+    const T n = norm();
+    if (n == T(0)) throw std::domain_error("Quaternion: cannot normalize the zero quaternion");
+    return BasicQuaternion(m_w / n, m_x / n, m_y / n, m_z / n);
+}
+
+// ── factories / conversion ───────────────────────────────────────────────────
+
+template <typename T>
+BasicRigidTransform<T> BasicRigidTransform<T>::rotationX(T r) {
+    return BasicRigidTransform(Quaternion(std::cos(r / T(2)), std::sin(r / T(2)), T(0), T(0)), PointType());
+}
+
+template <typename T>
+BasicRigidTransform<T> BasicRigidTransform<T>::rotationY(T r) {
+    return BasicRigidTransform(Quaternion(std::cos(r / T(2)), T(0), std::sin(r / T(2)), T(0)), PointType());
+}
+
+template <typename T>
+BasicRigidTransform<T> BasicRigidTransform<T>::rotationZ(T r) {
+    return BasicRigidTransform(Quaternion(std::cos(r / T(2)), T(0), T(0), std::sin(r / T(2))), PointType());
+}
+
+template <typename T>
+BasicRigidTransform<T> BasicRigidTransform<T>::fromTransform(const TransformType& t) {
+    using K = TransformKind;
+    const auto& m = t.matrix();
+    const PointType translation(m[0][3], m[1][3], m[2][3]);
+    switch (t.kind()) {
+        case K::Identity:
+        case K::Translation:
+            return BasicRigidTransform(Quaternion(), translation);
+        case K::Rigid:
+            break;
+        default:
+            throw std::invalid_argument("RigidTransform: transform is not rigid");
+    }
+
+    // Shepperd's method: divide by the largest of the four candidate
+    // components so the square root argument is never small.
+    const T trace = m[0][0] + m[1][1] + m[2][2];
+    Quaternion q;
+    if (trace > T(0)) {
+        const T s = std::sqrt(trace + T(1)) * T(2);
+        q = Quaternion(s / T(4), (m[2][1] - m[1][2]) / s, (m[0][2] - m[2][0]) / s, (m[1][0] - m[0][1]) / s);
+    } else if (m[0][0] > m[1][1] && m[0][0] > m[2][2]) {
+        const T s = std::sqrt(T(1) + m[0][0] - m[1][1] - m[2][2]) * T(2);
+        q = Quaternion((m[2][1] - m[1][2]) / s, s / T(4), (m[0][1] + m[1][0]) / s, (m[0][2] + m[2][0]) / s);
+    } else if (m[1][1] > m[2][2]) {
+        const T s = std::sqrt(T(1) + m[1][1] - m[0][0] - m[2][2]) * T(2);
+        q = Quaternion((m[0][2] - m[2][0]) / s, (m[0][1] + m[1][0]) / s, s / T(4), (m[1][2] + m[2][1]) / s);
+    } else {
+        const T s = std::sqrt(T(1) + m[2][2] - m[0][0] - m[1][1]) * T(2);
+        q = Quaternion((m[1][0] - m[0][1]) / s, (m[0][2] + m[2][0]) / s, (m[1][2] + m[2][1]) / s, s / T(4));
+    }
+    return BasicRigidTransform(q.normalized(), translation);
+}
+
+template <typename T>
+BasicTransform<T> BasicRigidTransform<T>::toTransform() const {
+    const T w = m_rotation.w(), x = m_rotation.x(), y = m_rotation.y(), z = m_rotation.z();
+    typename TransformType::Matrix d = detail::identity4x4<T>();
+    d[0][0] = T(1) - T(2) * (y * y + z * z);
+    d[0][1] = T(2) * (x * y - w * z);
+    d[0][2] = T(2) * (x * z + w * y);
+    d[1][0] = T(2) * (x * y + w * z);
+    d[1][1] = T(1) - T(2) * (x * x + z * z);
+    d[1][2] = T(2) * (y * z - w * x);
+    d[2][0] = T(2) * (x * z - w * y);
+    d[2][1] = T(2) * (y * z + w * x);
+    d[2][2] = T(1) - T(2) * (x * x + y * y);
+    d[0][3] = m_translation.x();
+    d[1][3] = m_translation.y();
+    d[2][3] = m_translation.z();
+    return TransformType::fromMatrix(d);
+}
+
+// ── operations ───────────────────────────────────────────────────────────────
+
+template <typename T>
+BasicRigidTransform<T> BasicRigidTransform<T>::normalized() const {
+    return BasicRigidTransform(m_rotation.normalized(), m_translation);
+}
+
+template <typename T>
+BasicRigidTransform<T> BasicRigidTransform<T>::slerp(const BasicRigidTransform& a, const BasicRigidTransform& b,
+                                                     T t) {
+    const Quaternion& qa = a.m_rotation;
+    Quaternion qb = b.m_rotation;
+    T d = qa.dot(qb);
+    if (d < T(0)) {   // q and -q are the same rotation: take the short arc
+        qb = Quaternion(-qb.w(), -qb.x(), -qb.y(), -qb.z());
+        d = -d;
+    }
+
+    T wa, wb;
+    if (d > T(1) - T(16) * BasicPoint<T>::Tolerance) {
+        // Nearly parallel: sin(theta) ~ 0, fall back to normalized lerp.
+        wa = T(1) - t;
+        wb = t;
+    } else {
+        const T theta = std::acos(d);
+        const T s = std::sin(theta);
+        wa = std::sin((T(1) - t) * theta) / s;
+        wb = std::sin(t * theta) / s;
+    }
+    const Quaternion q(wa * qa.w() + wb * qb.w(), wa * qa.x() + wb * qb.x(),
+                       wa * qa.y() + wb * qb.y(), wa * qa.z() + wb * qb.z());
+    const PointType p = a.m_translation + (b.m_translation - a.m_translation) * t;
+    return BasicRigidTransform(q.normalized(), p);
+}
+
+template <typename T>
+void BasicRigidTransform<T>::applyBatch(Buffer& points) const {
+    toTransform().applyBatch(points);
+}
+
+template <typename T>
+void BasicRigidTransform<T>::applyBatch(const Buffer& in, Buffer& out) const {
+    toTransform().applyBatch(in, out);
+}
+
+template <typename T>
+void BasicRigidTransform<T>::applyBatch(Buffer& points, ThreadPool& pool) const {
+    toTransform().applyBatch(points, pool);
+}
+
+template class BasicQuaternion<float>;
+template class BasicQuaternion<double>;
+template class BasicRigidTransform<float>;
+template class BasicRigidTransform<double>;
+
+} // namespace geometry
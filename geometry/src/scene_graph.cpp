@@ -0,0 +1,223 @@
+#include "geometry/scene_graph.h"
+#include "geometry/thread_pool.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace geometry {
+
+namespace {
+
+/// Levels smaller than this are recomputed on the calling thread.
+constexpr std::size_t ParallelGrain = 4096;
+
+} // namespace
+
+// ── construction ─────────────────────────────────────────────────────────────
+
+SceneGraph::NodeId SceneGraph::addNode(const Transform& local, NodeId parent) {
+    if (parent != NoParent && parent >= size())
+        throw std::invalid_argument("SceneGraph: unknown parent node");
+    if (size() >= NoParent)
+        throw std::length_error("SceneGraph: too many nodes");
+    const Transform inv = local.inverse();
+
+    // Appended out of order; relayout() sorts everything breadth-first on
+    // the next update.
+    const NodeId id = static_cast<NodeId>(size());
+    m_parent.push_back(parent);
+    m_pos.push_back(id);
+    m_local.push_back(local);
+    m_localInverse.push_back(inv);
+    m_layoutDirty = true;
+    return id;
+}
+
+void SceneGraph::reserve(std::size_t nodes) {
+    m_parent.reserve(nodes);
+    m_pos.reserve(nodes);
+    m_local.reserve(nodes);
+    m_localInverse.reserve(nodes);
+}
+
+void SceneGraph::setLocal(NodeId node, const Transform& local) {
+    const Transform inv = local.inverse();
+    const Pos pos = m_pos[node];
+    m_local[pos] = local;
+    m_localInverse[pos] = inv;
+    if (m_layoutDirty || m_marked[pos]) return;
+    m_marked[pos] = 1;
+    m_pendingRoots.push_back(pos);
+}
+
+// ── queries ──────────────────────────────────────────────────────────────────
+
+const Transform& SceneGraph::world(NodeId node) {
+    if (dirty()) update();
+    return m_world[m_pos[node]];
+}
+
+const Transform& SceneGraph::inverseWorld(NodeId node) {
+    if (dirty()) update();
+    return m_inverseWorld[m_pos[node]];
+}
+
+// ── layout ───────────────────────────────────────────────────────────────────
+
+void SceneGraph::relayout() {
+    const std::size_t n = size();
+
+    // Children of every node, in id order (CSR).
+    std::vector<Pos> childStart(n + 1, 0);
+    for (NodeId id = 0; id < n; ++id)
+        if (m_parent[id] != NoParent) ++childStart[m_parent[id] + 1];
+    for (std::size_t i = 0; i < n; ++i) childStart[i + 1] += childStart[i];
+    std::vector<NodeId> children(childStart[n]);
+    {
+        std::vector<Pos> fill(childStart.begin(), childStart.end() - 1);
+        for (NodeId id = 0; id < n; ++id)
+            if (m_parent[id] != NoParent) children[fill[m_parent[id]]++] = id;
+    }
+
+    // Breadth-first order: roots first, then each node's children together.
+    std::vector<NodeId> order;
+    order.reserve(n);
+    for (NodeId id = 0; id < n; ++id)
+        if (m_parent[id] == NoParent) order.push_back(id);
+
+    m_childBegin.assign(n, 0);
+    m_childEnd.assign(n, 0);
+    m_levelOf.assign(n, 0);
+    m_levelStart.assign(1, 0);
+    std::size_t levelEnd = order.size();
+    for (std::size_t p = 0; p < order.size(); ++p) {
+        if (p == levelEnd) {
+            m_levelStart.push_back(static_cast<Pos>(p));
+            levelEnd = order.size();
+        }
+        m_levelOf[p] = static_cast<std::uint32_t>(m_levelStart.size() - 1);
+        const NodeId id = order[p];
+        m_childBegin[p] = static_cast<Pos>(order.size());
+        order.insert(order.end(), children.begin() + childStart[id], children.begin() + childStart[id + 1]);
+        m_childEnd[p] = static_cast<Pos>(order.size());
+    }
+    m_levelStart.push_back(static_cast<Pos>(n));
+
+    // Permute the per-position arrays.
+    std::vector<Pos> newPos(n);
+    for (std::size_t p = 0; p < n; ++p) newPos[order[p]] = static_cast<Pos>(p);
+
+    std::vector<Transform> local(n), localInverse(n);
+    m_parentPos.assign(n, NoParent);
+    for (std::size_t p = 0; p < n; ++p) {
+        const NodeId id = order[p];
+        local[p] = m_local[m_pos[id]];
+        localInverse[p] = m_localInverse[m_pos[id]];
+        if (m_parent[id] != NoParent) m_parentPos[p] = newPos[m_parent[id]];
+    }
+    m_local.swap(local);
+    m_localInverse.swap(localInverse);
+    m_pos.swap(newPos);
+
+    m_world.resize(n);
+    m_inverseWorld.resize(n);
+    m_marked.assign(n, 0);
+    m_pendingRoots.clear();
+    m_layoutDirty = false;
+
+    // Everything is dirty: one range per level.
+    m_dirty.assign(levels(), {});
+    for (std::size_t l = 0; l < levels(); ++l)
+        m_dirty[l].push_back(Range{m_levelStart[l], m_levelStart[l + 1]});
+}
+
+// ── incremental update ───────────────────────────────────────────────────────
+
+void SceneGraph::collectDirty() {
+    m_dirty.resize(levels());
+    for (Pos root : m_pendingRoots) {
+        m_marked[root] = 0;
+        // The subtree's nodes on each level are contiguous; the next level's
+        // range is the children of the first through the last node.
+        Pos lo = root, hi = root + 1;
+        for (std::uint32_t l = m_levelOf[root]; lo < hi; ++l) {
+            m_dirty[l].push_back(Range{lo, hi});
+            lo = m_childBegin[lo];
+            hi = m_childEnd[hi - 1];
+        }
+    }
+    m_pendingRoots.clear();
+
+    // Nested dirty subtrees overlap; merge so every node is computed once.
+    for (auto& ranges : m_dirty) {
+        if (ranges.size() < 2) continue;
+        std::sort(ranges.begin(), ranges.end(), [](const Range& a, const Range& b) { return a.first < b.first; });
+        std::size_t out = 0;
+        for (std::size_t i = 1; i < ranges.size(); ++i) {
+            if (ranges[i].first <= ranges[out].last) ranges[out].last = std::max(ranges[out].last, ranges[i].last);
+            else ranges[++out] = ranges[i];
+        }
+        ranges.resize(out + 1);
+    }
+}
+
+void SceneGraph::recomputeRange(Pos first, Pos last) noexcept {
+    for (Pos p = first; p < last; ++p) {
+        const Pos parent = m_parentPos[p];
+        if (parent == NoParent) {
+            m_world[p] = m_local[p];
+            m_inverseWorld[p] = m_localInverse[p];
+        } else {
+            m_world[p] = m_world[parent] * m_local[p];
+            m_inverseWorld[p] = m_localInverse[p] * m_inverseWorld[parent];
+        }
+    }
+}
+
+template <typename ForLevel>
+void SceneGraph::recompute(ForLevel&& forLevel) {
+    if (m_layoutDirty) relayout();
+    else collectDirty();
+
+    m_lastUpdated = 0;
+    for (auto& ranges : m_dirty) {
+        std::size_t count = 0;
+        for (const Range& r : ranges) count += r.last - r.first;
+        if (count != 0) forLevel(ranges, count);
+        m_lastUpdated += count;
+        ranges.clear();
+    }
+}
+
+void SceneGraph::update() {
+    if (!dirty()) return;
+    recompute([this](const std::vector<Range>& ranges, std::size_t) {
+        for (const Range& r : ranges) recomputeRange(r.first, r.last);
+    });
+}
+
+void SceneGraph::update(ThreadPool& pool) {
+    if (!dirty()) return;
+    std::vector<std::size_t> offsets;
+    recompute([&](const std::vector<Range>& ranges, std::size_t count) {
+        if (count < 2 * ParallelGrain) {
+            for (const Range& r : ranges) recomputeRange(r.first, r.last);
+            return;
+        }
+        // Split the level's ranges as one index space [0, count).
+        offsets.assign(1, 0);
+        for (const Range& r : ranges) offsets.push_back(offsets.back() + (r.last - r.first));
+        pool.parallelFor(0, count, [&](std::size_t first, std::size_t last) {
+            std::size_t k = std::upper_bound(offsets.begin(), offsets.end(), first) - offsets.begin() - 1;
+            while (first < last) {
+                const std::size_t end = std::min<std::size_t>(last, offsets[k + 1]);
+                const Pos base = ranges[k].first;
+                recomputeRange(static_cast<Pos>(base + (first - offsets[k])),
+                               static_cast<Pos>(base + (end - offsets[k])));
+                first = end;
+                ++k;
+            }
+        }, ParallelGrain);
+    });
+}
+
+} // namespace geometry
@@ -4,71 +4,109 @@
 
 namespace geometry {
 
-static constexpr double PI = 3.14159265358979323846;
+template <typename T>
+static constexpr T PI = T(3.14159265358979323846);
 
 // ── Circle ───────────────────────────────────────────────────────────────────
 
-Circle::Circle(const Point& center, double radius)
+template <typename T>
+BasicCircle<T>::BasicCircle(const PointType& center, T radius)
     : m_center(center), m_radius(radius)
 {
-    if (radius <= 0.0) {
+    if (radius <= T(0)) {
         throw std::invalid_argument("Circle radius must be positive");
     }
 }
 
-double      Circle::area()      const { return PI * m_radius * m_radius; }
-double      Circle::perimeter() const { return 2.0 * PI * m_radius; }
-std::string Circle::name()      const { return "Circle"; }
-Point       Circle::centroid()  const { return m_center; }
+template <typename T> T           BasicCircle<T>::area()      const { return PI<T> * m_radius * m_radius; }
+template <typename T> T           BasicCircle<T>::perimeter() const { return T(2) * PI<T> * m_radius; }
+template <typename T> std::string BasicCircle<T>::name()      const { return "Circle"; }
+template <typename T> BasicPoint<T> BasicCircle<T>::centroid() const { return m_center; }
+
+template <typename T>
+Aabb BasicCircle<T>::bounds() const {
+    // The circle lies in the XY plane through its centre.
+    return Aabb(Point(PointType(m_center.x() - m_radius, m_center.y() - m_radius, m_center.z())),
+                Point(PointType(m_center.x() + m_radius, m_center.y() + m_radius, m_center.z())));
+}
 
 // ── Triangle ─────────────────────────────────────────────────────────────────
 
-Triangle::Triangle(const Point& a, const Point& b, const Point& c)
+template <typename T>
+BasicTriangle<T>::BasicTriangle(const PointType& a, const PointType& b, const PointType& c)
     : m_a(a), m_b(b), m_c(c) {}
 
-double Triangle::area() const {
+template <typename T>
+T BasicTriangle<T>::area() const {
     // Heron's formula
-    const double ab = m_a.distanceTo(m_b);
-    const double bc = m_b.distanceTo(m_c);
-    const double ca = m_c.distanceTo(m_a);
-    const double s  = (ab + bc + ca) / 2.0;
+    const T ab = m_a.distanceTo(m_b);
+    const T bc = m_b.distanceTo(m_c);
+    const T ca = m_c.distanceTo(m_a);
+    const T s  = (ab + bc + ca) / T(2);
     return std::sqrt(s * (s - ab) * (s - bc) * (s - ca));
 }
 
-double Triangle::perimeter() const {
+template <typename T>
+T BasicTriangle<T>::perimeter() const {
     return m_a.distanceTo(m_b) + m_b.distanceTo(m_c) + m_c.distanceTo(m_a);
 }
 
-std::string Triangle::name() const { return "Triangle"; }
+template <typename T>
+std::string BasicTriangle<T>::name() const { return "Triangle"; }
 
-Point Triangle::centroid() const {
-    return Point(
-        (m_a.x() + m_b.x() + m_c.x()) / 3.0,
-        (m_a.y() + m_b.y() + m_c.y()) / 3.0,
-        (m_a.z() + m_b.z() + m_c.z()) / 3.0
+template <typename T>
+BasicPoint<T> BasicTriangle<T>::centroid() const {
+    return PointType(
+        (m_a.x() + m_b.x() + m_c.x()) / T(3),
+        (m_a.y() + m_b.y() + m_c.y()) / T(3),
+        (m_a.z() + m_b.z() + m_c.z()) / T(3)
     );
 }
 
+template <typename T>
+Aabb BasicTriangle<T>::bounds() const {
+    Aabb box;
+    box.expand(Point(m_a));
+    box.expand(Point(m_b));
+    box.expand(Point(m_c));
+    return box;
+}
+
 // ── Rectangle ────────────────────────────────────────────────────────────────
 
-Rectangle::Rectangle(const Point& origin, double width, double height)
+template <typename T>
+BasicRectangle<T>::BasicRectangle(const PointType& origin, T width, T height)
     : m_origin(origin), m_width(width), m_height(height)
 {
-    if (width <= 0.0 || height <= 0.0) {
+    if (width <= T(0) || height <= T(0)) {
         throw std::invalid_argument("Rectangle dimensions must be positive");
     }
 }
 
-double      Rectangle::area()      const { return m_width * m_height; }
-double      Rectangle::perimeter() const { return 2.0 * (m_width + m_height); }
-std::string Rectangle::name()      const { return "Rectangle"; }
+template <typename T> T           BasicRectangle<T>::area()      const { return m_width * m_height; }
+template <typename T> T           BasicRectangle<T>::perimeter() const { return T(2) * (m_width + m_height); }
+template <typename T> std::string BasicRectangle<T>::name()      const { return "Rectangle"; }
 
-Point Rectangle::centroid() const {
-    return Point(
-        m_origin.x() + m_width  / 2.0,
-        m_origin.y() + m_height / 2.0,
+template <typename T>
+BasicPoint<T> BasicRectangle<T>::centroid() const {
+    return PointType(
+        m_origin.x() + m_width  / T(2),
+        m_origin.y() + m_height / T(2),
         m_origin.z()
     );
 }
 
+template <typename T>
+Aabb BasicRectangle<T>::bounds() const {
+    return Aabb(Point(m_origin),
+                Point(PointType(m_origin.x() + m_width, m_origin.y() + m_height, m_origin.z())));
+}
+
+template class BasicCircle<float>;
+template class BasicCircle<double>;
+template class BasicTriangle<float>;
+template class BasicTriangle<double>;
+template class BasicRectangle<float>;
+template class BasicRectangle<double>;
+
 } // namespace geometry
@@ -0,0 +1,78 @@
+#include "geometry/shape_arena.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace geometry {
+
+ShapeArena::ShapeArena(Kind kind, std::size_t initialBytes, std::pmr::memory_resource* upstream)
+    : m_kind(kind), m_upstream(upstream), m_entries(upstream), m_freeSlots(upstream)
+{
+    // Bookkeeping lives in the upstream resource so that growing it never
+    // strands dead blocks inside a monotonic arena.
+    if (kind == Kind::Monotonic) {
+        m_monotonic = std::make_unique<std::pmr::monotonic_buffer_resource>(initialBytes, upstream);
+        m_resource = m_monotonic.get();
+    } else {
+        m_pool = std::make_unique<std::pmr::unsynchronized_pool_resource>(upstream);
+        m_resource = m_pool.get();
+    }
+}
+
+ShapeArena::~ShapeArena() {
+    reset();
+}
+
+void* ShapeArena::allocate(std::size_t size, std::size_t align) {
+    return m_resource->allocate(size, align);
+}
+
+std::uint32_t ShapeArena::record(const Entry& e) {
+    // Generations are unique over the arena's lifetime (up to 2^32 shapes),
+    // not just per slot, so handles from before a reset() never match a new
+    // shape either.
+    // Zero is skipped: it is the generation of a default handle.
+    if (++m_generation == 0) ++m_generation;
+    if (!m_freeSlots.empty()) {
+        const std::uint32_t slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        m_entries[slot] = e;
+        m_entries[slot].generation = m_generation;
+        ++m_live;
+        return slot;
+    }
+    if (m_entries.size() >= std::numeric_limits<std::uint32_t>::max())
+        throw std::length_error("ShapeArena: too many shapes");
+    // Every slot may end up on the free list; reserve now so release()
+    // never allocates.
+    if (m_freeSlots.capacity() < m_entries.size() + 1)
+        m_freeSlots.reserve(std::max<std::size_t>(16, 2 * (m_entries.size() + 1)));
+    m_entries.push_back(e);
+    m_entries.back().generation = m_generation;
+    ++m_live;
+    return static_cast<std::uint32_t>(m_entries.size() - 1);
+}
+
+void ShapeArena::release(std::uint32_t slot) noexcept {
+    Entry& e = m_entries[slot];
+    if (!e.memory) return;
+    e.destroy(e.memory);
+    // A monotonic resource ignores deallocate(); the pool recycles the block.
+    m_resource->deallocate(e.memory, e.size, e.align);
+    e = Entry{nullptr, nullptr, nullptr, nullptr, 0, 0, 0};
+    --m_live;
+    m_freeSlots.push_back(slot);   // capacity reserved by record()
+}
+
+void ShapeArena::reset() noexcept {
+    for (Entry& e : m_entries) {
+        if (e.memory) e.destroy(e.memory);
+    }
+    m_entries.clear();
+    m_freeSlots.clear();
+    m_live = 0;
+    if (m_monotonic) m_monotonic->release();
+    if (m_pool) m_pool->release();
+}
+
+} // namespace geometry
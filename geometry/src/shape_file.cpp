@@ -0,0 +1,145 @@
+#include "geometry/shape_file.h"
+#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
+
+namespace geometry {
+
+// ── helpers ──────────────────────────────────────────────────────────────────
+
+static void requireSchema(const io::MappedColumnFile& file, const char* schema,
+                          const std::string& path) {
+    if (file.schema() != schema) {
+        throw std::runtime_error("geometry: " + path + " is not a " + schema + " file");
+    }
+}
+
+static void requireSameLength(std::initializer_list<const io::ColumnView<double>*> columns,
+                              const std::string& path) {
+    for (const auto* c : columns) {
+        if (c->size() != (*columns.begin())->size()) {
+            throw std::runtime_error("geometry: column lengths differ in " + path);
+        }
+    }
+}
+
+// ── points ───────────────────────────────────────────────────────────────────
+
+void writePointFile(const std::string& path, const PointBuffer& points,
+                    const io::WriterOptions& options) {
+    io::ColumnFileWriter w(path, PointFileSchema, options);
+    w.add("x", points.x(), points.size());
+    w.add("y", points.y(), points.size());
+    w.add("z", points.z(), points.size());
+    w.finish();
+}
+
+MappedPoints::MappedPoints(const std::string& path)
+    : m_file(path)
+{
+    requireSchema(m_file, PointFileSchema, path);
+    m_x = m_file.column<double>("x");
+    m_y = m_file.column<double>("y");
+    m_z = m_file.column<double>("z");
+    requireSameLength({&m_x, &m_y, &m_z}, path);
+}
+
+PointBuffer MappedPoints::toBuffer() const {
+    PointBuffer out(size());
+    std::copy(m_x.begin(), m_x.end(), out.x());
+    std::copy(m_y.begin(), m_y.end(), out.y());
+    std::copy(m_z.begin(), m_z.end(), out.z());
+    return out;
+}
+
+// ── shapes ───────────────────────────────────────────────────────────────────
+
+void writeShapeFile(const std::string& path, const ShapeStore& shapes,
+                    const io::WriterOptions& options) {
+    io::ColumnFileWriter w(path, ShapeFileSchema, options);
+
+    const ShapeStore::Circles& c = shapes.circles();
+    w.add("circle.cx", c.cx);
+    w.add("circle.cy", c.cy);
+    w.add("circle.cz", c.cz);
+    w.add("circle.r",  c.r);
+
+    const ShapeStore::Triangles& t = shapes.triangles();
+    w.add("triangle.ax", t.ax);
+    w.add("triangle.ay", t.ay);
+    w.add("triangle.az", t.az);
+    w.add("triangle.bx", t.bx);
+    w.add("triangle.by", t.by);
+    w.add("triangle.bz", t.bz);
+    w.add("triangle.cx", t.cx);
+    w.add("triangle.cy", t.cy);
+    w.add("triangle.cz", t.cz);
+
+    const ShapeStore::Rectangles& r = shapes.rectangles();
+    w.add("rectangle.ox", r.ox);
+    w.add("rectangle.oy", r.oy);
+    w.add("rectangle.oz", r.oz);
+    w.add("rectangle.w",  r.w);
+    w.add("rectangle.h",  r.h);
+
+    w.finish();
+}
+
+MappedShapes::MappedShapes(const std::string& path)
+    : m_file(path)
+{
+    requireSchema(m_file, ShapeFileSchema, path);
+    auto col = [&](const char* name) { return m_file.column<double>(name); };
+
+    Circles& c = m_circles;
+    c.cx = col("circle.cx");
+    c.cy = col("circle.cy");
+    c.cz = col("circle.cz");
+    c.r  = col("circle.r");
+    requireSameLength({&c.r, &c.cx, &c.cy, &c.cz}, path);
+
+    Triangles& t = m_triangles;
+    t.ax = col("triangle.ax");
+    t.ay = col("triangle.ay");
+    t.az = col("triangle.az");
+    t.bx = col("triangle.bx");
+    t.by = col("triangle.by");
+    t.bz = col("triangle.bz");
+    t.cx = col("triangle.cx");
+    t.cy = col("triangle.cy");
+    t.cz = col("triangle.cz");
+    requireSameLength({&t.ax, &t.ay, &t.az, &t.bx, &t.by, &t.bz, &t.cx, &t.cy, &t.cz}, path);
+
+    Rectangles& r = m_rectangles;
+    r.ox = col("rectangle.ox");
+    r.oy = col("rectangle.oy");
+    r.oz = col("rectangle.oz");
+    r.w  = col("rectangle.w");
+    r.h  = col("rectangle.h");
+    requireSameLength({&r.w, &r.ox, &r.oy, &r.oz, &r.h}, path);
+}
+
+ShapeStore MappedShapes::toStore() const {
+    ShapeStore store;
+    store.reserve(circleCount(), triangleCount(), rectangleCount());
+    try {
+        const Circles& c = m_circles;
+        for (std::size_t i = 0; i < c.r.size(); ++i) {
+            store.add(Circle(Point(c.cx[i], c.cy[i], c.cz[i]), c.r[i]));
+        }
+        const Triangles& t = m_triangles;
+        for (std::size_t i = 0; i < t.ax.size(); ++i) {
+            store.add(Triangle(Point(t.ax[i], t.ay[i], t.az[i]), Point(t.bx[i], t.by[i], t.bz[i]),
+                               Point(t.cx[i], t.cy[i], t.cz[i])));
+        }
+        const Rectangles& r = m_rectangles;
+        for (std::size_t i = 0; i < r.w.size(); ++i) {
+            store.add(Rectangle(Point(r.ox[i], r.oy[i], r.oz[i]), r.w[i], r.h[i]));
+        }
+    } catch (const std::invalid_argument& ex) {
+        throw std::runtime_error(std::string("geometry: invalid shape in mapped file: ") + ex.what());
+    }
+    return store;
+}
+
+} // namespace geometry
@@ -0,0 +1,373 @@
+#include "geometry/shape_store.h"
+#include "geometry/thread_pool.h"
+#include "io/metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace geometry {
+
+static constexpr double PI = 3.14159265358979323846;
+
+// ── construction ─────────────────────────────────────────────────────────────
+
+ShapeStore ShapeStore::fromShapes(const std::vector<std::unique_ptr<Shape>>& shapes) {
+    ShapeStore store;
+    for (const auto& s : shapes) store.add(*s);
+    return store;
+}
+
+void ShapeStore::add(const Circle& c) {
+    m_circles.cx.push_back(c.center().x());
+    m_circles.cy.push_back(c.center().y());
+    m_circles.cz.push_back(c.center().z());
+    m_circles.r.push_back(c.radius());
+}
+
+void ShapeStore::add(const Triangle& t) {
+    m_triangles.ax.push_back(t.a().x());
+    m_triangles.ay.push_back(t.a().y());
+    m_triangles.az.push_back(t.a().z());
+    m_triangles.bx.push_back(t.b().x());
+    m_triangles.by.push_back(t.b().y());
+    m_triangles.bz.push_back(t.b().z());
+    m_triangles.cx.push_back(t.c().x());
+    m_triangles.cy.push_back(t.c().y());
+    m_triangles.cz.push_back(t.c().z());
+}
+
+void ShapeStore::add(const Rectangle& r) {
+    m_rectangles.ox.push_back(r.origin().x());
+    m_rectangles.oy.push_back(r.origin().y());
+    m_rectangles.oz.push_back(r.origin().z());
+    m_rectangles.w.push_back(r.width());
+    m_rectangles.h.push_back(r.height());
+}
+
+void ShapeStore::add(const Shape& s) {
+    if (const auto* c = dynamic_cast<const Circle*>(&s))    { add(*c); return; }
+    if (const auto* t = dynamic_cast<const Triangle*>(&s))  { add(*t); return; }
+    if (const auto* r = dynamic_cast<const Rectangle*>(&s)) { add(*r); return; }
+    throw std::invalid_argument("ShapeStore: unsupported shape type: " + s.name());
+}
+
+void ShapeStore::reserve(std::size_t circles, std::size_t triangles, std::size_t rectangles) {
+    for (auto* col : {&m_circles.cx, &m_circles.cy, &m_circles.cz, &m_circles.r})
+        col->reserve(circles);
+    for (auto* col : {&m_triangles.ax, &m_triangles.ay, &m_triangles.az,
+                      &m_triangles.bx, &m_triangles.by, &m_triangles.bz,
+                      &m_triangles.cx, &m_triangles.cy, &m_triangles.cz})
+        col->reserve(triangles);
+    for (auto* col : {&m_rectangles.ox, &m_rectangles.oy, &m_rectangles.oz,
+                      &m_rectangles.w, &m_rectangles.h})
+        col->reserve(rectangles);
+}
+
+void ShapeStore::clear() noexcept {
+    m_circles    = Circles{};
+    m_triangles  = Triangles{};
+    m_rectangles = Rectangles{};
+}
+
+std::size_t ShapeStore::size() const noexcept {
+    return circleCount() + triangleCount() + rectangleCount();
+}
+
+// ── element access ───────────────────────────────────────────────────────────
+
+Circle ShapeStore::circle(std::size_t i) const {
+    const Circles& c = m_circles;
+    return Circle(Point(c.cx.at(i), c.cy[i], c.cz[i]), c.r[i]);
+}
+
+Triangle ShapeStore::triangle(std::size_t i) const {
+    const Triangles& t = m_triangles;
+    return Triangle(Point(t.ax.at(i), t.ay[i], t.az[i]),
+                    Point(t.bx[i], t.by[i], t.bz[i]),
+                    Point(t.cx[i], t.cy[i], t.cz[i]));
+}
+
+Rectangle ShapeStore::rectangle(std::size_t i) const {
+    const Rectangles& r = m_rectangles;
+    return Rectangle(Point(r.ox.at(i), r.oy[i], r.oz[i]), r.w[i], r.h[i]);
+}
+
+std::vector<std::unique_ptr<Shape>> ShapeStore::toShapes() const {
+    std::vector<std::unique_ptr<Shape>> shapes;
+    shapes.reserve(size());
+    for (std::size_t i = 0; i < circleCount(); ++i)
+        shapes.push_back(std::make_unique<Circle>(circle(i)));
+    for (std::size_t i = 0; i < triangleCount(); ++i)
+        shapes.push_back(std::make_unique<Triangle>(triangle(i)));
+    for (std::size_t i = 0; i < rectangleCount(); ++i)
+        shapes.push_back(std::make_unique<Rectangle>(rectangle(i)));
+    return shapes;
+}
+
+// ── bulk kernels ─────────────────────────────────────────────────────────────
+//
+// Each loop reads a handful of columns and writes one; none of them branch,
+// so the compiler is free to vectorise them.
+
+/// |AB × AC| for triangle \p i.
+template <typename Columns>
+static inline double twiceTriangleArea(const Columns& t, std::size_t i) {
+    const double ux = t.bx[i] - t.ax[i], uy = t.by[i] - t.ay[i], uz = t.bz[i] - t.az[i];
+    const double vx = t.cx[i] - t.ax[i], vy = t.cy[i] - t.ay[i], vz = t.cz[i] - t.az[i];
+    const double nx = uy * vz - uz * vy;
+    const double ny = uz * vx - ux * vz;
+    const double nz = ux * vy - uy * vx;
+    return std::sqrt(nx * nx + ny * ny + nz * nz);
+}
+
+template <typename Columns>
+static inline double trianglePerimeter(const Columns& t, std::size_t i) {
+    const double abx = t.bx[i] - t.ax[i], aby = t.by[i] - t.ay[i], abz = t.bz[i] - t.az[i];
+    const double bcx = t.cx[i] - t.bx[i], bcy = t.cy[i] - t.by[i], bcz = t.cz[i] - t.bz[i];
+    const double cax = t.ax[i] - t.cx[i], cay = t.ay[i] - t.cy[i], caz = t.az[i] - t.cz[i];
+    return std::sqrt(abx * abx + aby * aby + abz * abz)
+         + std::sqrt(bcx * bcx + bcy * bcy + bcz * bcz)
+         + std::sqrt(cax * cax + cay * cay + caz * caz);
+}
+
+// Shape index i runs over circles, then triangles, then rectangles.
+// bySegment cuts [first, last) at the type boundaries and hands each
+// callback a range of indices local to its column set.
+template <typename C, typename T, typename R>
+static void bySegment(const ShapeStore& s, std::size_t first, std::size_t last,
+                      C&& circles, T&& triangles, R&& rectangles) {
+    const std::size_t t0 = s.circleCount();
+    const std::size_t r0 = t0 + s.triangleCount();
+    if (first < t0) circles(first, std::min(last, t0));
+    if (first < r0 && last > t0) triangles(std::max(first, t0) - t0, std::min(last, r0) - t0);
+    if (last > r0) rectangles(std::max(first, r0) - r0, last - r0);
+}
+
+/// Areas of shapes [first, last), written to out[first..last).
+static void areasRange(const ShapeStore& s, std::size_t first, std::size_t last, double* out) {
+    const std::size_t nc = s.circleCount(), nt = s.triangleCount();
+    bySegment(s, first, last,
+        [&](std::size_t b, std::size_t e) {
+            const double* r = s.circles().r.data();
+            for (std::size_t i = b; i < e; ++i) out[i] = PI * r[i] * r[i];
+        },
+        [&](std::size_t b, std::size_t e) {
+            const ShapeStore::Triangles& t = s.triangles();
+            for (std::size_t i = b; i < e; ++i) out[nc + i] = 0.5 * twiceTriangleArea(t, i);
+        },
+        [&](std::size_t b, std::size_t e) {
+            const double* w = s.rectangles().w.data();
+            const double* h = s.rectangles().h.data();
+            for (std::size_t i = b; i < e; ++i) out[nc + nt + i] = w[i] * h[i];
+        });
+}
+
+static void perimetersRange(const ShapeStore& s, std::size_t first, std::size_t last, double* out) {
+    const std::size_t nc = s.circleCount(), nt = s.triangleCount();
+    bySegment(s, first, last,
+        [&](std::size_t b, std::size_t e) {
+            const double* r = s.circles().r.data();
+            for (std::size_t i = b; i < e; ++i) out[i] = 2.0 * PI * r[i];
+        },
+        [&](std::size_t b, std::size_t e) {
+            const ShapeStore::Triangles& t = s.triangles();
+            for (std::size_t i = b; i < e; ++i) out[nc + i] = trianglePerimeter(t, i);
+        },
+        [&](std::size_t b, std::size_t e) {
+            const double* w = s.rectangles().w.data();
+            const double* h = s.rectangles().h.data();
+            for (std::size_t i = b; i < e; ++i) out[nc + nt + i] = 2.0 * (w[i] + h[i]);
+        });
+}
+
+static double areaSum(const ShapeStore& s, std::size_t first, std::size_t last) {
+    double circles = 0.0, triangles = 0.0, rectangles = 0.0;
+    bySegment(s, first, last,
+        [&](std::size_t b, std::size_t e) {
+            const double* r = s.circles().r.data();
+            for (std::size_t i = b; i < e; ++i) circles += r[i] * r[i];
+        },
+        [&](std::size_t b, std::size_t e) {
+            const ShapeStore::Triangles& t = s.triangles();
+            for (std::size_t i = b; i < e; ++i) triangles += twiceTriangleArea(t, i);
+        },
+        [&](std::size_t b, std::size_t e) {
+            const double* w = s.rectangles().w.data();
+            const double* h = s.rectangles().h.data();
+            for (std::size_t i = b; i < e; ++i) rectangles += w[i] * h[i];
+        });
+    return PI * circles + 0.5 * triangles + rectangles;
+}
+
+static double perimeterSum(const ShapeStore& s, std::size_t first, std::size_t last) {
+    double circles = 0.0, triangles = 0.0, rectangles = 0.0;
+    bySegment(s, first, last,
+        [&](std::size_t b, std::size_t e) {
+            const double* r = s.circles().r.data();
+            for (std::size_t i = b; i < e; ++i) circles += r[i];
+        },
+        [&](std::size_t b, std::size_t e) {
+            const ShapeStore::Triangles& t = s.triangles();
+            for (std::size_t i = b; i < e; ++i) triangles += trianglePerimeter(t, i);
+        },
+        [&](std::size_t b, std::size_t e) {
+            const double* w = s.rectangles().w.data();
+            const double* h = s.rectangles().h.data();
+            for (std::size_t i = b; i < e; ++i) rectangles += w[i] + h[i];
+        });
+    return 2.0 * PI * circles + triangles + 2.0 * rectangles;
+}
+
+void ShapeStore::areas(double* out) const noexcept {
+    areasRange(*this, 0, size(), out);
+}
+
+void ShapeStore::perimeters(double* out) const noexcept {
+    perimetersRange(*this, 0, size(), out);
+}
+
+std::vector<double> ShapeStore::areas() const {
+    std::vector<double> out(size());
+    areas(out.data());
+    return out;
+}
+
+std::vector<double> ShapeStore::perimeters() const {
+    std::vector<double> out(size());
+    perimeters(out.data());
+    return out;
+}
+
+PointBuffer ShapeStore::centroids() const {
+    PointBuffer out;
+    centroids(out);
+    return out;
+}
+
+void ShapeStore::centroids(PointBuffer& out) const {
+    out.resize(size());
+    double* x = out.x();
+    double* y = out.y();
+    double* z = out.z();
+
+    const Circles& c = m_circles;
+    const std::size_t nc = circleCount();
+    for (std::size_t i = 0; i < nc; ++i) {
+        x[i] = c.cx[i];
+        y[i] = c.cy[i];
+        z[i] = c.cz[i];
+    }
+    x += nc; y += nc; z += nc;
+
+    const Triangles& t = m_triangles;
+    const std::size_t nt = triangleCount();
+    for (std::size_t i = 0; i < nt; ++i) {
+        x[i] = (t.ax[i] + t.bx[i] + t.cx[i]) / 3.0;
+        y[i] = (t.ay[i] + t.by[i] + t.cy[i]) / 3.0;
+        z[i] = (t.az[i] + t.bz[i] + t.cz[i]) / 3.0;
+    }
+    x += nt; y += nt; z += nt;
+
+    const Rectangles& r = m_rectangles;
+    const std::size_t nr = rectangleCount();
+    for (std::size_t i = 0; i < nr; ++i) {
+        x[i] = r.ox[i] + r.w[i] / 2.0;
+        y[i] = r.oy[i] + r.h[i] / 2.0;
+        z[i] = r.oz[i];
+    }
+}
+
+std::vector<Aabb> ShapeStore::bounds() const {
+    std::vector<Aabb> out;
+    out.reserve(size());
+
+    const Circles& c = m_circles;
+    for (std::size_t i = 0; i < circleCount(); ++i)
+        out.emplace_back(Point(c.cx[i] - c.r[i], c.cy[i] - c.r[i], c.cz[i]),
+                         Point(c.cx[i] + c.r[i], c.cy[i] + c.r[i], c.cz[i]));
+
+    const Triangles& t = m_triangles;
+    for (std::size_t i = 0; i < triangleCount(); ++i) {
+        Aabb box;
+        box.expand(Point(t.ax[i], t.ay[i], t.az[i]));
+        box.expand(Point(t.bx[i], t.by[i], t.bz[i]));
+        box.expand(Point(t.cx[i], t.cy[i], t.cz[i]));
+        out.push_back(box);
+    }
+
+    const Rectangles& r = m_rectangles;
+    for (std::size_t i = 0; i < rectangleCount(); ++i)
+        out.emplace_back(Point(r.ox[i], r.oy[i], r.oz[i]),
+                         Point(r.ox[i] + r.w[i], r.oy[i] + r.h[i], r.oz[i]));
+    return out;
+}
+
+double ShapeStore::totalArea() const noexcept {
+    double sum = 0.0;
+    const double* r = m_circles.r.data();
+    double rr = 0.0;
+    for (std::size_t i = 0; i < circleCount(); ++i) rr += r[i] * r[i];
+    sum += PI * rr;
+
+    const Triangles& t = m_triangles;
+    double tri = 0.0;
+    for (std::size_t i = 0; i < triangleCount(); ++i) {
+        tri += twiceTriangleArea(t, i);
+    }
+    sum += 0.5 * tri;
+
+    const double* w = m_rectangles.w.data();
+    const double* h = m_rectangles.h.data();
+    double rect = 0.0;
+    for (std::size_t i = 0; i < rectangleCount(); ++i) rect += w[i] * h[i];
+    return sum + rect;
+}
+
+double ShapeStore::totalPerimeter() const noexcept {
+    const double* r = m_circles.r.data();
+    double rs = 0.0;
+    for (std::size_t i = 0; i < circleCount(); ++i) rs += r[i];
+
+    const Triangles& t = m_triangles;
+    double tri = 0.0;
+    for (std::size_t i = 0; i < triangleCount(); ++i) {
+        tri += trianglePerimeter(t, i);
+    }
+
+    const double* w = m_rectangles.w.data();
+    const double* h = m_rectangles.h.data();
+    double rect = 0.0;
+    for (std::size_t i = 0; i < rectangleCount(); ++i) rect += w[i] + h[i];
+
+    return 2.0 * PI * rs + tri + 2.0 * rect;
+}
+
+// ── parallel kernels ─────────────────────────────────────────────────────────
+
+void ShapeStore::areas(double* out, ThreadPool& pool) const {
+    IO_METRICS_TIME("shape_store.areas_parallel");
+    IO_METRICS_COUNT("shape_store.shapes", size());
+    pool.parallelFor(0, size(), [&](std::size_t b, std::size_t e) { areasRange(*this, b, e, out); },
+                     ThreadPool::DefaultReduceGrain);
+}
+
+void ShapeStore::perimeters(double* out, ThreadPool& pool) const {
+    pool.parallelFor(0, size(), [&](std::size_t b, std::size_t e) { perimetersRange(*this, b, e, out); },
+                     ThreadPool::DefaultReduceGrain);
+}
+
+double ShapeStore::totalArea(ThreadPool& pool) const {
+    IO_METRICS_TIME("shape_store.total_area_parallel");
+    IO_METRICS_COUNT("shape_store.shapes", size());
+    return pool.parallelReduce(0, size(), 0.0,
+        [&](std::size_t b, std::size_t e) { return areaSum(*this, b, e); },
+        [](double a, double b) { return a + b; });
+}
+
+double ShapeStore::totalPerimeter(ThreadPool& pool) const {
+    return pool.parallelReduce(0, size(), 0.0,
+        [&](std::size_t b, std::size_t e) { return perimeterSum(*this, b, e); },
+        [](double a, double b) { return a + b; });
+}
+
+} // namespace geometry
@@ -0,0 +1,160 @@
+#include "geometry/shape_stream.h"
+#include "io/file_writer.h"
+#include "io/metrics.h"
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+
+namespace geometry {
+
+// ── reader ───────────────────────────────────────────────────────────────────
+
+ShapeStreamReader::ShapeStreamReader(int fd, std::size_t chunkSize)
+    : m_fd(fd), m_buffer(chunkSize)
+{
+    if (chunkSize == 0)
+        throw std::invalid_argument("ShapeStreamReader: chunk size must be positive");
+}
+
+bool ShapeStreamReader::nextChunk(const char*& first, const char*& last) {
+    IO_METRICS_TIME("shape_stream.read_chunk");
+    char* data = m_buffer.data();
+    if (m_carry != 0) std::memmove(data, data + m_tail, m_carry);
+    std::size_t filled = m_carry;
+    m_carry = 0;
+
+    // Fill the chunk; stop early on a short read (a pipe with nothing more
+    // buffered) once there is a complete line, so interactive input flows.
+    while (!m_eof && filled < m_buffer.size()) {
+        const std::size_t want = m_buffer.size() - filled;
+        const ssize_t got = ::read(m_fd, data + filled, want);
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error(std::string("shape stream: read failed: ") + std::strerror(errno));
+        }
+        if (got == 0) {
+            m_eof = true;
+            break;
+        }
+        const bool newline = std::memchr(data + filled, '\n', static_cast<std::size_t>(got)) != nullptr;
+        filled += static_cast<std::size_t>(got);
+        m_bytesRead += static_cast<std::uint64_t>(got);
+        if (static_cast<std::size_t>(got) < want && newline) break;
+    }
+    if (filled == 0) return false;
+
+    const void* nl = ::memrchr(data, '\n', filled);
+    if (nl == nullptr && !m_eof) {
+        throw std::runtime_error("shape stream line " + std::to_string(m_line + 1)
+                                 + ": line longer than the " + std::to_string(m_buffer.size())
+                                 + "-byte chunk");
+    }
+    const std::size_t end = nl ? static_cast<std::size_t>(static_cast<const char*>(nl) - data) + 1 : filled;
+    m_tail = end;
+    m_carry = filled - end;
+    first = data;
+    last = data + end;
+    return true;
+}
+
+void ShapeStreamReader::parseLine(const char* first, const char* last, Record& rec) const {
+    auto fail = [&](const std::string& what) {
+        throw std::runtime_error("shape stream line " + std::to_string(m_line) + ": " + what);
+    };
+    auto isBlank = [](char c) { return c == ' ' || c == '\t' || c == '\r'; };
+
+    const char* p = first;
+    while (p < last && isBlank(*p)) ++p;
+    if (p == last || *p == '#') {
+        rec.kind = Kind::None;
+        return;
+    }
+
+    const char* word = p;
+    while (p < last && !isBlank(*p)) ++p;
+    const std::string_view name(word, static_cast<std::size_t>(p - word));
+    int count = 0;
+    if (name == "circle")         { rec.kind = Kind::Circle;    count = 4; }
+    else if (name == "triangle")  { rec.kind = Kind::Triangle;  count = 9; }
+    else if (name == "rectangle") { rec.kind = Kind::Rectangle; count = 5; }
+    else fail("unknown shape '" + std::string(name) + "'");
+
+    for (int i = 0; i < count; ++i) {
+        while (p < last && isBlank(*p)) ++p;
+        // Accept "+1.5" as strtod does; from_chars only takes a '-' sign.
+        if (last - p > 1 && p[0] == '+' && p[1] != '-') ++p;
+        const auto res = std::from_chars(p, last, rec.v[i]);
+        if (res.ec != std::errc{})
+            fail(std::string(name) + " needs " + std::to_string(count) + " numbers");
+        if (res.ptr != last && !isBlank(*res.ptr)) fail("malformed number");
+        if (!std::isfinite(rec.v[i])) fail("non-finite number");
+        p = res.ptr;
+    }
+    while (p < last && isBlank(*p)) ++p;
+    if (p != last) fail("unexpected trailing characters");
+
+    switch (rec.kind) {
+        case Kind::Circle:
+            if (rec.v[3] <= 0.0) fail("circle radius must be positive");
+            break;
+        case Kind::Rectangle:
+            if (rec.v[3] <= 0.0 || rec.v[4] <= 0.0) fail("rectangle dimensions must be positive");
+            break;
+        default:
+            break;
+    }
+}
+
+// ── transform and write ──────────────────────────────────────────────────────
+
+namespace {
+
+Circle moved(const Circle& c, const Transform& t) {
+    return Circle(t.apply(c.center()), c.radius());
+}
+
+Triangle moved(const Triangle& s, const Transform& t) {
+    return Triangle(t.apply(s.a()), t.apply(s.b()), t.apply(s.c()));
+}
+
+Rectangle moved(const Rectangle& r, const Transform& t) {
+    return Rectangle(t.apply(r.origin()), r.width(), r.height());
+}
+
+template <typename S>
+void writeRecord(io::FileWriter& out, const S& s, const char* name) {
+    const Point c = s.centroid();
+    out.record().field("name", name).field("area", s.area()).field("perimeter", s.perimeter())
+        .field("centroid_x", c.x()).field("centroid_y", c.y()).field("centroid_z", c.z());
+}
+
+const char* recordName(const Circle&)    { return "Circle"; }
+const char* recordName(const Triangle&)  { return "Triangle"; }
+const char* recordName(const Rectangle&) { return "Rectangle"; }
+
+} // namespace
+
+ShapeStreamStats transformShapeStream(int fd, const Transform& transform, io::FileWriter& out,
+                                      std::size_t chunkSize) {
+    ShapeStreamReader reader(fd, chunkSize);
+    const std::size_t before = out.bytesWritten();
+    out.writeLine("name,area,perimeter,centroid_x,centroid_y,centroid_z");
+
+    ShapeStreamStats stats;
+    stats.records = reader.run([&](const auto& shape) {
+        const auto s = moved(shape, transform);
+        writeRecord(out, s, recordName(s));
+    });
+    stats.bytesIn = reader.bytesRead();
+    stats.bytesOut = out.bytesWritten() - before;
+    IO_METRICS_COUNT("shape_stream.records", stats.records);
+    IO_METRICS_COUNT("shape_stream.bytes_in", stats.bytesIn);
+    return stats;
+}
+
+} // namespace geometry
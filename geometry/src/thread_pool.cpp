@@ -0,0 +1,177 @@
+#include "geometry/thread_pool.h"
+
+namespace geometry {
+
+namespace {
+
+constexpr std::size_t NotAWorker = static_cast<std::size_t>(-1);
+
+// Identifies the pool and queue owned by the current thread, so nested
+// loops push to their own deque and steal from the rest.
+thread_local const ThreadPool* t_pool  = nullptr;
+thread_local std::size_t       t_index = NotAWorker;
+
+} // namespace
+
+struct ThreadPool::Job {
+    const std::function<void(std::size_t)>* body;
+    std::atomic<std::size_t>                remaining;
+    std::atomic<bool>                       failed{false};
+    std::exception_ptr                      error;
+    std::mutex                              mutex;
+    std::condition_variable                 done;
+    bool                                    finished = false;
+
+    Job(const std::function<void(std::size_t)>* b, std::size_t chunks)
+        : body(b), remaining(chunks) {}
+};
+
+// ── lifecycle ────────────────────────────────────────────────────────────────
+
+ThreadPool::ThreadPool(std::size_t threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t workers = threads - 1;
+    m_queues.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) m_queues.push_back(std::make_unique<Queue>());
+    m_workers.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) m_workers.emplace_back([this, i] { workerLoop(i); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto& t : m_workers) t.join();
+}
+
+ThreadPool& ThreadPool::instance() {
+    static ThreadPool pool;
+    return pool;
+}
+
+// ── scheduling ───────────────────────────────────────────────────────────────
+
+void ThreadPool::push(std::size_t queue, const Task& task) {
+    {
+        std::lock_guard<std::mutex> lock(m_queues[queue]->mutex);
+        m_queues[queue]->tasks.push_back(task);
+    }
+    m_queued.fetch_add(1);
+    if (m_sleeping.load() > 0) {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_wake.notify_one();
+    }
+}
+
+bool ThreadPool::pop(std::size_t self, Task& task) {
+    const std::size_t n = m_queues.size();
+    if (m_queued.load(std::memory_order_relaxed) == 0) return false;
+
+    // Own deque: newest first, for locality.
+    if (self != NotAWorker) {
+        Queue& q = *m_queues[self];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (!q.tasks.empty()) {
+            task = q.tasks.back();
+            q.tasks.pop_back();
+            m_queued.fetch_sub(1);
+            return true;
+        }
+    }
+
+    // Steal the oldest (largest) range from someone else.
+    const std::size_t start = self == NotAWorker ? 0 : self + 1;
+    for (std::size_t k = 0; k < n; ++k) {
+        Queue& q = *m_queues[(start + k) % n];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (!q.tasks.empty()) {
+            task = q.tasks.front();
+            q.tasks.pop_front();
+            m_queued.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::execute(std::size_t self, Task task) {
+    Job& job = *task.job;
+
+    // Split down to a single chunk, leaving the other halves to thieves.
+    const std::size_t home = self == NotAWorker ? 0 : self;
+    while (task.last - task.first > 1) {
+        const std::size_t mid = task.first + (task.last - task.first) / 2;
+        push(home, Task{task.job, mid, task.last});
+        task.last = mid;
+    }
+
+    if (!job.failed.load(std::memory_order_relaxed)) {
+        try {
+            (*job.body)(task.first);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(job.mutex);
+            if (!job.error) job.error = std::current_exception();
+            job.failed = true;
+        }
+    }
+
+    if (job.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> lock(job.mutex);
+        job.finished = true;
+        job.done.notify_all();
+    }
+}
+
+void ThreadPool::run(std::size_t chunks, const std::function<void(std::size_t)>& body) {
+    if (chunks == 0) return;
+    if (m_queues.empty() || chunks == 1) {
+        for (std::size_t c = 0; c < chunks; ++c) body(c);
+        return;
+    }
+
+    Job job(&body, chunks);
+    const std::size_t self = t_pool == this ? t_index : NotAWorker;
+
+    // Seed every worker with a contiguous share.
+    const std::size_t parts = std::min(m_queues.size(), chunks);
+    for (std::size_t i = 0; i < parts; ++i) {
+        push(i, Task{&job, chunks * i / parts, chunks * (i + 1) / parts});
+    }
+
+    Task task;
+    while (job.remaining.load(std::memory_order_acquire) > 0) {
+        if (pop(self, task)) {
+            execute(self, task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(job.mutex);
+        job.done.wait_for(lock, std::chrono::microseconds(100), [&] { return job.finished; });
+    }
+
+    // The last chunk's thread may still be signalling; wait for it to let go.
+    std::unique_lock<std::mutex> lock(job.mutex);
+    job.done.wait(lock, [&] { return job.finished; });
+    if (job.error) std::rethrow_exception(job.error);
+}
+
+void ThreadPool::workerLoop(std::size_t self) {
+    t_pool  = this;
+    t_index = self;
+
+    Task task;
+    for (;;) {
+        if (pop(self, task)) {
+            execute(self, task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleeping.fetch_add(1);
+        m_wake.wait(lock, [&] { return m_queued.load() > 0 || m_stop.load(); });
+        m_sleeping.fetch_sub(1);
+        if (m_stop.load() && m_queued.load() == 0) return;
+    }
+}
+
+} // namespace geometry
@@ -1,97 +1,113 @@
 #include "geometry/transform.h"
+#include "geometry/thread_pool.h"
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <stdexcept>
+#include <type_traits>
 
 namespace geometry {
 
 // ── helpers ──────────────────────────────────────────────────────────────────
 
-using Mat4 = std::array<std::array<double, 4>, 4>;
+template <typename T>
+using Mat4 = detail::BasicMat4<T>;
 
-static Mat4 zero4x4() {
-    Mat4 m{};
-    for (auto& row : m) row.fill(0.0);
-    return m;
+/// Tolerance for recognising an orthonormal 3×3 block; float matrices
+/// built from rotationX/Y/Z are only orthonormal to a few float ulps.
+template <typename T>
+constexpr T RigidEps = std::is_same<T, float>::value ? T(1e-6) : T(1e-12);
+
+/// Relative tolerance for a singular matrix: |det| against the product of
+/// the column norms (1 for orthogonal columns, 0 for dependent ones), or a
+/// pivot against the largest entry.  Both ratios are independent of scale,
+/// so a uniform scale of 1e-5 stays invertible.
+template <typename T>
+constexpr T SingularEps = std::numeric_limits<T>::epsilon() * T(64);
+
+template <typename T>
+static T columnNorm(const Mat4<T>& m, int j) {
+    return std::sqrt(m[0][j] * m[0][j] + m[1][j] * m[1][j] + m[2][j] * m[2][j]);
 }
 
-static Mat4 identity4x4() {
-    Mat4 m = zero4x4();
-    m[0][0] = m[1][1] = m[2][2] = m[3][3] = 1.0;
-    return m;
+template <typename T>
+static TransformKind classify(const Mat4<T>& m) {
+    using K = TransformKind;
+    if (m[3][0] != 0.0 || m[3][1] != 0.0 || m[3][2] != 0.0 || m[3][3] != 1.0)
+        return K::Projective;
+
+    const bool noTranslation = m[0][3] == 0.0 && m[1][3] == 0.0 && m[2][3] == 0.0;
+    bool diagonal = true;
+    bool unitDiagonal = true;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            if (i != j && m[i][j] != 0.0) diagonal = false;
+        }
+        if (m[i][i] != 1.0) unitDiagonal = false;
+    }
+    if (diagonal && unitDiagonal) return noTranslation ? K::Identity : K::Translation;
+    if (diagonal && noTranslation) return K::Scale;
+
+    // Rigid if the 3×3 block is orthonormal with determinant +1.
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            T dot = 0;
+            for (int k = 0; k < 3; ++k) dot += m[k][i] * m[k][j];
+            if (std::abs(dot - (i == j ? T(1) : T(0))) > RigidEps<T>) return K::Affine;
+        }
+    }
+    const T det =
+          m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+        - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+        + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+    return det > T(0) ? K::Rigid : K::Affine;
 }
 
 // ── constructors / factories ─────────────────────────────────────────────────
 
-Transform::Transform() : m(identity4x4()) {}
-
-Transform::Transform(const Mat4& data) : m(data) {}
-
-Transform Transform::identity() { return Transform{}; }
-
-Transform Transform::translation(double tx, double ty, double tz) {
-    Mat4 d = identity4x4();
-    d[0][3] = tx;
-    d[1][3] = ty;
-    d[2][3] = tz;
-    return Transform(d);
-}
-
-Transform Transform::scale(double sx, double sy, double sz) {
-    Mat4 d = identity4x4();
-    d[0][0] = sx;
-    d[1][1] = sy;
-    d[2][2] = sz;
-    return Transform(d);
+template <typename T>
+BasicTransform<T> BasicTransform<T>::fromMatrix(const Matrix& data) {
+    return BasicTransform(data, classify(data));
 }
 
-Transform Transform::rotationX(double r) {
-    Mat4 d = identity4x4();
+template <typename T>
+BasicTransform<T> BasicTransform<T>::rotationX(T r) {
+    Matrix d = detail::identity4x4<T>();
     d[1][1] =  std::cos(r);  d[1][2] = -std::sin(r);
     d[2][1] =  std::sin(r);  d[2][2] =  std::cos(r);
-    return Transform(d);
+    return BasicTransform(d, TransformKind::Rigid);
 }
 
-Transform Transform::rotationY(double r) {
-    Mat4 d = identity4x4();
+template <typename T>
+BasicTransform<T> BasicTransform<T>::rotationY(T r) {
+    Matrix d = detail::identity4x4<T>();
     d[0][0] =  std::cos(r);  d[0][2] =  std::sin(r);
     d[2][0] = -std::sin(r);  d[2][2] =  std::cos(r);
-    return Transform(d);
+    return BasicTransform(d, TransformKind::Rigid);
 }
 
-Transform Transform::rotationZ(double r) {
-    Mat4 d = identity4x4();
+template <typename T>
+BasicTransform<T> BasicTransform<T>::rotationZ(T r) {
+    Matrix d = detail::identity4x4<T>();
     d[0][0] =  std::cos(r);  d[0][1] = -std::sin(r);
     d[1][0] =  std::sin(r);  d[1][1] =  std::cos(r);
-    return Transform(d);
+    return BasicTransform(d, TransformKind::Rigid);
 }
 
 // ── operations ───────────────────────────────────────────────────────────────
 
-Transform Transform::operator*(const Transform& other) const {
-    Mat4 res = zero4x4();
-    for (int i = 0; i < 4; ++i)
-        for (int j = 0; j < 4; ++j)
-            for (int k = 0; k < 4; ++k)
-                res[i][j] += m[i][k] * other.m[k][j];
-    return Transform(res);
-}
-
-Point Transform::apply(const Point& p) const {
-    const double w = m[3][0]*p.x() + m[3][1]*p.y() + m[3][2]*p.z() + m[3][3];
-    return Point(
-        (m[0][0]*p.x() + m[0][1]*p.y() + m[0][2]*p.z() + m[0][3]) / w,
-        (m[1][0]*p.x() + m[1][1]*p.y() + m[1][2]*p.z() + m[1][3]) / w,
-        (m[2][0]*p.x() + m[2][1]*p.y() + m[2][2]*p.z() + m[2][3]) / w
-    );
-}
-
-/// Gauss-Jordan inverse for a 4×4 matrix.
-Transform Transform::inverse() const {
+/// Gauss-Jordan inverse for a general 4×4 matrix.
+template <typename T>
+static Mat4<T> gaussJordanInverse(const Mat4<T>& m) {
     // Augment [m | I]
-    std::array<std::array<double, 8>, 4> aug{};
+    std::array<std::array<T, 8>, 4> aug{};
+    T largest = T(0);
     for (int i = 0; i < 4; ++i) {
-        for (int j = 0; j < 4; ++j) aug[i][j] = m[i][j];
-        aug[i][4 + i] = 1.0;
+        for (int j = 0; j < 4; ++j) {
+            aug[i][j] = m[i][j];
+            largest = std::max(largest, std::abs(m[i][j]));
+        }
+        aug[i][4 + i] = T(1);
     }
     for (int col = 0; col < 4; ++col) {
         // Pivot
@@ -101,24 +117,98 @@ Transform Transform::inverse() const {
                 pivot = row;
         std::swap(aug[col], aug[pivot]);
 
-        if (std::abs(aug[col][col]) < 1e-12)
+        if (!(std::abs(aug[col][col]) > SingularEps<T> * largest))
             throw std::runtime_error("Transform matrix is singular");
 
-        const double div = aug[col][col];
-        for (double& v : aug[col]) v /= div;
+        const T div = aug[col][col];
+        for (T& v : aug[col]) v /= div;
 
         for (int row = 0; row < 4; ++row) {
             if (row == col) continue;
-            const double factor = aug[row][col];
+            const T factor = aug[row][col];
             for (int j = 0; j < 8; ++j)
                 aug[row][j] -= factor * aug[col][j];
         }
     }
-    Mat4 result{};
+    Mat4<T> result{};
     for (int i = 0; i < 4; ++i)
         for (int j = 0; j < 4; ++j)
             result[i][j] = aug[i][4 + j];
-    return Transform(result);
+    return result;
+}
+
+/// Inverse of the top 3×4 block of an affine matrix, via the adjugate.
+template <typename T>
+static Mat4<T> affineInverse(const Mat4<T>& m) {
+    const T c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+    const T c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+    const T c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+    const T det = m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02;
+    const T bound = columnNorm(m, 0) * columnNorm(m, 1) * columnNorm(m, 2);
+    if (!(std::abs(det) > SingularEps<T> * bound))
+        throw std::runtime_error("Transform matrix is singular");
+    const T inv = T(1) / det;
+
+    Mat4<T> r = detail::identity4x4<T>();
+    r[0][0] = c00 * inv;
+    r[1][0] = c01 * inv;
+    r[2][0] = c02 * inv;
+    r[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * inv;
+    r[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * inv;
+    r[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * inv;
+    r[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * inv;
+    r[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * inv;
+    r[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * inv;
+    for (int i = 0; i < 3; ++i)
+        r[i][3] = -(r[i][0] * m[0][3] + r[i][1] * m[1][3] + r[i][2] * m[2][3]);
+    return r;
+}
+
+template <typename T>
+BasicTransform<T> BasicTransform<T>::inverse() const {
+    switch (m_kind) {
+        case TransformKind::Identity:
+            return *this;
+
+        case TransformKind::Translation:
+            return translation(-m[0][3], -m[1][3], -m[2][3]);
+
+        case TransformKind::Scale:
+            if (m[0][0] == T(0) || m[1][1] == T(0) || m[2][2] == T(0))
+                throw std::runtime_error("Transform matrix is singular");
+            return scale(T(1) / m[0][0], T(1) / m[1][1], T(1) / m[2][2]);
+
+        case TransformKind::Rigid: {
+            // R^-1 = R^T, t' = -R^T t
+            Matrix r = detail::identity4x4<T>();
+            for (int i = 0; i < 3; ++i)
+                for (int j = 0; j < 3; ++j)
+                    r[i][j] = m[j][i];
+            for (int i = 0; i < 3; ++i)
+                r[i][3] = -(r[i][0] * m[0][3] + r[i][1] * m[1][3] + r[i][2] * m[2][3]);
+            return BasicTransform(r, TransformKind::Rigid);
+        }
+
+        case TransformKind::Affine:
+            return BasicTransform(affineInverse(m), TransformKind::Affine);
+
+        case TransformKind::Projective:
+            break;
+    }
+    return BasicTransform(gaussJordanInverse(m), TransformKind::Projective);
 }
 
+template <typename T>
+void BasicTransform<T>::inverseBatch(const std::vector<BasicTransform>& in,
+                                     std::vector<BasicTransform>& out, ThreadPool& pool) {
+    out.resize(in.size());
+    pool.parallelTransform(in.begin(), in.end(), out.begin(),
+                           [](const BasicTransform& t) { return t.inverse(); }, 1024);
+}
+
+// Instantiates the members defined above; applyBatch is instantiated in
+// transform_batch.cpp alongside its kernels.
+template class BasicTransform<float>;
+template class BasicTransform<double>;
+
 } // namespace geometry
@@ -0,0 +1,410 @@
+#include "geometry/transform.h"
+#include "geometry/point_buffer.h"
+#include "geometry/thread_pool.h"
+#include "io/metrics.h"
+#include <algorithm>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define GEOMETRY_X86_SIMD 1
+#endif
+
+namespace geometry {
+
+// ── kernels ──────────────────────────────────────────────────────────────────
+//
+// Each SIMD kernel specialises on the transform kind exactly as
+// Transform::apply() does: affine rows evaluate ((m0*x + m1*y) + m2*z) + m3
+// with no divide, projective rows divide by w, translations and scales touch
+// only the diagonal / last column.  Remainders go through apply() itself.
+// Inputs and outputs may alias.
+
+namespace {
+
+template <typename T>
+struct Columns {
+    const T*    ix; const T* iy; const T* iz;
+    T*          ox; T*       oy; T*       oz;
+    std::size_t n;
+};
+
+template <typename T>
+void applyScalar(const BasicTransform<T>& t, const Columns<T>& c, std::size_t begin) {
+    for (std::size_t i = begin; i < c.n; ++i) {
+        const BasicPoint<T> p = t.apply(BasicPoint<T>(c.ix[i], c.iy[i], c.iz[i]));
+        c.ox[i] = p.x();
+        c.oy[i] = p.y();
+        c.oz[i] = p.z();
+    }
+}
+
+template <typename T>
+void applyScalarAll(const BasicTransform<T>& t, const Columns<T>& c) { applyScalar(t, c, 0); }
+
+#ifdef GEOMETRY_X86_SIMD
+
+// The SSE2 and AVX2 kernels are spelled out separately: GCC will not inline
+// target-specific intrinsics into a shared template, and the kernels are
+// short enough that the duplication is easier to read than a macro.
+
+inline __m128d rowSse2(const __m128d* r, __m128d x, __m128d y, __m128d z) {
+    __m128d acc = _mm_mul_pd(r[0], x);
+    acc = _mm_add_pd(acc, _mm_mul_pd(r[1], y));
+    acc = _mm_add_pd(acc, _mm_mul_pd(r[2], z));
+    return _mm_add_pd(acc, r[3]);
+}
+
+void applySse2(const Transform& t, const Columns<double>& c) {
+    const auto& m = t.matrix();
+    __m128d r[4][4];
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+            r[i][j] = _mm_set1_pd(m[i][j]);
+
+    std::size_t i = 0;
+    switch (t.kind()) {
+        case TransformKind::Identity:
+            break;  // the scalar remainder loop copies
+
+        case TransformKind::Translation:
+            for (; i + 2 <= c.n; i += 2) {
+                _mm_storeu_pd(c.ox + i, _mm_add_pd(_mm_loadu_pd(c.ix + i), r[0][3]));
+                _mm_storeu_pd(c.oy + i, _mm_add_pd(_mm_loadu_pd(c.iy + i), r[1][3]));
+                _mm_storeu_pd(c.oz + i, _mm_add_pd(_mm_loadu_pd(c.iz + i), r[2][3]));
+            }
+            break;
+
+        case TransformKind::Scale:
+            for (; i + 2 <= c.n; i += 2) {
+                _mm_storeu_pd(c.ox + i, _mm_mul_pd(_mm_loadu_pd(c.ix + i), r[0][0]));
+                _mm_storeu_pd(c.oy + i, _mm_mul_pd(_mm_loadu_pd(c.iy + i), r[1][1]));
+                _mm_storeu_pd(c.oz + i, _mm_mul_pd(_mm_loadu_pd(c.iz + i), r[2][2]));
+            }
+            break;
+
+        case TransformKind::Rigid:
+        case TransformKind::Affine:
+            for (; i + 2 <= c.n; i += 2) {
+                const __m128d x = _mm_loadu_pd(c.ix + i);
+                const __m128d y = _mm_loadu_pd(c.iy + i);
+                const __m128d z = _mm_loadu_pd(c.iz + i);
+                _mm_storeu_pd(c.ox + i, rowSse2(r[0], x, y, z));
+                _mm_storeu_pd(c.oy + i, rowSse2(r[1], x, y, z));
+                _mm_storeu_pd(c.oz + i, rowSse2(r[2], x, y, z));
+            }
+            break;
+
+        case TransformKind::Projective:
+            for (; i + 2 <= c.n; i += 2) {
+                const __m128d x = _mm_loadu_pd(c.ix + i);
+                const __m128d y = _mm_loadu_pd(c.iy + i);
+                const __m128d z = _mm_loadu_pd(c.iz + i);
+                const __m128d w = rowSse2(r[3], x, y, z);
+                _mm_storeu_pd(c.ox + i, _mm_div_pd(rowSse2(r[0], x, y, z), w));
+                _mm_storeu_pd(c.oy + i, _mm_div_pd(rowSse2(r[1], x, y, z), w));
+                _mm_storeu_pd(c.oz + i, _mm_div_pd(rowSse2(r[2], x, y, z), w));
+            }
+            break;
+    }
+    applyScalar(t, c, i);
+}
+
+__attribute__((target("avx2")))
+inline __m256d rowAvx2(const __m256d* r, __m256d x, __m256d y, __m256d z) {
+    __m256d acc = _mm256_mul_pd(r[0], x);
+    acc = _mm256_add_pd(acc, _mm256_mul_pd(r[1], y));
+    acc = _mm256_add_pd(acc, _mm256_mul_pd(r[2], z));
+    return _mm256_add_pd(acc, r[3]);
+}
+
+__attribute__((target("avx2")))
+void applyAvx2(const Transform& t, const Columns<double>& c) {
+    const auto& m = t.matrix();
+    __m256d r[4][4];
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+            r[i][j] = _mm256_set1_pd(m[i][j]);
+
+    std::size_t i = 0;
+    switch (t.kind()) {
+        case TransformKind::Identity:
+            break;
+
+        case TransformKind::Translation:
+            for (; i + 4 <= c.n; i += 4) {
+                _mm256_storeu_pd(c.ox + i, _mm256_add_pd(_mm256_loadu_pd(c.ix + i), r[0][3]));
+                _mm256_storeu_pd(c.oy + i, _mm256_add_pd(_mm256_loadu_pd(c.iy + i), r[1][3]));
+                _mm256_storeu_pd(c.oz + i, _mm256_add_pd(_mm256_loadu_pd(c.iz + i), r[2][3]));
+            }
+            break;
+
+        case TransformKind::Scale:
+            for (; i + 4 <= c.n; i += 4) {
+                _mm256_storeu_pd(c.ox + i, _mm256_mul_pd(_mm256_loadu_pd(c.ix + i), r[0][0]));
+                _mm256_storeu_pd(c.oy + i, _mm256_mul_pd(_mm256_loadu_pd(c.iy + i), r[1][1]));
+                _mm256_storeu_pd(c.oz + i, _mm256_mul_pd(_mm256_loadu_pd(c.iz + i), r[2][2]));
+            }
+            break;
+
+        case TransformKind::Rigid:
+        case TransformKind::Affine:
+            for (; i + 4 <= c.n; i += 4) {
+                const __m256d x = _mm256_loadu_pd(c.ix + i);
+                const __m256d y = _mm256_loadu_pd(c.iy + i);
+                const __m256d z = _mm256_loadu_pd(c.iz + i);
+                _mm256_storeu_pd(c.ox + i, rowAvx2(r[0], x, y, z));
+                _mm256_storeu_pd(c.oy + i, rowAvx2(r[1], x, y, z));
+                _mm256_storeu_pd(c.oz + i, rowAvx2(r[2], x, y, z));
+            }
+            break;
+
+        case TransformKind::Projective:
+            for (; i + 4 <= c.n; i += 4) {
+                const __m256d x = _mm256_loadu_pd(c.ix + i);
+                const __m256d y = _mm256_loadu_pd(c.iy + i);
+                const __m256d z = _mm256_loadu_pd(c.iz + i);
+                const __m256d w = rowAvx2(r[3], x, y, z);
+                _mm256_storeu_pd(c.ox + i, _mm256_div_pd(rowAvx2(r[0], x, y, z), w));
+                _mm256_storeu_pd(c.oy + i, _mm256_div_pd(rowAvx2(r[1], x, y, z), w));
+                _mm256_storeu_pd(c.oz + i, _mm256_div_pd(rowAvx2(r[2], x, y, z), w));
+            }
+            break;
+    }
+    applyScalar(t, c, i);
+}
+
+// Single-precision kernels: the same operations on twice as many lanes
+// (4 per SSE register, 8 per AVX register).
+
+inline __m128 rowSse2F(const __m128* r, __m128 x, __m128 y, __m128 z) {
+    __m128 acc = _mm_mul_ps(r[0], x);
+    acc = _mm_add_ps(acc, _mm_mul_ps(r[1], y));
+    acc = _mm_add_ps(acc, _mm_mul_ps(r[2], z));
+    return _mm_add_ps(acc, r[3]);
+}
+
+void applySse2F(const TransformF& t, const Columns<float>& c) {
+    const auto& m = t.matrix();
+    __m128 r[4][4];
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+            r[i][j] = _mm_set1_ps(m[i][j]);
+
+    std::size_t i = 0;
+    switch (t.kind()) {
+        case TransformKind::Identity:
+            break;  // the scalar remainder loop copies
+
+        case TransformKind::Translation:
+            for (; i + 4 <= c.n; i += 4) {
+                _mm_storeu_ps(c.ox + i, _mm_add_ps(_mm_loadu_ps(c.ix + i), r[0][3]));
+                _mm_storeu_ps(c.oy + i, _mm_add_ps(_mm_loadu_ps(c.iy + i), r[1][3]));
+                _mm_storeu_ps(c.oz + i, _mm_add_ps(_mm_loadu_ps(c.iz + i), r[2][3]));
+            }
+            break;
+
+        case TransformKind::Scale:
+            for (; i + 4 <= c.n; i += 4) {
+                _mm_storeu_ps(c.ox + i, _mm_mul_ps(_mm_loadu_ps(c.ix + i), r[0][0]));
+                _mm_storeu_ps(c.oy + i, _mm_mul_ps(_mm_loadu_ps(c.iy + i), r[1][1]));
+                _mm_storeu_ps(c.oz + i, _mm_mul_ps(_mm_loadu_ps(c.iz + i), r[2][2]));
+            }
+            break;
+
+        case TransformKind::Rigid:
+        case TransformKind::Affine:
+            for (; i + 4 <= c.n; i += 4) {
+                const __m128 x = _mm_loadu_ps(c.ix + i);
+                const __m128 y = _mm_loadu_ps(c.iy + i);
+                const __m128 z = _mm_loadu_ps(c.iz + i);
+                _mm_storeu_ps(c.ox + i, rowSse2F(r[0], x, y, z));
+                _mm_storeu_ps(c.oy + i, rowSse2F(r[1], x, y, z));
+                _mm_storeu_ps(c.oz + i, rowSse2F(r[2], x, y, z));
+            }
+            break;
+
+        case TransformKind::Projective:
+            for (; i + 4 <= c.n; i += 4) {
+                const __m128 x = _mm_loadu_ps(c.ix + i);
+                const __m128 y = _mm_loadu_ps(c.iy + i);
+                const __m128 z = _mm_loadu_ps(c.iz + i);
+                const __m128 w = rowSse2F(r[3], x, y, z);
+                _mm_storeu_ps(c.ox + i, _mm_div_ps(rowSse2F(r[0], x, y, z), w));
+                _mm_storeu_ps(c.oy + i, _mm_div_ps(rowSse2F(r[1], x, y, z), w));
+                _mm_storeu_ps(c.oz + i, _mm_div_ps(rowSse2F(r[2], x, y, z), w));
+            }
+            break;
+    }
+    applyScalar(t, c, i);
+}
+
+__attribute__((target("avx2")))
+inline __m256 rowAvx2F(const __m256* r, __m256 x, __m256 y, __m256 z) {
+    __m256 acc = _mm256_mul_ps(r[0], x);
+    acc = _mm256_add_ps(acc, _mm256_mul_ps(r[1], y));
+    acc = _mm256_add_ps(acc, _mm256_mul_ps(r[2], z));
+    return _mm256_add_ps(acc, r[3]);
+}
+
+__attribute__((target("avx2")))
+void applyAvx2F(const TransformF& t, const Columns<float>& c) {
+    const auto& m = t.matrix();
+    __m256 r[4][4];
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+            r[i][j] = _mm256_set1_ps(m[i][j]);
+
+    std::size_t i = 0;
+    switch (t.kind()) {
+        case TransformKind::Identity:
+            break;
+
+        case TransformKind::Translation:
+            for (; i + 8 <= c.n; i += 8) {
+                _mm256_storeu_ps(c.ox + i, _mm256_add_ps(_mm256_loadu_ps(c.ix + i), r[0][3]));
+                _mm256_storeu_ps(c.oy + i, _mm256_add_ps(_mm256_loadu_ps(c.iy + i), r[1][3]));
+                _mm256_storeu_ps(c.oz + i, _mm256_add_ps(_mm256_loadu_ps(c.iz + i), r[2][3]));
+            }
+            break;
+
+        case TransformKind::Scale:
+            for (; i + 8 <= c.n; i += 8) {
+                _mm256_storeu_ps(c.ox + i, _mm256_mul_ps(_mm256_loadu_ps(c.ix + i), r[0][0]));
+                _mm256_storeu_ps(c.oy + i, _mm256_mul_ps(_mm256_loadu_ps(c.iy + i), r[1][1]));
+                _mm256_storeu_ps(c.oz + i, _mm256_mul_ps(_mm256_loadu_ps(c.iz + i), r[2][2]));
+            }
+            break;
+
+        case TransformKind::Rigid:
+        case TransformKind::Affine:
+            for (; i + 8 <= c.n; i += 8) {
+                const __m256 x = _mm256_loadu_ps(c.ix + i);
+                const __m256 y = _mm256_loadu_ps(c.iy + i);
+                const __m256 z = _mm256_loadu_ps(c.iz + i);
+                _mm256_storeu_ps(c.ox + i, rowAvx2F(r[0], x, y, z));
+                _mm256_storeu_ps(c.oy + i, rowAvx2F(r[1], x, y, z));
+                _mm256_storeu_ps(c.oz + i, rowAvx2F(r[2], x, y, z));
+            }
+            break;
+
+        case TransformKind::Projective:
+            for (; i + 8 <= c.n; i += 8) {
+                const __m256 x = _mm256_loadu_ps(c.ix + i);
+                const __m256 y = _mm256_loadu_ps(c.iy + i);
+                const __m256 z = _mm256_loadu_ps(c.iz + i);
+                const __m256 w = rowAvx2F(r[3], x, y, z);
+                _mm256_storeu_ps(c.ox + i, _mm256_div_ps(rowAvx2F(r[0], x, y, z), w));
+                _mm256_storeu_ps(c.oy + i, _mm256_div_ps(rowAvx2F(r[1], x, y, z), w));
+                _mm256_storeu_ps(c.oz + i, _mm256_div_ps(rowAvx2F(r[2], x, y, z), w));
+            }
+            break;
+    }
+    applyScalar(t, c, i);
+}
+
+#endif // GEOMETRY_X86_SIMD
+
+template <typename T>
+using KernelFn = void (*)(const BasicTransform<T>&, const Columns<T>&);
+
+template <typename T>
+KernelFn<T> selectKernel();
+
+template <>
+KernelFn<double> selectKernel<double>() {
+#ifdef GEOMETRY_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return applyAvx2;
+    if (__builtin_cpu_supports("sse2")) return applySse2;
+#endif
+    return applyScalarAll<double>;
+}
+
+template <>
+KernelFn<float> selectKernel<float>() {
+#ifdef GEOMETRY_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return applyAvx2F;
+    if (__builtin_cpu_supports("sse2")) return applySse2F;
+#endif
+    return applyScalarAll<float>;
+}
+
+template <typename T>
+KernelFn<T> kernelFor() {
+    static const KernelFn<T> kernel = selectKernel<T>();
+    return kernel;
+}
+
+/// Smallest block handed to one thread: big enough to amortise scheduling.
+constexpr std::size_t ParallelGrain = 16384;
+
+} // namespace
+
+// ── Transform batch API ──────────────────────────────────────────────────────
+
+template <typename T>
+void BasicTransform<T>::applyBatch(Buffer& points) const {
+    if (m_kind == TransformKind::Identity) return;
+    applyBatch(points, points);
+}
+
+template <typename T>
+void BasicTransform<T>::applyBatch(const Buffer& in, Buffer& out) const {
+    IO_METRICS_TIME("transform.apply_batch");
+    IO_METRICS_COUNT("transform.apply_batch.points", in.size());
+    if (&in != &out) out.resize(in.size());
+    const Columns<T> c{in.x(), in.y(), in.z(), out.x(), out.y(), out.z(), in.size()};
+    kernelFor<T>()(*this, c);
+}
+
+template <typename T>
+void BasicTransform<T>::applyBatch(Buffer& points, ThreadPool& pool) const {
+    if (m_kind == TransformKind::Identity) return;
+    applyBatch(points, points, pool);
+}
+
+template <typename T>
+void BasicTransform<T>::applyBatch(const Buffer& in, Buffer& out, ThreadPool& pool) const {
+    IO_METRICS_TIME("transform.apply_batch_parallel");
+    IO_METRICS_COUNT("transform.apply_batch.points", in.size());
+    const KernelFn<T> kernel = kernelFor<T>();
+    if (&in != &out) out.resize(in.size());
+    const Columns<T> all{in.x(), in.y(), in.z(), out.x(), out.y(), out.z(), in.size()};
+
+    // Blocks are whole cache lines so neighbouring threads never share one.
+    constexpr std::size_t lineMask = Buffer::Alignment / sizeof(T) - 1;
+    const std::size_t perThread = in.size() / (pool.concurrency() * 8);
+    const std::size_t grain = std::max<std::size_t>(ParallelGrain, (perThread + lineMask) & ~lineMask);
+    pool.parallelFor(0, in.size(), [&](std::size_t first, std::size_t last) {
+        const Columns<T> c{all.ix + first, all.iy + first, all.iz + first,
+                           all.ox + first, all.oy + first, all.oz + first, last - first};
+        kernel(*this, c);
+    }, grain);
+}
+
+template <typename T>
+void BasicTransform<T>::applyBatch(const T* x, const T* y, const T* z, std::size_t n,
+                                   Buffer& out) const {
+    IO_METRICS_TIME("transform.apply_batch");
+    IO_METRICS_COUNT("transform.apply_batch.points", n);
+    out.resize(n);
+    const Columns<T> c{x, y, z, out.x(), out.y(), out.z(), n};
+    kernelFor<T>()(*this, c);
+}
+
+// The rest of BasicTransform is instantiated in transform.cpp.
+#define GEOMETRY_INSTANTIATE_APPLY_BATCH(T)                                                       \
+    template void BasicTransform<T>::applyBatch(Buffer&) const;                                   \
+    template void BasicTransform<T>::applyBatch(const Buffer&, Buffer&) const;                    \
+    template void BasicTransform<T>::applyBatch(const T*, const T*, const T*, std::size_t,        \
+                                                Buffer&) const;                                   \
+    template void BasicTransform<T>::applyBatch(Buffer&, ThreadPool&) const;                      \
+    template void BasicTransform<T>::applyBatch(const Buffer&, Buffer&, ThreadPool&) const;
+
+GEOMETRY_INSTANTIATE_APPLY_BATCH(float)
+GEOMETRY_INSTANTIATE_APPLY_BATCH(double)
+
+#undef GEOMETRY_INSTANTIATE_APPLY_BATCH
+
+} // namespace geometry
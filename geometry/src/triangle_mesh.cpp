@@ -0,0 +1,256 @@
+#include "geometry/triangle_mesh.h"
+#include "geometry/thread_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace geometry {
+
+// ── construction ─────────────────────────────────────────────────────────────
+
+TriangleMesh::TriangleMesh(PointBuffer vertices, std::vector<Index> indices)
+    : m_vertices(std::move(vertices)), m_indices(std::move(indices))
+{
+    if (m_indices.size() % 3 != 0)
+        throw std::invalid_argument("TriangleMesh: index count must be a multiple of 3");
+    const std::size_t n = m_vertices.size();
+    if (std::any_of(m_indices.begin(), m_indices.end(), [n](Index i) { return i >= n; }))
+        throw std::invalid_argument("TriangleMesh: vertex index out of range");
+}
+
+TriangleMesh::Index TriangleMesh::addVertex(const Point& p) {
+    m_vertices.push_back(p);
+    return static_cast<Index>(m_vertices.size() - 1);
+}
+
+void TriangleMesh::addFace(Index a, Index b, Index c) {
+    const std::size_t n = m_vertices.size();
+    if (a >= n || b >= n || c >= n)
+        throw std::invalid_argument("TriangleMesh: vertex index out of range");
+    m_indices.insert(m_indices.end(), {a, b, c});
+}
+
+void TriangleMesh::reserve(std::size_t vertices, std::size_t faces) {
+    m_vertices.reserve(vertices);
+    m_indices.reserve(faces * 3);
+}
+
+Triangle TriangleMesh::face(std::size_t f) const {
+    const Index* i = &m_indices.at(f * 3);
+    return Triangle(m_vertices[i[0]], m_vertices[i[1]], m_vertices[i[2]]);
+}
+
+// ── face kernels ─────────────────────────────────────────────────────────────
+//
+// Faces are processed in blocks: a scalar loop gathers the three vertices
+// of each face through the index buffer into local columns, then
+// branch-free loops over those columns do the arithmetic, which the
+// compiler can vectorise.
+
+namespace {
+
+constexpr std::size_t Block = 256;
+
+/// Smallest range of faces handed to one thread.
+constexpr std::size_t ParallelGrain = 16 * Block;
+
+struct FaceBlock {
+    std::size_t n;
+    double ax[Block], ay[Block], az[Block];
+    double nx[Block], ny[Block], nz[Block];   ///< AB × AC
+    double sx[Block], sy[Block], sz[Block];   ///< A + B + C (centroid only)
+};
+
+/// Gather faces [first, first + n) and compute their cross products;
+/// with \p sums also the vertex sums.
+void gather(const PointBuffer& v, const TriangleMesh::Index* idx, std::size_t first, std::size_t n,
+            FaceBlock& b, bool sums) {
+    const double* x = v.x();
+    const double* y = v.y();
+    const double* z = v.z();
+    double bx[Block], by[Block], bz[Block], cx[Block], cy[Block], cz[Block];
+    b.n = n;
+    for (std::size_t k = 0; k < n; ++k) {
+        const TriangleMesh::Index* f = idx + (first + k) * 3;
+        b.ax[k] = x[f[0]]; b.ay[k] = y[f[0]]; b.az[k] = z[f[0]];
+        bx[k]   = x[f[1]]; by[k]   = y[f[1]]; bz[k]   = z[f[1]];
+        cx[k]   = x[f[2]]; cy[k]   = y[f[2]]; cz[k]   = z[f[2]];
+    }
+    for (std::size_t k = 0; k < n; ++k) {
+        const double ux = bx[k] - b.ax[k], uy = by[k] - b.ay[k], uz = bz[k] - b.az[k];
+        const double vx = cx[k] - b.ax[k], vy = cy[k] - b.ay[k], vz = cz[k] - b.az[k];
+        b.nx[k] = uy * vz - uz * vy;
+        b.ny[k] = uz * vx - ux * vz;
+        b.nz[k] = ux * vy - uy * vx;
+    }
+    if (sums) {
+        for (std::size_t k = 0; k < n; ++k) {
+            b.sx[k] = b.ax[k] + bx[k] + cx[k];
+            b.sy[k] = b.ay[k] + by[k] + cy[k];
+            b.sz[k] = b.az[k] + bz[k] + cz[k];
+        }
+    }
+}
+
+/// Call fn(const FaceBlock&, firstFace) for every block of [first, last).
+template <typename Fn>
+void forEachBlock(const TriangleMesh& m, std::size_t first, std::size_t last, bool sums, Fn&& fn) {
+    FaceBlock b;
+    for (std::size_t f = first; f < last; f += Block) {
+        gather(m.vertices(), m.indices().data(), f, std::min(Block, last - f), b, sums);
+        fn(b, f);
+    }
+}
+
+void areasRange(const TriangleMesh& m, std::size_t first, std::size_t last, double* out) {
+    forEachBlock(m, first, last, false, [out](const FaceBlock& b, std::size_t f) {
+        for (std::size_t k = 0; k < b.n; ++k)
+            out[f + k] = 0.5 * std::sqrt(b.nx[k] * b.nx[k] + b.ny[k] * b.ny[k] + b.nz[k] * b.nz[k]);
+    });
+}
+
+void normalsRange(const TriangleMesh& m, std::size_t first, std::size_t last, PointBuffer& out) {
+    double* ox = out.x();
+    double* oy = out.y();
+    double* oz = out.z();
+    forEachBlock(m, first, last, false, [&](const FaceBlock& b, std::size_t f) {
+        for (std::size_t k = 0; k < b.n; ++k) {
+            const double len = std::sqrt(b.nx[k] * b.nx[k] + b.ny[k] * b.ny[k] + b.nz[k] * b.nz[k]);
+            const double inv = len > 0.0 ? 1.0 / len : 0.0;
+            ox[f + k] = b.nx[k] * inv;
+            oy[f + k] = b.ny[k] * inv;
+            oz[f + k] = b.nz[k] * inv;
+        }
+    });
+}
+
+/// Sum of |AB × AC| over [first, last), i.e. twice the area.
+double twiceAreaSum(const TriangleMesh& m, std::size_t first, std::size_t last) {
+    double sum = 0.0;
+    forEachBlock(m, first, last, false, [&](const FaceBlock& b, std::size_t) {
+        for (std::size_t k = 0; k < b.n; ++k)
+            sum += std::sqrt(b.nx[k] * b.nx[k] + b.ny[k] * b.ny[k] + b.nz[k] * b.nz[k]);
+    });
+    return sum;
+}
+
+/// Area-weighted vertex sums: Σ 2A·(a+b+c) per axis and Σ 2A.
+struct Moments {
+    double x = 0.0, y = 0.0, z = 0.0, w = 0.0;
+};
+
+Moments momentsRange(const TriangleMesh& m, std::size_t first, std::size_t last) {
+    Moments s;
+    forEachBlock(m, first, last, true, [&](const FaceBlock& b, std::size_t) {
+        for (std::size_t k = 0; k < b.n; ++k) {
+            const double w = std::sqrt(b.nx[k] * b.nx[k] + b.ny[k] * b.ny[k] + b.nz[k] * b.nz[k]);
+            s.x += w * b.sx[k];
+            s.y += w * b.sy[k];
+            s.z += w * b.sz[k];
+            s.w += w;
+        }
+    });
+    return s;
+}
+
+Point centroidOf(const Moments& s) {
+    if (s.w == 0.0) throw std::domain_error("TriangleMesh: centroid of a surface with zero area");
+    // Each face contributes (a + b + c) / 3 weighted by its area.
+    const double scale = 1.0 / (3.0 * s.w);
+    return Point(s.x * scale, s.y * scale, s.z * scale);
+}
+
+} // namespace
+
+void TriangleMesh::faceAreas(double* out) const noexcept {
+    areasRange(*this, 0, faceCount(), out);
+}
+
+std::vector<double> TriangleMesh::faceAreas() const {
+    std::vector<double> out(faceCount());
+    faceAreas(out.data());
+    return out;
+}
+
+void TriangleMesh::faceNormals(PointBuffer& out) const {
+    out.resize(faceCount());
+    normalsRange(*this, 0, faceCount(), out);
+}
+
+void TriangleMesh::vertexNormals(PointBuffer& out) const {
+    out.resize(vertexCount());
+    double* ox = out.x();
+    double* oy = out.y();
+    double* oz = out.z();
+    std::fill(ox, ox + vertexCount(), 0.0);
+    std::fill(oy, oy + vertexCount(), 0.0);
+    std::fill(oz, oz + vertexCount(), 0.0);
+
+    // AB × AC has length 2·area, so summing it weights faces by area.
+    // The scatter is serial: faces sharing a vertex would race.
+    const Index* idx = m_indices.data();
+    forEachBlock(*this, 0, faceCount(), false, [&](const FaceBlock& b, std::size_t f) {
+        for (std::size_t k = 0; k < b.n; ++k) {
+            const Index* v = idx + (f + k) * 3;
+            for (int j = 0; j < 3; ++j) {
+                ox[v[j]] += b.nx[k];
+                oy[v[j]] += b.ny[k];
+                oz[v[j]] += b.nz[k];
+            }
+        }
+    });
+    for (std::size_t i = 0; i < vertexCount(); ++i) {
+        const double len = std::sqrt(ox[i] * ox[i] + oy[i] * oy[i] + oz[i] * oz[i]);
+        const double inv = len > 0.0 ? 1.0 / len : 0.0;
+        ox[i] *= inv;
+        oy[i] *= inv;
+        oz[i] *= inv;
+    }
+}
+
+double TriangleMesh::surfaceArea() const noexcept {
+    return 0.5 * twiceAreaSum(*this, 0, faceCount());
+}
+
+Point TriangleMesh::centroid() const {
+    return centroidOf(momentsRange(*this, 0, faceCount()));
+}
+
+void TriangleMesh::transform(const Transform& t) {
+    t.applyBatch(m_vertices);
+}
+
+// ── parallel kernels ─────────────────────────────────────────────────────────
+
+void TriangleMesh::faceAreas(double* out, ThreadPool& pool) const {
+    pool.parallelFor(0, faceCount(), [&](std::size_t b, std::size_t e) {
+        areasRange(*this, b, e, out);
+    }, ParallelGrain);
+}
+
+void TriangleMesh::faceNormals(PointBuffer& out, ThreadPool& pool) const {
+    out.resize(faceCount());
+    pool.parallelFor(0, faceCount(), [&](std::size_t b, std::size_t e) {
+        normalsRange(*this, b, e, out);
+    }, ParallelGrain);
+}
+
+double TriangleMesh::surfaceArea(ThreadPool& pool) const {
+    return 0.5 * pool.parallelReduce(0, faceCount(), 0.0,
+        [&](std::size_t b, std::size_t e) { return twiceAreaSum(*this, b, e); },
+        [](double a, double b) { return a + b; }, ParallelGrain);
+}
+
+Point TriangleMesh::centroid(ThreadPool& pool) const {
+    return centroidOf(pool.parallelReduce(0, faceCount(), Moments{},
+        [&](std::size_t b, std::size_t e) { return momentsRange(*this, b, e); },
+        [](const Moments& a, const Moments& b) {
+            return Moments{a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w};
+        }, ParallelGrain));
+}
+
+void TriangleMesh::transform(const Transform& t, ThreadPool& pool) {
+    t.applyBatch(m_vertices, pool);
+}
+
+} // namespace geometry
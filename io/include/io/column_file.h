@@ -0,0 +1,179 @@
+#pragma once
+
+#include "file_writer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace io {
+
+// ── On-disk layout (version 1, little-endian) ────────────────────────────────
+//
+//   offset 0    ColumnFileHeader                      64 bytes
+//   offset 64   ColumnFileEntry × columnCount         64 bytes each
+//   ...         column blocks, each starting on a ColumnFileAlignment
+//               boundary, zero padding in between
+//
+// The index sits in the header so a reader can locate every column without
+// touching the data pages.
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "io/column_file.h: the column file format is little-endian only"
+#endif
+
+constexpr std::uint32_t ColumnFileVersion   = 1;
+constexpr std::size_t   ColumnFileAlignment = 64;
+constexpr std::size_t   ColumnNameSize      = 32;
+
+enum class ColumnType : std::uint32_t {
+    Float64 = 1,
+    Int64   = 2,
+    UInt32  = 3,
+    UInt8   = 4
+};
+
+struct ColumnFileHeader {
+    char          magic[8];        ///< "IOCOLS\0\1"
+    std::uint32_t version;
+    std::uint32_t columnCount;
+    std::uint64_t indexOffset;
+    std::uint64_t fileSize;
+    char          schema[32];      ///< Free-form tag, e.g. "geometry.points"
+};
+
+struct ColumnFileEntry {
+    char          name[ColumnNameSize];
+    ColumnType    type;
+    std::uint32_t elementSize;
+    std::uint64_t count;
+    std::uint64_t offset;          ///< From the start of the file; aligned
+    std::uint64_t reserved;
+};
+
+static_assert(sizeof(ColumnFileHeader) == 64, "ColumnFileHeader layout");
+static_assert(sizeof(ColumnFileEntry)  == 64, "ColumnFileEntry layout");
+
+/// Maps a C++ element type to its ColumnType tag.
+template <typename T> struct ColumnTypeOf;
+template <> struct ColumnTypeOf<double>        { static constexpr ColumnType value = ColumnType::Float64; };
+template <> struct ColumnTypeOf<std::int64_t>  { static constexpr ColumnType value = ColumnType::Int64; };
+template <> struct ColumnTypeOf<std::uint32_t> { static constexpr ColumnType value = ColumnType::UInt32; };
+template <> struct ColumnTypeOf<std::uint8_t>  { static constexpr ColumnType value = ColumnType::UInt8; };
+
+// ── Writer ───────────────────────────────────────────────────────────────────
+
+/// Writes a column file through FileWriter.
+///
+/// add() only records a pointer; the data must stay alive until finish(),
+/// which lays out the index and streams every column in one pass.
+class ColumnFileWriter {
+public:
+    ColumnFileWriter(const std::string& path, std::string_view schema,
+                     const WriterOptions& options = {});
+
+    ColumnFileWriter(const ColumnFileWriter&)            = delete;
+    ColumnFileWriter& operator=(const ColumnFileWriter&) = delete;
+
+    /// Register a column.  Throws std::invalid_argument for duplicate names
+    /// or names that do not fit in ColumnNameSize - 1 bytes.
+    template <typename T>
+    void add(std::string_view name, const T* data, std::size_t count) {
+        addRaw(name, ColumnTypeOf<T>::value, sizeof(T), data, count);
+    }
+
+    template <typename T, typename Alloc>
+    void add(std::string_view name, const std::vector<T, Alloc>& column) {
+        add(name, column.data(), column.size());
+    }
+
+    /// Write the header, index and columns, then flush.
+    void finish();
+
+    std::size_t bytesWritten() const noexcept { return m_writer.bytesWritten(); }
+
+private:
+    struct Pending {
+        ColumnFileEntry entry;
+        const void*     data;
+    };
+
+    void addRaw(std::string_view name, ColumnType type, std::size_t elementSize,
+                const void* data, std::size_t count);
+
+    FileWriter           m_writer;
+    std::string          m_schema;
+    std::vector<Pending> m_columns;
+    bool                 m_finished{false};
+};
+
+// ── Reader ───────────────────────────────────────────────────────────────────
+
+/// Read-only, zero-copy view of one column.
+template <typename T>
+class ColumnView {
+public:
+    ColumnView() = default;
+    ColumnView(const T* data, std::size_t size) : m_data(data), m_size(size) {}
+
+    const T*    data()  const noexcept { return m_data; }
+    std::size_t size()  const noexcept { return m_size; }
+    bool        empty() const noexcept { return m_size == 0; }
+    const T*    begin() const noexcept { return m_data; }
+    const T*    end()   const noexcept { return m_data + m_size; }
+    const T& operator[](std::size_t i) const noexcept { return m_data[i]; }
+
+private:
+    const T*    m_data{nullptr};
+    std::size_t m_size{0};
+};
+
+/// Memory-mapped column file.
+///
+/// Opening validates the header and index only; column pages are faulted
+/// in by the kernel on first access, so opening a multi-GB file costs a
+/// few system calls.  Views stay valid for the lifetime of the object.
+/// Throws std::runtime_error for missing, truncated or malformed files.
+class MappedColumnFile {
+public:
+    explicit MappedColumnFile(const std::string& path);
+    ~MappedColumnFile();
+
+    MappedColumnFile(MappedColumnFile&& other) noexcept;
+    MappedColumnFile& operator=(MappedColumnFile&& other) noexcept;
+    MappedColumnFile(const MappedColumnFile&)            = delete;
+    MappedColumnFile& operator=(const MappedColumnFile&) = delete;
+
+    std::string_view schema()      const noexcept;
+    std::size_t      columnCount() const noexcept { return m_entryCount; }
+    std::size_t      fileSize()    const noexcept { return m_size; }
+
+    const ColumnFileEntry& entry(std::size_t i) const noexcept { return m_entries[i]; }
+    bool has(std::string_view name) const noexcept { return find(name) != nullptr; }
+
+    /// Throws std::runtime_error if the column is missing or has another type.
+    template <typename T>
+    ColumnView<T> column(std::string_view name) const {
+        const ColumnFileEntry& e = require(name, ColumnTypeOf<T>::value, sizeof(T));
+        return ColumnView<T>(reinterpret_cast<const T*>(m_base + e.offset),
+                             static_cast<std::size_t>(e.count));
+    }
+
+    /// Ask the kernel to start reading every column in the background.
+    void prefetch() const noexcept;
+
+private:
+    const ColumnFileEntry* find(std::string_view name) const noexcept;
+    const ColumnFileEntry& require(std::string_view name, ColumnType type,
+                                   std::size_t elementSize) const;
+    void release() noexcept;
+
+    const unsigned char*   m_base{nullptr};
+    std::size_t            m_size{0};
+    const ColumnFileEntry* m_entries{nullptr};
+    std::size_t            m_entryCount{0};
+};
+
+} // namespace io
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace io {
+
+// ── On-disk layout (version 1, little-endian) ────────────────────────────────
+//
+//   offset 0    CompressedFileHeader                   16 bytes
+//   16          CompressedBlockHeader + payload        one per block
+//   ...         CompressedBlockHeader {0, 0}           end of the blocks
+//               CompressedBlockEntry × blockCount      the index
+//               CompressedFileTrailer                  24 bytes, at the very end
+//
+// Written by FileWriter with WriterOptions::compression; each of the
+// writer's buffers becomes one independently compressed block (see io/lz.h),
+// or is stored as is when compression would not shrink it.  The index and
+// trailer are written when the writer closes, so a reader can locate every
+// block from the end of the file; a file whose writer did not finish has
+// only whole blocks and is read by walking the block headers.
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "io/compressed_file.h: the compressed file format is little-endian only"
+#endif
+
+constexpr std::uint32_t CompressedFileVersion = 1;
+constexpr char          CompressedFileMagic[8]  = {'I', 'O', 'L', 'Z', 'B', '\0', '\0', '\1'};
+constexpr char          CompressedIndexMagic[8] = {'I', 'O', 'L', 'Z', 'I', 'D', 'X', '\1'};
+
+/// Set in CompressedBlockHeader::storedSize for a block kept uncompressed.
+constexpr std::uint32_t CompressedBlockRaw = 0x80000000u;
+
+struct CompressedFileHeader {
+    char          magic[8];        ///< "IOLZB\0\0\1"
+    std::uint32_t version;
+    std::uint32_t blockSize;       ///< Largest decompressed block
+};
+
+struct CompressedBlockHeader {
+    std::uint32_t rawSize;         ///< Decompressed bytes; 0 ends the blocks
+    std::uint32_t storedSize;      ///< Payload bytes, | CompressedBlockRaw if stored
+};
+
+struct CompressedBlockEntry {
+    std::uint64_t offset;          ///< Of the block header, from the start of the file
+    std::uint32_t rawSize;
+    std::uint32_t storedSize;
+};
+
+struct CompressedFileTrailer {
+    std::uint64_t indexOffset;
+    std::uint64_t blockCount;
+    char          magic[8];        ///< "IOLZIDX\1"
+};
+
+static_assert(sizeof(CompressedFileHeader)  == 16, "CompressedFileHeader layout");
+static_assert(sizeof(CompressedBlockHeader) == 8,  "CompressedBlockHeader layout");
+static_assert(sizeof(CompressedBlockEntry)  == 16, "CompressedBlockEntry layout");
+static_assert(sizeof(CompressedFileTrailer) == 24, "CompressedFileTrailer layout");
+
+// ── Streaming reader ─────────────────────────────────────────────────────────
+
+/// Sequential reader that decompresses one block at a time.
+///
+/// Reads with read(2) only, so it also works on pipes and on files still
+/// being written.  Throws std::runtime_error for malformed or truncated
+/// input.
+class CompressedReader {
+public:
+    explicit CompressedReader(const std::string& path);
+    /// Read from \p fd, positioned at the start of the file; the caller keeps ownership.
+    explicit CompressedReader(int fd);
+    ~CompressedReader();
+
+    CompressedReader(const CompressedReader&)            = delete;
+    CompressedReader& operator=(const CompressedReader&) = delete;
+
+    /// Copy up to \p size decompressed bytes into \p dst; returns 0 at the end.
+    std::size_t read(void* dst, std::size_t size);
+
+    /// Next line without its '\n'; false at the end.
+    bool readLine(std::string& line);
+
+    /// Decompressed bytes consumed so far.
+    std::uint64_t position() const noexcept { return m_position; }
+
+private:
+    void open();
+    bool nextBlock();
+    bool readExact(void* dst, std::size_t size, bool atBoundary);
+
+    int               m_fd = -1;
+    bool              m_owned = false;
+    std::uint32_t     m_blockSize = 0;
+    std::vector<char> m_stored;
+    std::vector<char> m_block;
+    std::size_t       m_blockPos = 0;
+    std::size_t       m_blockEnd = 0;
+    std::uint64_t     m_position = 0;
+    bool              m_done = false;
+};
+
+// ── Random-access reader ─────────────────────────────────────────────────────
+
+/// One block of a MappedCompressedFile.
+struct CompressedBlock {
+    std::uint64_t rawOffset;       ///< Position in the decompressed stream
+    std::uint64_t fileOffset;      ///< Of the block header
+    std::uint32_t rawSize;
+    std::uint32_t storedSize;      ///< Payload bytes, without the flag
+    bool          stored;          ///< Kept uncompressed
+};
+
+/// Memory-mapped compressed file with a block index, for seeking and for
+/// decompressing blocks in parallel.
+///
+/// The index comes from the trailer, or from a walk over the block
+/// headers when the writer did not finish.  All reads are const and
+/// thread-safe.  Throws std::runtime_error for missing, truncated or
+/// malformed files.
+class MappedCompressedFile {
+public:
+    explicit MappedCompressedFile(const std::string& path);
+    ~MappedCompressedFile();
+
+    MappedCompressedFile(MappedCompressedFile&& other) noexcept;
+    MappedCompressedFile& operator=(MappedCompressedFile&& other) noexcept;
+    MappedCompressedFile(const MappedCompressedFile&)            = delete;
+    MappedCompressedFile& operator=(const MappedCompressedFile&) = delete;
+
+    /// Decompressed size of the whole stream.
+    std::uint64_t size()       const noexcept { return m_rawSize; }
+    std::size_t   fileSize()   const noexcept { return m_size; }
+    std::uint32_t blockSize()  const noexcept { return m_blockSize; }
+    std::size_t   blockCount() const noexcept { return m_blocks.size(); }
+    /// True when the index came from the trailer of a finished file.
+    bool          indexed()    const noexcept { return m_indexed; }
+
+    const CompressedBlock& block(std::size_t i) const noexcept { return m_blocks[i]; }
+
+    /// Block holding decompressed byte \p offset (blockCount() past the end).
+    std::size_t blockAt(std::uint64_t offset) const noexcept;
+
+    /// Decompress block \p i into \p dst, which must hold block(i).rawSize bytes.
+    void readBlock(std::size_t i, void* dst) const;
+
+    /// Copy decompressed bytes starting at \p offset; returns the count,
+    /// short only at the end of the stream.
+    std::size_t read(std::uint64_t offset, void* dst, std::size_t size) const;
+
+private:
+    void release() noexcept;
+
+    const unsigned char*         m_base{nullptr};
+    std::size_t                  m_size{0};
+    std::uint32_t                m_blockSize{0};
+    std::uint64_t                m_rawSize{0};
+    bool                         m_indexed{false};
+    std::vector<CompressedBlock> m_blocks;
+};
+
+} // namespace io
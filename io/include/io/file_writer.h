@@ -1,38 +1,177 @@
 #pragma once
 
+#include <chrono>
 #include <string>
+#include <string_view>
 #include <fstream>
+#include <memory>
+#include <type_traits>
 #include <vector>
 #include <cstdint>
 
 namespace io {
 
+/// How the async writer pushes full buffers to the kernel.
+enum class WriteBackend {
+    Auto,     ///< io_uring when available, otherwise pwritev
+    IoUring,  ///< io_uring only; the constructor throws if it is unavailable
+    Writev    ///< pwritev
+};
+
+/// When the async writer calls fdatasync().  A failed fdatasync() is a
+/// write error: rethrown by the next call, and by every call after it.
+enum class Durability {
+    None,        ///< Never; leave it to the page cache
+    Periodic,    ///< At most once per WriterOptions::syncInterval while dirty
+    GroupCommit  ///< After every batch of buffers, covering all of them at once
+};
+
+/// Block compression applied by the async writer.
+enum class Compression {
+    None,
+    Lz     ///< In-tree LZ codec (io/lz.h) in the framed format of io/compressed_file.h
+};
+
+/// Upper bound on the compression threads used when
+/// WriterOptions::compressionThreads is 0.
+constexpr std::size_t DefaultCompressionThreads = 4;
+
+/// Parameters for the high-throughput FileWriter mode.
+struct WriterOptions {
+    bool                      async       = false;    ///< Enable the buffered background writer
+    std::size_t               bufferSize  = 4 << 20;  ///< Bytes per buffer (rounded up to 4 KiB)
+    std::size_t               bufferCount = 2;        ///< Buffers in rotation (at least 2)
+    WriteBackend              backend     = WriteBackend::Auto;
+    Durability                durability  = Durability::None;
+    std::chrono::milliseconds syncInterval{1000};
+    Compression               compression = Compression::None;  ///< Implies async; no append
+    /// 0 = one per hardware thread, at most DefaultCompressionThreads.
+    /// Each thread adds a buffer of bufferSize bytes and its compressed
+    /// output buffer of about the same size, i.e. ~8 MiB per thread at the
+    /// defaults; the ring holds compressionThreads + 2 pairs in total.
+    std::size_t               compressionThreads = 0;
+};
+
+/// Layout of the lines written by FileWriter::record().
+enum class RecordFormat {
+    Csv,       ///< Comma-separated values (RFC 4180 quoting); field names are ignored
+    JsonLines  ///< One JSON object per line, keyed by field name
+};
+
 /// Simple file writer with line buffering and flush control.
+///
+/// With WriterOptions::async the writer owns a ring of large page-aligned
+/// buffers.  The caller copies into the active buffer, and a background
+/// thread submits each full one with io_uring or pwritev while the caller
+/// carries on filling the next.  Errors from the background thread are
+/// rethrown as std::runtime_error by the next call on the writer.
+///
+/// With WriterOptions::compression every buffer handed over, full or
+/// flushed, becomes one block of a compressed file (io/compressed_file.h).
+/// The background thread compresses each batch of buffers across
+/// compressionThreads threads before writing it, and the block index is
+/// written when the writer is destroyed.  The ring grows to at least
+/// compressionThreads + 2 buffers, each with a matching output buffer.
+/// bytesWritten() counts the bytes before compression.
 class FileWriter {
 public:
     explicit FileWriter(const std::string& path, bool append = false);
+    FileWriter(const std::string& path, const WriterOptions& options, bool append = false);
     ~FileWriter();
 
     FileWriter(const FileWriter&)            = delete;
     FileWriter& operator=(const FileWriter&) = delete;
 
     /// Write a single line (newline appended automatically).
-    void writeLine(const std::string& line);
+    void writeLine(std::string_view line);
 
     /// Write raw bytes.
     void writeBytes(const std::vector<uint8_t>& data);
+    void writeBytes(const void* data, std::size_t size);
+
+    class Record;
+
+    /// Start a line of fields formatted straight into the writer's buffer.
+    /// The line ends with Record::end() or when the record is destroyed;
+    /// other writes must wait until then.
+    Record record(RecordFormat format = RecordFormat::Csv);
 
     /// Flush internal buffer to disk.
     void flush();
 
+    /// Flush, then make the data durable with fdatasync() (async mode only;
+    /// stream mode only flushes).  The destructor syncs too, in Periodic and
+    /// GroupCommit mode, but cannot report a failure: call sync() first.
+    void sync();
+
     bool isOpen() const noexcept;
 
     /// Total bytes written during this session.
     std::size_t bytesWritten() const noexcept;
 
+    /// Backend actually used by the async writer, or Auto in stream mode.
+    WriteBackend backend() const noexcept;
+
 private:
-    std::ofstream m_file;
-    std::size_t   m_bytesWritten{0};
+    class AsyncWriter;
+
+    /// Free space at the write position, at least \p need bytes long.
+    void space(std::size_t need, char*& first, char*& last);
+    /// Mark the current space as written up to \p end.
+    void commit(const char* end);
+
+    std::ofstream                m_file;
+    std::unique_ptr<AsyncWriter> m_async;
+    std::unique_ptr<char[]>      m_staging;   ///< Record space in stream mode
+    std::size_t                  m_bytesWritten{0};
+};
+
+/// One line of fields, appended with std::to_chars and no allocation.
+///
+/// Doubles are printed in the shortest form that round-trips, or in fixed
+/// notation with the given number of decimals (clamped to [0, 300]).
+/// In JSON-lines mode non-finite doubles are written as null, since JSON
+/// has no spelling for them.
+///
+///     writer.record().field("name", s.name()).field("area", s.area(), 4);
+class FileWriter::Record {
+public:
+    Record(const Record&)            = delete;
+    Record& operator=(const Record&) = delete;
+    ~Record();
+
+    Record& field(std::string_view name, double value);
+    Record& field(std::string_view name, double value, int precision);
+    Record& field(std::string_view name, bool value);
+    Record& field(std::string_view name, std::string_view value);
+    Record& field(std::string_view name, const char* value) { return field(name, std::string_view(value)); }
+
+    template <typename T,
+              typename = std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value>>
+    Record& field(std::string_view name, T value) {
+        if (std::is_signed<T>::value) return integer(name, static_cast<long long>(value));
+        return integer(name, static_cast<unsigned long long>(value));
+    }
+
+    /// Finish the line; called by the destructor if not called before.
+    void end();
+
+private:
+    friend class FileWriter;
+    Record(FileWriter& writer, RecordFormat format);
+
+    Record& integer(std::string_view name, long long value);
+    Record& integer(std::string_view name, unsigned long long value);
+    void    ensure(std::size_t need);
+    void    begin(std::string_view name);
+    void    text(std::string_view value);
+
+    FileWriter&  m_writer;
+    RecordFormat m_format;
+    char*        m_pos = nullptr;   ///< Write position in the writer's buffer
+    char*        m_end = nullptr;
+    bool         m_first = true;
+    bool         m_open = true;
 };
 
 } // namespace io
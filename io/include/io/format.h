@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace io {
+
+/// One type-erased argument for formatTo().
+class FormatArg {
+public:
+    enum class Type { Bool, Char, Int, UInt, Double, String };
+
+    FormatArg(bool v) noexcept               : m_type(Type::Bool)   { m_value.b = v; }
+    FormatArg(char v) noexcept               : m_type(Type::Char)   { m_value.c = v; }
+    FormatArg(double v) noexcept             : m_type(Type::Double) { m_value.d = v; }
+    FormatArg(float v) noexcept              : m_type(Type::Double) { m_value.d = v; }
+    FormatArg(const char* v) noexcept        : FormatArg(std::string_view(v ? v : "(null)")) {}
+    FormatArg(const std::string& v) noexcept : FormatArg(std::string_view(v)) {}
+    FormatArg(std::string_view v) noexcept   : m_type(Type::String) {
+        m_value.s.data = v.data();
+        m_value.s.size = v.size();
+    }
+
+    template <typename T,
+              typename = std::enable_if_t<std::is_integral<T>::value &&
+                                          !std::is_same<T, bool>::value &&
+                                          !std::is_same<T, char>::value>>
+    FormatArg(T v) noexcept {
+        if (std::is_signed<T>::value) {
+            m_type = Type::Int;
+            m_value.i = static_cast<long long>(v);
+        } else {
+            m_type = Type::UInt;
+            m_value.u = static_cast<unsigned long long>(v);
+        }
+    }
+
+    Type               type()   const noexcept { return m_type; }
+    bool               asBool() const noexcept { return m_value.b; }
+    char               asChar() const noexcept { return m_value.c; }
+    long long          asInt()  const noexcept { return m_value.i; }
+    unsigned long long asUInt() const noexcept { return m_value.u; }
+    double             asDouble() const noexcept { return m_value.d; }
+    std::string_view   asString() const noexcept { return {m_value.s.data, m_value.s.size}; }
+
+private:
+    Type m_type;
+    union {
+        bool               b;
+        char               c;
+        long long          i;
+        unsigned long long u;
+        double             d;
+        struct { const char* data; std::size_t size; } s;
+    } m_value;
+};
+
+/// Append \p fmt to \p out, replacing each "{}" with the next argument.
+///
+/// Supported replacement fields are "{}" and "{:.N}" with an optional
+/// floating-point type suffix 'f', 'e' or 'g' (e.g. "{:.4f}").  "{{" and
+/// "}}" produce literal braces.  Plain "{}" prints doubles in the shortest
+/// form that round-trips.  Numbers are rendered with std::to_chars, so
+/// nothing is allocated once \p out has enough capacity.  Missing arguments
+/// print as "{?}" and surplus arguments are ignored: formatting never throws
+/// on a malformed log statement.
+void vformatTo(std::string& out, std::string_view fmt, const FormatArg* args, std::size_t count);
+
+template <typename... Args>
+void formatTo(std::string& out, std::string_view fmt, const Args&... args) {
+    const FormatArg packed[sizeof...(Args) + 1] = {FormatArg(args)..., FormatArg(false)};
+    vformatTo(out, fmt, packed, sizeof...(Args));
+}
+
+} // namespace io
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace io {
+
+/// Longest escape of one input byte: "\u001f".
+constexpr std::size_t MaxJsonEscape = 6;
+
+/// Write \p c as it appears inside a JSON string to \p out, which has room
+/// for MaxJsonEscape bytes, and return the end.  Quotes, backslashes and
+/// control characters are escaped; other bytes, UTF-8 included, pass
+/// through.  Used by FileWriter::Record, the JSON dumps and bench output.
+inline char* escapeJsonChar(char c, char* out) noexcept {
+    static constexpr char Hex[] = "0123456789abcdef";
+    const auto u = static_cast<unsigned char>(c);
+    if (c == '"' || c == '\\') {
+        *out++ = '\\';
+        *out++ = c;
+    } else if (u >= 0x20) {
+        *out++ = c;
+    } else if (c == '\n') {
+        *out++ = '\\';
+        *out++ = 'n';
+    } else if (c == '\t') {
+        *out++ = '\\';
+        *out++ = 't';
+    } else if (c == '\r') {
+        *out++ = '\\';
+        *out++ = 'r';
+    } else {
+        const char escape[MaxJsonEscape] = {'\\', 'u', '0', '0', Hex[u >> 4], Hex[u & 15]};
+        for (const char e : escape) *out++ = e;
+    }
+    return out;
+}
+
+/// Append \p s to \p out as a quoted JSON string.
+inline void appendJsonString(std::string& out, std::string_view s) {
+    char escaped[MaxJsonEscape];
+    out += '"';
+    for (const char c : s) out.append(escaped, escapeJsonChar(c, escaped));
+    out += '"';
+}
+
+} // namespace io
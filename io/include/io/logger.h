@@ -1,35 +1,199 @@
 #pragma once
 
-#include <string>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <string_view>
+
+#include "io/format.h"
+
+// ── Compile-time level filtering ─────────────────────────────────────────────
+//
+// IO_LOG_DEBUG / IO_LOG_INFO / IO_LOG_WARNING / IO_LOG_ERROR check the
+// runtime level before evaluating any of their arguments, and expand to
+// nothing at all below IO_LOG_MIN_LEVEL.  Logger::debug() / info() /
+// warning() / error() compile to nothing below it too, and isEnabled() is
+// false there.  Set the minimum with -DIO_LOG_MIN_LEVEL=<LEVEL> at
+// configure time.
+
+#define IO_LOG_LEVEL_DEBUG   0
+#define IO_LOG_LEVEL_INFO    1
+#define IO_LOG_LEVEL_WARNING 2
+#define IO_LOG_LEVEL_ERROR   3
+
+#ifndef IO_LOG_MIN_LEVEL
+#  ifdef NDEBUG
+#    define IO_LOG_MIN_LEVEL IO_LOG_LEVEL_INFO
+#  else
+#    define IO_LOG_MIN_LEVEL IO_LOG_LEVEL_DEBUG
+#  endif
+#endif
+
+#define IO_LOG_AT(logger, level, ...)                                   \
+    do {                                                                \
+        auto& io_log_ = (logger);                                       \
+        if (io_log_.isEnabled(level)) io_log_.log(level, __VA_ARGS__);  \
+    } while (0)
+
+#if IO_LOG_MIN_LEVEL <= IO_LOG_LEVEL_DEBUG
+#  define IO_LOG_DEBUG(logger, ...) IO_LOG_AT(logger, ::io::LogLevel::DEBUG, __VA_ARGS__)
+#else
+#  define IO_LOG_DEBUG(logger, ...) ((void)0)
+#endif
+#if IO_LOG_MIN_LEVEL <= IO_LOG_LEVEL_INFO
+#  define IO_LOG_INFO(logger, ...) IO_LOG_AT(logger, ::io::LogLevel::INFO, __VA_ARGS__)
+#else
+#  define IO_LOG_INFO(logger, ...) ((void)0)
+#endif
+#if IO_LOG_MIN_LEVEL <= IO_LOG_LEVEL_WARNING
+#  define IO_LOG_WARNING(logger, ...) IO_LOG_AT(logger, ::io::LogLevel::WARNING, __VA_ARGS__)
+#else
+#  define IO_LOG_WARNING(logger, ...) ((void)0)
+#endif
+#if IO_LOG_MIN_LEVEL <= IO_LOG_LEVEL_ERROR
+#  define IO_LOG_ERROR(logger, ...) IO_LOG_AT(logger, ::io::LogLevel::ERROR, __VA_ARGS__)
+#else
+#  define IO_LOG_ERROR(logger, ...) ((void)0)
+#endif
 
 namespace io {
 
 enum class LogLevel { DEBUG, INFO, WARNING, ERROR };
 
+/// Resolution of the timestamp prefix on each line.
+enum class TimestampPrecision {
+    Seconds,       ///< "2024-01-31 12:00:00"
+    Microseconds   ///< "2024-01-31 12:00:00.123456"
+};
+
+/// What an async producer does when its queue is full.
+enum class OverflowPolicy {
+    Block,       ///< Spin until the writer thread frees a slot; drop (counted) once stopAsync() has run
+    Drop,        ///< Discard the record silently (still counted)
+    CountDrops   ///< Discard the record and report the count in the log
+};
+
+/// Parameters for Logger::startAsync().
+struct AsyncOptions {
+    std::size_t               queueCapacity = 4096;  ///< Records per producer thread (power of two)
+    OverflowPolicy            overflow      = OverflowPolicy::Block;
+    std::size_t               batchBytes    = 64 * 1024;  ///< Output is written in chunks of this size
+    std::chrono::milliseconds idleWait{1};           ///< Writer sleep when all queues are empty
+};
+
 /// Thread-safe singleton logger that writes to stdout.
+///
+/// Lines are assembled in a reusable thread-local buffer with a timestamp
+/// prefix that is re-rendered at most once per second per thread, so the
+/// steady-state formatting path does not allocate.  In the default
+/// synchronous mode only the final write happens under a mutex.  After startAsync() producers only copy the record into a
+/// per-thread lock-free ring; a background thread formats and writes
+/// records in batches.
 class Logger {
 public:
     static Logger& instance();
 
     void setLevel(LogLevel level);
-    void log(LogLevel level, const std::string& message);
+    void setTimestampPrecision(TimestampPrecision precision);
+    void log(LogLevel level, std::string_view message);
 
-    void debug(const std::string& msg);
-    void info(const std::string& msg);
-    void warning(const std::string& msg);
-    void error(const std::string& msg);
+    /// Format with io::formatTo() (e.g. `log.info("area={:.4f}", a)`) into a
+    /// reusable thread-local buffer.  Nothing is formatted if \p level is
+    /// filtered out; use the IO_LOG_* macros to also skip evaluating the
+    /// arguments.
+    template <typename Arg, typename... Args>
+    void log(LogLevel level, std::string_view fmt, const Arg& arg, const Args&... args);
+
+    /// False for levels below IO_LOG_MIN_LEVEL, which are never written.
+    static constexpr bool isCompiledIn(LogLevel level) noexcept {
+        return static_cast<int>(level) >= IO_LOG_MIN_LEVEL;
+    }
+
+    bool isEnabled(LogLevel level) const noexcept {
+        return isCompiledIn(level) && level >= m_level.load(std::memory_order_relaxed);
+    }
+
+    /// The per-level calls compile to nothing below IO_LOG_MIN_LEVEL.
+    void debug(std::string_view msg)   { logIfCompiledIn<LogLevel::DEBUG>(msg); }
+    void info(std::string_view msg)    { logIfCompiledIn<LogLevel::INFO>(msg); }
+    void warning(std::string_view msg) { logIfCompiledIn<LogLevel::WARNING>(msg); }
+    void error(std::string_view msg)   { logIfCompiledIn<LogLevel::ERROR>(msg); }
+
+    template <typename Arg, typename... Args>
+    void debug(std::string_view fmt, const Arg& arg, const Args&... args) {
+        logIfCompiledIn<LogLevel::DEBUG>(fmt, arg, args...);
+    }
+    template <typename Arg, typename... Args>
+    void info(std::string_view fmt, const Arg& arg, const Args&... args) {
+        logIfCompiledIn<LogLevel::INFO>(fmt, arg, args...);
+    }
+    template <typename Arg, typename... Args>
+    void warning(std::string_view fmt, const Arg& arg, const Args&... args) {
+        logIfCompiledIn<LogLevel::WARNING>(fmt, arg, args...);
+    }
+    template <typename Arg, typename... Args>
+    void error(std::string_view fmt, const Arg& arg, const Args&... args) {
+        logIfCompiledIn<LogLevel::ERROR>(fmt, arg, args...);
+    }
+
+    /// Switch to asynchronous mode.  No-op if already async.
+    void startAsync(const AsyncOptions& options = AsyncOptions{});
+
+    /// Drain all queued records, stop the writer thread and return to
+    /// synchronous mode.  Call once producers have quiesced: a record pushed
+    /// concurrently with the switch is written at the next startAsync() or
+    /// at shutdown.
+    void stopAsync();
+
+    bool isAsync() const noexcept;
+
+    /// Block until every record logged before this call has been written.
+    void flush();
+
+    /// Records discarded by the Drop / CountDrops overflow policies, or by
+    /// Block after stopAsync(), since the first startAsync().
+    std::uint64_t droppedCount() const noexcept;
 
 private:
-    Logger() = default;
+    Logger();
+    ~Logger();
     Logger(const Logger&)            = delete;
     Logger& operator=(const Logger&) = delete;
 
-    LogLevel   m_level{LogLevel::INFO};
-    std::mutex m_mutex;
+    class AsyncBackend;
+
+    template <LogLevel Level, typename... Args>
+    void logIfCompiledIn(const Args&... args) {
+        if constexpr (isCompiledIn(Level)) log(Level, args...);
+        else ((void)args, ...);
+    }
 
-    static std::string levelToString(LogLevel level);
-    static std::string currentTimestamp();
+    std::atomic<LogLevel>           m_level{LogLevel::INFO};
+    std::atomic<TimestampPrecision> m_precision{TimestampPrecision::Seconds};
+    std::mutex                      m_mutex;
+    std::unique_ptr<AsyncBackend>   m_async;
+    std::atomic<bool>               m_asyncEnabled{false};
+
+    static const char*  levelToString(LogLevel level);
+    static void         formatLine(std::string& out, LogLevel level,
+                                   std::chrono::system_clock::time_point time,
+                                   TimestampPrecision precision, std::string_view message);
+    static std::string& formatBuffer();
 };
 
+// ── template implementation ──────────────────────────────────────────────────
+
+template <typename Arg, typename... Args>
+void Logger::log(LogLevel level, std::string_view fmt, const Arg& arg, const Args&... args) {
+    if (!isEnabled(level)) return;
+    std::string& buf = formatBuffer();
+    buf.clear();
+    formatTo(buf, fmt, arg, args...);
+    log(level, std::string_view(buf));
+}
+
 } // namespace io
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+
+namespace io {
+
+// ── LZ block codec ───────────────────────────────────────────────────────────
+//
+// A byte-oriented LZ77 codec in the LZ4 family: greedy matching through a
+// 4-byte hash table, 64 KiB window, no entropy stage.  A compressed block
+// is a run of sequences, each
+//
+//   token        high nibble: literal count, low nibble: match length - 4
+//                (15 in either nibble continues in 255-valued extra bytes)
+//   literals
+//   offset       2 bytes, little-endian, 1..65535 back from the output
+//
+// and the last sequence stops after its literals.  Blocks are independent,
+// so any number of them can be compressed or decompressed in parallel.
+
+/// Largest output lzCompress() can produce for \p size input bytes.
+std::size_t lzCompressBound(std::size_t size) noexcept;
+
+/// Compress \p size bytes into \p dst, which must hold lzCompressBound(size)
+/// bytes.  Returns the compressed size.  Throws std::length_error for
+/// inputs of 4 GiB or more.
+std::size_t lzCompress(const void* src, std::size_t size, void* dst);
+
+/// Decompress a block into \p dst and return the decompressed size.
+/// Every read and write is bounds-checked: malformed input, or output
+/// larger than \p capacity, throws std::runtime_error.  Bytes of \p dst
+/// past the decompressed size may be overwritten.
+std::size_t lzDecompress(const void* src, std::size_t size, void* dst, std::size_t capacity);
+
+} // namespace io
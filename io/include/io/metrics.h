@@ -0,0 +1,303 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#  include <x86intrin.h>
+#endif
+
+// ── Compile-time switch ──────────────────────────────────────────────────────
+//
+// IO_METRICS_COUNT / IO_METRICS_RECORD / IO_METRICS_TIME expand to nothing
+// when IO_METRICS_ENABLED is 0, and Counter / Histogram / ScopedTimer become
+// empty inline stubs.  Set with -DIO_ENABLE_METRICS=OFF at configure time.
+
+#ifndef IO_METRICS_ENABLED
+#  define IO_METRICS_ENABLED 1
+#endif
+
+#define IO_METRICS_CAT_(a, b) a##b
+#define IO_METRICS_CAT(a, b)  IO_METRICS_CAT_(a, b)
+
+#if IO_METRICS_ENABLED
+/// Add \p n to the counter called \p name.
+#  define IO_METRICS_COUNT(name, n)                                                       \
+    do {                                                                                  \
+        static const ::io::Counter io_metric_ = ::io::Metrics::instance().counter(name);  \
+        io_metric_.add(n);                                                                \
+    } while (0)
+/// Record \p value in the histogram called \p name.
+#  define IO_METRICS_RECORD(name, value)                                                      \
+    do {                                                                                      \
+        static const ::io::Histogram io_metric_ = ::io::Metrics::instance().histogram(name);  \
+        io_metric_.record(value);                                                             \
+    } while (0)
+/// Time the rest of the enclosing scope into the timer called \p name.
+#  define IO_METRICS_TIME(name)                                                                  \
+    static const ::io::Histogram IO_METRICS_CAT(io_timer_h_, __LINE__) =                        \
+        ::io::Metrics::instance().timer(name);                                                  \
+    const ::io::ScopedTimer IO_METRICS_CAT(io_timer_, __LINE__)(IO_METRICS_CAT(io_timer_h_, __LINE__))
+#else
+#  define IO_METRICS_COUNT(name, n)      ((void)0)
+#  define IO_METRICS_RECORD(name, value) ((void)0)
+#  define IO_METRICS_TIME(name)          ((void)0)
+#endif
+
+namespace io {
+
+class FileWriter;
+class Logger;
+enum class LogLevel;
+
+namespace detail {
+
+/// Log-linear bucketing: values below 8 get their own bucket, then every
+/// power of two is split into 8 equal sub-buckets (at most 12.5% wide).
+/// Values of 2^48 and above share the last bucket.
+constexpr unsigned      MetricsSubBucketBits = 3;
+constexpr unsigned      MetricsSubBuckets    = 1u << MetricsSubBucketBits;
+constexpr unsigned      MetricsMaxExponent   = 47;
+constexpr std::size_t   MetricsBuckets       = (MetricsMaxExponent - MetricsSubBucketBits + 2) * MetricsSubBuckets;
+constexpr std::size_t   MetricsMaxCounters   = 128;
+constexpr std::size_t   MetricsMaxHistograms = 32;
+
+constexpr std::size_t bucketIndex(std::uint64_t v) noexcept {
+    if (v < MetricsSubBuckets) return static_cast<std::size_t>(v);
+    const unsigned e = 63u - static_cast<unsigned>(__builtin_clzll(v));
+    if (e > MetricsMaxExponent) return MetricsBuckets - 1;
+    return (e - MetricsSubBucketBits + 1) * MetricsSubBuckets
+         + static_cast<std::size_t>((v >> (e - MetricsSubBucketBits)) & (MetricsSubBuckets - 1));
+}
+
+/// Smallest value that lands in bucket \p i.
+constexpr std::uint64_t bucketLowerBound(std::size_t i) noexcept {
+    if (i < MetricsSubBuckets) return i;
+    const unsigned e = static_cast<unsigned>(i / MetricsSubBuckets) + MetricsSubBucketBits - 1;
+    return (MetricsSubBuckets + i % MetricsSubBuckets) << (e - MetricsSubBucketBits);
+}
+
+/// Hot-path storage of one thread.  Only the owning thread writes, with a
+/// plain load + store (no locked instruction); readers merge all shards
+/// with relaxed loads.
+struct alignas(64) MetricsShard {
+    struct HistogramCells {
+        std::atomic<std::uint64_t> buckets[MetricsBuckets];
+        std::atomic<std::uint64_t> sum;
+        std::atomic<std::uint64_t> max;
+    };
+
+    std::atomic<std::uint64_t> counters[MetricsMaxCounters];
+    HistogramCells             histograms[MetricsMaxHistograms];
+    std::atomic<bool>          abandoned;
+};
+
+inline void bump(std::atomic<std::uint64_t>& cell, std::uint64_t n) noexcept {
+    cell.store(cell.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+/// Register the calling thread's shard (slow path, once per thread).
+MetricsShard* registerShard();
+
+inline thread_local MetricsShard* t_metricsShard = nullptr;
+
+inline MetricsShard& localShard() {
+    MetricsShard* s = t_metricsShard;
+    return s ? *s : *registerShard();
+}
+
+} // namespace detail
+
+/// Raw timestamp for ScopedTimer: the TSC on x86 (invariant on every
+/// x86-64 CPU Linux runs on), steady_clock nanoseconds elsewhere.
+/// Metrics converts timer histograms to nanoseconds when it reads them.
+inline std::uint64_t metricsTicks() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/// Handle to a named monotonically increasing counter.
+class Counter {
+public:
+    void add(std::uint64_t n = 1) const noexcept {
+#if IO_METRICS_ENABLED
+        detail::bump(detail::localShard().counters[m_id], n);
+#else
+        (void)n;
+#endif
+    }
+
+private:
+    friend class Metrics;
+    explicit Counter(std::uint32_t id) noexcept : m_id(id) {}
+    std::uint32_t m_id;
+};
+
+/// Handle to a named log-linear histogram of non-negative integers.
+class Histogram {
+public:
+    void record(std::uint64_t value) const noexcept {
+#if IO_METRICS_ENABLED
+        auto& h = detail::localShard().histograms[m_id];
+        detail::bump(h.buckets[detail::bucketIndex(value)], 1);
+        detail::bump(h.sum, value);
+        if (value > h.max.load(std::memory_order_relaxed)) h.max.store(value, std::memory_order_relaxed);
+#else
+        (void)value;
+#endif
+    }
+
+private:
+    friend class Metrics;
+    explicit Histogram(std::uint32_t id) noexcept : m_id(id) {}
+    std::uint32_t m_id;
+};
+
+/// Records the ticks between construction and destruction into a timer
+/// histogram (see Metrics::timer()).
+class ScopedTimer {
+public:
+#if IO_METRICS_ENABLED
+    explicit ScopedTimer(const Histogram& timer) noexcept : m_timer(timer), m_start(metricsTicks()) {}
+    ~ScopedTimer() { m_timer.record(metricsTicks() - m_start); }
+#else
+    explicit ScopedTimer(const Histogram&) noexcept {}
+#endif
+
+    ScopedTimer(const ScopedTimer&)            = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+#if IO_METRICS_ENABLED
+private:
+    const Histogram& m_timer;
+    std::uint64_t    m_start;
+#endif
+};
+
+/// Merged view of every metric at one point in time.  Timer values are in
+/// nanoseconds; plain histograms keep their recorded units.
+struct MetricsSnapshot {
+    struct CounterValue {
+        std::string   name;
+        std::uint64_t value;
+    };
+    struct HistogramValue {
+        std::string   name;
+        bool          isTimer;
+        std::uint64_t count;
+        double        sum;
+        double        max;
+        double        scale;     ///< Bucket units to reported units
+        std::vector<std::uint64_t> buckets;
+
+        double mean() const noexcept { return count ? sum / static_cast<double>(count) : 0.0; }
+        /// Value below which a fraction \p q of the samples fall, to within
+        /// the bucket width (the bucket midpoint is reported).
+        double percentile(double q) const noexcept;
+    };
+
+    std::chrono::system_clock::time_point time;
+    std::vector<CounterValue>             counters;
+    std::vector<HistogramValue>           histograms;
+};
+
+/// Process-wide registry of named counters and histograms.
+///
+/// Each thread records into its own shard on the first use of any metric,
+/// so recording takes no lock and shares no cache line with other threads.
+/// snapshot() merges the shards under the registry mutex.  Shards of exited
+/// threads are folded into a retired total, so their counts are kept.
+///
+/// Handles are obtained once by name (usually through the IO_METRICS_*
+/// macros, which cache them in a function-local static); asking for an
+/// existing name returns the same metric.  There is room for 128 counters
+/// and 32 histograms; registering more throws std::runtime_error.
+class Metrics {
+public:
+    static Metrics& instance();
+
+    Counter   counter(const std::string& name);
+    Histogram histogram(const std::string& name);
+    /// A histogram fed by ScopedTimer: recorded in ticks, read back in ns.
+    Histogram timer(const std::string& name);
+
+    MetricsSnapshot snapshot();
+
+    /// One line per metric through \p log: counters as "name=value", timers
+    /// and histograms with count, mean, p50, p99 and max.
+    void report(Logger& log, LogLevel level);
+
+    /// One JSON object per call, on a single line, through \p out:
+    ///   {"time":..,"counters":{"name":v,..},
+    ///    "histograms":{"name":{"unit":"ns","count":..,"mean":..,"p50":..,"p90":..,"p99":..,"max":..},..}}
+    void writeJson(FileWriter& out);
+
+    /// Ticks per nanosecond for timer histograms.
+    double ticksPerNanosecond();
+
+private:
+    Metrics();
+    ~Metrics();
+    Metrics(const Metrics&)            = delete;
+    Metrics& operator=(const Metrics&) = delete;
+
+    friend detail::MetricsShard* detail::registerShard();
+
+    struct HistogramInfo {
+        std::string name;
+        bool        isTimer;
+    };
+
+    Histogram                registerHistogram(const std::string& name, bool isTimer);
+    detail::MetricsShard*    addShard();
+    void                     fold(const detail::MetricsShard& shard, detail::MetricsShard& into) const;
+
+    std::mutex                                         m_mutex;
+    std::vector<std::string>                           m_counterNames;
+    std::vector<HistogramInfo>                         m_histograms;
+    std::vector<std::unique_ptr<detail::MetricsShard>> m_shards;
+    std::unique_ptr<detail::MetricsShard>              m_retired;
+    std::unique_ptr<detail::MetricsShard>              m_total;     ///< snapshot() merge buffer
+
+    std::uint64_t                         m_calibrationTicks;
+    std::chrono::steady_clock::time_point m_calibrationTime;
+};
+
+/// Background thread that emits a snapshot every \p interval, and a final
+/// one when destroyed, through a Logger or as JSON lines through a
+/// FileWriter.  The FileWriter must not be used by anyone else meanwhile.
+class MetricsReporter {
+public:
+    MetricsReporter(std::chrono::milliseconds interval, Logger& log, LogLevel level);
+    MetricsReporter(std::chrono::milliseconds interval, FileWriter& out);
+    ~MetricsReporter();
+
+    MetricsReporter(const MetricsReporter&)            = delete;
+    MetricsReporter& operator=(const MetricsReporter&) = delete;
+
+private:
+    void start(std::chrono::milliseconds interval);
+    void emit();
+
+    Logger*                 m_log = nullptr;
+    LogLevel                m_level{};
+    FileWriter*             m_out = nullptr;
+    std::mutex              m_mutex;
+    std::condition_variable m_wake;
+    bool                    m_stop = false;
+    std::thread             m_thread;
+};
+
+} // namespace io
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace io {
+
+class FileWriter;
+class Logger;
+enum class LogLevel;
+
+// ── Hardware performance counters ────────────────────────────────────────────
+//
+// A thin wrapper over Linux perf_event_open(2) counting user-space events of
+// the calling thread.  Counters are opened once and left running; a region
+// reads them at its start and end and keeps the difference, so regions can
+// nest and cost two read(2) calls each.
+//
+// Opening fails without a PMU (most VMs and containers), under seccomp, or
+// when /proc/sys/kernel/perf_event_paranoid is above 2.  Every event that
+// cannot be opened is simply missing from the samples: nothing throws, and
+// reports say "unavailable" with the reason.
+
+enum class PerfEvent { Cycles, Instructions, CacheMisses, BranchMisses };
+
+constexpr std::size_t PerfEventCount = 4;
+
+/// "cycles", "instructions", "cache-misses" or "branch-misses".
+const char* perfEventName(PerfEvent event) noexcept;
+
+/// Event counts of one region, or the sum of several.
+struct PerfSample {
+    std::array<std::uint64_t, PerfEventCount> counts{};
+    std::uint32_t valid       = 0;       ///< Bit i set when counts[i] was measured
+    std::uint64_t elements    = 0;       ///< Work items, for the per-element ratios
+    std::uint64_t nanoseconds = 0;       ///< Wall time
+    std::uint64_t runs        = 0;       ///< Regions summed into this sample
+    bool          multiplexed = false;   ///< Some count was scaled up from part of the run
+
+    bool          has(PerfEvent e)   const noexcept { return valid >> static_cast<unsigned>(e) & 1u; }
+    std::uint64_t count(PerfEvent e) const noexcept { return counts[static_cast<std::size_t>(e)]; }
+
+    /// Instructions per cycle; NaN unless both were measured.
+    double ipc() const noexcept;
+    /// Events per element; NaN if \p e was not measured or there are no elements.
+    double perElement(PerfEvent e) const noexcept;
+
+    /// Sum two samples; an event stays valid only if it is valid in both.
+    PerfSample& operator+=(const PerfSample& other) noexcept;
+};
+
+/// The four events for the calling thread.
+///
+/// Grouped counters are scheduled onto the PMU together, so their ratios
+/// (IPC, misses per instruction) come from exactly the same instructions;
+/// if the group does not fit, it is time-shared as a whole.  Independent
+/// counters are scheduled one by one, which lets more events run on a
+/// busy PMU at the cost of comparing counts from different time slices.
+///
+/// Counts only the thread that constructed it; mark() and since() must be
+/// called from that thread.  For worker threads use one instance each, or
+/// ScopedPerf, which keeps one per thread.
+class PerfCounters {
+public:
+    enum class Mode { Grouped, Independent };
+
+    explicit PerfCounters(Mode mode = Mode::Grouped);
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&)            = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /// The grouped counters of the calling thread, opened on first use.
+    static PerfCounters& forThisThread();
+
+    /// At least one event could be opened.
+    bool available() const noexcept { return m_valid != 0; }
+    bool available(PerfEvent e) const noexcept { return m_valid >> static_cast<unsigned>(e) & 1u; }
+    Mode mode() const noexcept { return m_mode; }
+    /// Why events are missing (empty when all four opened).
+    const std::string& error() const noexcept { return m_error; }
+
+    /// Raw totals at one point in time, for since().
+    struct Mark {
+        struct Reading {
+            std::uint64_t value;
+            std::uint64_t enabled;   ///< Kernel time the event was enabled, ns
+            std::uint64_t running;   ///< ... and actually on the PMU
+        };
+        std::array<Reading, PerfEventCount> readings{};
+        std::uint32_t                       valid = 0;
+        std::uint64_t                       nanoseconds = 0;
+    };
+
+    Mark mark() const noexcept;
+
+    /// Events counted since \p start, scaled up where the kernel time-shared
+    /// the PMU, with \p elements attached.
+    PerfSample since(const Mark& start, std::uint64_t elements = 0) const noexcept;
+
+    /// Why events are missing in this process (empty if none are),
+    /// probed once with a grouped set.
+    static std::string unavailableReason();
+
+private:
+    Mode                                  m_mode;
+    std::array<int, PerfEventCount>       m_fd;
+    std::array<PerfEvent, PerfEventCount> m_order;        ///< Events in group read order
+    std::size_t                           m_opened = 0;
+    std::uint32_t                         m_valid  = 0;
+    std::string                           m_error;
+};
+
+/// Named regions, summed over every run and every thread that recorded
+/// them, reported through a Logger or as one JSON line.  Thread-safe.
+class PerfReport {
+public:
+    void add(const std::string& region, const PerfSample& sample);
+
+    /// Regions in the order they were first added.
+    std::vector<std::pair<std::string, PerfSample>> regions() const;
+
+    void clear();
+
+    /// One line per region through \p log: counts, IPC, and cache and
+    /// branch misses per element, or "unavailable" and the reason.
+    void report(Logger& log, LogLevel level) const;
+
+    /// One JSON object on a single line through \p out:
+    ///   {"available":true,"regions":{"name":{"runs":..,"elements":..,"ns":..,
+    ///    "cycles":..,"instructions":..,"cache-misses":..,"branch-misses":..,
+    ///    "ipc":..,"cache-misses/element":..,"branch-misses/element":..},..}}
+    /// "available" is true when some region has counts; events that were
+    /// not measured are null, and "error" gives the reason.
+    void writeJson(FileWriter& out) const;
+
+private:
+    mutable std::mutex                              m_mutex;
+    std::vector<std::pair<std::string, PerfSample>> m_regions;
+};
+
+/// Counts the calling thread's events from construction to destruction and
+/// adds them to a PerfReport region, e.g.
+///
+///     io::ScopedPerf perf(report, "triangle.area", triangles.size());
+///
+/// Use the same region name in every worker to sum a parallel loop.
+class ScopedPerf {
+public:
+    ScopedPerf(PerfReport& report, std::string region, std::uint64_t elements = 0);
+    ~ScopedPerf();
+
+    ScopedPerf(const ScopedPerf&)            = delete;
+    ScopedPerf& operator=(const ScopedPerf&) = delete;
+
+    void setElements(std::uint64_t elements) noexcept { m_elements = elements; }
+
+private:
+    PerfReport&        m_report;
+    std::string        m_region;
+    std::uint64_t      m_elements;
+    PerfCounters&      m_counters;
+    PerfCounters::Mark m_start;
+};
+
+} // namespace io
@@ -0,0 +1,195 @@
+#include "io/column_file.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace io {
+
+static constexpr char Magic[8] = {'I', 'O', 'C', 'O', 'L', 'S', '\0', '\1'};
+
+static std::uint64_t alignUp(std::uint64_t n) {
+    return (n + ColumnFileAlignment - 1) / ColumnFileAlignment * ColumnFileAlignment;
+}
+
+// ── ColumnFileWriter ─────────────────────────────────────────────────────────
+
+ColumnFileWriter::ColumnFileWriter(const std::string& path, std::string_view schema,
+                                   const WriterOptions& options)
+    : m_writer(path, options), m_schema(schema)
+{
+    if (m_schema.size() >= sizeof(ColumnFileHeader::schema)) {
+        throw std::invalid_argument("ColumnFileWriter: schema tag too long");
+    }
+}
+
+void ColumnFileWriter::addRaw(std::string_view name, ColumnType type, std::size_t elementSize,
+                              const void* data, std::size_t count) {
+    if (m_finished) throw std::logic_error("ColumnFileWriter: add() after finish()");
+    if (name.empty() || name.size() >= ColumnNameSize) {
+        throw std::invalid_argument("ColumnFileWriter: bad column name: " + std::string(name));
+    }
+    for (const Pending& p : m_columns) {
+        if (name == p.entry.name) {
+            throw std::invalid_argument("ColumnFileWriter: duplicate column: " + std::string(name));
+        }
+    }
+
+    Pending p{};
+    std::memcpy(p.entry.name, name.data(), name.size());
+    p.entry.type        = type;
+    p.entry.elementSize = static_cast<std::uint32_t>(elementSize);
+    p.entry.count       = count;
+    p.data              = data;
+    m_columns.push_back(p);
+}
+
+void ColumnFileWriter::finish() {
+    if (m_finished) return;
+    m_finished = true;
+
+    ColumnFileHeader header{};
+    std::memcpy(header.magic, Magic, sizeof Magic);
+    std::memcpy(header.schema, m_schema.data(), m_schema.size());
+    header.version     = ColumnFileVersion;
+    header.columnCount = static_cast<std::uint32_t>(m_columns.size());
+    header.indexOffset = sizeof(ColumnFileHeader);
+
+    std::uint64_t offset = alignUp(header.indexOffset + m_columns.size() * sizeof(ColumnFileEntry));
+    for (Pending& p : m_columns) {
+        p.entry.offset = offset;
+        offset = alignUp(offset + p.entry.count * p.entry.elementSize);
+    }
+    header.fileSize = offset;
+
+    static constexpr char zeros[ColumnFileAlignment] = {};
+    std::uint64_t written = 0;
+    auto put = [&](const void* data, std::size_t size) {
+        m_writer.writeBytes(data, size);
+        written += size;
+    };
+    auto pad = [&] { put(zeros, static_cast<std::size_t>(alignUp(written) - written)); };
+
+    put(&header, sizeof header);
+    for (const Pending& p : m_columns) put(&p.entry, sizeof p.entry);
+    pad();
+    for (const Pending& p : m_columns) {
+        put(p.data, static_cast<std::size_t>(p.entry.count * p.entry.elementSize));
+        pad();
+    }
+    m_writer.flush();
+}
+
+// ── MappedColumnFile ─────────────────────────────────────────────────────────
+
+MappedColumnFile::MappedColumnFile(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("MappedColumnFile: cannot open file: " + path);
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(ColumnFileHeader))) {
+        ::close(fd);
+        throw std::runtime_error("MappedColumnFile: not a column file: " + path);
+    }
+    m_size = static_cast<std::size_t>(st.st_size);
+    void* base = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        throw std::runtime_error("MappedColumnFile: mmap failed: " + path + ": " + std::strerror(errno));
+    }
+    m_base = static_cast<const unsigned char*>(base);
+
+    auto fail = [&](const char* what) {
+        release();
+        throw std::runtime_error(std::string("MappedColumnFile: ") + what + ": " + path);
+    };
+
+    const auto* header = reinterpret_cast<const ColumnFileHeader*>(m_base);
+    if (std::memcmp(header->magic, Magic, sizeof Magic) != 0) fail("bad magic");
+    if (header->version != ColumnFileVersion) fail("unsupported version");
+    if (header->fileSize > m_size) fail("truncated file");
+
+    // Compare against what is left of the mapping so no sum can wrap.
+    if (header->indexOffset % alignof(ColumnFileEntry) != 0 || header->indexOffset > m_size
+        || header->columnCount > (m_size - header->indexOffset) / sizeof(ColumnFileEntry))
+        fail("bad index");
+
+    m_entries    = reinterpret_cast<const ColumnFileEntry*>(m_base + header->indexOffset);
+    m_entryCount = header->columnCount;
+    for (std::size_t i = 0; i < m_entryCount; ++i) {
+        const ColumnFileEntry& e = m_entries[i];
+        if (e.name[ColumnNameSize - 1] != '\0') fail("bad column name");
+        if (e.offset % ColumnFileAlignment != 0 || e.elementSize == 0) fail("bad column entry");
+        if (e.offset > m_size || e.count > (m_size - e.offset) / e.elementSize) fail("column out of bounds");
+    }
+}
+
+MappedColumnFile::~MappedColumnFile() {
+    release();
+}
+
+MappedColumnFile::MappedColumnFile(MappedColumnFile&& other) noexcept
+    : m_base(other.m_base), m_size(other.m_size),
+      m_entries(other.m_entries), m_entryCount(other.m_entryCount)
+{
+    other.m_base       = nullptr;
+    other.m_size       = 0;
+    other.m_entries    = nullptr;
+    other.m_entryCount = 0;
+}
+
+MappedColumnFile& MappedColumnFile::operator=(MappedColumnFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        std::swap(m_base, other.m_base);
+        std::swap(m_size, other.m_size);
+        std::swap(m_entries, other.m_entries);
+        std::swap(m_entryCount, other.m_entryCount);
+    }
+    return *this;
+}
+
+void MappedColumnFile::release() noexcept {
+    if (m_base) ::munmap(const_cast<unsigned char*>(m_base), m_size);
+    m_base       = nullptr;
+    m_size       = 0;
+    m_entries    = nullptr;
+    m_entryCount = 0;
+}
+
+std::string_view MappedColumnFile::schema() const noexcept {
+    if (!m_base) return {};
+    const auto* header = reinterpret_cast<const ColumnFileHeader*>(m_base);
+    return std::string_view(header->schema, strnlen(header->schema, sizeof header->schema));
+}
+
+void MappedColumnFile::prefetch() const noexcept {
+    if (m_base) ::madvise(const_cast<unsigned char*>(m_base), m_size, MADV_WILLNEED);
+}
+
+const ColumnFileEntry* MappedColumnFile::find(std::string_view name) const noexcept {
+    for (std::size_t i = 0; i < m_entryCount; ++i) {
+        if (name == m_entries[i].name) return &m_entries[i];
+    }
+    return nullptr;
+}
+
+const ColumnFileEntry& MappedColumnFile::require(std::string_view name, ColumnType type,
+                                                  std::size_t elementSize) const {
+    const ColumnFileEntry* e = find(name);
+    if (!e) {
+        throw std::runtime_error("MappedColumnFile: missing column: " + std::string(name));
+    }
+    if (e->type != type || e->elementSize != elementSize) {
+        throw std::runtime_error("MappedColumnFile: column has another type: " + std::string(name));
+    }
+    return *e;
+}
+
+} // namespace io
@@ -0,0 +1,298 @@
+#include "io/compressed_file.h"
+#include "io/lz.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace io {
+
+namespace {
+
+/// Common checks on a block header read from disk.
+bool validBlock(const CompressedBlockHeader& h, std::uint32_t blockSize) {
+    const std::uint32_t stored = h.storedSize & ~CompressedBlockRaw;
+    if (h.rawSize == 0 || h.rawSize > blockSize) return false;
+    return (h.storedSize & CompressedBlockRaw) ? stored == h.rawSize : stored <= lzCompressBound(blockSize);
+}
+
+bool validHeader(const CompressedFileHeader& h) {
+    return std::memcmp(h.magic, CompressedFileMagic, sizeof h.magic) == 0 && h.version == CompressedFileVersion
+        && h.blockSize > 0 && h.blockSize < CompressedBlockRaw;
+}
+
+} // namespace
+
+// ── CompressedReader ─────────────────────────────────────────────────────────
+
+CompressedReader::CompressedReader(const std::string& path)
+    : m_fd(::open(path.c_str(), O_RDONLY | O_CLOEXEC)), m_owned(true)
+{
+    if (m_fd < 0) {
+        throw std::runtime_error("CompressedReader: cannot open file: " + path);
+    }
+    try {
+        open();
+    } catch (...) {
+        ::close(m_fd);
+        throw;
+    }
+}
+
+CompressedReader::CompressedReader(int fd) : m_fd(fd) {
+    open();
+}
+
+CompressedReader::~CompressedReader() {
+    if (m_owned) ::close(m_fd);
+}
+
+void CompressedReader::open() {
+    CompressedFileHeader header{};
+    if (!readExact(&header, sizeof header, true) || !validHeader(header)) {
+        throw std::runtime_error("CompressedReader: not a compressed file");
+    }
+    m_blockSize = header.blockSize;
+    m_block.resize(m_blockSize);
+    m_stored.resize(lzCompressBound(m_blockSize));
+}
+
+bool CompressedReader::readExact(void* dst, std::size_t size, bool atBoundary) {
+    auto* out = static_cast<char*>(dst);
+    std::size_t done = 0;
+    while (done < size) {
+        const ssize_t n = ::read(m_fd, out + done, size - done);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error(std::string("CompressedReader: read failed: ") + std::strerror(errno));
+        }
+        if (n == 0) {
+            if (done == 0 && atBoundary) return false;
+            throw std::runtime_error("CompressedReader: truncated file");
+        }
+        done += static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+bool CompressedReader::nextBlock() {
+    if (m_done) return false;
+    // A file whose writer did not finish ends after a whole block instead
+    // of at the end marker.
+    CompressedBlockHeader header{};
+    if (!readExact(&header, sizeof header, true) || header.rawSize == 0) {
+        m_done = true;
+        return false;
+    }
+    if (!validBlock(header, m_blockSize)) throw std::runtime_error("CompressedReader: bad block header");
+
+    const std::uint32_t stored = header.storedSize & ~CompressedBlockRaw;
+    if (header.storedSize & CompressedBlockRaw) {
+        readExact(m_block.data(), stored, false);
+    } else {
+        readExact(m_stored.data(), stored, false);
+        if (lzDecompress(m_stored.data(), stored, m_block.data(), m_block.size()) != header.rawSize) {
+            throw std::runtime_error("CompressedReader: block size mismatch");
+        }
+    }
+    m_blockPos = 0;
+    m_blockEnd = header.rawSize;
+    return true;
+}
+
+std::size_t CompressedReader::read(void* dst, std::size_t size) {
+    auto* out = static_cast<char*>(dst);
+    std::size_t copied = 0;
+    while (copied < size) {
+        if (m_blockPos == m_blockEnd && !nextBlock()) break;
+        const std::size_t n = std::min(size - copied, m_blockEnd - m_blockPos);
+        std::memcpy(out + copied, m_block.data() + m_blockPos, n);
+        m_blockPos += n;
+        copied += n;
+    }
+    m_position += copied;
+    return copied;
+}
+
+bool CompressedReader::readLine(std::string& line) {
+    line.clear();
+    bool any = false;
+    for (;;) {
+        if (m_blockPos == m_blockEnd && !nextBlock()) return any;
+        const char* first = m_block.data() + m_blockPos;
+        const char* last  = m_block.data() + m_blockEnd;
+        const auto* newline = static_cast<const char*>(std::memchr(first, '\n', static_cast<std::size_t>(last - first)));
+        const char* stop = newline ? newline : last;
+        line.append(first, stop);
+        m_blockPos = static_cast<std::size_t>((newline ? newline + 1 : last) - m_block.data());
+        m_position += static_cast<std::size_t>((newline ? newline + 1 : last) - first);
+        any = true;
+        if (newline) return true;
+    }
+}
+
+// ── MappedCompressedFile ─────────────────────────────────────────────────────
+
+MappedCompressedFile::MappedCompressedFile(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("MappedCompressedFile: cannot open file: " + path);
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(CompressedFileHeader))) {
+        ::close(fd);
+        throw std::runtime_error("MappedCompressedFile: not a compressed file: " + path);
+    }
+    m_size = static_cast<std::size_t>(st.st_size);
+    void* base = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        throw std::runtime_error("MappedCompressedFile: mmap failed: " + path + ": " + std::strerror(errno));
+    }
+    m_base = static_cast<const unsigned char*>(base);
+
+    auto fail = [&](const char* what) {
+        release();
+        throw std::runtime_error(std::string("MappedCompressedFile: ") + what + ": " + path);
+    };
+    auto blockAtFile = [&](std::uint64_t offset) {
+        CompressedBlockHeader h;
+        std::memcpy(&h, m_base + offset, sizeof h);
+        return h;
+    };
+    auto add = [&](std::uint64_t offset, const CompressedBlockHeader& h) {
+        const std::uint32_t stored = h.storedSize & ~CompressedBlockRaw;
+        if (!validBlock(h, m_blockSize)) fail("bad block header");
+        m_blocks.push_back({m_rawSize, offset, h.rawSize, stored, (h.storedSize & CompressedBlockRaw) != 0});
+        m_rawSize += h.rawSize;
+        return offset + sizeof h + stored;
+    };
+
+    CompressedFileHeader header;
+    std::memcpy(&header, m_base, sizeof header);
+    if (!validHeader(header)) fail("not a compressed file");
+    m_blockSize = header.blockSize;
+
+    // Finished file: the trailer locates the index.
+    CompressedFileTrailer trailer{};
+    if (m_size >= sizeof header + sizeof(CompressedBlockHeader) + sizeof trailer) {
+        std::memcpy(&trailer, m_base + m_size - sizeof trailer, sizeof trailer);
+    }
+    if (std::memcmp(trailer.magic, CompressedIndexMagic, sizeof trailer.magic) == 0) {
+        const std::uint64_t indexEnd = m_size - sizeof trailer;
+        const std::uint64_t first = sizeof header + sizeof(CompressedBlockHeader);
+        if (trailer.indexOffset < first || trailer.indexOffset > indexEnd
+            || trailer.blockCount != (indexEnd - trailer.indexOffset) / sizeof(CompressedBlockEntry)
+            || (indexEnd - trailer.indexOffset) % sizeof(CompressedBlockEntry) != 0)
+            fail("bad index");
+
+        // Blocks are back to back and end with the marker just before the index.
+        m_blocks.reserve(static_cast<std::size_t>(trailer.blockCount));
+        std::uint64_t next = sizeof header;
+        for (std::uint64_t i = 0; i < trailer.blockCount; ++i) {
+            CompressedBlockEntry e;
+            std::memcpy(&e, m_base + trailer.indexOffset + i * sizeof e, sizeof e);
+            if (e.offset != next || e.offset + sizeof(CompressedBlockHeader) > trailer.indexOffset) fail("bad index");
+            const CompressedBlockHeader h = blockAtFile(e.offset);
+            if (h.rawSize != e.rawSize || h.storedSize != e.storedSize) fail("index does not match blocks");
+            next = add(e.offset, h);
+        }
+        if (next + sizeof(CompressedBlockHeader) != trailer.indexOffset || blockAtFile(next).rawSize != 0)
+            fail("bad index");
+        m_indexed = true;
+        return;
+    }
+
+    // Unfinished file: walk the block headers.
+    std::uint64_t next = sizeof header;
+    while (next < m_size) {
+        if (m_size - next < sizeof(CompressedBlockHeader)) fail("truncated file");
+        const CompressedBlockHeader h = blockAtFile(next);
+        if (h.rawSize == 0) break;
+        if (!validBlock(h, m_blockSize)) fail("bad block header");
+        if ((h.storedSize & ~CompressedBlockRaw) > m_size - next - sizeof h) fail("truncated file");
+        next = add(next, h);
+    }
+}
+
+MappedCompressedFile::~MappedCompressedFile() {
+    release();
+}
+
+MappedCompressedFile::MappedCompressedFile(MappedCompressedFile&& other) noexcept
+    : m_base(other.m_base), m_size(other.m_size), m_blockSize(other.m_blockSize),
+      m_rawSize(other.m_rawSize), m_indexed(other.m_indexed), m_blocks(std::move(other.m_blocks))
+{
+    other.m_base = nullptr;
+    other.release();
+}
+
+MappedCompressedFile& MappedCompressedFile::operator=(MappedCompressedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        std::swap(m_base, other.m_base);
+        std::swap(m_size, other.m_size);
+        std::swap(m_blockSize, other.m_blockSize);
+        std::swap(m_rawSize, other.m_rawSize);
+        std::swap(m_indexed, other.m_indexed);
+        std::swap(m_blocks, other.m_blocks);
+    }
+    return *this;
+}
+
+void MappedCompressedFile::release() noexcept {
+    if (m_base) ::munmap(const_cast<unsigned char*>(m_base), m_size);
+    m_base      = nullptr;
+    m_size      = 0;
+    m_blockSize = 0;
+    m_rawSize   = 0;
+    m_indexed   = false;
+    m_blocks.clear();
+}
+
+std::size_t MappedCompressedFile::blockAt(std::uint64_t offset) const noexcept {
+    if (offset >= m_rawSize) return m_blocks.size();
+    const auto it = std::upper_bound(m_blocks.begin(), m_blocks.end(), offset,
+                                     [](std::uint64_t o, const CompressedBlock& b) { return o < b.rawOffset; });
+    return static_cast<std::size_t>(it - m_blocks.begin()) - 1;
+}
+
+void MappedCompressedFile::readBlock(std::size_t i, void* dst) const {
+    const CompressedBlock& b = m_blocks[i];
+    const unsigned char* payload = m_base + b.fileOffset + sizeof(CompressedBlockHeader);
+    if (b.stored) {
+        std::memcpy(dst, payload, b.rawSize);
+    } else if (lzDecompress(payload, b.storedSize, dst, b.rawSize) != b.rawSize) {
+        throw std::runtime_error("MappedCompressedFile: block size mismatch");
+    }
+}
+
+std::size_t MappedCompressedFile::read(std::uint64_t offset, void* dst, std::size_t size) const {
+    auto* out = static_cast<char*>(dst);
+    std::vector<char> partial;
+    std::size_t copied = 0;
+    for (std::size_t i = blockAt(offset); i < m_blocks.size() && copied < size; ++i) {
+        const CompressedBlock& b = m_blocks[i];
+        const auto skip = static_cast<std::size_t>(offset + copied - b.rawOffset);
+        const std::size_t n = std::min<std::size_t>(b.rawSize - skip, size - copied);
+        if (n == b.rawSize) {
+            readBlock(i, out + copied);
+        } else if (b.stored) {
+            std::memcpy(out + copied, m_base + b.fileOffset + sizeof(CompressedBlockHeader) + skip, n);
+        } else {
+            partial.resize(b.rawSize);
+            readBlock(i, partial.data());
+            std::memcpy(out + copied, partial.data() + skip, n);
+        }
+        copied += n;
+    }
+    return copied;
+}
+
+} // namespace io
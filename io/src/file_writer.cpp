@@ -1,8 +1,556 @@
 #include "io/file_writer.h"
+#include "io/compressed_file.h"
+#include "io/json.h"
+#include "io/lz.h"
+#include "io/metrics.h"
+#include "uring.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <climits>
+#include <cerrno>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <functional>
+#include <mutex>
+#include <new>
 #include <stdexcept>
+#include <sys/uio.h>
+#include <thread>
+#include <unistd.h>
 
 namespace io {
 
+// ── compression workers ──────────────────────────────────────────────────────
+
+namespace {
+
+/// Helper threads that run one parallel loop at a time together with the
+/// calling thread.  Used by the async writer to compress a batch of blocks.
+class WorkerGroup {
+public:
+    explicit WorkerGroup(std::size_t helpers) {
+        for (std::size_t i = 0; i < helpers; ++i) m_threads.emplace_back([this] { loop(); });
+    }
+
+    ~WorkerGroup() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_start.notify_all();
+        for (std::thread& t : m_threads) t.join();
+    }
+
+    WorkerGroup(const WorkerGroup&)            = delete;
+    WorkerGroup& operator=(const WorkerGroup&) = delete;
+
+    /// Call fn(i) for every i in [0, count) and return when all are done.
+    /// \p fn must not throw.
+    void run(std::size_t count, const std::function<void(std::size_t)>& fn) {
+        if (m_threads.empty() || count < 2) {
+            for (std::size_t i = 0; i < count; ++i) fn(i);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_fn = &fn;
+            m_count = count;
+            m_next.store(0, std::memory_order_relaxed);
+            m_busy = m_threads.size();
+            ++m_generation;
+        }
+        m_start.notify_all();
+        work();
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [&] { return m_busy == 0; });
+        m_fn = nullptr;
+    }
+
+private:
+    void work() {
+        for (std::size_t i = m_next.fetch_add(1, std::memory_order_relaxed); i < m_count;
+             i = m_next.fetch_add(1, std::memory_order_relaxed))
+            (*m_fn)(i);
+    }
+
+    void loop() {
+        std::uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_start.wait(lock, [&] { return m_stop || m_generation != seen; });
+                if (m_stop) return;
+                seen = m_generation;
+            }
+            work();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_busy == 0) m_done.notify_one();
+        }
+    }
+
+    std::vector<std::thread>                    m_threads;
+    std::mutex                                  m_mutex;
+    std::condition_variable                     m_start;
+    std::condition_variable                     m_done;
+    const std::function<void(std::size_t)>*     m_fn = nullptr;
+    std::size_t                                 m_count = 0;
+    std::atomic<std::size_t>                    m_next{0};
+    std::size_t                                 m_busy = 0;
+    std::uint64_t                               m_generation = 0;
+    bool                                        m_stop = false;
+};
+
+} // namespace
+
+// ── async writer ─────────────────────────────────────────────────────────────
+//
+// Buffers cycle between three places: the producer's active buffer, the
+// queue of full buffers waiting for the background thread, and the free
+// list.  The background thread takes the whole queue at once and writes it
+// with a single io_uring submission (or one pwritev), so under load several
+// buffers go out per system call and, in GroupCommit mode, share a single
+// fdatasync().
+//
+// In compressed mode the background thread first compresses the batch
+// into its own output buffers, on the worker group, and returns the input
+// buffers to the free list before the write, so the producer keeps
+// filling while the compressed batch goes to disk.
+
+class FileWriter::AsyncWriter {
+public:
+    AsyncWriter(const std::string& path, const WriterOptions& options, bool append);
+    ~AsyncWriter();
+
+    void write(const char* data, std::size_t size);
+    void writeLine(std::string_view line);
+    void flush();
+
+    /// Free space in the active buffer, handing it over first if it has
+    /// less than \p need bytes left (\p need must not exceed a buffer).
+    void space(std::size_t need, char*& first, char*& last) {
+        if (need > m_capacity - m_active.size) submitActive();
+        first = m_active.data + m_active.size;
+        last  = m_active.data + m_capacity;
+    }
+    /// Mark the active buffer as filled up to \p end; returns the bytes added.
+    std::size_t commit(const char* end) {
+        const auto size = static_cast<std::size_t>(end - (m_active.data + m_active.size));
+        m_active.size += size;
+        return size;
+    }
+
+    void sync();
+    WriteBackend backend() const noexcept { return m_backend; }
+
+private:
+    static constexpr std::size_t PageSize = 4096;
+
+    struct Buffer {
+        char*       data = nullptr;
+        std::size_t size = 0;
+    };
+
+    void run();
+    void writeBatch(const std::vector<Buffer>& batch);
+    void compressBatch(const std::vector<Buffer>& batch);
+    void recordBlocks(off_t start);
+    void writeAt(const void* data, std::size_t size);
+    void writeIndex();
+    void submitActive();
+    void throwIfFailed();
+    void datasync();
+    void release() noexcept;
+
+    WriterOptions m_options;
+    std::size_t   m_capacity;
+    int           m_fd = -1;
+    off_t         m_offset = 0;         ///< Background thread only
+    WriteBackend  m_backend = WriteBackend::Writev;
+    detail::Uring m_uring;
+
+    std::vector<char*> m_storage;
+    Buffer             m_active;        ///< Producer only
+
+    std::mutex              m_mutex;
+    std::condition_variable m_workReady;
+    std::condition_variable m_bufferFree;
+    std::deque<Buffer>      m_full;
+    std::vector<Buffer>     m_free;
+    std::size_t             m_inFlight = 0;
+    bool                    m_stop = false;
+    std::string             m_error;
+
+    std::chrono::steady_clock::time_point m_lastSync;
+    bool                                  m_dirty = false;   ///< Background thread only
+
+    // Compressed mode; background thread only.
+    std::unique_ptr<WorkerGroup>      m_workers;
+    std::vector<char*>                m_packedStorage;  ///< One per buffer
+    std::vector<Buffer>               m_packed;         ///< Current compressed batch
+    std::vector<CompressedBlockEntry> m_index;
+
+    std::thread m_thread;
+};
+
+FileWriter::AsyncWriter::AsyncWriter(const std::string& path, const WriterOptions& options,
+                                     bool append)
+    : m_options(options),
+      m_capacity((std::max<std::size_t>(options.bufferSize, PageSize) + PageSize - 1) / PageSize * PageSize)
+{
+    const bool compressed = options.compression != Compression::None;
+    std::size_t count = std::max<std::size_t>(options.bufferCount, 2);
+    std::size_t threads = 0;
+    if (compressed) {
+        if (append) {
+            throw std::invalid_argument("FileWriter: cannot append to a compressed file");
+        }
+        if (m_capacity >= CompressedBlockRaw) {
+            throw std::invalid_argument("FileWriter: compressed buffers must be under 2 GiB");
+        }
+        threads = options.compressionThreads;
+        if (threads == 0) {
+            // Every thread costs two buffers; more than a few rarely pays off.
+            threads = std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()),
+                                            DefaultCompressionThreads);
+        }
+        // Room for a full batch per thread while the producer fills another.
+        count = std::max(count, threads + 2);
+    }
+
+    const int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (append ? 0 : O_TRUNC);
+    m_fd = ::open(path.c_str(), flags, 0644);
+    if (m_fd < 0) {
+        throw std::runtime_error("FileWriter: cannot open file: " + path);
+    }
+
+    // The destructor does not run for a constructor that throws; m_uring,
+    // a member, unmaps itself.
+    try {
+        if (append) m_offset = ::lseek(m_fd, 0, SEEK_END);
+
+        if (options.backend != WriteBackend::Writev && m_uring.init(static_cast<unsigned>(count))) {
+            m_backend = WriteBackend::IoUring;
+        } else if (options.backend == WriteBackend::IoUring) {
+            throw std::runtime_error("FileWriter: io_uring is not available");
+        }
+
+        m_storage.reserve(count);
+        m_free.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            char* p = static_cast<char*>(::operator new(m_capacity, std::align_val_t{PageSize}));
+            m_storage.push_back(p);
+            m_free.push_back(Buffer{p, 0});
+        }
+        m_active = m_free.back();
+        m_free.pop_back();
+
+        if (compressed) {
+            const std::size_t packedSize = sizeof(CompressedBlockHeader) + lzCompressBound(m_capacity);
+            m_packedStorage.reserve(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                m_packedStorage.push_back(static_cast<char*>(::operator new(packedSize, std::align_val_t{PageSize})));
+            }
+            m_workers = std::make_unique<WorkerGroup>(threads - 1);
+
+            CompressedFileHeader header{};
+            std::memcpy(header.magic, CompressedFileMagic, sizeof header.magic);
+            header.version   = CompressedFileVersion;
+            header.blockSize = static_cast<std::uint32_t>(m_capacity);
+            try {
+                writeAt(&header, sizeof header);
+            } catch (const std::exception& ex) {
+                throw std::runtime_error(std::string("FileWriter: ") + ex.what());
+            }
+        }
+
+        m_lastSync = std::chrono::steady_clock::now();
+        m_thread = std::thread([this] { run(); });
+    } catch (...) {
+        release();
+        throw;
+    }
+}
+
+FileWriter::AsyncWriter::~AsyncWriter() {
+    try {
+        flush();
+    } catch (...) {
+        // Destructors must not throw; the error was already reported if the
+        // caller flushed explicitly.
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_workReady.notify_all();
+    m_thread.join();
+    if (m_workers && m_error.empty()) {
+        try {
+            writeIndex();
+        } catch (...) {
+            // Without the index the file still reads by walking its blocks.
+        }
+    }
+    if (m_options.durability != Durability::None && m_error.empty()) {
+        // Nobody is left to report a failure to; callers that need to know
+        // call sync() before destroying the writer.
+        ::fdatasync(m_fd);
+    }
+    release();
+}
+
+void FileWriter::AsyncWriter::release() noexcept {
+    ::close(m_fd);
+    for (char* p : m_storage) ::operator delete(p, std::align_val_t{PageSize});
+    for (char* p : m_packedStorage) ::operator delete(p, std::align_val_t{PageSize});
+}
+
+void FileWriter::AsyncWriter::throwIfFailed() {
+    if (!m_error.empty()) throw std::runtime_error("FileWriter: " + m_error);
+}
+
+void FileWriter::AsyncWriter::write(const char* data, std::size_t size) {
+    if (size == 0) return;
+    if (size <= m_capacity - m_active.size) {
+        std::memcpy(m_active.data + m_active.size, data, size);
+        m_active.size += size;
+        return;
+    }
+    while (size > 0) {
+        if (m_active.size == m_capacity) submitActive();
+        const std::size_t n = std::min(size, m_capacity - m_active.size);
+        std::memcpy(m_active.data + m_active.size, data, n);
+        m_active.size += n;
+        data += n;
+        size -= n;
+    }
+}
+
+void FileWriter::AsyncWriter::writeLine(std::string_view line) {
+    // Common case: line and newline both fit, one bounds check.
+    if (line.size() < m_capacity - m_active.size) {
+        char* out = m_active.data + m_active.size;
+        std::memcpy(out, line.data(), line.size());
+        out[line.size()] = '\n';
+        m_active.size += line.size() + 1;
+        return;
+    }
+    write(line.data(), line.size());
+    write("\n", 1);
+}
+
+void FileWriter::AsyncWriter::submitActive() {
+    // Time the caller spends handing over a buffer, including any wait for a free one.
+    IO_METRICS_TIME("file_writer.submit");
+    std::unique_lock<std::mutex> lock(m_mutex);
+    throwIfFailed();
+    if (m_active.data) m_full.push_back(m_active);
+    // The buffer now belongs to the background thread.  Until a free one
+    // arrives the producer holds none: a full null buffer, so the next
+    // write comes back here, and rethrows, if the wait below throws.
+    m_active = Buffer{nullptr, m_capacity};
+    m_workReady.notify_one();
+    m_bufferFree.wait(lock, [&] { return !m_free.empty() || !m_error.empty(); });
+    throwIfFailed();
+    m_active = m_free.back();
+    m_free.pop_back();
+}
+
+void FileWriter::AsyncWriter::flush() {
+    if (m_active.size > 0) submitActive();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_bufferFree.wait(lock, [&] { return (m_full.empty() && m_inFlight == 0) || !m_error.empty(); });
+    throwIfFailed();
+}
+
+void FileWriter::AsyncWriter::sync() {
+    flush();
+    if (::fdatasync(m_fd) != 0) {
+        // A failed fdatasync may drop the dirty pages, so a later one can
+        // succeed without the data: keep failing like a write error.
+        const std::string error = std::string("fdatasync failed: ") + std::strerror(errno);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_error.empty()) m_error = error;
+        throwIfFailed();
+    }
+}
+
+void FileWriter::AsyncWriter::datasync() {
+    IO_METRICS_TIME("file_writer.fdatasync");
+    if (::fdatasync(m_fd) != 0) {
+        throw std::runtime_error(std::string("fdatasync failed: ") + std::strerror(errno));
+    }
+    m_lastSync = std::chrono::steady_clock::now();
+    m_dirty = false;
+}
+
+void FileWriter::AsyncWriter::writeBatch(const std::vector<Buffer>& batch) {
+    IO_METRICS_TIME("file_writer.write_batch");
+    IO_METRICS_RECORD("file_writer.buffers_per_batch", batch.size());
+    std::vector<iovec> iov;
+    iov.reserve(batch.size());
+    std::size_t total = 0;
+    for (const Buffer& b : batch) {
+        iov.push_back(iovec{b.data, b.size});
+        total += b.size;
+    }
+
+    std::size_t done = 0;
+    if (m_backend == WriteBackend::IoUring) {
+        const long long res = m_uring.writeAll(m_fd, iov.data(), static_cast<unsigned>(iov.size()),
+                                               m_offset);
+        if (res < 0) throw std::runtime_error(std::string("write failed: ") + std::strerror(static_cast<int>(-res)));
+        done = static_cast<std::size_t>(res);
+    }
+
+    // pwritev path, also used to finish short io_uring writes.
+    while (done < total) {
+        std::size_t skip = done;
+        std::size_t first = 0;
+        while (skip >= iov[first].iov_len) skip -= iov[first++].iov_len;
+        std::vector<iovec> rest(iov.begin() + static_cast<std::ptrdiff_t>(first), iov.end());
+        rest.front().iov_base = static_cast<char*>(rest.front().iov_base) + skip;
+        rest.front().iov_len -= skip;
+
+        const int count = static_cast<int>(std::min<std::size_t>(rest.size(), IOV_MAX));
+        const ssize_t n = ::pwritev(m_fd, rest.data(), count, m_offset + static_cast<off_t>(done));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error(std::string("write failed: ") + std::strerror(errno));
+        }
+        done += static_cast<std::size_t>(n);
+    }
+    m_offset += static_cast<off_t>(total);
+    m_dirty = true;
+    IO_METRICS_COUNT("file_writer.bytes", total);
+}
+
+void FileWriter::AsyncWriter::compressBatch(const std::vector<Buffer>& batch) {
+    IO_METRICS_TIME("file_writer.compress");
+    m_packed.resize(batch.size());
+    m_workers->run(batch.size(), [&](std::size_t i) {
+        const Buffer& in = batch[i];
+        char* const out = m_packedStorage[i];
+        char* const payload = out + sizeof(CompressedBlockHeader);
+        CompressedBlockHeader header{static_cast<std::uint32_t>(in.size), 0};
+        std::size_t stored = lzCompress(in.data, in.size, payload);
+        if (stored >= in.size) {
+            std::memcpy(payload, in.data, in.size);
+            stored = in.size;
+            header.storedSize = CompressedBlockRaw;
+        }
+        header.storedSize |= static_cast<std::uint32_t>(stored);
+        std::memcpy(out, &header, sizeof header);
+        m_packed[i] = Buffer{out, sizeof header + stored};
+    });
+}
+
+void FileWriter::AsyncWriter::recordBlocks(off_t start) {
+    for (const Buffer& b : m_packed) {
+        CompressedBlockHeader header;
+        std::memcpy(&header, b.data, sizeof header);
+        m_index.push_back({static_cast<std::uint64_t>(start), header.rawSize, header.storedSize});
+        start += static_cast<off_t>(b.size);
+    }
+}
+
+void FileWriter::AsyncWriter::writeAt(const void* data, std::size_t size) {
+    const auto* p = static_cast<const char*>(data);
+    while (size > 0) {
+        const ssize_t n = ::pwrite(m_fd, p, size, m_offset);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error(std::string("write failed: ") + std::strerror(errno));
+        }
+        p += n;
+        size -= static_cast<std::size_t>(n);
+        m_offset += static_cast<off_t>(n);
+    }
+}
+
+void FileWriter::AsyncWriter::writeIndex() {
+    const CompressedBlockHeader end{0, 0};
+    writeAt(&end, sizeof end);
+    CompressedFileTrailer trailer{};
+    trailer.indexOffset = static_cast<std::uint64_t>(m_offset);
+    trailer.blockCount  = m_index.size();
+    std::memcpy(trailer.magic, CompressedIndexMagic, sizeof trailer.magic);
+    writeAt(m_index.data(), m_index.size() * sizeof(CompressedBlockEntry));
+    writeAt(&trailer, sizeof trailer);
+}
+
+void FileWriter::AsyncWriter::run() {
+    std::vector<Buffer> batch;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            auto ready = [&] { return !m_full.empty() || m_stop; };
+            if (m_options.durability == Durability::Periodic && m_dirty) {
+                m_workReady.wait_until(lock, m_lastSync + m_options.syncInterval, ready);
+            } else {
+                m_workReady.wait(lock, ready);
+            }
+            if (m_full.empty() && m_stop) return;
+            batch.assign(m_full.begin(), m_full.end());
+            m_full.clear();
+            m_inFlight = batch.size();
+        }
+
+        std::string error;
+        try {
+            if (!batch.empty() && m_workers) {
+                compressBatch(batch);
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    for (Buffer& b : batch) {
+                        b.size = 0;
+                        m_free.push_back(b);
+                    }
+                }
+                batch.clear();
+                m_bufferFree.notify_all();
+                const off_t start = m_offset;
+                writeBatch(m_packed);
+                recordBlocks(start);
+            } else if (!batch.empty()) {
+                writeBatch(batch);
+            }
+            const bool due = std::chrono::steady_clock::now() - m_lastSync >= m_options.syncInterval;
+            if (m_dirty && (m_options.durability == Durability::GroupCommit ||
+                            (m_options.durability == Durability::Periodic && due)))
+                datasync();
+        } catch (const std::exception& ex) {
+            error = ex.what();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (Buffer& b : batch) {
+                b.size = 0;
+                m_free.push_back(b);
+            }
+            m_inFlight = 0;
+            if (!error.empty() && m_error.empty()) m_error = error;
+        }
+        batch.clear();
+        m_bufferFree.notify_all();
+    }
+}
+
+// ── FileWriter ───────────────────────────────────────────────────────────────
+
+namespace {
+
+/// Record space in stream mode; no field asks for more.
+constexpr std::size_t StagingSize = 4096;
+
+} // namespace
+
 FileWriter::FileWriter(const std::string& path, bool append) {
     const auto mode = append
         ? (std::ios::out | std::ios::app)
@@ -13,6 +561,20 @@ FileWriter::FileWriter(const std::string& path, bool append) {
     }
 }
 
+FileWriter::FileWriter(const std::string& path, const WriterOptions& options, bool append) {
+    if (!options.async && options.compression == Compression::None) {
+        const auto mode = append
+            ? (std::ios::out | std::ios::app)
+            : (std::ios::out | std::ios::trunc);
+        m_file.open(path, mode);
+        if (!m_file.is_open()) {
+            throw std::runtime_error("FileWriter: cannot open file: " + path);
+        }
+        return;
+    }
+    m_async = std::make_unique<AsyncWriter>(path, options, append);
+}
+
 FileWriter::~FileWriter() {
     if (m_file.is_open()) {
         m_file.flush();
@@ -20,30 +582,242 @@ FileWriter::~FileWriter() {
     }
 }
 
-void FileWriter::writeLine(const std::string& line) {
-    const std::string out = line + "\n";
-    m_file.write(out.data(), static_cast<std::streamsize>(out.size()));
-    m_bytesWritten += out.size();
+void FileWriter::writeLine(std::string_view line) {
+    if (m_async) {
+        m_async->writeLine(line);
+    } else {
+        m_file.write(line.data(), static_cast<std::streamsize>(line.size()));
+        m_file.put('\n');
+    }
+    m_bytesWritten += line.size() + 1;
 }
 
 void FileWriter::writeBytes(const std::vector<uint8_t>& data) {
-    m_file.write(
-        reinterpret_cast<const char*>(data.data()),
-        static_cast<std::streamsize>(data.size())
-    );
-    m_bytesWritten += data.size();
+    writeBytes(data.data(), data.size());
+}
+
+void FileWriter::writeBytes(const void* data, std::size_t size) {
+    if (m_async) {
+        m_async->write(static_cast<const char*>(data), size);
+    } else {
+        m_file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    }
+    m_bytesWritten += size;
+}
+
+FileWriter::Record FileWriter::record(RecordFormat format) {
+    return Record(*this, format);
+}
+
+void FileWriter::space(std::size_t need, char*& first, char*& last) {
+    if (m_async) {
+        m_async->space(need, first, last);
+        return;
+    }
+    // Stream mode stages each piece of a record and hands it to the
+    // stream's own buffer on commit, so the staging area is always empty here.
+    if (need > StagingSize) throw std::length_error("FileWriter: record field too large");
+    if (!m_staging) m_staging.reset(new char[StagingSize]);
+    first = m_staging.get();
+    last  = m_staging.get() + StagingSize;
+}
+
+void FileWriter::commit(const char* end) {
+    if (m_async) {
+        m_bytesWritten += m_async->commit(end);
+    } else {
+        const auto size = static_cast<std::size_t>(end - m_staging.get());
+        m_file.write(m_staging.get(), static_cast<std::streamsize>(size));
+        m_bytesWritten += size;
+    }
 }
 
 void FileWriter::flush() {
-    m_file.flush();
+    if (m_async) {
+        m_async->flush();
+    } else {
+        m_file.flush();
+    }
+}
+
+void FileWriter::sync() {
+    if (m_async) {
+        m_async->sync();
+    } else {
+        m_file.flush();
+    }
 }
 
 bool FileWriter::isOpen() const noexcept {
-    return m_file.is_open();
+    return m_async != nullptr || m_file.is_open();
 }
 
 std::size_t FileWriter::bytesWritten() const noexcept {
     return m_bytesWritten;
 }
 
+WriteBackend FileWriter::backend() const noexcept {
+    return m_async ? m_async->backend() : WriteBackend::Auto;
+}
+
+// ── FileWriter::Record ───────────────────────────────────────────────────────
+//
+// A record keeps a window [m_pos, m_end) of the writer's free space and
+// formats into it directly; only when a field might not fit does it commit
+// what it has and ask the writer for a fresh window.
+
+namespace {
+
+/// Longest shortest-form double or 64-bit integer, plus a separator.
+constexpr std::size_t MaxNumber = 32;
+
+/// Input characters escaped per ensure() call.
+constexpr std::size_t TextChunk = 256;
+
+} // namespace
+
+FileWriter::Record::Record(FileWriter& writer, RecordFormat format)
+    : m_writer(writer), m_format(format)
+{
+    m_writer.space(MaxNumber, m_pos, m_end);
+    if (m_format == RecordFormat::JsonLines) *m_pos++ = '{';
+}
+
+FileWriter::Record::~Record() {
+    if (!m_open) return;
+    try {
+        end();
+    } catch (...) {
+        // Destructors must not throw; an async write error is reported
+        // again by the writer's next call.
+    }
+}
+
+void FileWriter::Record::end() {
+    if (!m_open) return;
+    m_open = false;
+    ensure(2);
+    if (m_format == RecordFormat::JsonLines) *m_pos++ = '}';
+    *m_pos++ = '\n';
+    m_writer.commit(m_pos);
+}
+
+void FileWriter::Record::ensure(std::size_t need) {
+    if (static_cast<std::size_t>(m_end - m_pos) >= need) return;
+    try {
+        m_writer.commit(m_pos);
+        m_writer.space(need, m_pos, m_end);
+    } catch (...) {
+        // The space may already belong to the background thread: abandon
+        // the record rather than finish it there.
+        m_open = false;
+        throw;
+    }
+}
+
+void FileWriter::Record::begin(std::string_view name) {
+    if (m_format == RecordFormat::Csv) {
+        ensure(1);
+        if (!m_first) *m_pos++ = ',';
+    } else {
+        ensure(2);
+        if (!m_first) *m_pos++ = ',';
+        text(name);
+        ensure(1);
+        *m_pos++ = ':';
+    }
+    m_first = false;
+}
+
+void FileWriter::Record::text(std::string_view value) {
+    if (m_format == RecordFormat::Csv) {
+        // Quote only when the value needs it, doubling embedded quotes.
+        const bool quote = value.find_first_of(",\"\r\n") != std::string_view::npos;
+        if (quote) {
+            ensure(1);
+            *m_pos++ = '"';
+        }
+        while (!value.empty()) {
+            const std::size_t n = std::min(value.size(), TextChunk);
+            ensure(2 * n);
+            for (const char c : value.substr(0, n)) {
+                if (c == '"') *m_pos++ = '"';
+                *m_pos++ = c;
+            }
+            value.remove_prefix(n);
+        }
+        if (quote) {
+            ensure(1);
+            *m_pos++ = '"';
+        }
+        return;
+    }
+
+    // Room for both quotes, so an empty value needs no further ensure().
+    ensure(2);
+    *m_pos++ = '"';
+    while (!value.empty()) {
+        const std::size_t n = std::min(value.size(), TextChunk);
+        ensure(MaxJsonEscape * n + 1);
+        for (const char c : value.substr(0, n)) m_pos = escapeJsonChar(c, m_pos);
+        value.remove_prefix(n);
+    }
+    *m_pos++ = '"';
+}
+
+FileWriter::Record& FileWriter::Record::field(std::string_view name, double value) {
+    begin(name);
+    ensure(MaxNumber);
+    if (m_format == RecordFormat::JsonLines && !std::isfinite(value)) {
+        std::memcpy(m_pos, "null", 4);
+        m_pos += 4;
+    } else {
+        m_pos = std::to_chars(m_pos, m_end, value).ptr;
+    }
+    return *this;
+}
+
+FileWriter::Record& FileWriter::Record::field(std::string_view name, double value, int precision) {
+    precision = std::clamp(precision, 0, 300);
+    begin(name);
+    // Sign, 309 integer digits of DBL_MAX, point and decimals.
+    ensure(312 + static_cast<std::size_t>(precision));
+    if (m_format == RecordFormat::JsonLines && !std::isfinite(value)) {
+        std::memcpy(m_pos, "null", 4);
+        m_pos += 4;
+    } else {
+        m_pos = std::to_chars(m_pos, m_end, value, std::chars_format::fixed, precision).ptr;
+    }
+    return *this;
+}
+
+FileWriter::Record& FileWriter::Record::field(std::string_view name, bool value) {
+    begin(name);
+    ensure(5);
+    const std::string_view word = value ? "true" : "false";
+    std::memcpy(m_pos, word.data(), word.size());
+    m_pos += word.size();
+    return *this;
+}
+
+FileWriter::Record& FileWriter::Record::field(std::string_view name, std::string_view value) {
+    begin(name);
+    text(value);
+    return *this;
+}
+
+FileWriter::Record& FileWriter::Record::integer(std::string_view name, long long value) {
+    begin(name);
+    ensure(MaxNumber);
+    m_pos = std::to_chars(m_pos, m_end, value).ptr;
+    return *this;
+}
+
+FileWriter::Record& FileWriter::Record::integer(std::string_view name, unsigned long long value) {
+    begin(name);
+    ensure(MaxNumber);
+    m_pos = std::to_chars(m_pos, m_end, value).ptr;
+    return *this;
+}
+
 } // namespace io
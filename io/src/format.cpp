@@ -0,0 +1,105 @@
+#include "io/format.h"
+#include <charconv>
+
+namespace io {
+
+namespace {
+
+struct Spec {
+    int  precision = -1;
+    char type      = '\0';
+};
+
+/// Parse the inside of a replacement field (between '{' and '}').
+Spec parseSpec(std::string_view field) {
+    Spec spec;
+    if (field.empty() || field[0] != ':') return spec;
+    std::size_t i = 1;
+    if (i < field.size() && field[i] == '.') {
+        int p = 0;
+        for (++i; i < field.size() && field[i] >= '0' && field[i] <= '9'; ++i)
+            p = p * 10 + (field[i] - '0');
+        spec.precision = p;
+    }
+    if (i < field.size()) spec.type = field[i];
+    return spec;
+}
+
+template <typename T>
+void appendChars(std::string& out, T value) {
+    char buf[24];
+    const auto res = std::to_chars(buf, buf + sizeof buf, value);
+    out.append(buf, res.ptr);
+}
+
+void appendDouble(std::string& out, double value, const Spec& spec) {
+    char buf[640];  // fits any double in fixed notation at the clamped precision
+    std::to_chars_result res;
+    if (spec.precision < 0) {
+        res = std::to_chars(buf, buf + sizeof buf, value);
+    } else {
+        const int precision = spec.precision > 300 ? 300 : spec.precision;
+        std::chars_format format = std::chars_format::general;
+        if (spec.type == 'f') format = std::chars_format::fixed;
+        if (spec.type == 'e') format = std::chars_format::scientific;
+        res = std::to_chars(buf, buf + sizeof buf, value, format, precision);
+    }
+    if (res.ec == std::errc{}) {
+        out.append(buf, res.ptr);
+    } else {
+        out += "{?}";
+    }
+}
+
+void appendArg(std::string& out, const FormatArg& arg, const Spec& spec) {
+    switch (arg.type()) {
+        case FormatArg::Type::Bool:   out += arg.asBool() ? "true" : "false"; break;
+        case FormatArg::Type::Char:   out += arg.asChar();                    break;
+        case FormatArg::Type::Int:    appendChars(out, arg.asInt());          break;
+        case FormatArg::Type::UInt:   appendChars(out, arg.asUInt());         break;
+        case FormatArg::Type::Double: appendDouble(out, arg.asDouble(), spec); break;
+        case FormatArg::Type::String: out += arg.asString();                  break;
+    }
+}
+
+} // namespace
+
+void vformatTo(std::string& out, std::string_view fmt, const FormatArg* args, std::size_t count) {
+    std::size_t next = 0;
+    std::size_t i = 0;
+    while (i < fmt.size()) {
+        const char c = fmt[i];
+        if (c == '{') {
+            if (i + 1 < fmt.size() && fmt[i + 1] == '{') {
+                out += '{';
+                i += 2;
+                continue;
+            }
+            const std::size_t close = fmt.find('}', i + 1);
+            if (close == std::string_view::npos) {
+                out.append(fmt.substr(i));
+                return;
+            }
+            if (next < count) {
+                appendArg(out, args[next], parseSpec(fmt.substr(i + 1, close - i - 1)));
+            } else {
+                out += "{?}";
+            }
+            ++next;
+            i = close + 1;
+            continue;
+        }
+        if (c == '}' && i + 1 < fmt.size() && fmt[i + 1] == '}') {
+            out += '}';
+            i += 2;
+            continue;
+        }
+        // Copy the literal run up to the next brace in one append.
+        std::size_t end = fmt.find_first_of("{}", i + 1);
+        if (end == std::string_view::npos) end = fmt.size();
+        out.append(fmt.substr(i, end - i));
+        i = end;
+    }
+}
+
+} // namespace io
@@ -1,37 +1,330 @@
 #include "io/logger.h"
 #include <iostream>
 #include <chrono>
+#include <condition_variable>
 #include <ctime>
-#include <iomanip>
-#include <sstream>
+#include <thread>
+#include <vector>
 
 namespace io {
 
+// ── async backend ────────────────────────────────────────────────────────────
+//
+// Each producer thread owns a single-producer / single-consumer ring, so the
+// hot path is a copy into a preallocated slot plus one release store; there
+// is no shared cache line between producers.  The writer thread round-robins
+// over all rings, formats records into one batch string and writes it with a
+// single call.  Slot strings keep their capacity, so steady-state producers
+// do not allocate.
+
+class Logger::AsyncBackend {
+public:
+    AsyncBackend(const AsyncOptions& options, const std::atomic<TimestampPrecision>& precision)
+        : m_options(options), m_precision(precision) {}
+    ~AsyncBackend() { stop(); }
+
+    void start(const AsyncOptions& options);
+    void stop();
+    void push(LogLevel level, std::string_view message);
+    void flush();
+    std::uint64_t dropped() const noexcept { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    using Clock = std::chrono::system_clock;
+
+    struct Record {
+        LogLevel          level = LogLevel::INFO;
+        Clock::time_point time;
+        std::string       message;
+    };
+
+    struct Ring {
+        explicit Ring(std::size_t capacity) : slots(capacity), mask(capacity - 1) {}
+
+        std::vector<Record> slots;
+        const std::size_t   mask;
+
+        alignas(64) std::atomic<std::size_t>   head{0};     ///< Written by the producer
+        std::size_t                            cachedTail{0};
+        alignas(64) std::atomic<std::size_t>   tail{0};     ///< Written by the writer thread
+        alignas(64) std::atomic<std::uint64_t> dropped{0};  ///< Written by the producer; for CountDrops
+        std::atomic<bool>                      abandoned{false};
+        std::uint64_t                          reportedDrops{0};
+    };
+
+    /// Thread-local link to the calling thread's ring; marks it abandoned on
+    /// thread exit so the writer can reclaim it once drained.
+    struct ProducerHandle {
+        std::shared_ptr<Ring> ring;
+        ~ProducerHandle() { if (ring) ring->abandoned.store(true, std::memory_order_release); }
+    };
+
+    Ring& localRing();
+    void  run();
+    bool  drain(Ring& ring, std::string& out);
+    void  drainAll(std::string& out);
+    void  write(std::string& out);
+
+    AsyncOptions                           m_options;
+    const std::atomic<TimestampPrecision>& m_precision;
+
+    std::mutex                         m_ringsMutex;
+    std::vector<std::shared_ptr<Ring>> m_rings;
+
+    std::atomic<std::uint64_t> m_dropped{0};   ///< All rings, including reclaimed ones
+
+    std::thread             m_thread;
+    std::atomic<bool>       m_running{false};
+    std::mutex              m_wakeMutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_flushed;
+    std::uint64_t           m_flushRequested{0};
+    std::uint64_t           m_flushCompleted{0};
+};
+
+void Logger::AsyncBackend::start(const AsyncOptions& options) {
+    m_options = options;
+    std::size_t cap = 1;
+    while (cap < m_options.queueCapacity) cap <<= 1;
+    m_options.queueCapacity = cap;
+
+    m_running.store(true, std::memory_order_release);
+    m_thread = std::thread([this] { run(); });
+}
+
+void Logger::AsyncBackend::stop() {
+    if (!m_thread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_running.store(false, std::memory_order_release);
+    }
+    m_wake.notify_all();
+    m_thread.join();
+    m_flushed.notify_all();
+
+    // Pick up anything pushed while the writer was shutting down.
+    std::string out;
+    drainAll(out);
+    write(out);
+    std::cout.flush();
+}
+
+Logger::AsyncBackend::Ring& Logger::AsyncBackend::localRing() {
+    static thread_local ProducerHandle handle;
+    if (!handle.ring) {
+        handle.ring = std::make_shared<Ring>(m_options.queueCapacity);
+        std::lock_guard<std::mutex> lock(m_ringsMutex);
+        m_rings.push_back(handle.ring);
+    }
+    return *handle.ring;
+}
+
+void Logger::AsyncBackend::push(LogLevel level, std::string_view message) {
+    Ring& r = localRing();
+    const std::size_t capacity = r.mask + 1;
+    const std::size_t h = r.head.load(std::memory_order_relaxed);
+
+    if (h - r.cachedTail >= capacity) {
+        r.cachedTail = r.tail.load(std::memory_order_acquire);
+        while (h - r.cachedTail >= capacity) {
+            // Block waits for the writer thread; once stop() has joined it
+            // nothing will free a slot, so the record is dropped instead.
+            if (m_options.overflow != OverflowPolicy::Block || !m_running.load(std::memory_order_acquire)) {
+                r.dropped.store(r.dropped.load(std::memory_order_relaxed) + 1,
+                                std::memory_order_relaxed);
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            std::this_thread::yield();
+            r.cachedTail = r.tail.load(std::memory_order_acquire);
+        }
+    }
+
+    Record& slot = r.slots[h & r.mask];
+    slot.level = level;
+    slot.time  = Clock::now();
+    slot.message.assign(message);
+    r.head.store(h + 1, std::memory_order_release);
+}
+
+void Logger::AsyncBackend::flush() {
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+    if (!m_running.load(std::memory_order_acquire)) return;
+    const std::uint64_t ticket = ++m_flushRequested;
+    m_wake.notify_one();
+    m_flushed.wait(lock, [&] {
+        return m_flushCompleted >= ticket || !m_running.load(std::memory_order_acquire);
+    });
+}
+
+
+void Logger::AsyncBackend::write(std::string& out) {
+    if (out.empty()) return;
+    std::cout.write(out.data(), static_cast<std::streamsize>(out.size()));
+    out.clear();
+}
+
+bool Logger::AsyncBackend::drain(Ring& r, std::string& out) {
+    std::size_t t = r.tail.load(std::memory_order_relaxed);
+    const std::size_t h = r.head.load(std::memory_order_acquire);
+    const bool any = t != h;
+    for (; t != h; ++t) {
+        const Record& rec = r.slots[t & r.mask];
+        Logger::formatLine(out, rec.level, rec.time,
+                           m_precision.load(std::memory_order_relaxed), rec.message);
+        r.tail.store(t + 1, std::memory_order_release);
+        if (out.size() >= m_options.batchBytes) write(out);
+    }
+
+    const std::uint64_t dropped = r.dropped.load(std::memory_order_relaxed);
+    if (m_options.overflow == OverflowPolicy::CountDrops && dropped > r.reportedDrops) {
+        Logger::formatLine(out, LogLevel::WARNING, Clock::now(),
+                           m_precision.load(std::memory_order_relaxed),
+                           std::to_string(dropped - r.reportedDrops) + " log record(s) dropped");
+        r.reportedDrops = dropped;
+    }
+    return any;
+}
+
+void Logger::AsyncBackend::drainAll(std::string& out) {
+    std::vector<std::shared_ptr<Ring>> rings;
+    {
+        std::lock_guard<std::mutex> lock(m_ringsMutex);
+        rings = m_rings;
+    }
+    for (const auto& r : rings) drain(*r, out);
+}
+
+void Logger::AsyncBackend::run() {
+    std::string out;
+    out.reserve(m_options.batchBytes * 2);
+    std::vector<std::shared_ptr<Ring>> rings;
+
+    for (;;) {
+        std::uint64_t flushTarget;
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            flushTarget = m_flushRequested;
+        }
+        const bool stopping = !m_running.load(std::memory_order_acquire);
+
+        {
+            // Reclaim rings whose thread has exited and that are fully drained.
+            std::lock_guard<std::mutex> lock(m_ringsMutex);
+            for (auto it = m_rings.begin(); it != m_rings.end();) {
+                Ring& r = **it;
+                if (r.abandoned.load(std::memory_order_acquire) &&
+                    r.tail.load(std::memory_order_relaxed) == r.head.load(std::memory_order_acquire))
+                    it = m_rings.erase(it);
+                else
+                    ++it;
+            }
+            rings = m_rings;
+        }
+
+        bool any = false;
+        for (const auto& r : rings) any |= drain(*r, out);
+        write(out);
+
+        if (flushTarget != 0) {
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            if (flushTarget > m_flushCompleted) {
+                lock.unlock();
+                std::cout.flush();
+                lock.lock();
+                m_flushCompleted = flushTarget;
+                m_flushed.notify_all();
+            }
+        }
+
+        if (stopping) break;
+        if (!any) {
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            m_wake.wait_for(lock, m_options.idleWait, [&] {
+                return m_flushRequested > flushTarget || !m_running.load(std::memory_order_acquire);
+            });
+        }
+    }
+    std::cout.flush();
+}
+
+// ── Logger ───────────────────────────────────────────────────────────────────
+
+// The backend exists for the logger's whole life, so droppedCount() and
+// log() never race with its creation; only its writer thread comes and goes.
+Logger::Logger() : m_async(std::make_unique<AsyncBackend>(AsyncOptions{}, m_precision)) {}
+
+Logger::~Logger() {
+    stopAsync();
+}
+
 Logger& Logger::instance() {
     static Logger logger;
     return logger;
 }
 
 void Logger::setLevel(LogLevel level) {
+    m_level.store(level, std::memory_order_relaxed);
+}
+
+void Logger::setTimestampPrecision(TimestampPrecision precision) {
+    m_precision.store(precision, std::memory_order_relaxed);
+}
+
+void Logger::log(LogLevel level, std::string_view message) {
+    if (!isEnabled(level)) return;
+
+    if (m_asyncEnabled.load(std::memory_order_acquire)) {
+        m_async->push(level, message);
+        return;
+    }
+
+    static thread_local std::string line;
+    line.clear();
+    formatLine(line, level, std::chrono::system_clock::now(),
+               m_precision.load(std::memory_order_relaxed), message);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::cout.write(line.data(), static_cast<std::streamsize>(line.size()));
+}
+
+std::string& Logger::formatBuffer() {
+    static thread_local std::string buffer;
+    return buffer;
+}
+
+void Logger::startAsync(const AsyncOptions& options) {
     std::lock_guard<std::mutex> lock(m_mutex);
-    m_level = level;
+    if (m_asyncEnabled.load(std::memory_order_relaxed)) return;
+    m_async->start(options);
+    m_asyncEnabled.store(true, std::memory_order_release);
 }
 
-void Logger::log(LogLevel level, const std::string& message) {
+void Logger::stopAsync() {
     std::lock_guard<std::mutex> lock(m_mutex);
-    if (level >= m_level) {
-        std::cout << "[" << currentTimestamp() << "] "
-                  << "[" << levelToString(level) << "] "
-                  << message << "\n";
+    if (!m_asyncEnabled.load(std::memory_order_relaxed)) return;
+    m_asyncEnabled.store(false, std::memory_order_release);
+    m_async->stop();
+}
+
+bool Logger::isAsync() const noexcept {
+    return m_asyncEnabled.load(std::memory_order_acquire);
+}
+
+void Logger::flush() {
+    if (m_asyncEnabled.load(std::memory_order_acquire)) {
+        m_async->flush();
+        return;
     }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::cout.flush();
 }
 
-void Logger::debug(const std::string& msg)   { log(LogLevel::DEBUG,   msg); }
-void Logger::info(const std::string& msg)    { log(LogLevel::INFO,    msg); }
-void Logger::warning(const std::string& msg) { log(LogLevel::WARNING, msg); }
-void Logger::error(const std::string& msg)   { log(LogLevel::ERROR,   msg); }
+std::uint64_t Logger::droppedCount() const noexcept {
+    return m_async->dropped();
+}
 
-std::string Logger::levelToString(LogLevel level) {
+const char* Logger::levelToString(LogLevel level) {
     switch (level) {
         case LogLevel::DEBUG:   return "DEBUG";
         case LogLevel::INFO:    return "INFO ";
@@ -41,13 +334,51 @@ std::string Logger::levelToString(LogLevel level) {
     return "?????";
 }
 
-std::string Logger::currentTimestamp() {
-    const auto now = std::chrono::system_clock::now();
-    const auto t   = std::chrono::system_clock::to_time_t(now);
-    std::ostringstream oss;
-    // std::localtime is not thread-safe; wrap in the mutex of the caller.
-    oss << std::put_time(std::localtime(&t), "%Y-%m-%d %H:%M:%S");
-    return oss.str();
+namespace {
+
+/// Per-thread rendering of the seconds part of the timestamp.
+struct TimestampCache {
+    std::time_t second = -1;
+    char        text[20]{};   // "YYYY-MM-DD HH:MM:SS"
+};
+
+} // namespace
+
+/// Append "[timestamp] [LEVEL] message\n" to \p out.  Allocation-free once
+/// \p out has enough capacity.
+void Logger::formatLine(std::string& out, LogLevel level,
+                        std::chrono::system_clock::time_point time,
+                        TimestampPrecision precision, std::string_view message)
+{
+    static thread_local TimestampCache cache;
+
+    const auto sinceEpoch = time.time_since_epoch();
+    const auto seconds    = std::chrono::duration_cast<std::chrono::seconds>(sinceEpoch);
+    const std::time_t t   = static_cast<std::time_t>(seconds.count());
+    if (t != cache.second) {
+        std::tm tm{};
+        localtime_r(&t, &tm);
+        std::strftime(cache.text, sizeof cache.text, "%Y-%m-%d %H:%M:%S", &tm);
+        cache.second = t;
+    }
+
+    out += '[';
+    out.append(cache.text, sizeof cache.text - 1);
+    if (precision == TimestampPrecision::Microseconds) {
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(sinceEpoch - seconds).count();
+        char frac[6];
+        for (int i = 5; i >= 0; --i) {
+            frac[i] = static_cast<char>('0' + us % 10);
+            us /= 10;
+        }
+        out += '.';
+        out.append(frac, 6);
+    }
+    out += "] [";
+    out += levelToString(level);
+    out += "] ";
+    out += message;
+    out += '\n';
 }
 
 } // namespace io
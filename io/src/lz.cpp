@@ -0,0 +1,205 @@
+#include "io/lz.h"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "io/lz.cpp: match extension assumes a little-endian target"
+#endif
+
+namespace io {
+
+namespace {
+
+constexpr std::size_t MinMatch  = 4;
+constexpr std::size_t MaxOffset = 65535;
+constexpr int         HashLog   = 14;      ///< 64 KiB table: stays in L2
+/// After 2^SkipShift misses in a row the search step grows by one, so
+/// incompressible input is skipped quickly instead of hashed byte by byte.
+constexpr int         SkipShift = 6;
+/// Bytes moved per step by the wide copies in the decoder.
+constexpr std::size_t Wide      = 16;
+
+std::uint32_t load32(const unsigned char* p) {
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof v);
+    return v;
+}
+
+std::uint64_t load64(const unsigned char* p) {
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof v);
+    return v;
+}
+
+std::uint32_t hash(std::uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - HashLog);
+}
+
+/// Length of the common prefix of \p a and the earlier \p b, up to \p limit.
+std::size_t commonLength(const unsigned char* a, const unsigned char* b, const unsigned char* limit) {
+    const unsigned char* const start = a;
+    while (limit - a >= 8) {
+        const std::uint64_t diff = load64(a) ^ load64(b);
+        if (diff != 0) return static_cast<std::size_t>(a - start) + (__builtin_ctzll(diff) >> 3);
+        a += 8;
+        b += 8;
+    }
+    while (a < limit && *a == *b) {
+        ++a;
+        ++b;
+    }
+    return static_cast<std::size_t>(a - start);
+}
+
+unsigned char* putLength(unsigned char* op, std::size_t n) {
+    for (; n >= 255; n -= 255) *op++ = 255;
+    *op++ = static_cast<unsigned char>(n);
+    return op;
+}
+
+unsigned char* putLiterals(unsigned char* op, unsigned char* token, const unsigned char* literals,
+                           std::size_t count) {
+    *token = static_cast<unsigned char>((count < 15 ? count : 15) << 4);
+    if (count >= 15) op = putLength(op, count - 15);
+    std::memcpy(op, literals, count);
+    return op + count;
+}
+
+unsigned char* putSequence(unsigned char* op, const unsigned char* literals, std::size_t count,
+                           std::size_t offset, std::size_t length) {
+    unsigned char* const token = op++;
+    op = putLiterals(op, token, literals, count);
+    *op++ = static_cast<unsigned char>(offset);
+    *op++ = static_cast<unsigned char>(offset >> 8);
+    const std::size_t extra = length - MinMatch;
+    *token |= static_cast<unsigned char>(extra < 15 ? extra : 15);
+    return extra >= 15 ? putLength(op, extra - 15) : op;
+}
+
+[[noreturn]] void malformed() {
+    throw std::runtime_error("lzDecompress: malformed block");
+}
+
+} // namespace
+
+std::size_t lzCompressBound(std::size_t size) noexcept {
+    return size + size / 255 + 16;
+}
+
+std::size_t lzCompress(const void* src, std::size_t size, void* dst) {
+    if (size > UINT32_MAX) throw std::length_error("lzCompress: block of 4 GiB or more");
+
+    const auto* const base = static_cast<const unsigned char*>(src);
+    const auto* const end  = base + size;
+    auto* op = static_cast<unsigned char*>(dst);
+    const unsigned char* anchor = base;
+
+    if (size >= MinMatch) {
+        // Positions relative to base; 0 (an unused slot) fails the ref < ip test at
+        // the start and is verified by the 4-byte compare everywhere else.
+        std::uint32_t table[std::size_t{1} << HashLog];
+        std::memset(table, 0, sizeof table);
+
+        const unsigned char* const last = end - MinMatch;   // last position with 4 readable bytes
+        const unsigned char* ip = base;
+        std::size_t misses = 0;
+        while (ip <= last) {
+            const std::uint32_t sequence = load32(ip);
+            std::uint32_t& slot = table[hash(sequence)];
+            const unsigned char* ref = base + slot;
+            slot = static_cast<std::uint32_t>(ip - base);
+            if (ref >= ip || static_cast<std::size_t>(ip - ref) > MaxOffset || load32(ref) != sequence) {
+                ip += 1 + (misses++ >> SkipShift);
+                continue;
+            }
+            while (ip > anchor && ref > base && ip[-1] == ref[-1]) {
+                --ip;
+                --ref;
+            }
+            const std::size_t length = MinMatch + commonLength(ip + MinMatch, ref + MinMatch, end);
+            op = putSequence(op, anchor, static_cast<std::size_t>(ip - anchor),
+                             static_cast<std::size_t>(ip - ref), length);
+            ip += length;
+            anchor = ip;
+            misses = 0;
+            // Remember a position inside the match too; it often starts the next one.
+            if (ip <= last) table[hash(load32(ip - 2))] = static_cast<std::uint32_t>(ip - 2 - base);
+        }
+    }
+
+    unsigned char* const token = op++;
+    op = putLiterals(op, token, anchor, static_cast<std::size_t>(end - anchor));
+    return static_cast<std::size_t>(op - static_cast<unsigned char*>(dst));
+}
+
+std::size_t lzDecompress(const void* src, std::size_t size, void* dst, std::size_t capacity) {
+    const auto* ip = static_cast<const unsigned char*>(src);
+    const auto* const iend = ip + size;
+    auto* const obegin = static_cast<unsigned char*>(dst);
+    auto* op = obegin;
+    auto* const oend = obegin + capacity;
+
+    auto readLength = [&](std::size_t n) {
+        unsigned char b;
+        do {
+            if (ip == iend) malformed();
+            b = *ip++;
+            n += b;
+        } while (b == 255);
+        return n;
+    };
+
+    for (;;) {
+        if (ip == iend) malformed();
+        const unsigned token = *ip++;
+
+        std::size_t count = token >> 4;
+        if (count == 15) count = readLength(count);
+        if (count <= Wide && iend - ip >= static_cast<std::ptrdiff_t>(Wide)
+                          && oend - op >= static_cast<std::ptrdiff_t>(Wide)) {
+            std::memcpy(op, ip, Wide);   // short run: one fixed-size copy, tail rewritten later
+        } else {
+            if (count > static_cast<std::size_t>(iend - ip) || count > static_cast<std::size_t>(oend - op))
+                malformed();
+            std::memcpy(op, ip, count);
+        }
+        op += count;
+        ip += count;
+        if (ip == iend) break;
+
+        if (iend - ip < 2) malformed();
+        const std::size_t offset = ip[0] | static_cast<std::size_t>(ip[1]) << 8;
+        ip += 2;
+        std::size_t length = token & 15;
+        if (length == 15) length = readLength(length);
+        length += MinMatch;
+        if (offset == 0 || offset > static_cast<std::size_t>(op - obegin)
+                        || length > static_cast<std::size_t>(oend - op))
+            malformed();
+
+        const unsigned char* const from = op - offset;
+        if (offset >= Wide && static_cast<std::size_t>(oend - op) >= length + Wide) {
+            for (std::size_t i = 0; i < length; i += Wide) std::memcpy(op + i, from + i, Wide);
+        } else if (offset >= length) {
+            std::memcpy(op, from, length);
+        } else {
+            // Overlapping match: the output repeats with period offset.  Copy
+            // in growing chunks, each from a whole number of periods back, so
+            // no single copy overlaps itself.
+            std::size_t done = 0;
+            std::size_t back = offset;
+            while (done < length) {
+                const std::size_t n = length - done < back ? length - done : back;
+                std::memcpy(op + done, op + done - back, n);
+                done += n;
+                back = (done + offset) / offset * offset;
+            }
+        }
+        op += length;
+    }
+    return static_cast<std::size_t>(op - obegin);
+}
+
+} // namespace io
@@ -0,0 +1,294 @@
+#include "io/metrics.h"
+#include "io/file_writer.h"
+#include "io/format.h"
+#include "io/json.h"
+#include "io/logger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <pthread.h>
+#include <stdexcept>
+
+namespace io {
+
+// ── shards ───────────────────────────────────────────────────────────────────
+
+namespace detail {
+
+namespace {
+
+/// Marks the thread's shard abandoned on thread exit so the next snapshot
+/// folds it into the retired totals.
+///
+/// A pthread key rather than a thread_local guard object: key destructors
+/// run after every C++ thread_local destructor, so a thread_local that
+/// records metrics while it is destroyed still finds its shard.  A guard
+/// could be destroyed first, and the late record would register a shard
+/// that nothing abandons.  If a later key destructor records and registers
+/// again, pthreads runs the destructor once more for the new shard.
+void abandonShard(void* shard) {
+    t_metricsShard = nullptr;
+    static_cast<MetricsShard*>(shard)->abandoned.store(true, std::memory_order_release);
+}
+
+pthread_key_t shardKey() {
+    static const pthread_key_t key = [] {
+        pthread_key_t k;
+        if (::pthread_key_create(&k, abandonShard) != 0)
+            throw std::runtime_error("Metrics: cannot create the thread-exit key");
+        return k;
+    }();
+    return key;
+}
+
+} // namespace
+
+MetricsShard* registerShard() {
+    const pthread_key_t key = shardKey();
+    MetricsShard* shard = Metrics::instance().addShard();
+    ::pthread_setspecific(key, shard);
+    t_metricsShard = shard;
+    return shard;
+}
+
+} // namespace detail
+
+// ── registry ─────────────────────────────────────────────────────────────────
+
+Metrics& Metrics::instance() {
+    // Never destroyed: threads still running during static destruction may
+    // record into their shards.
+    static Metrics* metrics = new Metrics();
+    return *metrics;
+}
+
+Metrics::Metrics()
+    : m_retired(new detail::MetricsShard()),
+      m_total(new detail::MetricsShard()),
+      m_calibrationTicks(metricsTicks()),
+      m_calibrationTime(std::chrono::steady_clock::now()) {}
+
+Metrics::~Metrics() = default;
+
+Counter Metrics::counter(const std::string& name) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = std::find(m_counterNames.begin(), m_counterNames.end(), name);
+    if (it != m_counterNames.end()) return Counter(static_cast<std::uint32_t>(it - m_counterNames.begin()));
+    if (m_counterNames.size() == detail::MetricsMaxCounters)
+        throw std::runtime_error("Metrics: too many counters, cannot add " + name);
+    m_counterNames.push_back(name);
+    return Counter(static_cast<std::uint32_t>(m_counterNames.size() - 1));
+}
+
+Histogram Metrics::histogram(const std::string& name) {
+    return registerHistogram(name, false);
+}
+
+Histogram Metrics::timer(const std::string& name) {
+    return registerHistogram(name, true);
+}
+
+Histogram Metrics::registerHistogram(const std::string& name, bool isTimer) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (std::size_t i = 0; i < m_histograms.size(); ++i) {
+        if (m_histograms[i].name != name) continue;
+        if (m_histograms[i].isTimer != isTimer)
+            throw std::runtime_error("Metrics: " + name + " is registered as both a timer and a histogram");
+        return Histogram(static_cast<std::uint32_t>(i));
+    }
+    if (m_histograms.size() == detail::MetricsMaxHistograms)
+        throw std::runtime_error("Metrics: too many histograms, cannot add " + name);
+    m_histograms.push_back(HistogramInfo{name, isTimer});
+    return Histogram(static_cast<std::uint32_t>(m_histograms.size() - 1));
+}
+
+detail::MetricsShard* Metrics::addShard() {
+    auto shard = std::make_unique<detail::MetricsShard>();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_shards.push_back(std::move(shard));
+    return m_shards.back().get();
+}
+
+void Metrics::fold(const detail::MetricsShard& s, detail::MetricsShard& into) const {
+    constexpr auto relaxed = std::memory_order_relaxed;
+    for (std::size_t i = 0; i < m_counterNames.size(); ++i)
+        detail::bump(into.counters[i], s.counters[i].load(relaxed));
+    for (std::size_t h = 0; h < m_histograms.size(); ++h) {
+        const auto& from = s.histograms[h];
+        auto& to = into.histograms[h];
+        for (std::size_t b = 0; b < detail::MetricsBuckets; ++b) detail::bump(to.buckets[b], from.buckets[b].load(relaxed));
+        detail::bump(to.sum, from.sum.load(relaxed));
+        to.max.store(std::max(to.max.load(relaxed), from.max.load(relaxed)), relaxed);
+    }
+}
+
+double Metrics::ticksPerNanosecond() {
+#if defined(__x86_64__) || defined(__i386__)
+    // Measured against steady_clock since construction; wait until the
+    // baseline is long enough for the sampling skew not to matter.
+    using namespace std::chrono;
+    constexpr auto minBaseline = milliseconds(10);
+    const auto elapsed = steady_clock::now() - m_calibrationTime;
+    if (elapsed < minBaseline) std::this_thread::sleep_for(minBaseline - elapsed);
+    const std::uint64_t ticks = metricsTicks();
+    const auto ns = duration_cast<nanoseconds>(steady_clock::now() - m_calibrationTime).count();
+    return static_cast<double>(ticks - m_calibrationTicks) / static_cast<double>(ns);
+#else
+    return 1.0;
+#endif
+}
+
+MetricsSnapshot Metrics::snapshot() {
+    const double nsPerTick = 1.0 / ticksPerNanosecond();
+    MetricsSnapshot snap;
+    snap.time = std::chrono::system_clock::now();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Fold the shards of exited threads into the retired totals.
+    for (auto it = m_shards.begin(); it != m_shards.end();) {
+        if ((*it)->abandoned.load(std::memory_order_acquire)) {
+            fold(**it, *m_retired);
+            it = m_shards.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    // Reuse one merge buffer: only the cells of registered metrics are used.
+    constexpr auto relaxed = std::memory_order_relaxed;
+    detail::MetricsShard* total = m_total.get();
+    for (std::size_t i = 0; i < m_counterNames.size(); ++i) total->counters[i].store(0, relaxed);
+    for (std::size_t h = 0; h < m_histograms.size(); ++h) {
+        auto& cells = total->histograms[h];
+        for (auto& b : cells.buckets) b.store(0, relaxed);
+        cells.sum.store(0, relaxed);
+        cells.max.store(0, relaxed);
+    }
+    fold(*m_retired, *total);
+    for (const auto& shard : m_shards) fold(*shard, *total);
+
+    snap.counters.reserve(m_counterNames.size());
+    for (std::size_t i = 0; i < m_counterNames.size(); ++i)
+        snap.counters.push_back({m_counterNames[i], total->counters[i].load(relaxed)});
+
+    snap.histograms.reserve(m_histograms.size());
+    for (std::size_t h = 0; h < m_histograms.size(); ++h) {
+        const auto& cells = total->histograms[h];
+        MetricsSnapshot::HistogramValue v;
+        v.name = m_histograms[h].name;
+        v.isTimer = m_histograms[h].isTimer;
+        v.scale = v.isTimer ? nsPerTick : 1.0;
+        v.buckets.resize(detail::MetricsBuckets);
+        v.count = 0;
+        for (std::size_t b = 0; b < detail::MetricsBuckets; ++b) {
+            v.buckets[b] = cells.buckets[b].load(relaxed);
+            v.count += v.buckets[b];
+        }
+        v.sum = static_cast<double>(cells.sum.load(relaxed)) * v.scale;
+        v.max = static_cast<double>(cells.max.load(relaxed)) * v.scale;
+        snap.histograms.push_back(std::move(v));
+    }
+    return snap;
+}
+
+double MetricsSnapshot::HistogramValue::percentile(double q) const noexcept {
+    if (count == 0) return 0.0;
+    const double r = std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(count));
+    const std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(r));
+    std::uint64_t seen = 0;
+    for (std::size_t b = 0; b < buckets.size(); ++b) {
+        seen += buckets[b];
+        if (seen < rank) continue;
+        const double lo = static_cast<double>(detail::bucketLowerBound(b));
+        const double hi = b + 1 < buckets.size() ? static_cast<double>(detail::bucketLowerBound(b + 1)) : lo;
+        return std::min((lo + std::max(lo, hi - 1)) / 2 * scale, max);
+    }
+    return max;
+}
+
+// ── output ───────────────────────────────────────────────────────────────────
+
+void Metrics::report(Logger& log, LogLevel level) {
+    if (!log.isEnabled(level)) return;
+    const MetricsSnapshot snap = snapshot();
+    for (const auto& c : snap.counters) log.log(level, "metric {} = {}", c.name, c.value);
+    for (const auto& h : snap.histograms) {
+        const char* unit = h.isTimer ? " ns" : "";
+        log.log(level, "metric {} count={} mean={:.1f}{} p50={:.1f}{} p99={:.1f}{} max={:.1f}{}",
+                h.name, h.count, h.mean(), unit, h.percentile(0.5), unit, h.percentile(0.99), unit,
+                h.max, unit);
+    }
+}
+
+void Metrics::writeJson(FileWriter& out) {
+    const MetricsSnapshot snap = snapshot();
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(snap.time.time_since_epoch()).count();
+    std::string line = "{\"time\":";
+    formatTo(line, "{}", static_cast<long long>(ms));
+    line += ",\"counters\":{";
+    for (std::size_t i = 0; i < snap.counters.size(); ++i) {
+        if (i) line += ',';
+        appendJsonString(line, snap.counters[i].name);
+        formatTo(line, ":{}", snap.counters[i].value);
+    }
+    line += "},\"histograms\":{";
+    for (std::size_t i = 0; i < snap.histograms.size(); ++i) {
+        const auto& h = snap.histograms[i];
+        if (i) line += ',';
+        appendJsonString(line, h.name);
+        line += h.isTimer ? ":{\"unit\":\"ns\"" : ":{\"unit\":\"\"";
+        formatTo(line, ",\"count\":{},\"mean\":{:.1f},\"p50\":{:.1f},\"p90\":{:.1f},\"p99\":{:.1f},\"max\":{:.1f}",
+                 h.count, h.mean(), h.percentile(0.5), h.percentile(0.9), h.percentile(0.99), h.max);
+        line += '}';
+    }
+    line += "}}";
+    out.writeLine(line);
+}
+
+// ── reporter ─────────────────────────────────────────────────────────────────
+
+MetricsReporter::MetricsReporter(std::chrono::milliseconds interval, Logger& log, LogLevel level)
+    : m_log(&log), m_level(level) {
+    start(interval);
+}
+
+MetricsReporter::MetricsReporter(std::chrono::milliseconds interval, FileWriter& out)
+    : m_out(&out) {
+    start(interval);
+}
+
+MetricsReporter::~MetricsReporter() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    m_thread.join();
+    try {
+        emit();
+    } catch (...) {
+        // Destructors must not throw; a failing FileWriter reports its
+        // error on the owner's next call.
+    }
+}
+
+void MetricsReporter::start(std::chrono::milliseconds interval) {
+    m_thread = std::thread([this, interval] {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!m_wake.wait_for(lock, interval, [this] { return m_stop; })) {
+            lock.unlock();
+            try {
+                emit();
+            } catch (const std::exception& ex) {
+                Logger::instance().error("MetricsReporter: {}", ex.what());
+            }
+            lock.lock();
+        }
+    });
+}
+
+void MetricsReporter::emit() {
+    if (m_log) Metrics::instance().report(*m_log, m_level);
+    else Metrics::instance().writeJson(*m_out);
+}
+
+} // namespace io
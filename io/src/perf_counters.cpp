@@ -0,0 +1,303 @@
+#include "io/perf_counters.h"
+#include "io/file_writer.h"
+#include "io/format.h"
+#include "io/json.h"
+#include "io/logger.h"
+
+#include <chrono>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(__linux__)
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+namespace io {
+
+namespace {
+
+constexpr const char* EventNames[PerfEventCount] = {"cycles", "instructions", "cache-misses", "branch-misses"};
+
+std::uint64_t steadyNanoseconds() noexcept {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+#if defined(__linux__)
+
+std::uint32_t bit(PerfEvent e) noexcept {
+    return 1u << static_cast<unsigned>(e);
+}
+
+constexpr std::uint64_t EventConfigs[PerfEventCount] = {
+    PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES,
+};
+
+/// Count \p e in user space for the calling thread on any CPU.  A group
+/// leader starts disabled and is enabled once the whole group is open;
+/// members follow their leader.
+int openEvent(PerfEvent e, int groupFd, bool grouped) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof attr);
+    attr.size           = sizeof attr;
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.config         = EventConfigs[static_cast<std::size_t>(e)];
+    attr.disabled       = groupFd < 0 ? 1 : 0;
+    attr.exclude_kernel = 1;   // allowed up to perf_event_paranoid 2
+    attr.exclude_hv     = 1;
+    attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    if (grouped) attr.read_format |= PERF_FORMAT_GROUP;
+    return static_cast<int>(::syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, PERF_FLAG_FD_CLOEXEC));
+}
+
+bool readExact(int fd, void* dst, std::size_t size) noexcept {
+    const ssize_t n = ::read(fd, dst, size);
+    return n == static_cast<ssize_t>(size);
+}
+
+#endif
+
+} // namespace
+
+const char* perfEventName(PerfEvent event) noexcept {
+    return EventNames[static_cast<std::size_t>(event)];
+}
+
+// ── PerfSample ───────────────────────────────────────────────────────────────
+
+double PerfSample::ipc() const noexcept {
+    if (!has(PerfEvent::Cycles) || !has(PerfEvent::Instructions) || count(PerfEvent::Cycles) == 0)
+        return std::numeric_limits<double>::quiet_NaN();
+    return static_cast<double>(count(PerfEvent::Instructions)) / static_cast<double>(count(PerfEvent::Cycles));
+}
+
+double PerfSample::perElement(PerfEvent e) const noexcept {
+    if (!has(e) || elements == 0) return std::numeric_limits<double>::quiet_NaN();
+    return static_cast<double>(count(e)) / static_cast<double>(elements);
+}
+
+PerfSample& PerfSample::operator+=(const PerfSample& other) noexcept {
+    valid = runs ? valid & other.valid : other.valid;
+    for (std::size_t i = 0; i < PerfEventCount; ++i) counts[i] += other.counts[i];
+    elements    += other.elements;
+    nanoseconds += other.nanoseconds;
+    runs        += other.runs;
+    multiplexed  = multiplexed || other.multiplexed;
+    return *this;
+}
+
+// ── PerfCounters ─────────────────────────────────────────────────────────────
+
+PerfCounters::PerfCounters(Mode mode) : m_mode(mode) {
+    m_fd.fill(-1);
+#if defined(__linux__)
+    const bool grouped = mode == Mode::Grouped;
+    for (std::size_t i = 0; i < PerfEventCount; ++i) {
+        const auto e = static_cast<PerfEvent>(i);
+        const int leader = grouped && m_opened ? m_fd[static_cast<std::size_t>(m_order[0])] : -1;
+        const int fd = openEvent(e, leader, grouped);
+        if (fd < 0) {
+            // Keep the first reason: it is usually the same for every event.
+            const int error = errno;
+            if (m_error.empty()) {
+                m_error = std::string("perf_event_open(") + EventNames[i] + "): " + std::strerror(error);
+                if (error == EACCES || error == EPERM) m_error += " (see /proc/sys/kernel/perf_event_paranoid)";
+                else if (error == ENOENT) m_error += " (no hardware counters)";
+            }
+            continue;
+        }
+        m_fd[i] = fd;
+        m_order[m_opened++] = e;
+        m_valid |= bit(e);
+    }
+    for (std::size_t i = 0; i < PerfEventCount; ++i) {
+        if (m_fd[i] >= 0 && (!grouped || static_cast<PerfEvent>(i) == m_order[0]))
+            ::ioctl(m_fd[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+#else
+    m_error = "perf_event_open: not supported on this platform";
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#if defined(__linux__)
+    // Members first, then the leader.
+    for (std::size_t i = m_opened; i-- > 0;) ::close(m_fd[static_cast<std::size_t>(m_order[i])]);
+#endif
+}
+
+PerfCounters& PerfCounters::forThisThread() {
+    thread_local PerfCounters counters;
+    return counters;
+}
+
+std::string PerfCounters::unavailableReason() {
+    static const std::string reason = PerfCounters().error();
+    return reason;
+}
+
+PerfCounters::Mark PerfCounters::mark() const noexcept {
+    Mark m;
+#if defined(__linux__)
+    if (m_mode == Mode::Grouped && m_opened) {
+        // { nr, time_enabled, time_running, value[nr] } in group order.
+        std::uint64_t buffer[3 + PerfEventCount];
+        const int leader = m_fd[static_cast<std::size_t>(m_order[0])];
+        if (readExact(leader, buffer, sizeof(std::uint64_t) * (3 + m_opened)) && buffer[0] == m_opened) {
+            for (std::size_t i = 0; i < m_opened; ++i) {
+                const auto e = static_cast<std::size_t>(m_order[i]);
+                m.readings[e] = {buffer[3 + i], buffer[1], buffer[2]};
+                m.valid |= 1u << e;
+            }
+        }
+    } else {
+        for (std::size_t i = 0; i < PerfEventCount; ++i) {
+            std::uint64_t buffer[3];
+            if (m_fd[i] >= 0 && readExact(m_fd[i], buffer, sizeof buffer)) {
+                m.readings[i] = {buffer[0], buffer[1], buffer[2]};
+                m.valid |= 1u << i;
+            }
+        }
+    }
+#endif
+    m.nanoseconds = steadyNanoseconds();
+    return m;
+}
+
+PerfSample PerfCounters::since(const Mark& start, std::uint64_t elements) const noexcept {
+    const Mark end = mark();
+    PerfSample s;
+    s.elements    = elements;
+    s.nanoseconds = end.nanoseconds - start.nanoseconds;
+    s.runs        = 1;
+    for (std::size_t i = 0; i < PerfEventCount; ++i) {
+        if (!(start.valid & end.valid & (1u << i))) continue;
+        const auto& a = start.readings[i];
+        const auto& b = end.readings[i];
+        const std::uint64_t enabled = b.enabled - a.enabled;
+        const std::uint64_t running = b.running - a.running;
+        // Never on the PMU during the region: there is nothing to scale.
+        if (running == 0 && enabled != 0) continue;
+        std::uint64_t value = b.value - a.value;
+        if (running < enabled) {
+            value = static_cast<std::uint64_t>(static_cast<double>(value) * static_cast<double>(enabled)
+                                               / static_cast<double>(running));
+            s.multiplexed = true;
+        }
+        s.counts[i] = value;
+        s.valid |= 1u << i;
+    }
+    return s;
+}
+
+// ── PerfReport ───────────────────────────────────────────────────────────────
+
+void PerfReport::add(const std::string& region, const PerfSample& sample) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& r : m_regions) {
+        if (r.first == region) {
+            r.second += sample;
+            return;
+        }
+    }
+    m_regions.emplace_back(region, sample);
+}
+
+std::vector<std::pair<std::string, PerfSample>> PerfReport::regions() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_regions;
+}
+
+void PerfReport::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_regions.clear();
+}
+
+void PerfReport::report(Logger& log, LogLevel level) const {
+    if (!log.isEnabled(level)) return;
+    std::string line;
+    for (const auto& [name, s] : regions()) {
+        line.clear();
+        formatTo(line, "perf {} runs={} elements={} time={:.3f} ms", name, s.runs, s.elements,
+                 static_cast<double>(s.nanoseconds) / 1e6);
+        if (!s.valid) {
+            formatTo(line, " counters unavailable ({})", PerfCounters::unavailableReason());
+            log.log(level, line);
+            continue;
+        }
+        for (std::size_t i = 0; i < PerfEventCount; ++i) {
+            if (s.valid & (1u << i)) formatTo(line, " {}={}", EventNames[i], s.counts[i]);
+        }
+        if (s.has(PerfEvent::Cycles) && s.has(PerfEvent::Instructions)) formatTo(line, " ipc={:.2f}", s.ipc());
+        if (s.elements) {
+            if (s.has(PerfEvent::CacheMisses))
+                formatTo(line, " cache-misses/element={:.4f}", s.perElement(PerfEvent::CacheMisses));
+            if (s.has(PerfEvent::BranchMisses))
+                formatTo(line, " branch-misses/element={:.4f}", s.perElement(PerfEvent::BranchMisses));
+        }
+        if (s.multiplexed) line += " (multiplexed)";
+        log.log(level, line);
+    }
+}
+
+void PerfReport::writeJson(FileWriter& out) const {
+    auto number = [](std::string& line, double v) {
+        if (std::isfinite(v)) formatTo(line, "{:.4f}", v);
+        else line += "null";
+    };
+
+    const auto all = regions();
+    bool measured = false;
+    for (const auto& r : all) measured = measured || r.second.valid;
+    const std::string reason = PerfCounters::unavailableReason();
+
+    std::string line = "{\"available\":";
+    line += measured ? "true" : "false";
+    if (!reason.empty()) {
+        line += ",\"error\":";
+        appendJsonString(line, reason);
+    }
+    line += ",\"regions\":{";
+    for (std::size_t r = 0; r < all.size(); ++r) {
+        const auto& [name, s] = all[r];
+        if (r) line += ',';
+        appendJsonString(line, name);
+        formatTo(line, ":{{\"runs\":{},\"elements\":{},\"ns\":{}", s.runs, s.elements, s.nanoseconds);
+        for (std::size_t i = 0; i < PerfEventCount; ++i) {
+            formatTo(line, ",\"{}\":", EventNames[i]);
+            if (s.valid & (1u << i)) formatTo(line, "{}", s.counts[i]);
+            else line += "null";
+        }
+        line += ",\"ipc\":";
+        number(line, s.ipc());
+        line += ",\"cache-misses/element\":";
+        number(line, s.perElement(PerfEvent::CacheMisses));
+        line += ",\"branch-misses/element\":";
+        number(line, s.perElement(PerfEvent::BranchMisses));
+        formatTo(line, ",\"multiplexed\":{}}}", s.multiplexed);
+    }
+    line += "}}";
+    out.writeLine(line);
+}
+
+// ── ScopedPerf ───────────────────────────────────────────────────────────────
+
+ScopedPerf::ScopedPerf(PerfReport& report, std::string region, std::uint64_t elements)
+    : m_report(report), m_region(std::move(region)), m_elements(elements),
+      m_counters(PerfCounters::forThisThread()), m_start(m_counters.mark())
+{}
+
+ScopedPerf::~ScopedPerf() {
+    try {
+        m_report.add(m_region, m_counters.since(m_start, m_elements));
+    } catch (...) {
+        // Destructors must not throw; a failed allocation loses this run.
+    }
+}
+
+} // namespace io
@@ -0,0 +1,172 @@
+#include "uring.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace io {
+namespace detail {
+
+namespace {
+
+int uringSetup(unsigned entries, io_uring_params* p) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, p));
+}
+
+int uringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags,
+                                    nullptr, 0));
+}
+
+int uringRegister(int fd, unsigned opcode, void* arg, unsigned count) {
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, count));
+}
+
+/// IORING_OP_WRITE arrived in 5.6, together with IORING_REGISTER_PROBE; on
+/// 5.1 - 5.5 the ring sets up but every write fails with -EINVAL.
+bool supportsWrite(int fd) {
+    constexpr unsigned Ops = 256;
+    alignas(io_uring_probe) unsigned char storage[sizeof(io_uring_probe) + Ops * sizeof(io_uring_probe_op)];
+    std::memset(storage, 0, sizeof storage);
+    auto* probe = reinterpret_cast<io_uring_probe*>(storage);
+    if (uringRegister(fd, IORING_REGISTER_PROBE, probe, Ops) < 0) return false;
+    return probe->last_op >= IORING_OP_WRITE && (probe->ops[IORING_OP_WRITE].flags & IO_URING_OP_SUPPORTED);
+}
+
+template <typename T>
+T* at(void* base, unsigned offset) {
+    return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+}
+
+} // namespace
+
+Uring::~Uring() {
+    if (m_sqes) munmap(m_sqes, m_sqesSize);
+    if (m_cqRing && m_cqRing != m_sqRing) munmap(m_cqRing, m_cqRingSize);
+    if (m_sqRing) munmap(m_sqRing, m_sqRingSize);
+    if (m_fd >= 0) close(m_fd);
+}
+
+bool Uring::init(unsigned entries) {
+    io_uring_params p;
+    std::memset(&p, 0, sizeof p);
+    const int fd = uringSetup(entries, &p);
+    if (fd < 0) return false;
+    m_fd = fd;
+    m_entries = p.sq_entries;
+    if (!supportsWrite(fd)) return false;
+
+    m_sqRingSize = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    m_cqRingSize = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+    const bool single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single) m_sqRingSize = m_cqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+
+    m_sqRing = mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                    fd, IORING_OFF_SQ_RING);
+    if (m_sqRing == MAP_FAILED) { m_sqRing = nullptr; return false; }
+
+    if (single) {
+        m_cqRing = m_sqRing;
+    } else {
+        m_cqRing = mmap(nullptr, m_cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        fd, IORING_OFF_CQ_RING);
+        if (m_cqRing == MAP_FAILED) { m_cqRing = nullptr; return false; }
+    }
+
+    m_sqesSize = p.sq_entries * sizeof(io_uring_sqe);
+    m_sqes = mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                  fd, IORING_OFF_SQES);
+    if (m_sqes == MAP_FAILED) { m_sqes = nullptr; return false; }
+
+    m_sqTail  = at<unsigned>(m_sqRing, p.sq_off.tail);
+    m_sqMask  = at<unsigned>(m_sqRing, p.sq_off.ring_mask);
+    m_sqArray = at<unsigned>(m_sqRing, p.sq_off.array);
+    m_cqHead  = at<unsigned>(m_cqRing, p.cq_off.head);
+    m_cqTail  = at<unsigned>(m_cqRing, p.cq_off.tail);
+    m_cqMask  = at<unsigned>(m_cqRing, p.cq_off.ring_mask);
+    m_cqes    = at<void>(m_cqRing, p.cq_off.cqes);
+    return true;
+}
+
+long long Uring::writeAll(int fd, const iovec* bufs, unsigned count, off_t offset) {
+    auto* sqes = static_cast<io_uring_sqe*>(m_sqes);
+    auto* cqes = static_cast<io_uring_cqe*>(m_cqes);
+    long long total = 0;
+
+    for (unsigned done = 0; done < count;) {
+        const unsigned batch = std::min(count - done, m_entries);
+
+        unsigned tail = *m_sqTail;
+        off_t pos = offset;
+        for (unsigned i = 0; i < batch; ++i) {
+            const unsigned idx = tail & *m_sqMask;
+            io_uring_sqe& sqe = sqes[idx];
+            std::memset(&sqe, 0, sizeof sqe);
+            sqe.opcode    = IORING_OP_WRITE;
+            sqe.fd        = fd;
+            sqe.addr      = reinterpret_cast<std::uint64_t>(bufs[done + i].iov_base);
+            sqe.len       = static_cast<std::uint32_t>(bufs[done + i].iov_len);
+            sqe.off       = static_cast<std::uint64_t>(pos);
+            sqe.user_data = done + i;
+            m_sqArray[idx] = idx;
+            pos += static_cast<off_t>(bufs[done + i].iov_len);
+            ++tail;
+        }
+        __atomic_store_n(m_sqTail, tail, __ATOMIC_RELEASE);
+
+        // The kernel may consume fewer SQEs than asked for, and a signal can
+        // interrupt the wait; either way it may already own some buffers, so
+        // every submitted write is reaped before returning, even on error.
+        unsigned queued = batch;
+        unsigned submitted = 0;
+        unsigned reaped = 0;
+        long long firstError = 0;
+        bool shortWrite = false;
+        for (;;) {
+            unsigned head = *m_cqHead;
+            const unsigned cqTail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+            for (; head != cqTail; ++head, ++reaped) {
+                // Results may arrive in any order.
+                const io_uring_cqe& cqe = cqes[head & *m_cqMask];
+                const unsigned i = static_cast<unsigned>(cqe.user_data);
+                if (cqe.res < 0) {
+                    if (firstError == 0) firstError = cqe.res;
+                } else if (static_cast<std::size_t>(cqe.res) != bufs[i].iov_len) {
+                    shortWrite = true;
+                }
+            }
+            __atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+
+            const unsigned pending = queued - submitted;
+            if (pending == 0 && reaped == submitted) break;
+            const unsigned wait = reaped < submitted ? 1 : 0;
+            const int n = uringEnter(m_fd, pending, wait, wait ? IORING_ENTER_GETEVENTS : 0);
+            if (n >= 0) {
+                submitted += static_cast<unsigned>(n);
+                continue;
+            }
+            if (errno == EINTR) continue;
+            const long long err = -errno;
+            // Only a broken ring (EBADF, EFAULT) fails a bare wait; nothing to reap.
+            if (pending == 0) return err;
+            // Withdraw the SQEs the kernel never consumed, then drain the rest.
+            __atomic_store_n(m_sqTail, tail - pending, __ATOMIC_RELEASE);
+            queued = submitted;
+            if (firstError == 0) firstError = err;
+        }
+        if (firstError != 0) return firstError;
+        if (shortWrite) return total;  // caller rewrites from `total` with pwrite
+
+        for (unsigned i = 0; i < batch; ++i) total += static_cast<long long>(bufs[done + i].iov_len);
+        offset = pos;
+        done += batch;
+    }
+    return total;
+}
+
+} // namespace detail
+} // namespace io
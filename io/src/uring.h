@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+namespace io {
+namespace detail {
+
+/// Minimal io_uring wrapper (raw syscalls, no liburing) that submits a
+/// batch of writes and waits for all of them.  Used only by the async
+/// FileWriter's background thread.
+class Uring {
+public:
+    Uring() = default;
+    ~Uring();
+
+    Uring(const Uring&)            = delete;
+    Uring& operator=(const Uring&) = delete;
+
+    /// Set up a ring with room for \p entries submissions.
+    /// Returns false if io_uring is unavailable (old kernel, seccomp, ...)
+    /// or cannot do plain writes (IORING_OP_WRITE, kernel 5.6+).
+    bool init(unsigned entries);
+
+    bool valid() const noexcept { return m_fd >= 0; }
+
+    /// Write \p count buffers back-to-back starting at \p offset.
+    /// Returns bytes written, or -errno on the first failure.  Short writes
+    /// are reported as a smaller total; the caller finishes them.  Never
+    /// returns while the kernel still holds one of \p bufs.
+    long long writeAll(int fd, const iovec* bufs, unsigned count, off_t offset);
+
+private:
+    int       m_fd = -1;
+    unsigned  m_entries = 0;
+
+    void*     m_sqRing = nullptr;
+    void*     m_cqRing = nullptr;
+    void*     m_sqes   = nullptr;
+    std::size_t m_sqRingSize = 0;
+    std::size_t m_cqRingSize = 0;
+    std::size_t m_sqesSize   = 0;
+
+    unsigned* m_sqTail  = nullptr;
+    unsigned* m_sqMask  = nullptr;
+    unsigned* m_sqArray = nullptr;
+    unsigned* m_cqHead  = nullptr;
+    unsigned* m_cqTail  = nullptr;
+    unsigned* m_cqMask  = nullptr;
+    void*     m_cqes    = nullptr;
+};
+
+} // namespace detail
+} // namespace io